@@ -0,0 +1,202 @@
+// automatically generated by the FlatBuffers compiler, do not modify
+
+
+#ifndef FLATBUFFERS_GENERATED_FBREQUEST_OSRM_ENGINE_API_FBREQUEST_H_
+#define FLATBUFFERS_GENERATED_FBREQUEST_OSRM_ENGINE_API_FBREQUEST_H_
+
+#include "flatbuffers/flatbuffers.h"
+
+// Ensure the included flatbuffers.h is the same version as when this file was
+// generated, otherwise it may not be compatible.
+static_assert(FLATBUFFERS_VERSION_MAJOR == 24 &&
+              FLATBUFFERS_VERSION_MINOR == 3 &&
+              FLATBUFFERS_VERSION_REVISION == 25,
+             "Non-compatible flatbuffers version included");
+
+namespace osrm {
+namespace engine {
+namespace api {
+namespace fbrequest {
+
+struct Coordinate;
+
+struct Bearing;
+
+struct FBRequest;
+struct FBRequestBuilder;
+
+FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(4) Coordinate FLATBUFFERS_FINAL_CLASS {
+ private:
+  int32_t longitude_;
+  int32_t latitude_;
+
+ public:
+  Coordinate()
+      : longitude_(0),
+        latitude_(0) {
+  }
+  Coordinate(int32_t _longitude, int32_t _latitude)
+      : longitude_(::flatbuffers::EndianScalar(_longitude)),
+        latitude_(::flatbuffers::EndianScalar(_latitude)) {
+  }
+  int32_t longitude() const {
+    return ::flatbuffers::EndianScalar(longitude_);
+  }
+  int32_t latitude() const {
+    return ::flatbuffers::EndianScalar(latitude_);
+  }
+};
+FLATBUFFERS_STRUCT_END(Coordinate, 8);
+
+FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(2) Bearing FLATBUFFERS_FINAL_CLASS {
+ private:
+  int16_t bearing_;
+  int16_t range_;
+
+ public:
+  Bearing()
+      : bearing_(0),
+        range_(0) {
+  }
+  Bearing(int16_t _bearing, int16_t _range)
+      : bearing_(::flatbuffers::EndianScalar(_bearing)),
+        range_(::flatbuffers::EndianScalar(_range)) {
+  }
+  int16_t bearing() const {
+    return ::flatbuffers::EndianScalar(bearing_);
+  }
+  int16_t range() const {
+    return ::flatbuffers::EndianScalar(range_);
+  }
+};
+FLATBUFFERS_STRUCT_END(Bearing, 4);
+
+struct FBRequest FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
+  typedef FBRequestBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_COORDINATES = 4,
+    VT_RADIUSES = 6,
+    VT_BEARINGS = 8,
+    VT_TIMESTAMPS = 10
+  };
+  const ::flatbuffers::Vector<const osrm::engine::api::fbrequest::Coordinate *> *coordinates() const {
+    return GetPointer<const ::flatbuffers::Vector<const osrm::engine::api::fbrequest::Coordinate *> *>(VT_COORDINATES);
+  }
+  const ::flatbuffers::Vector<double> *radiuses() const {
+    return GetPointer<const ::flatbuffers::Vector<double> *>(VT_RADIUSES);
+  }
+  const ::flatbuffers::Vector<const osrm::engine::api::fbrequest::Bearing *> *bearings() const {
+    return GetPointer<const ::flatbuffers::Vector<const osrm::engine::api::fbrequest::Bearing *> *>(VT_BEARINGS);
+  }
+  const ::flatbuffers::Vector<uint32_t> *timestamps() const {
+    return GetPointer<const ::flatbuffers::Vector<uint32_t> *>(VT_TIMESTAMPS);
+  }
+  bool Verify(::flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_COORDINATES) &&
+           verifier.VerifyVector(coordinates()) &&
+           VerifyOffset(verifier, VT_RADIUSES) &&
+           verifier.VerifyVector(radiuses()) &&
+           VerifyOffset(verifier, VT_BEARINGS) &&
+           verifier.VerifyVector(bearings()) &&
+           VerifyOffset(verifier, VT_TIMESTAMPS) &&
+           verifier.VerifyVector(timestamps()) &&
+           verifier.EndTable();
+  }
+};
+
+struct FBRequestBuilder {
+  typedef FBRequest Table;
+  ::flatbuffers::FlatBufferBuilder &fbb_;
+  ::flatbuffers::uoffset_t start_;
+  void add_coordinates(::flatbuffers::Offset<::flatbuffers::Vector<const osrm::engine::api::fbrequest::Coordinate *>> coordinates) {
+    fbb_.AddOffset(FBRequest::VT_COORDINATES, coordinates);
+  }
+  void add_radiuses(::flatbuffers::Offset<::flatbuffers::Vector<double>> radiuses) {
+    fbb_.AddOffset(FBRequest::VT_RADIUSES, radiuses);
+  }
+  void add_bearings(::flatbuffers::Offset<::flatbuffers::Vector<const osrm::engine::api::fbrequest::Bearing *>> bearings) {
+    fbb_.AddOffset(FBRequest::VT_BEARINGS, bearings);
+  }
+  void add_timestamps(::flatbuffers::Offset<::flatbuffers::Vector<uint32_t>> timestamps) {
+    fbb_.AddOffset(FBRequest::VT_TIMESTAMPS, timestamps);
+  }
+  explicit FBRequestBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ::flatbuffers::Offset<FBRequest> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = ::flatbuffers::Offset<FBRequest>(end);
+    return o;
+  }
+};
+
+inline ::flatbuffers::Offset<FBRequest> CreateFBRequest(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    ::flatbuffers::Offset<::flatbuffers::Vector<const osrm::engine::api::fbrequest::Coordinate *>> coordinates = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<double>> radiuses = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<const osrm::engine::api::fbrequest::Bearing *>> bearings = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<uint32_t>> timestamps = 0) {
+  FBRequestBuilder builder_(_fbb);
+  builder_.add_timestamps(timestamps);
+  builder_.add_bearings(bearings);
+  builder_.add_radiuses(radiuses);
+  builder_.add_coordinates(coordinates);
+  return builder_.Finish();
+}
+
+inline ::flatbuffers::Offset<FBRequest> CreateFBRequestDirect(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    const std::vector<osrm::engine::api::fbrequest::Coordinate> *coordinates = nullptr,
+    const std::vector<double> *radiuses = nullptr,
+    const std::vector<osrm::engine::api::fbrequest::Bearing> *bearings = nullptr,
+    const std::vector<uint32_t> *timestamps = nullptr) {
+  auto coordinates__ = coordinates ? _fbb.CreateVectorOfStructs<osrm::engine::api::fbrequest::Coordinate>(*coordinates) : 0;
+  auto radiuses__ = radiuses ? _fbb.CreateVector<double>(*radiuses) : 0;
+  auto bearings__ = bearings ? _fbb.CreateVectorOfStructs<osrm::engine::api::fbrequest::Bearing>(*bearings) : 0;
+  auto timestamps__ = timestamps ? _fbb.CreateVector<uint32_t>(*timestamps) : 0;
+  return osrm::engine::api::fbrequest::CreateFBRequest(
+      _fbb,
+      coordinates__,
+      radiuses__,
+      bearings__,
+      timestamps__);
+}
+
+inline const osrm::engine::api::fbrequest::FBRequest *GetFBRequest(const void *buf) {
+  return ::flatbuffers::GetRoot<osrm::engine::api::fbrequest::FBRequest>(buf);
+}
+
+inline const osrm::engine::api::fbrequest::FBRequest *GetSizePrefixedFBRequest(const void *buf) {
+  return ::flatbuffers::GetSizePrefixedRoot<osrm::engine::api::fbrequest::FBRequest>(buf);
+}
+
+inline bool VerifyFBRequestBuffer(
+    ::flatbuffers::Verifier &verifier) {
+  return verifier.VerifyBuffer<osrm::engine::api::fbrequest::FBRequest>(nullptr);
+}
+
+inline bool VerifySizePrefixedFBRequestBuffer(
+    ::flatbuffers::Verifier &verifier) {
+  return verifier.VerifySizePrefixedBuffer<osrm::engine::api::fbrequest::FBRequest>(nullptr);
+}
+
+inline void FinishFBRequestBuffer(
+    ::flatbuffers::FlatBufferBuilder &fbb,
+    ::flatbuffers::Offset<osrm::engine::api::fbrequest::FBRequest> root) {
+  fbb.Finish(root);
+}
+
+inline void FinishSizePrefixedFBRequestBuffer(
+    ::flatbuffers::FlatBufferBuilder &fbb,
+    ::flatbuffers::Offset<osrm::engine::api::fbrequest::FBRequest> root) {
+  fbb.FinishSizePrefixed(root);
+}
+
+}  // namespace fbrequest
+}  // namespace api
+}  // namespace engine
+}  // namespace osrm
+
+#endif  // FLATBUFFERS_GENERATED_FBREQUEST_OSRM_ENGINE_API_FBREQUEST_H_
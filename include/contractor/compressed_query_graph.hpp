@@ -0,0 +1,240 @@
+#ifndef OSRM_CONTRACTOR_COMPRESSED_QUERY_GRAPH_HPP
+#define OSRM_CONTRACTOR_COMPRESSED_QUERY_GRAPH_HPP
+
+#include "contractor/query_edge.hpp"
+#include "contractor/query_graph.hpp"
+
+#include "storage/shared_memory_ownership.hpp"
+#include "storage/tar_fwd.hpp"
+
+#include "util/integer_range.hpp"
+#include "util/patched_packed_vector.hpp"
+#include "util/static_graph.hpp"
+#include "util/typedefs.hpp"
+#include "util/vector_view.hpp"
+
+#include <boost/assert.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <ranges>
+#include <string>
+
+namespace osrm::contractor
+{
+namespace detail
+{
+template <storage::Ownership Ownership> class CompressedQueryGraph;
+} // namespace detail
+
+namespace serialization
+{
+template <storage::Ownership Ownership>
+void read(storage::tar::FileReader &reader,
+          const std::string &name,
+          detail::CompressedQueryGraph<Ownership> &graph);
+
+template <storage::Ownership Ownership>
+void write(storage::tar::FileWriter &writer,
+           const std::string &name,
+           const detail::CompressedQueryGraph<Ownership> &graph);
+} // namespace serialization
+
+// An edge of the contracted graph together with its target and data
+struct AdjacentEdge
+{
+    EdgeID edge;
+    NodeID target;
+    QueryEdge::EdgeData data;
+};
+
+namespace detail
+{
+// Contracted graph with the same nodes and edge IDs as the QueryGraph it was built from, for
+// datasets that trade query latency for memory.
+//
+// The target of an edge is stored as the zig-zag encoded difference to its source node, shifted
+// left by the shortcut, forward and backward flags. The turn IDs, weights, durations and
+// distances are packed to the widths most edges need, larger values are kept as exceptions.
+// Decoding a target needs the source node, which the adjacency iterators know. GetTarget of a
+// single edge has to search for the source node first.
+template <storage::Ownership Ownership> class CompressedQueryGraph
+{
+    template <typename T> using Vector = util::ViewOrVector<T, Ownership>;
+    template <std::size_t Bits> using Packed = util::detail::PatchedPackedVector<Bits, Ownership>;
+
+  public:
+    static constexpr std::size_t TARGET_BITS = 24;
+    static constexpr std::size_t TURN_ID_BITS = 31;
+    // 29 hours in deciseconds, longer edges are exceptions
+    static constexpr std::size_t WEIGHT_BITS = 20;
+    static constexpr std::size_t DURATION_BITS = 20;
+    // the bits of a non-negative float without the sign
+    static constexpr std::size_t DISTANCE_BITS = 31;
+
+    using NodeArrayEntry = util::static_graph_details::NodeArrayEntry;
+    using EdgeRange = util::range<EdgeID>;
+
+    CompressedQueryGraph() = default;
+
+    CompressedQueryGraph(Vector<NodeArrayEntry> node_array_,
+                         Packed<TARGET_BITS> targets_,
+                         Packed<TURN_ID_BITS> turn_ids_,
+                         Packed<WEIGHT_BITS> weights_,
+                         Packed<DURATION_BITS> durations_,
+                         Packed<DISTANCE_BITS> distances_)
+        : node_array(std::move(node_array_)), targets(std::move(targets_)),
+          turn_ids(std::move(turn_ids_)), weights(std::move(weights_)),
+          durations(std::move(durations_)), distances(std::move(distances_))
+    {
+        BOOST_ASSERT(!node_array.empty());
+    }
+
+    // A default constructed graph has no node array, not even the sentinel
+    bool IsEmpty() const { return node_array.empty(); }
+
+    unsigned GetNumberOfNodes() const { return node_array.size() - 1; }
+
+    unsigned GetNumberOfEdges() const { return node_array.back().first_edge; }
+
+    EdgeID BeginEdges(const NodeID node) const { return node_array[node].first_edge; }
+
+    EdgeID EndEdges(const NodeID node) const { return node_array[node + 1].first_edge; }
+
+    EdgeRange GetAdjacentEdgeRange(const NodeID node) const
+    {
+        return util::irange(BeginEdges(node), EndEdges(node));
+    }
+
+    unsigned GetOutDegree(const NodeID node) const { return EndEdges(node) - BeginEdges(node); }
+
+    AdjacentEdge GetAdjacentEdge(const NodeID source, const EdgeID edge) const
+    {
+        BOOST_ASSERT(BeginEdges(source) <= edge && edge < EndEdges(source));
+        const auto target_and_flags = targets[edge];
+        return {edge,
+                static_cast<NodeID>(source + util::zigzagDecode(target_and_flags >> 3)),
+                GetEdgeData(edge, target_and_flags)};
+    }
+
+    NodeID GetTarget(const EdgeID edge) const
+    {
+        return static_cast<NodeID>(GetSource(edge) + util::zigzagDecode(targets[edge] >> 3));
+    }
+
+    QueryEdge::EdgeData GetEdgeData(const EdgeID edge) const
+    {
+        return GetEdgeData(edge, targets[edge]);
+    }
+
+    friend void serialization::read<Ownership>(storage::tar::FileReader &reader,
+                                               const std::string &name,
+                                               CompressedQueryGraph &graph);
+    friend void serialization::write<Ownership>(storage::tar::FileWriter &writer,
+                                                const std::string &name,
+                                                const CompressedQueryGraph &graph);
+
+  private:
+    QueryEdge::EdgeData GetEdgeData(const EdgeID edge, const std::uint64_t target_and_flags) const
+    {
+        return QueryEdge::EdgeData{
+            static_cast<NodeID>(turn_ids[edge]),
+            (target_and_flags & 4) != 0,
+            EdgeWeight{static_cast<EdgeWeight::value_type>(weights[edge])},
+            EdgeDuration{static_cast<EdgeDuration::value_type>(durations[edge])},
+            EdgeDistance{std::bit_cast<float>(static_cast<std::uint32_t>(distances[edge]))},
+            (target_and_flags & 2) != 0,
+            (target_and_flags & 1) != 0};
+    }
+
+    NodeID GetSource(const EdgeID edge) const
+    {
+        // the last node whose edges start at or before the edge
+        const auto next = std::upper_bound(node_array.begin(),
+                                           node_array.end(),
+                                           edge,
+                                           [](const EdgeID edge, const NodeArrayEntry &entry)
+                                           { return edge < entry.first_edge; });
+        BOOST_ASSERT(next != node_array.begin());
+        return static_cast<NodeID>(std::distance(node_array.begin(), next) - 1);
+    }
+
+    Vector<NodeArrayEntry> node_array;
+    Packed<TARGET_BITS> targets;
+    Packed<TURN_ID_BITS> turn_ids;
+    Packed<WEIGHT_BITS> weights;
+    Packed<DURATION_BITS> durations;
+    Packed<DISTANCE_BITS> distances;
+};
+} // namespace detail
+
+using CompressedQueryGraph = detail::CompressedQueryGraph<storage::Ownership::Container>;
+using CompressedQueryGraphView = detail::CompressedQueryGraph<storage::Ownership::View>;
+
+// Compresses the edges of a contracted graph, edge IDs stay the same
+CompressedQueryGraph compressQueryGraph(const QueryGraph &graph);
+
+// Iterates over the edges of a node that pass an edge filter. The edges are read from the query
+// graph, or decoded from the compressed graph if the dataset has one instead.
+class AdjacentEdgeIterator : public boost::iterator_facade<AdjacentEdgeIterator,
+                                                           const AdjacentEdge,
+                                                           boost::forward_traversal_tag,
+                                                           AdjacentEdge>
+{
+  public:
+    AdjacentEdgeIterator() = default;
+
+    AdjacentEdgeIterator(const QueryGraphView *graph,
+                         const CompressedQueryGraphView *compressed_graph,
+                         const util::vector_view<bool> *edge_filter,
+                         const NodeID node,
+                         const EdgeID edge,
+                         const EdgeID end)
+        : graph(graph), compressed_graph(compressed_graph), edge_filter(edge_filter), node(node),
+          edge(edge), end(end)
+    {
+        SkipFiltered();
+    }
+
+  private:
+    friend class ::boost::iterator_core_access;
+
+    void increment()
+    {
+        ++edge;
+        SkipFiltered();
+    }
+
+    bool equal(const AdjacentEdgeIterator &other) const { return edge == other.edge; }
+
+    AdjacentEdge dereference() const
+    {
+        if (compressed_graph)
+        {
+            return compressed_graph->GetAdjacentEdge(node, edge);
+        }
+        return {edge, graph->GetTarget(edge), graph->GetEdgeData(edge)};
+    }
+
+    void SkipFiltered()
+    {
+        while (edge < end && !(*edge_filter)[edge])
+        {
+            ++edge;
+        }
+    }
+
+    const QueryGraphView *graph = nullptr;
+    const CompressedQueryGraphView *compressed_graph = nullptr;
+    const util::vector_view<bool> *edge_filter = nullptr;
+    NodeID node = SPECIAL_NODEID;
+    EdgeID edge = SPECIAL_EDGEID;
+    EdgeID end = SPECIAL_EDGEID;
+};
+
+using AdjacentEdgeRange = std::ranges::subrange<AdjacentEdgeIterator>;
+} // namespace osrm::contractor
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef OSMR_CONTRACTOR_CONTRACTED_METRIC_HPP
 #define OSMR_CONTRACTOR_CONTRACTED_METRIC_HPP
 
+#include "contractor/compressed_query_graph.hpp"
+#include "contractor/phast_sweep.hpp"
 #include "contractor/query_graph.hpp"
 
 namespace osrm::contractor
@@ -12,6 +14,10 @@ template <storage::Ownership Ownership> struct ContractedMetric
 {
     detail::QueryGraph<Ownership> graph;
     std::vector<util::ViewOrVector<bool, Ownership>> edge_filter;
+    // One sweep per exclude class, empty unless osrm-contract was run with --phast
+    std::vector<detail::PhastSweep<Ownership>> phast_sweeps = {};
+    // Replaces the graph if osrm-contract was run with --compress-graph
+    detail::CompressedQueryGraph<Ownership> compressed_graph = {};
 };
 } // namespace detail
 
@@ -39,8 +39,14 @@ namespace osrm::contractor
 struct ContractorConfig final : storage::IOConfig
 {
     ContractorConfig()
-        : IOConfig(
-              {".osrm.ebg", ".osrm.ebg_nodes", ".osrm.properties"}, {}, {".osrm.hsgr", ".osrm.enw"})
+        : IOConfig({".osrm.ebg", ".osrm.ebg_nodes", ".osrm.properties"},
+                   {".osrm.fileIndex",
+                    ".osrm.cnbg_to_ebg",
+                    ".osrm.maneuver_overrides",
+                    ".osrm.partition",
+                    ".osrm.cells",
+                    ".osrm.mldgr"},
+                   {".osrm.hsgr", ".osrm.enw"})
     {
     }
 
@@ -60,6 +66,18 @@ struct ContractorConfig final : storage::IOConfig
 
     unsigned requested_num_threads = 0;
 
+    // Write the downward edges in sweep order for PHAST many-to-all queries
+    bool build_phast_sweep = false;
+
+    // Renumber the edge-based nodes by contraction level and depth-first order, so that CH
+    // queries touch fewer cache lines and pages. Rewrites all data indexed by edge-based node
+    // and removes the MLD data of the dataset.
+    bool renumber_nodes = false;
+
+    // Store the contracted graph with delta encoded targets and packed edge data. Uses less memory
+    // at the cost of slower queries.
+    bool compress_graph = false;
+
     // DEPRECATED to be removed in v6.0
     // A percentage of vertices that will be contracted for the hierarchy.
     // Offers a trade-off between preprocessing and query time.
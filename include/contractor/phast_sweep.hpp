@@ -0,0 +1,54 @@
+#ifndef OSRM_CONTRACTOR_PHAST_SWEEP_HPP
+#define OSRM_CONTRACTOR_PHAST_SWEEP_HPP
+
+#include "contractor/query_graph.hpp"
+
+#include "storage/shared_memory_ownership.hpp"
+
+#include "util/typedefs.hpp"
+#include "util/vector_view.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace osrm::contractor
+{
+
+namespace detail
+{
+// Downward edges of a contraction hierarchy in the order needed by a PHAST sweep
+// (Delling et al., "PHAST: Hardware-Accelerated Shortest Path Trees").
+//
+// Nodes are numbered by their position in a topological order of the upward graph, highest
+// node first. All downward arcs into the node at position i are stored contiguously in
+// arcs[first_arc[i], first_arc[i + 1]) and only refer to tail positions smaller than or equal
+// to i. A linear scan over all positions therefore settles every node after all nodes it can
+// be reached from via downward arcs.
+template <storage::Ownership Ownership> struct PhastSweep
+{
+    struct Arc
+    {
+        std::uint32_t tail;
+        EdgeWeight weight;
+        EdgeDuration duration;
+        EdgeDistance distance;
+    };
+
+    // sweep position -> node id
+    util::ViewOrVector<NodeID, Ownership> nodes;
+    // node id -> sweep position
+    util::ViewOrVector<std::uint32_t, Ownership> positions;
+    util::ViewOrVector<std::uint32_t, Ownership> first_arc;
+    util::ViewOrVector<Arc, Ownership> arcs;
+};
+} // namespace detail
+
+using PhastSweep = detail::PhastSweep<storage::Ownership::Container>;
+using PhastSweepView = detail::PhastSweep<storage::Ownership::View>;
+
+// Computes the sweep for the subgraph of edges selected by the filter. Throws if the selected
+// edges do not form a hierarchy, e.g. because the graph was only partially contracted.
+PhastSweep buildPhastSweep(const QueryGraph &graph, const std::vector<bool> &edge_filter);
+} // namespace osrm::contractor
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef OSRM_CONTRACTOR_RENUMBER_HPP
+#define OSRM_CONTRACTOR_RENUMBER_HPP
+
+#include "contractor/query_graph.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace osrm::contractor
+{
+
+// Permutation that numbers the nodes of a contraction hierarchy by descending level, in
+// depth-first order of the downward graph within a level. Upward searches all end in the few
+// highest nodes, which then share a small part of the node and edge arrays, and nodes that are
+// settled one after the other end up close to each other.
+std::vector<std::uint32_t> makePermutation(const QueryGraph &graph);
+
+// Applies the permutation to the graph, the middle nodes of its shortcuts and the edge filters
+void renumber(QueryGraph &graph,
+              std::vector<std::vector<bool>> &edge_filters,
+              const std::vector<std::uint32_t> &permutation);
+} // namespace osrm::contractor
+
+#endif
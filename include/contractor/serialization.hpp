@@ -11,12 +11,68 @@
 namespace osrm::contractor::serialization
 {
 
+template <storage::Ownership Ownership>
+void write(storage::tar::FileWriter &writer,
+           const std::string &name,
+           const detail::PhastSweep<Ownership> &sweep)
+{
+    storage::serialization::write(writer, name + "/nodes", sweep.nodes);
+    storage::serialization::write(writer, name + "/positions", sweep.positions);
+    storage::serialization::write(writer, name + "/first_arc", sweep.first_arc);
+    storage::serialization::write(writer, name + "/arcs", sweep.arcs);
+}
+
+template <storage::Ownership Ownership>
+void read(storage::tar::FileReader &reader,
+          const std::string &name,
+          detail::PhastSweep<Ownership> &sweep)
+{
+    storage::serialization::read(reader, name + "/nodes", sweep.nodes);
+    storage::serialization::read(reader, name + "/positions", sweep.positions);
+    storage::serialization::read(reader, name + "/first_arc", sweep.first_arc);
+    storage::serialization::read(reader, name + "/arcs", sweep.arcs);
+}
+
+template <storage::Ownership Ownership>
+void write(storage::tar::FileWriter &writer,
+           const std::string &name,
+           const detail::CompressedQueryGraph<Ownership> &graph)
+{
+    storage::serialization::write(writer, name + "/node_array", graph.node_array);
+    util::serialization::write(writer, name + "/targets", graph.targets);
+    util::serialization::write(writer, name + "/turn_ids", graph.turn_ids);
+    util::serialization::write(writer, name + "/weights", graph.weights);
+    util::serialization::write(writer, name + "/durations", graph.durations);
+    util::serialization::write(writer, name + "/distances", graph.distances);
+}
+
+template <storage::Ownership Ownership>
+void read(storage::tar::FileReader &reader,
+          const std::string &name,
+          detail::CompressedQueryGraph<Ownership> &graph)
+{
+    storage::serialization::read(reader, name + "/node_array", graph.node_array);
+    util::serialization::read(reader, name + "/targets", graph.targets);
+    util::serialization::read(reader, name + "/turn_ids", graph.turn_ids);
+    util::serialization::read(reader, name + "/weights", graph.weights);
+    util::serialization::read(reader, name + "/durations", graph.durations);
+    util::serialization::read(reader, name + "/distances", graph.distances);
+}
+
 template <storage::Ownership Ownership>
 void write(storage::tar::FileWriter &writer,
            const std::string &name,
            const detail::ContractedMetric<Ownership> &metric)
 {
-    util::serialization::write(writer, name + "/contracted_graph", metric.graph);
+    // the compressed graph replaces the contracted graph
+    if (metric.compressed_graph.IsEmpty())
+    {
+        util::serialization::write(writer, name + "/contracted_graph", metric.graph);
+    }
+    else
+    {
+        write(writer, name + "/compressed_graph", metric.compressed_graph);
+    }
 
     writer.WriteElementCount64(name + "/exclude", metric.edge_filter.size());
     for (const auto index : util::irange<std::size_t>(0, metric.edge_filter.size()))
@@ -25,6 +81,15 @@ void write(storage::tar::FileWriter &writer,
                                       name + "/exclude/" + std::to_string(index) + "/edge_filter",
                                       metric.edge_filter[index]);
     }
+
+    if (!metric.phast_sweeps.empty())
+    {
+        writer.WriteElementCount64(name + "/phast", metric.phast_sweeps.size());
+        for (const auto index : util::irange<std::size_t>(0, metric.phast_sweeps.size()))
+        {
+            write(writer, name + "/phast/" + std::to_string(index), metric.phast_sweeps[index]);
+        }
+    }
 }
 
 template <storage::Ownership Ownership>
@@ -32,7 +97,14 @@ void read(storage::tar::FileReader &reader,
           const std::string &name,
           detail::ContractedMetric<Ownership> &metric)
 {
-    util::serialization::read(reader, name + "/contracted_graph", metric.graph);
+    if (reader.HasEntry(name + "/compressed_graph/node_array.meta"))
+    {
+        read(reader, name + "/compressed_graph", metric.compressed_graph);
+    }
+    else
+    {
+        util::serialization::read(reader, name + "/contracted_graph", metric.graph);
+    }
 
     metric.edge_filter.resize(reader.ReadElementCount64(name + "/exclude"));
     for (const auto index : util::irange<std::size_t>(0, metric.edge_filter.size()))
@@ -41,6 +113,16 @@ void read(storage::tar::FileReader &reader,
                                      name + "/exclude/" + std::to_string(index) + "/edge_filter",
                                      metric.edge_filter[index]);
     }
+
+    // PHAST sweeps are optional
+    if (reader.HasEntry(name + "/phast.meta"))
+    {
+        metric.phast_sweeps.resize(reader.ReadElementCount64(name + "/phast"));
+        for (const auto index : util::irange<std::size_t>(0, metric.phast_sweeps.size()))
+        {
+            read(reader, name + "/phast/" + std::to_string(index), metric.phast_sweeps[index]);
+        }
+    }
 }
 } // namespace osrm::contractor::serialization
 
@@ -0,0 +1,278 @@
+#ifndef OSRM_CUSTOMIZER_COMPRESSED_MULTI_LEVEL_GRAPH_HPP
+#define OSRM_CUSTOMIZER_COMPRESSED_MULTI_LEVEL_GRAPH_HPP
+
+#include "customizer/edge_based_graph.hpp"
+
+#include "storage/shared_memory_ownership.hpp"
+#include "storage/tar_fwd.hpp"
+
+#include "util/integer_range.hpp"
+#include "util/patched_packed_vector.hpp"
+#include "util/static_graph.hpp"
+#include "util/typedefs.hpp"
+#include "util/vector_view.hpp"
+
+#include <boost/assert.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <ranges>
+#include <string>
+
+namespace osrm::customizer
+{
+namespace detail
+{
+template <storage::Ownership Ownership> class CompressedMultiLevelGraph;
+} // namespace detail
+
+namespace serialization
+{
+template <storage::Ownership Ownership>
+void read(storage::tar::FileReader &reader,
+          const std::string &name,
+          detail::CompressedMultiLevelGraph<Ownership> &graph);
+
+template <storage::Ownership Ownership>
+void write(storage::tar::FileWriter &writer,
+           const std::string &name,
+           const detail::CompressedMultiLevelGraph<Ownership> &graph);
+} // namespace serialization
+
+// An edge of the multi-level graph together with its target, data and directions
+struct AdjacentEdge
+{
+    EdgeID edge;
+    NodeID target;
+    EdgeBasedGraphEdgeData data;
+    bool forward;
+    bool backward;
+};
+
+namespace detail
+{
+// Multi-level graph with the same nodes, edge IDs and border edge offsets as the graph it was
+// built from, for datasets that trade query latency for memory.
+//
+// The target of an edge is stored as the zig-zag encoded difference to its source node, shifted
+// left by the forward and backward flags. The turn IDs and the node weights, durations and
+// distances are packed to the widths most of them need, larger values are kept as exceptions.
+// Decoding a target needs the source node, which the adjacency iterators know. GetTarget of a
+// single edge has to search for the source node first.
+template <storage::Ownership Ownership> class CompressedMultiLevelGraph
+{
+    template <typename T> using Vector = util::ViewOrVector<T, Ownership>;
+    template <std::size_t Bits> using Packed = util::detail::PatchedPackedVector<Bits, Ownership>;
+
+  public:
+    static constexpr std::size_t TARGET_BITS = 24;
+    static constexpr std::size_t TURN_ID_BITS = 31;
+    // 29 hours in deciseconds, longer segments are exceptions
+    static constexpr std::size_t WEIGHT_BITS = 20;
+    static constexpr std::size_t DURATION_BITS = 20;
+    // the bits of a non-negative float without the sign
+    static constexpr std::size_t DISTANCE_BITS = 31;
+
+    using NodeArrayEntry = util::static_graph_details::NodeArrayEntry;
+    using EdgeOffset = MultiLevelEdgeBasedGraph::EdgeOffset;
+    using EdgeRange = util::range<EdgeID>;
+
+    CompressedMultiLevelGraph() = default;
+
+    CompressedMultiLevelGraph(Vector<NodeArrayEntry> node_array_,
+                              Packed<TARGET_BITS> targets_,
+                              Packed<TURN_ID_BITS> turn_ids_,
+                              Vector<EdgeOffset> node_to_edge_offset_,
+                              Packed<WEIGHT_BITS> node_weights_,
+                              Packed<DURATION_BITS> node_durations_,
+                              Packed<DISTANCE_BITS> node_distances_)
+        : node_array(std::move(node_array_)), targets(std::move(targets_)),
+          turn_ids(std::move(turn_ids_)), node_to_edge_offset(std::move(node_to_edge_offset_)),
+          node_weights(std::move(node_weights_)), node_durations(std::move(node_durations_)),
+          node_distances(std::move(node_distances_))
+    {
+        BOOST_ASSERT(!node_array.empty());
+    }
+
+    // A default constructed graph has no node array, not even the sentinel
+    bool IsEmpty() const { return node_array.empty(); }
+
+    unsigned GetNumberOfNodes() const { return node_array.size() - 1; }
+
+    unsigned GetNumberOfEdges() const { return node_array.back().first_edge; }
+
+    EdgeID BeginEdges(const NodeID node) const { return node_array[node].first_edge; }
+
+    EdgeID EndEdges(const NodeID node) const { return node_array[node + 1].first_edge; }
+
+    EdgeRange GetAdjacentEdgeRange(const NodeID node) const
+    {
+        return util::irange(BeginEdges(node), EndEdges(node));
+    }
+
+    unsigned GetOutDegree(const NodeID node) const { return EndEdges(node) - BeginEdges(node); }
+
+    // Same layout as in partitioner::MultiLevelGraph
+    EdgeID BeginBorderEdges(const LevelID level, const NodeID node) const
+    {
+        const auto index = node * GetNumberOfLevels();
+        if (index >= node_to_edge_offset.size() - 1)
+        {
+            // On level 0 all edges are border edges
+            return level == 0 ? BeginEdges(node) : EndEdges(node);
+        }
+        return BeginEdges(node) + node_to_edge_offset[index + level];
+    }
+
+    EdgeRange GetBorderEdgeRange(const LevelID level, const NodeID node) const
+    {
+        return util::irange(BeginBorderEdges(level, node), EndEdges(node));
+    }
+
+    LevelID GetNumberOfLevels() const { return node_to_edge_offset.back(); }
+
+    NodeID GetMaxBorderNodeID() const
+    {
+        return (node_to_edge_offset.size() - 1) / GetNumberOfLevels() - 1;
+    }
+
+    EdgeWeight GetNodeWeight(const NodeID node) const
+    {
+        return EdgeWeight{static_cast<EdgeWeight::value_type>(node_weights[node])};
+    }
+
+    EdgeDuration GetNodeDuration(const NodeID node) const
+    {
+        return EdgeDuration{static_cast<EdgeDuration::value_type>(node_durations[node])};
+    }
+
+    EdgeDistance GetNodeDistance(const NodeID node) const
+    {
+        return EdgeDistance{std::bit_cast<float>(static_cast<std::uint32_t>(node_distances[node]))};
+    }
+
+    bool IsForwardEdge(const EdgeID edge) const { return (targets[edge] & 2) != 0; }
+
+    bool IsBackwardEdge(const EdgeID edge) const { return (targets[edge] & 1) != 0; }
+
+    AdjacentEdge GetAdjacentEdge(const NodeID source, const EdgeID edge) const
+    {
+        BOOST_ASSERT(BeginEdges(source) <= edge && edge < EndEdges(source));
+        const auto target_and_flags = targets[edge];
+        return {edge,
+                static_cast<NodeID>(source + util::zigzagDecode(target_and_flags >> 2)),
+                GetEdgeData(edge),
+                (target_and_flags & 2) != 0,
+                (target_and_flags & 1) != 0};
+    }
+
+    NodeID GetTarget(const EdgeID edge) const
+    {
+        return static_cast<NodeID>(GetSource(edge) + util::zigzagDecode(targets[edge] >> 2));
+    }
+
+    EdgeBasedGraphEdgeData GetEdgeData(const EdgeID edge) const
+    {
+        return {static_cast<NodeID>(turn_ids[edge])};
+    }
+
+    EdgeID FindEdge(const NodeID from, const NodeID to) const
+    {
+        for (const auto edge : GetAdjacentEdgeRange(from))
+        {
+            if (GetAdjacentEdge(from, edge).target == to)
+            {
+                return edge;
+            }
+        }
+        return SPECIAL_EDGEID;
+    }
+
+    friend void serialization::read<Ownership>(storage::tar::FileReader &reader,
+                                               const std::string &name,
+                                               CompressedMultiLevelGraph &graph);
+    friend void serialization::write<Ownership>(storage::tar::FileWriter &writer,
+                                                const std::string &name,
+                                                const CompressedMultiLevelGraph &graph);
+
+  private:
+    NodeID GetSource(const EdgeID edge) const
+    {
+        // the last node whose edges start at or before the edge
+        const auto next = std::upper_bound(node_array.begin(),
+                                           node_array.end(),
+                                           edge,
+                                           [](const EdgeID edge, const NodeArrayEntry &entry)
+                                           { return edge < entry.first_edge; });
+        BOOST_ASSERT(next != node_array.begin());
+        return static_cast<NodeID>(std::distance(node_array.begin(), next) - 1);
+    }
+
+    Vector<NodeArrayEntry> node_array;
+    Packed<TARGET_BITS> targets;
+    Packed<TURN_ID_BITS> turn_ids;
+    Vector<EdgeOffset> node_to_edge_offset;
+    Packed<WEIGHT_BITS> node_weights;
+    Packed<DURATION_BITS> node_durations;
+    Packed<DISTANCE_BITS> node_distances;
+};
+} // namespace detail
+
+using CompressedMultiLevelEdgeBasedGraph =
+    detail::CompressedMultiLevelGraph<storage::Ownership::Container>;
+using CompressedMultiLevelEdgeBasedGraphView =
+    detail::CompressedMultiLevelGraph<storage::Ownership::View>;
+
+// Compresses the edges and node metrics of a multi-level graph, edge IDs stay the same
+CompressedMultiLevelEdgeBasedGraph compressMultiLevelGraph(const MultiLevelEdgeBasedGraph &graph);
+
+// Iterates over a range of edges of a node. The edges are read from the multi-level graph, or
+// decoded from the compressed graph if the dataset has one instead.
+class AdjacentEdgeIterator : public boost::iterator_facade<AdjacentEdgeIterator,
+                                                           const AdjacentEdge,
+                                                           boost::forward_traversal_tag,
+                                                           AdjacentEdge>
+{
+  public:
+    AdjacentEdgeIterator() = default;
+
+    AdjacentEdgeIterator(const MultiLevelEdgeBasedGraphView *graph,
+                         const CompressedMultiLevelEdgeBasedGraphView *compressed_graph,
+                         const NodeID node,
+                         const EdgeID edge)
+        : graph(graph), compressed_graph(compressed_graph), node(node), edge(edge)
+    {
+    }
+
+  private:
+    friend class ::boost::iterator_core_access;
+
+    void increment() { ++edge; }
+
+    bool equal(const AdjacentEdgeIterator &other) const { return edge == other.edge; }
+
+    AdjacentEdge dereference() const
+    {
+        if (compressed_graph)
+        {
+            return compressed_graph->GetAdjacentEdge(node, edge);
+        }
+        return {edge,
+                graph->GetTarget(edge),
+                graph->GetEdgeData(edge),
+                graph->IsForwardEdge(edge),
+                graph->IsBackwardEdge(edge)};
+    }
+
+    const MultiLevelEdgeBasedGraphView *graph = nullptr;
+    const CompressedMultiLevelEdgeBasedGraphView *compressed_graph = nullptr;
+    NodeID node = SPECIAL_NODEID;
+    EdgeID edge = SPECIAL_EDGEID;
+};
+
+using AdjacentEdgeRange = std::ranges::subrange<AdjacentEdgeIterator>;
+} // namespace osrm::customizer
+
+#endif
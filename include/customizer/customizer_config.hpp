@@ -32,6 +32,10 @@ struct CustomizationConfig final : storage::IOConfig
 
     unsigned requested_num_threads;
 
+    // Store the multi-level graph with delta encoded targets and packed node metrics. Uses less
+    // memory at the cost of slower queries.
+    bool compress_graph = false;
+
     updater::UpdaterConfig updater_config;
 };
 } // namespace osrm::customizer
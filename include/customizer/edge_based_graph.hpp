@@ -68,6 +68,8 @@ class MultiLevelGraph : public partitioner::MultiLevelGraph<EdgeDataT, Ownership
                  original_edge_array,
                  SuperT::node_to_edge_offset,
                  SuperT::connectivity_checksum) = std::move(graph).data();
+        SuperT::number_of_nodes = SuperT::node_array.size() - 1;
+        SuperT::number_of_edges = SuperT::node_array.back().first_edge;
 
         SuperT::edge_array.reserve(original_edge_array.size());
         for (const auto &edge : original_edge_array)
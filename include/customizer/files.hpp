@@ -102,6 +102,45 @@ inline void writeGraph(const std::filesystem::path &path,
     writer.WriteFrom("/mld/connectivity_checksum", connectivity_checksum);
     serialization::write(writer, "/mld/multilevelgraph", graph);
 }
+
+// reads .osrm.mldgr file of osrm-customize --compress-graph
+template <typename CompressedMultiLevelGraphT>
+inline void readCompressedGraph(const std::filesystem::path &path,
+                                CompressedMultiLevelGraphT &graph,
+                                std::uint32_t &connectivity_checksum)
+{
+    static_assert(
+        std::is_same<customizer::CompressedMultiLevelEdgeBasedGraphView,
+                     CompressedMultiLevelGraphT>::value ||
+            std::is_same<customizer::CompressedMultiLevelEdgeBasedGraph,
+                         CompressedMultiLevelGraphT>::value,
+        "");
+
+    storage::tar::FileReader reader{path, storage::tar::FileReader::VerifyFingerprint};
+
+    reader.ReadInto("/mld/connectivity_checksum", connectivity_checksum);
+    serialization::read(reader, "/mld/compressedmultilevelgraph", graph);
+}
+
+// writes .osrm.mldgr file of osrm-customize --compress-graph
+template <typename CompressedMultiLevelGraphT>
+inline void writeCompressedGraph(const std::filesystem::path &path,
+                                 const CompressedMultiLevelGraphT &graph,
+                                 const std::uint32_t connectivity_checksum)
+{
+    static_assert(
+        std::is_same<customizer::CompressedMultiLevelEdgeBasedGraphView,
+                     CompressedMultiLevelGraphT>::value ||
+            std::is_same<customizer::CompressedMultiLevelEdgeBasedGraph,
+                         CompressedMultiLevelGraphT>::value,
+        "");
+
+    storage::tar::FileWriter writer{path, storage::tar::FileWriter::GenerateFingerprint};
+
+    writer.WriteElementCount64("/mld/connectivity_checksum", 1);
+    writer.WriteFrom("/mld/connectivity_checksum", connectivity_checksum);
+    serialization::write(writer, "/mld/compressedmultilevelgraph", graph);
+}
 } // namespace osrm::customizer::files
 
 #endif
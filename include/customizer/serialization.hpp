@@ -1,6 +1,7 @@
 #ifndef OSRM_CUSTOMIZER_SERIALIZATION_HPP
 #define OSRM_CUSTOMIZER_SERIALIZATION_HPP
 
+#include "customizer/compressed_multi_level_graph.hpp"
 #include "customizer/edge_based_graph.hpp"
 
 #include "partitioner/cell_storage.hpp"
@@ -9,6 +10,8 @@
 #include "storage/shared_memory_ownership.hpp"
 #include "storage/tar.hpp"
 
+#include "util/serialization.hpp"
+
 namespace osrm::customizer::serialization
 {
 
@@ -61,6 +64,34 @@ inline void write(storage::tar::FileWriter &writer,
     storage::serialization::write(writer, name + "/is_backward_edge", graph.is_backward_edge);
     storage::serialization::write(writer, name + "/node_to_edge_offset", graph.node_to_edge_offset);
 }
+
+template <storage::Ownership Ownership>
+inline void read(storage::tar::FileReader &reader,
+                 const std::string &name,
+                 detail::CompressedMultiLevelGraph<Ownership> &graph)
+{
+    storage::serialization::read(reader, name + "/node_array", graph.node_array);
+    util::serialization::read(reader, name + "/node_weights", graph.node_weights);
+    util::serialization::read(reader, name + "/node_durations", graph.node_durations);
+    util::serialization::read(reader, name + "/node_distances", graph.node_distances);
+    util::serialization::read(reader, name + "/targets", graph.targets);
+    util::serialization::read(reader, name + "/turn_ids", graph.turn_ids);
+    storage::serialization::read(reader, name + "/node_to_edge_offset", graph.node_to_edge_offset);
+}
+
+template <storage::Ownership Ownership>
+inline void write(storage::tar::FileWriter &writer,
+                  const std::string &name,
+                  const detail::CompressedMultiLevelGraph<Ownership> &graph)
+{
+    storage::serialization::write(writer, name + "/node_array", graph.node_array);
+    util::serialization::write(writer, name + "/node_weights", graph.node_weights);
+    util::serialization::write(writer, name + "/node_durations", graph.node_durations);
+    util::serialization::write(writer, name + "/node_distances", graph.node_distances);
+    util::serialization::write(writer, name + "/targets", graph.targets);
+    util::serialization::write(writer, name + "/turn_ids", graph.turn_ids);
+    storage::serialization::write(writer, name + "/node_to_edge_offset", graph.node_to_edge_offset);
+}
 } // namespace osrm::customizer::serialization
 
 #endif
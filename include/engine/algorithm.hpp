@@ -55,6 +55,12 @@ template <typename AlgorithmT> struct HasGetTileTurns final : std::false_type
 template <typename AlgorithmT> struct HasExcludeFlags final : std::false_type
 {
 };
+template <typename AlgorithmT> struct HasPhastSearch final : std::false_type
+{
+};
+template <typename AlgorithmT> struct HasIsochroneSearch final : std::false_type
+{
+};
 
 // Algorithms supported by Contraction Hierarchies
 template <> struct HasAlternativePathSearch<ch::Algorithm> final : std::true_type
@@ -81,6 +87,12 @@ template <> struct HasGetTileTurns<ch::Algorithm> final : std::true_type
 template <> struct HasExcludeFlags<ch::Algorithm> final : std::true_type
 {
 };
+template <> struct HasPhastSearch<ch::Algorithm> final : std::true_type
+{
+};
+template <> struct HasIsochroneSearch<ch::Algorithm> final : std::false_type
+{
+};
 
 // Algorithms supported by Multi-Level Dijkstra
 template <> struct HasAlternativePathSearch<mld::Algorithm> final : std::true_type
@@ -107,6 +119,12 @@ template <> struct HasGetTileTurns<mld::Algorithm> final : std::true_type
 template <> struct HasExcludeFlags<mld::Algorithm> final : std::true_type
 {
 };
+template <> struct HasPhastSearch<mld::Algorithm> final : std::false_type
+{
+};
+template <> struct HasIsochroneSearch<mld::Algorithm> final : std::true_type
+{
+};
 } // namespace osrm::engine::routing_algorithms
 
 #endif
@@ -2,12 +2,15 @@
 #define ENGINE_API_BASE_API_HPP
 
 #include "engine/api/base_parameters.hpp"
+#include "engine/api/base_result.hpp"
 #include "engine/api/flatbuffers/fbresult_generated.h"
 #include "engine/datafacade/datafacade_base.hpp"
 
 #include "engine/api/json_factory.hpp"
 #include "engine/hint.hpp"
 #include "util/coordinate_calculation.hpp"
+#include "util/json_renderer.hpp"
+#include "util/request_phases.hpp"
 
 #include <memory>
 #include <ranges>
@@ -44,6 +47,26 @@ class BaseAPI
     }
 
   protected:
+    // Assembles the JSON tree of a response with make_json, and renders it right away if the
+    // caller asked for a RenderedJSON response
+    template <typename MakeJSON>
+    void MakeJSONResponse(ResultT &response, const MakeJSON &make_json) const
+    {
+        if (std::holds_alternative<RenderedJSON>(response))
+        {
+            util::json::Object json_result;
+            make_json(json_result);
+            const util::ScopedRequestPhase rendering(util::RequestPhase::Rendering);
+            auto &rendered_result = std::get<RenderedJSON>(response);
+            rendered_result.content.clear();
+            util::json::render(rendered_result.content, json_result);
+        }
+        else
+        {
+            make_json(std::get<util::json::Object>(response));
+        }
+    }
+
     util::json::Object MakeWaypoint(const PhantomNodeCandidates &candidates) const
     {
         // TODO: check forward/reverse
@@ -30,12 +30,14 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "engine/approach.hpp"
 #include "engine/bearing.hpp"
+#include "engine/cancellation.hpp"
 #include "engine/hint.hpp"
 #include "util/coordinate.hpp"
 
 #include <optional>
 
 #include <algorithm>
+#include <memory>
 #include <vector>
 
 namespace osrm::engine::api
@@ -89,6 +91,11 @@ struct BaseParameters
 
     SnappingType snapping = SnappingType::Default;
 
+    // Lets the searches of the request give up with a RequestCancelledException once the token is
+    // cancelled or its deadline has passed. Not part of the URL; osrm-routed installs its own
+    // token for every request.
+    std::shared_ptr<const CancellationToken> cancellation;
+
     BaseParameters(std::vector<util::Coordinate> coordinates_ = {},
                    std::vector<std::optional<Hint>> hints_ = {},
                    std::vector<std::optional<double>> radiuses_ = {},
@@ -5,12 +5,22 @@
 #include <variant>
 
 #include <string>
+#include <vector>
 
 #include "util/json_container.hpp"
 
 namespace osrm::engine::api
 {
-using ResultT = std::variant<util::json::Object, std::string, flatbuffers::FlatBufferBuilder>;
+// JSON response that is rendered while it is assembled, without building a util::json tree
+// first. APIs with large results like the table service render directly, all other JSON APIs
+// render their tree into it. Tiles are only available as a std::string.
+struct RenderedJSON
+{
+    std::vector<char> content;
+};
+
+using ResultT =
+    std::variant<util::json::Object, std::string, flatbuffers::FlatBufferBuilder, RenderedJSON>;
 } // namespace osrm::engine::api
 
 #endif
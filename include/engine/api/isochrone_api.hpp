@@ -0,0 +1,199 @@
+#ifndef ENGINE_API_ISOCHRONE_API_HPP
+#define ENGINE_API_ISOCHRONE_API_HPP
+
+#include "engine/api/base_api.hpp"
+#include "engine/api/isochrone_parameters.hpp"
+#include "engine/api/json_factory.hpp"
+#include "engine/phantom_node.hpp"
+#include "engine/routing_algorithms/isochrone.hpp"
+
+#include "util/coordinate_calculation.hpp"
+#include "util/rectangle.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+namespace osrm::engine::api
+{
+
+class IsochroneAPI final : public BaseAPI
+{
+  public:
+    // Angular resolution of the polygon around the source
+    static constexpr std::size_t NUMBER_OF_SECTORS = 64;
+    // Smallest distance from the source to the border of the polygon in meters
+    static constexpr double MIN_POLYGON_RADIUS = 10.;
+
+    IsochroneAPI(const datafacade::BaseDataFacade &facade_, const IsochroneParameters &parameters_)
+        : BaseAPI(facade_, parameters_), parameters(parameters_)
+    {
+    }
+
+    void MakeResponse(const PhantomNodeCandidates &source_candidates,
+                      const std::vector<routing_algorithms::IsochroneNode> &reached,
+                      ResultT &response) const
+    {
+        MakeJSONResponse(response,
+                         [&](util::json::Object &json_result)
+                         { MakeResponse(source_candidates, reached, json_result); });
+    }
+
+    void MakeResponse(const PhantomNodeCandidates &source_candidates,
+                      const std::vector<routing_algorithms::IsochroneNode> &reached,
+                      util::json::Object &response) const
+    {
+        BOOST_ASSERT(parameters.coordinates.size() == 1);
+
+        if (!parameters.skip_waypoints)
+        {
+            util::json::Array waypoints;
+            waypoints.values.push_back(MakeWaypoint(source_candidates));
+            response.values.emplace("waypoints", std::move(waypoints));
+        }
+
+        if (parameters.output == IsochroneParameters::OutputType::Edges)
+        {
+            response.values.emplace("edges", MakeEdges(reached));
+        }
+        else
+        {
+            response.values.emplace("polygon",
+                                    MakePolygon(candidatesSnappedLocation(source_candidates),
+                                                reached));
+        }
+
+        response.values.emplace("code", "Ok");
+        auto data_timestamp = facade.GetTimestamp();
+        if (!data_timestamp.empty())
+        {
+            response.values.emplace("data_version", data_timestamp);
+        }
+    }
+
+    const IsochroneParameters &parameters;
+
+  protected:
+    // Coordinates of the segment in driving direction
+    std::vector<util::Coordinate> GetGeometry(const NodeID node) const
+    {
+        const auto geometry_index = facade.GetGeometryIndex(node);
+        std::vector<util::Coordinate> coordinates;
+        const auto add_coordinate = [&](const NodeID geometry_node)
+        { coordinates.push_back(facade.GetCoordinateOfNode(geometry_node)); };
+        if (geometry_index.forward)
+        {
+            std::ranges::for_each(facade.GetUncompressedForwardGeometry(geometry_index.id),
+                                  add_coordinate);
+        }
+        else
+        {
+            std::ranges::for_each(facade.GetUncompressedReverseGeometry(geometry_index.id),
+                                  add_coordinate);
+        }
+        return coordinates;
+    }
+
+    // Coordinate where the segment starts in driving direction
+    util::Coordinate GetStartCoordinate(const NodeID node) const
+    {
+        const auto geometry_index = facade.GetGeometryIndex(node);
+        return facade.GetCoordinateOfNode(
+            geometry_index.forward
+                ? facade.GetUncompressedForwardGeometry(geometry_index.id).front()
+                : facade.GetUncompressedReverseGeometry(geometry_index.id).front());
+    }
+
+    util::json::Array MakeEdges(const std::vector<routing_algorithms::IsochroneNode> &reached) const
+    {
+        util::json::Array edges;
+        edges.values.reserve(reached.size());
+        for (const auto &reached_node : reached)
+        {
+            const auto coordinates = GetGeometry(reached_node.node);
+
+            util::json::Object edge;
+            edge.values["geometry"] =
+                json::makeGeoJSONGeometry(coordinates.begin(), coordinates.end());
+            // Source segments are entered in their middle at time zero
+            edge.values["duration"] =
+                std::max(from_alias<double>(reached_node.duration), 0.) / 10.;
+            edges.values.push_back(std::move(edge));
+        }
+        return edges;
+    }
+
+    // Star-shaped polygon through the farthest reached segment start in every sector around the
+    // source. Unlike a convex hull it follows the dents between reachable corridors.
+    util::json::Object
+    MakePolygon(const util::Coordinate source,
+                const std::vector<routing_algorithms::IsochroneNode> &reached) const
+    {
+        struct Vertex
+        {
+            util::Coordinate coordinate;
+            double distance;
+        };
+        std::vector<std::optional<Vertex>> sectors(NUMBER_OF_SECTORS);
+        for (const auto &reached_node : reached)
+        {
+            const auto coordinate = GetStartCoordinate(reached_node.node);
+            const auto distance =
+                util::coordinate_calculation::greatCircleDistance(source, coordinate);
+            const auto bearing = util::coordinate_calculation::bearing(source, coordinate);
+            const auto sector = std::min<std::size_t>(
+                bearing / 360. * NUMBER_OF_SECTORS, NUMBER_OF_SECTORS - 1);
+            if (!sectors[sector] || sectors[sector]->distance < distance)
+            {
+                sectors[sector] = Vertex{coordinate, distance};
+            }
+        }
+
+        std::vector<util::Coordinate> ring;
+        double max_distance = 0;
+        for (const auto &vertex : sectors)
+        {
+            if (vertex)
+            {
+                ring.push_back(vertex->coordinate);
+                max_distance = std::max(max_distance, vertex->distance);
+            }
+        }
+        if (ring.size() < 2)
+        {
+            // A ring needs three distinct positions, answer with a square around the source that
+            // contains the start of every reached segment
+            const auto bounds = util::RectangleInt2D::ExpandMeters(
+                source, std::max(max_distance, MIN_POLYGON_RADIUS));
+            ring = {{bounds.min_lon, bounds.min_lat},
+                    {bounds.max_lon, bounds.min_lat},
+                    {bounds.max_lon, bounds.max_lat},
+                    {bounds.min_lon, bounds.max_lat}};
+        }
+        else if (ring.size() == 2)
+        {
+            // Two reached directions and the source make a triangle
+            ring.insert(ring.begin(), source);
+        }
+        ring.push_back(ring.front());
+
+        util::json::Array coordinates;
+        coordinates.values.reserve(ring.size());
+        std::transform(ring.begin(),
+                       ring.end(),
+                       std::back_inserter(coordinates.values),
+                       &json::detail::coordinateToLonLat);
+        util::json::Array rings;
+        rings.values.push_back(std::move(coordinates));
+
+        util::json::Object polygon;
+        polygon.values["type"] = "Polygon";
+        polygon.values["coordinates"] = std::move(rings);
+        return polygon;
+    }
+};
+} // namespace osrm::engine::api
+
+#endif
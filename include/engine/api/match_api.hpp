@@ -37,8 +37,9 @@ class MatchAPI final : public RouteAPI
         }
         else
         {
-            auto &json_result = std::get<util::json::Object>(response);
-            MakeResponse(sub_matchings, sub_routes, json_result);
+            MakeJSONResponse(response,
+                             [&](util::json::Object &json_result)
+                             { MakeResponse(sub_matchings, sub_routes, json_result); });
         }
     }
     void MakeResponse(const std::vector<map_matching::SubMatching> &sub_matchings,
@@ -36,8 +36,9 @@ class NearestAPI final : public BaseAPI
         }
         else
         {
-            auto &json_result = std::get<util::json::Object>(response);
-            MakeResponse(phantom_nodes, json_result);
+            MakeJSONResponse(response,
+                             [&](util::json::Object &json_result)
+                             { MakeResponse(phantom_nodes, json_result); });
         }
     }
 
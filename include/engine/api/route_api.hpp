@@ -58,8 +58,10 @@ class RouteAPI : public BaseAPI
         }
         else
         {
-            auto &json_result = std::get<util::json::Object>(response);
-            MakeResponse(raw_routes, waypoint_candidates, json_result);
+            // a rendered response can be kept in the route cache
+            MakeJSONResponse(response,
+                             [&](util::json::Object &json_result)
+                             { MakeResponse(raw_routes, waypoint_candidates, json_result); });
         }
     }
 
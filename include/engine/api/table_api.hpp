@@ -17,10 +17,13 @@
 #include "engine/internal_route_result.hpp"
 
 #include "util/integer_range.hpp"
+#include "util/json_renderer.hpp"
 
 #include <boost/range/algorithm/transform.hpp>
 
 #include <iterator>
+#include <string_view>
+#include <utility>
 
 namespace osrm::engine::api
 {
@@ -55,6 +58,11 @@ class TableAPI final : public BaseAPI
             auto &fb_result = std::get<flatbuffers::FlatBufferBuilder>(response);
             MakeResponse(tables, candidates, fallback_speed_cells, fb_result);
         }
+        else if (std::holds_alternative<RenderedJSON>(response))
+        {
+            auto &rendered_result = std::get<RenderedJSON>(response);
+            MakeResponse(tables, candidates, fallback_speed_cells, rendered_result);
+        }
         else
         {
             auto &json_result = std::get<util::json::Object>(response);
@@ -128,9 +136,7 @@ class TableAPI final : public BaseAPI
             distances = MakeDistanceTable(fb_result, tables.second);
         }
 
-        bool have_speed_cells =
-            parameters.fallback_speed != from_alias<double>(INVALID_FALLBACK_SPEED) &&
-            parameters.fallback_speed > 0;
+        bool have_speed_cells = HasSpeedCells();
         flatbuffers::Offset<flatbuffers::Vector<uint32_t>> speed_cells;
         if (have_speed_cells)
         {
@@ -170,6 +176,100 @@ class TableAPI final : public BaseAPI
                  const std::vector<PhantomNodeCandidates> &candidates,
                  const std::vector<TableCellRef> &fallback_speed_cells,
                  util::json::Object &response) const
+    {
+        const auto [number_of_sources, number_of_destinations] =
+            MakeTableHeader(candidates, response);
+
+        if (parameters.annotations & TableParameters::AnnotationsType::Duration)
+        {
+            response.values.emplace(
+                "durations",
+                MakeDurationTable(tables.first, number_of_sources, number_of_destinations));
+        }
+
+        if (parameters.annotations & TableParameters::AnnotationsType::Distance)
+        {
+            response.values.emplace(
+                "distances",
+                MakeDistanceTable(tables.second, number_of_sources, number_of_destinations));
+        }
+
+        if (HasSpeedCells())
+        {
+            response.values.emplace("fallback_speed_cells",
+                                    MakeEstimatesTable(fallback_speed_cells));
+        }
+    }
+
+    // Same response as the util::json::Object overload, but the matrices are rendered directly
+    // from the result vectors instead of allocating a util::json::Value for every cell.
+    virtual void
+    MakeResponse(const std::pair<std::vector<EdgeDuration>, std::vector<EdgeDistance>> &tables,
+                 const std::vector<PhantomNodeCandidates> &candidates,
+                 const std::vector<TableCellRef> &fallback_speed_cells,
+                 RenderedJSON &response) const
+    {
+        util::json::Object header;
+        const auto [number_of_sources, number_of_destinations] =
+            MakeTableHeader(candidates, header);
+
+        const bool use_durations =
+            parameters.annotations & TableParameters::AnnotationsType::Duration;
+        const bool use_distances =
+            parameters.annotations & TableParameters::AnnotationsType::Distance;
+
+        auto &out = response.content;
+        out.clear();
+        // a rendered cell takes about 8 bytes
+        out.reserve((use_durations + use_distances) * number_of_sources * number_of_destinations *
+                    8);
+
+        // The header has at least the code member, reopen it to append the matrices
+        util::json::render(out, header);
+        BOOST_ASSERT(!out.empty() && out.back() == '}');
+        out.pop_back();
+
+        if (use_durations)
+        {
+            RenderTable(out,
+                        "durations",
+                        tables.first,
+                        number_of_sources,
+                        number_of_destinations,
+                        &MakeDurationValue);
+        }
+
+        if (use_distances)
+        {
+            RenderTable(out,
+                        "distances",
+                        tables.second,
+                        number_of_sources,
+                        number_of_destinations,
+                        &MakeDistanceValue);
+        }
+
+        if (HasSpeedCells())
+        {
+            static constexpr std::string_view key = ",\"fallback_speed_cells\":";
+            out.insert(out.end(), key.begin(), key.end());
+            util::json::Renderer renderer(out);
+            renderer(MakeEstimatesTable(fallback_speed_cells));
+        }
+        out.push_back('}');
+    }
+
+  protected:
+    bool HasSpeedCells() const
+    {
+        return parameters.fallback_speed != from_alias<double>(INVALID_FALLBACK_SPEED) &&
+               parameters.fallback_speed > 0;
+    }
+
+    // Adds waypoints, code and data_version and returns the number of rows and columns
+    std::pair<std::size_t, std::size_t>
+    MakeTableHeader(const std::vector<PhantomNodeCandidates> &candidates,
+                    util::json::Object &response) const
     {
         auto number_of_sources = parameters.sources.size();
         auto number_of_destinations = parameters.destinations.size();
@@ -208,36 +308,72 @@ class TableAPI final : public BaseAPI
             }
         }
 
-        if (parameters.annotations & TableParameters::AnnotationsType::Duration)
+        response.values.emplace("code", "Ok");
+        auto data_timestamp = facade.GetTimestamp();
+        if (!data_timestamp.empty())
         {
-            response.values.emplace(
-                "durations",
-                MakeDurationTable(tables.first, number_of_sources, number_of_destinations));
+            response.values.emplace("data_version", data_timestamp);
         }
 
-        if (parameters.annotations & TableParameters::AnnotationsType::Distance)
+        return {number_of_sources, number_of_destinations};
+    }
+
+    static util::json::Value MakeDurationValue(const EdgeDuration duration)
+    {
+        if (duration == MAXIMAL_EDGE_DURATION)
         {
-            response.values.emplace(
-                "distances",
-                MakeDistanceTable(tables.second, number_of_sources, number_of_destinations));
+            return util::json::Null();
         }
+        // division by 10 because the duration is in deciseconds (10s)
+        return util::json::Number(from_alias<double>(duration) / 10.);
+    }
 
-        if (parameters.fallback_speed != from_alias<double>(INVALID_FALLBACK_SPEED) &&
-            parameters.fallback_speed > 0)
+    static util::json::Value MakeDistanceValue(const EdgeDistance distance)
+    {
+        if (distance == INVALID_EDGE_DISTANCE)
         {
-            response.values.emplace("fallback_speed_cells",
-                                    MakeEstimatesTable(fallback_speed_cells));
+            return util::json::Null();
         }
+        // round to single decimal place
+        return util::json::Number(std::round(from_alias<double>(distance) * 10) / 10.);
+    }
 
-        response.values.emplace("code", "Ok");
-        auto data_timestamp = facade.GetTimestamp();
-        if (!data_timestamp.empty())
+    // Appends ,"key":[[...],...] to an object that is being rendered
+    template <typename T>
+    static void RenderTable(std::vector<char> &out,
+                            const std::string_view key,
+                            const std::vector<T> &values,
+                            const std::size_t number_of_rows,
+                            const std::size_t number_of_columns,
+                            util::json::Value (*make_value)(T))
+    {
+        BOOST_ASSERT(values.size() == number_of_rows * number_of_columns);
+        util::json::Renderer renderer(out);
+
+        out.insert(out.end(), {',', '"'});
+        out.insert(out.end(), key.begin(), key.end());
+        out.insert(out.end(), {'"', ':', '['});
+        for (const auto row : util::irange<std::size_t>(0UL, number_of_rows))
         {
-            response.values.emplace("data_version", data_timestamp);
+            if (row > 0)
+            {
+                out.push_back(',');
+            }
+            out.push_back('[');
+            const auto row_begin = values.begin() + row * number_of_columns;
+            for (const auto column : util::irange<std::size_t>(0UL, number_of_columns))
+            {
+                if (column > 0)
+                {
+                    out.push_back(',');
+                }
+                std::visit(renderer, make_value(row_begin[column]));
+            }
+            out.push_back(']');
         }
+        out.push_back(']');
     }
 
-  protected:
     virtual flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<fbresult::Waypoint>>>
     MakeWaypoints(flatbuffers::FlatBufferBuilder &builder,
                   const std::vector<PhantomNodeCandidates> &candidates) const
@@ -271,44 +407,47 @@ class TableAPI final : public BaseAPI
         return builder.CreateVector(waypoints);
     }
 
+    // The matrices are written straight into the builder, no temporary copy is needed
     virtual flatbuffers::Offset<flatbuffers::Vector<float>>
     MakeDurationTable(flatbuffers::FlatBufferBuilder &builder,
                       const std::vector<EdgeDuration> &values) const
     {
-        std::vector<float> distance_table;
-        distance_table.resize(values.size());
+        float *duration_table = nullptr;
+        const auto offset = builder.CreateUninitializedVector(values.size(), &duration_table);
         std::transform(values.begin(),
                        values.end(),
-                       distance_table.begin(),
+                       duration_table,
                        [](const EdgeDuration duration)
                        {
                            if (duration == MAXIMAL_EDGE_DURATION)
                            {
-                               return 0.;
+                               return flatbuffers::EndianScalar(0.f);
                            }
-                           return from_alias<double>(duration) / 10.;
+                           return flatbuffers::EndianScalar(
+                               static_cast<float>(from_alias<double>(duration) / 10.));
                        });
-        return builder.CreateVector(distance_table);
+        return offset;
     }
 
     virtual flatbuffers::Offset<flatbuffers::Vector<float>>
     MakeDistanceTable(flatbuffers::FlatBufferBuilder &builder,
                       const std::vector<EdgeDistance> &values) const
     {
-        std::vector<float> duration_table;
-        duration_table.resize(values.size());
+        float *distance_table = nullptr;
+        const auto offset = builder.CreateUninitializedVector(values.size(), &distance_table);
         std::transform(values.begin(),
                        values.end(),
-                       duration_table.begin(),
+                       distance_table,
                        [](const EdgeDistance distance)
                        {
                            if (distance == INVALID_EDGE_DISTANCE)
                            {
-                               return 0.;
+                               return flatbuffers::EndianScalar(0.f);
                            }
-                           return std::round(from_alias<double>(distance) * 10) / 10.;
+                           return flatbuffers::EndianScalar(static_cast<float>(
+                               std::round(from_alias<double>(distance) * 10) / 10.));
                        });
-        return builder.CreateVector(duration_table);
+        return offset;
     }
 
     virtual flatbuffers::Offset<flatbuffers::Vector<uint32_t>>
@@ -367,19 +506,8 @@ class TableAPI final : public BaseAPI
             auto row_begin_iterator = values.begin() + (row * number_of_columns);
             auto row_end_iterator = values.begin() + ((row + 1) * number_of_columns);
             json_row.values.resize(number_of_columns);
-            std::transform(row_begin_iterator,
-                           row_end_iterator,
-                           json_row.values.begin(),
-                           [](const EdgeDuration duration)
-                           {
-                               if (duration == MAXIMAL_EDGE_DURATION)
-                               {
-                                   return util::json::Value(util::json::Null());
-                               }
-                               // division by 10 because the duration is in deciseconds (10s)
-                               return util::json::Value(
-                                   util::json::Number(from_alias<double>(duration) / 10.));
-                           });
+            std::transform(
+                row_begin_iterator, row_end_iterator, json_row.values.begin(), MakeDurationValue);
 
             json_table.values.push_back(util::json::Value{json_row});
         }
@@ -397,19 +525,8 @@ class TableAPI final : public BaseAPI
             auto row_begin_iterator = values.begin() + (row * number_of_columns);
             auto row_end_iterator = values.begin() + ((row + 1) * number_of_columns);
             json_row.values.resize(number_of_columns);
-            std::transform(row_begin_iterator,
-                           row_end_iterator,
-                           json_row.values.begin(),
-                           [](const EdgeDistance distance)
-                           {
-                               if (distance == INVALID_EDGE_DISTANCE)
-                               {
-                                   return util::json::Value(util::json::Null());
-                               }
-                               // round to single decimal place
-                               return util::json::Value(util::json::Number(
-                                   std::round(from_alias<double>(distance) * 10) / 10.));
-                           });
+            std::transform(
+                row_begin_iterator, row_end_iterator, json_row.values.begin(), MakeDistanceValue);
             json_table.values.push_back(util::json::Value{json_row});
         }
         return json_table;
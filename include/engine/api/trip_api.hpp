@@ -34,8 +34,9 @@ class TripAPI final : public RouteAPI
         }
         else
         {
-            auto &json_result = std::get<util::json::Object>(response);
-            MakeResponse(sub_trips, sub_routes, candidates, json_result);
+            MakeJSONResponse(response,
+                             [&](util::json::Object &json_result)
+                             { MakeResponse(sub_trips, sub_routes, candidates, json_result); });
         }
     }
     void MakeResponse(const std::vector<std::vector<NodeID>> &sub_trips,
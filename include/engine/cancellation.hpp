@@ -0,0 +1,180 @@
+#ifndef OSRM_ENGINE_CANCELLATION_HPP
+#define OSRM_ENGINE_CANCELLATION_HPP
+
+#include "util/exception.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+
+namespace osrm::engine
+{
+
+enum class CancellationReason : std::uint8_t
+{
+    None,
+    // the deadline of the request has passed
+    Timeout,
+    // the request was cancelled, e.g. because the client went away
+    Cancelled
+};
+
+// Thrown out of the search loops of a request that was cancelled
+class RequestCancelledException : public util::exception
+{
+  public:
+    explicit RequestCancelledException(const CancellationReason reason_)
+        : exception(reason_ == CancellationReason::Timeout
+                        ? "RequestCancelledException: The request exceeded its deadline"
+                        : "RequestCancelledException: The request was cancelled"),
+          reason(reason_)
+    {
+    }
+
+    CancellationReason Reason() const { return reason; }
+
+  private:
+    // This function exists to 'anchor' the class, and stop the compiler from
+    // copying vtable and RTTI info into every object file that includes
+    // this header. (Caught by -Wweak-vtables under Clang.)
+    virtual void anchor() const override;
+    const CancellationReason reason;
+};
+
+/**
+ * Tells the searches of a request when to give up: once its deadline has passed, once Cancel()
+ * was called from any thread or once the optional probe reports that the client is gone.
+ *
+ * The searches only look at the token every few hundred settled nodes, see CheckCancellation().
+ */
+class CancellationToken
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    CancellationToken() = default;
+
+    explicit CancellationToken(const std::optional<Clock::time_point> deadline,
+                               std::function<bool()> is_abandoned = {})
+        : deadline(deadline), is_abandoned(std::move(is_abandoned))
+    {
+    }
+
+    CancellationToken(const CancellationToken &) = delete;
+    CancellationToken &operator=(const CancellationToken &) = delete;
+
+    void Cancel() { reason.store(CancellationReason::Cancelled, std::memory_order_relaxed); }
+
+    // Once a token reports a reason it keeps reporting it
+    CancellationReason Check() const
+    {
+        auto current = reason.load(std::memory_order_relaxed);
+        if (current != CancellationReason::None)
+        {
+            return current;
+        }
+
+        if (deadline && Clock::now() >= *deadline)
+        {
+            current = CancellationReason::Timeout;
+        }
+        else if (is_abandoned && is_abandoned())
+        {
+            current = CancellationReason::Cancelled;
+        }
+
+        if (current != CancellationReason::None)
+        {
+            reason.store(current, std::memory_order_relaxed);
+        }
+        return current;
+    }
+
+    void ThrowIfCancelled() const
+    {
+        const auto current = Check();
+        if (current != CancellationReason::None)
+        {
+            throw RequestCancelledException(current);
+        }
+    }
+
+  private:
+    std::optional<Clock::time_point> deadline;
+    std::function<bool()> is_abandoned;
+    mutable std::atomic<CancellationReason> reason{CancellationReason::None};
+};
+
+namespace detail
+{
+// Number of calls of CheckCancellation() between two looks at the token
+inline constexpr std::uint32_t CANCELLATION_CHECK_INTERVAL = 512;
+
+struct CancellationState
+{
+    const CancellationToken *token = nullptr;
+    std::uint32_t countdown = CANCELLATION_CHECK_INTERVAL;
+};
+
+inline thread_local CancellationState cancellation_state;
+} // namespace detail
+
+// Token of the request handled by this thread, nullptr if there is none
+inline const CancellationToken *CurrentCancellationToken()
+{
+    return detail::cancellation_state.token;
+}
+
+/**
+ * Makes the token the one of the request handled by this thread until it is destroyed. Does
+ * nothing for a nullptr, so a token of the parameters only replaces the one of the server if
+ * there is one. Tasks that run parts of a search on other threads install the token there too.
+ */
+class ScopedCancellation
+{
+  public:
+    explicit ScopedCancellation(const CancellationToken *token)
+    {
+        auto &state = detail::cancellation_state;
+        if (token)
+        {
+            active = true;
+            previous = state.token;
+            state.token = token;
+            state.countdown = detail::CANCELLATION_CHECK_INTERVAL;
+        }
+    }
+
+    ~ScopedCancellation()
+    {
+        if (active)
+        {
+            detail::cancellation_state.token = previous;
+        }
+    }
+
+    ScopedCancellation(const ScopedCancellation &) = delete;
+    ScopedCancellation &operator=(const ScopedCancellation &) = delete;
+
+  private:
+    bool active = false;
+    const CancellationToken *previous = nullptr;
+};
+
+// Called by the search loops for every settled node. Throws RequestCancelledException if the
+// token of the current request was cancelled, but only looks at it every few hundred calls.
+inline void CheckCancellation()
+{
+    auto &state = detail::cancellation_state;
+    if (state.token == nullptr || --state.countdown != 0)
+    {
+        return;
+    }
+    state.countdown = detail::CANCELLATION_CHECK_INTERVAL;
+    state.token->ThrowIfCancelled();
+}
+} // namespace osrm::engine
+
+#endif // OSRM_ENGINE_CANCELLATION_HPP
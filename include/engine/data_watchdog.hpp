@@ -4,16 +4,15 @@
 #include "engine/datafacade/contiguous_internalmem_datafacade.hpp"
 #include "engine/datafacade/shared_memory_allocator.hpp"
 #include "engine/datafacade_factory.hpp"
+#include "engine/dataset_snapshot.hpp"
 
 #include "storage/shared_datatype.hpp"
 #include "storage/shared_memory.hpp"
 #include "storage/shared_monitor.hpp"
 
 #include <boost/interprocess/sync/named_upgradable_mutex.hpp>
-#include <boost/thread/lock_types.hpp>
-#include <boost/thread/locks.hpp>
-#include <boost/thread/shared_mutex.hpp>
 
+#include <atomic>
 #include <memory>
 #include <thread>
 
@@ -32,6 +31,8 @@ class DataWatchdogImpl<AlgorithmT, datafacade::ContiguousInternalMemoryDataFacad
 {
     using mutex_type = typename storage::SharedMonitor<storage::SharedRegionRegister>::mutex_type;
     using Facade = datafacade::ContiguousInternalMemoryDataFacade<AlgorithmT>;
+    using FacadeFactory =
+        DataFacadeFactory<datafacade::ContiguousInternalMemoryDataFacade, AlgorithmT>;
 
   public:
     DataWatchdogImpl(const std::string &dataset_name) : dataset_name(dataset_name), active(true)
@@ -54,14 +55,7 @@ class DataWatchdogImpl<AlgorithmT, datafacade::ContiguousInternalMemoryDataFacad
             static_region = *static_shared_region;
             updatable_region = *updatable_shared_region;
 
-            {
-                boost::unique_lock<boost::shared_mutex> swap_lock(factory_mutex);
-                facade_factory =
-                    DataFacadeFactory<datafacade::ContiguousInternalMemoryDataFacade, AlgorithmT>(
-                        std::make_shared<datafacade::SharedMemoryAllocator>(
-                            std::vector<storage::SharedRegionRegister::ShmKey>{
-                                static_region.shm_key, updatable_region.shm_key}));
-            }
+            PublishFactory();
         }
 
         watcher = std::thread(&DataWatchdogImpl::Run, this);
@@ -76,18 +70,50 @@ class DataWatchdogImpl<AlgorithmT, datafacade::ContiguousInternalMemoryDataFacad
 
     std::shared_ptr<const Facade> Get(const api::BaseParameters &params) const
     {
-        // make sure facade_factory stays stable while we call Get()
-        boost::shared_lock<boost::shared_mutex> swap_lock(factory_mutex);
-        return facade_factory.Get(params);
+        // our reference keeps the factory alive even if it is swapped out in the meantime
+        return LoadFactory()->Get(params);
     }
     std::shared_ptr<const Facade> Get(const api::TileParameters &params) const
     {
-        // make sure facade_factory stays stable while we call Get()
-        boost::shared_lock<boost::shared_mutex> swap_lock(factory_mutex);
-        return facade_factory.Get(params);
+        // our reference keeps the factory alive even if it is swapped out in the meantime
+        return LoadFactory()->Get(params);
     }
 
   private:
+    // Request threads only ever load the current factory atomically, the watchdog thread
+    // replaces it as a whole. A replaced factory (and its facades and shared memory mapping)
+    // is freed once the last request that still uses it drops its reference.
+    std::shared_ptr<const FacadeFactory> LoadFactory() const
+    {
+        if (auto *snapshot = CurrentDatasetSnapshot())
+        {
+            return snapshot->Pin<FacadeFactory>(this, [this] { return LoadCurrentFactory(); });
+        }
+        return LoadCurrentFactory();
+    }
+
+    std::shared_ptr<const FacadeFactory> LoadCurrentFactory() const
+    {
+#if defined(__cpp_lib_atomic_shared_ptr)
+        return facade_factory.load(std::memory_order_acquire);
+#else
+        return std::atomic_load_explicit(&facade_factory, std::memory_order_acquire);
+#endif
+    }
+
+    void PublishFactory()
+    {
+        auto allocator = std::make_shared<datafacade::SharedMemoryAllocator>(
+            std::vector<storage::SharedRegionRegister::ShmKey>{static_region.shm_key,
+                                                               updatable_region.shm_key});
+        auto factory = std::make_shared<const FacadeFactory>(std::move(allocator));
+#if defined(__cpp_lib_atomic_shared_ptr)
+        facade_factory.store(std::move(factory), std::memory_order_release);
+#else
+        std::atomic_store_explicit(&facade_factory, std::move(factory), std::memory_order_release);
+#endif
+    }
+
     void Run()
     {
         while (active)
@@ -116,20 +142,12 @@ class DataWatchdogImpl<AlgorithmT, datafacade::ContiguousInternalMemoryDataFacad
                         << (int)updatable_region.shm_key << " with timestamps "
                         << static_region.timestamp << " and " << updatable_region.timestamp;
 
-            {
-                boost::unique_lock<boost::shared_mutex> swap_lock(factory_mutex);
-                facade_factory =
-                    DataFacadeFactory<datafacade::ContiguousInternalMemoryDataFacade, AlgorithmT>(
-                        std::make_shared<datafacade::SharedMemoryAllocator>(
-                            std::vector<storage::SharedRegionRegister::ShmKey>{
-                                static_region.shm_key, updatable_region.shm_key}));
-            }
+            PublishFactory();
         }
 
         util::Log() << "DataWatchdog thread stopped";
     }
 
-    mutable boost::shared_mutex factory_mutex;
     const std::string dataset_name;
     storage::SharedMonitor<storage::SharedRegionRegister> barrier;
     std::thread watcher;
@@ -138,7 +156,11 @@ class DataWatchdogImpl<AlgorithmT, datafacade::ContiguousInternalMemoryDataFacad
     storage::SharedRegion updatable_region;
     storage::SharedRegion *static_shared_region;
     storage::SharedRegion *updatable_shared_region;
-    DataFacadeFactory<datafacade::ContiguousInternalMemoryDataFacade, AlgorithmT> facade_factory;
+#if defined(__cpp_lib_atomic_shared_ptr)
+    std::atomic<std::shared_ptr<const FacadeFactory>> facade_factory;
+#else
+    std::shared_ptr<const FacadeFactory> facade_factory;
+#endif
 };
 } // namespace detail
 
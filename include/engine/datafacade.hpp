@@ -1,14 +1,23 @@
 #ifndef OSRM_ENGINE_DATAFACADE_DATAFACADE_HPP
 #define OSRM_ENGINE_DATAFACADE_DATAFACADE_HPP
 
+#include "engine/algorithm.hpp"
 #include "engine/datafacade/contiguous_internalmem_datafacade.hpp"
 
+#include <type_traits>
+
 namespace osrm::engine
 {
 
 using DataFacadeBase = datafacade::ContiguousInternalMemoryDataFacadeBase;
 template <typename AlgorithmT>
 using DataFacade = datafacade::ContiguousInternalMemoryDataFacade<AlgorithmT>;
+
+// The routing algorithms are instantiated on the concrete facades, not on the virtual
+// interfaces, so the graph accessors in the search loops are called directly and can be inlined.
+// This only holds as long as nothing can override them.
+static_assert(std::is_final_v<DataFacade<routing_algorithms::ch::Algorithm>>);
+static_assert(std::is_final_v<DataFacade<routing_algorithms::mld::Algorithm>>);
 } // namespace osrm::engine
 
 #endif
@@ -1,7 +1,10 @@
 #ifndef OSRM_ENGINE_DATAFACADE_ALGORITHM_DATAFACADE_HPP
 #define OSRM_ENGINE_DATAFACADE_ALGORITHM_DATAFACADE_HPP
 
+#include "contractor/compressed_query_graph.hpp"
+#include "contractor/phast_sweep.hpp"
 #include "contractor/query_edge.hpp"
+#include "customizer/compressed_multi_level_graph.hpp"
 #include "customizer/edge_based_graph.hpp"
 #include "extractor/edge_based_edge.hpp"
 #include "engine/algorithm.hpp"
@@ -9,7 +12,7 @@
 #include "partitioner/cell_storage.hpp"
 #include "partitioner/multi_level_partition.hpp"
 
-#include "util/filtered_graph.hpp"
+#include "util/filtered_integer_range.hpp"
 #include "util/integer_range.hpp"
 
 namespace osrm::engine::datafacade
@@ -26,6 +29,7 @@ template <> class AlgorithmDataFacade<CH>
   public:
     using EdgeData = contractor::QueryEdge::EdgeData;
     using EdgeRange = util::filtered_range<EdgeID, util::vector_view<bool>>;
+    using AdjacentEdgeRange = contractor::AdjacentEdgeRange;
 
     virtual ~AlgorithmDataFacade() = default;
 
@@ -38,10 +42,13 @@ template <> class AlgorithmDataFacade<CH>
 
     virtual NodeID GetTarget(const EdgeID edge_based_edge_id) const = 0;
 
-    virtual const EdgeData &GetEdgeData(const EdgeID edge_based_edge_id) const = 0;
+    virtual EdgeData GetEdgeData(const EdgeID edge_based_edge_id) const = 0;
 
     virtual EdgeRange GetAdjacentEdgeRange(const NodeID edge_based_node_id) const = 0;
 
+    // the edges of the node with their targets and data, decoded if the graph is compressed
+    virtual AdjacentEdgeRange GetAdjacentEdges(const NodeID edge_based_node_id) const = 0;
+
     // searches for a specific edge
     virtual EdgeID FindEdge(const NodeID edge_based_node_from,
                             const NodeID edge_based_node_to) const = 0;
@@ -56,6 +63,9 @@ template <> class AlgorithmDataFacade<CH>
     virtual EdgeID FindSmallestEdge(const NodeID edge_based_node_from,
                                     const NodeID edge_based_node_to,
                                     const std::function<bool(const EdgeData &)> &filter) const = 0;
+
+    // returns nullptr if the dataset was contracted without PHAST sweeps
+    virtual const contractor::PhastSweepView *GetPhastSweep() const = 0;
 };
 
 template <> class AlgorithmDataFacade<MLD>
@@ -63,6 +73,7 @@ template <> class AlgorithmDataFacade<MLD>
   public:
     using EdgeData = customizer::EdgeBasedGraphEdgeData;
     using EdgeRange = util::range<EdgeID>;
+    using AdjacentEdgeRange = customizer::AdjacentEdgeRange;
 
     virtual ~AlgorithmDataFacade() = default;
 
@@ -90,7 +101,7 @@ template <> class AlgorithmDataFacade<MLD>
 
     virtual NodeID GetTarget(const EdgeID edge_based_edge_id) const = 0;
 
-    virtual const EdgeData &GetEdgeData(const EdgeID edge_based_edge_id) const = 0;
+    virtual EdgeData GetEdgeData(const EdgeID edge_based_edge_id) const = 0;
 
     virtual const partitioner::MultiLevelPartitionView &GetMultiLevelPartition() const = 0;
 
@@ -101,6 +112,10 @@ template <> class AlgorithmDataFacade<MLD>
     virtual EdgeRange GetBorderEdgeRange(const LevelID level,
                                          const NodeID edge_based_node_id) const = 0;
 
+    // the border edges with their targets, data and directions, decoded if the graph is compressed
+    virtual AdjacentEdgeRange GetBorderEdges(const LevelID level,
+                                             const NodeID edge_based_node_id) const = 0;
+
     // searches for a specific edge
     virtual EdgeID FindEdge(const NodeID edge_based_node_from,
                             const NodeID edge_based_node_to) const = 0;
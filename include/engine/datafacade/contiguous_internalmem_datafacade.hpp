@@ -23,6 +23,8 @@
 #include <cstddef>
 #include <iterator>
 #include <memory>
+#include <optional>
+#include <ranges>
 #include <string>
 #include <utility>
 #include <vector>
@@ -56,11 +58,11 @@ template <>
 class ContiguousInternalMemoryAlgorithmDataFacade<CH> : public datafacade::AlgorithmDataFacade<CH>
 {
   private:
-    using QueryGraph = util::FilteredGraphView<contractor::QueryGraphView>;
-    using GraphNode = QueryGraph::NodeArrayEntry;
-    using GraphEdge = QueryGraph::EdgeArrayEntry;
-
-    QueryGraph m_query_graph;
+    // A dataset has either the query graph or the compressed graph
+    contractor::QueryGraphView m_query_graph;
+    std::optional<contractor::CompressedQueryGraphView> m_compressed_graph;
+    util::vector_view<bool> m_edge_filter;
+    std::optional<contractor::PhastSweepView> m_phast_sweep;
 
     // allocator that keeps the allocation data
     std::shared_ptr<ContiguousBlockAllocator> allocator;
@@ -79,54 +81,120 @@ class ContiguousInternalMemoryAlgorithmDataFacade<CH> : public datafacade::Algor
                                     const std::string &metric_name,
                                     const std::size_t exclude_index)
     {
-        m_query_graph =
-            make_filtered_graph_view(index, "/ch/metrics/" + metric_name, exclude_index);
+        const auto metric_prefix = "/ch/metrics/" + metric_name;
+        if (has_compressed_query_graph(index, metric_prefix))
+        {
+            m_compressed_graph =
+                make_compressed_query_graph_view(index, metric_prefix + "/compressed_graph");
+        }
+        else
+        {
+            m_query_graph = make_query_graph_view(index, metric_prefix + "/contracted_graph");
+        }
+        m_edge_filter = make_edge_filter_view(index, metric_prefix, exclude_index);
+
+        const auto phast_prefix = metric_prefix + "/phast/" + std::to_string(exclude_index);
+        bool has_phast_sweep = false;
+        index.List(phast_prefix + "/",
+                   boost::make_function_output_iterator([&](const auto &)
+                                                        { has_phast_sweep = true; }));
+        if (has_phast_sweep)
+        {
+            m_phast_sweep = make_phast_sweep_view(index, phast_prefix);
+        }
     }
 
     // search graph access
-    unsigned GetNumberOfNodes() const override final { return m_query_graph.GetNumberOfNodes(); }
+    unsigned GetNumberOfNodes() const override final
+    {
+        return m_compressed_graph ? m_compressed_graph->GetNumberOfNodes()
+                                  : m_query_graph.GetNumberOfNodes();
+    }
 
-    unsigned GetNumberOfEdges() const override final { return m_query_graph.GetNumberOfEdges(); }
+    unsigned GetNumberOfEdges() const override final
+    {
+        return m_compressed_graph ? m_compressed_graph->GetNumberOfEdges()
+                                  : m_query_graph.GetNumberOfEdges();
+    }
 
     unsigned GetOutDegree(const NodeID edge_based_node_id) const override final
     {
-        return m_query_graph.GetOutDegree(edge_based_node_id);
+        return std::ranges::distance(GetAdjacentEdges(edge_based_node_id));
     }
 
     NodeID GetTarget(const EdgeID edge_based_edge_id) const override final
     {
-        return m_query_graph.GetTarget(edge_based_edge_id);
+        BOOST_ASSERT(m_edge_filter[edge_based_edge_id]);
+        return m_compressed_graph ? m_compressed_graph->GetTarget(edge_based_edge_id)
+                                  : m_query_graph.GetTarget(edge_based_edge_id);
     }
 
-    const EdgeData &GetEdgeData(const EdgeID edge_based_edge_id) const override final
+    EdgeData GetEdgeData(const EdgeID edge_based_edge_id) const override final
     {
-        return m_query_graph.GetEdgeData(edge_based_edge_id);
+        BOOST_ASSERT(m_edge_filter[edge_based_edge_id]);
+        return m_compressed_graph ? m_compressed_graph->GetEdgeData(edge_based_edge_id)
+                                  : m_query_graph.GetEdgeData(edge_based_edge_id);
     }
 
     EdgeRange GetAdjacentEdgeRange(const NodeID edge_based_node_id) const override final
     {
-        return m_query_graph.GetAdjacentEdgeRange(edge_based_node_id);
+        return EdgeRange{
+            BeginEdges(edge_based_node_id), EndEdges(edge_based_node_id), m_edge_filter};
+    }
+
+    AdjacentEdgeRange GetAdjacentEdges(const NodeID edge_based_node_id) const override final
+    {
+        const auto *compressed_graph = m_compressed_graph ? &*m_compressed_graph : nullptr;
+        const auto end = EndEdges(edge_based_node_id);
+        return AdjacentEdgeRange{contractor::AdjacentEdgeIterator{&m_query_graph,
+                                                                  compressed_graph,
+                                                                  &m_edge_filter,
+                                                                  edge_based_node_id,
+                                                                  BeginEdges(edge_based_node_id),
+                                                                  end},
+                                 contractor::AdjacentEdgeIterator{&m_query_graph,
+                                                                  compressed_graph,
+                                                                  &m_edge_filter,
+                                                                  edge_based_node_id,
+                                                                  end,
+                                                                  end}};
     }
 
     // searches for a specific edge
     EdgeID FindEdge(const NodeID edge_based_node_from,
                     const NodeID edge_based_node_to) const override final
     {
-        return m_query_graph.FindEdge(edge_based_node_from, edge_based_node_to);
+        for (const auto &edge : GetAdjacentEdges(edge_based_node_from))
+        {
+            if (edge.target == edge_based_node_to)
+            {
+                return edge.edge;
+            }
+        }
+        return SPECIAL_EDGEID;
     }
 
     EdgeID FindEdgeInEitherDirection(const NodeID edge_based_node_from,
                                      const NodeID edge_based_node_to) const override final
     {
-        return m_query_graph.FindEdgeInEitherDirection(edge_based_node_from, edge_based_node_to);
+        const auto edge = FindEdge(edge_based_node_from, edge_based_node_to);
+        return SPECIAL_EDGEID != edge ? edge : FindEdge(edge_based_node_to, edge_based_node_from);
     }
 
     EdgeID FindEdgeIndicateIfReverse(const NodeID edge_based_node_from,
                                      const NodeID edge_based_node_to,
                                      bool &result) const override final
     {
-        return m_query_graph.FindEdgeIndicateIfReverse(
-            edge_based_node_from, edge_based_node_to, result);
+        auto edge = FindEdge(edge_based_node_from, edge_based_node_to);
+        if (SPECIAL_EDGEID == edge)
+        {
+            edge = FindEdge(edge_based_node_to, edge_based_node_from);
+            if (SPECIAL_EDGEID != edge)
+            {
+                result = true;
+            }
+        }
+        return edge;
     }
 
     EdgeID
@@ -134,7 +202,36 @@ class ContiguousInternalMemoryAlgorithmDataFacade<CH> : public datafacade::Algor
                      const NodeID edge_based_node_to,
                      const std::function<bool(const EdgeData &)> &filter) const override final
     {
-        return m_query_graph.FindSmallestEdge(edge_based_node_from, edge_based_node_to, filter);
+        EdgeID smallest_edge = SPECIAL_EDGEID;
+        EdgeWeight smallest_weight = INVALID_EDGE_WEIGHT;
+        for (const auto &edge : GetAdjacentEdges(edge_based_node_from))
+        {
+            if (edge.target == edge_based_node_to && edge.data.weight < smallest_weight &&
+                filter(edge.data))
+            {
+                smallest_edge = edge.edge;
+                smallest_weight = edge.data.weight;
+            }
+        }
+        return smallest_edge;
+    }
+
+    const contractor::PhastSweepView *GetPhastSweep() const override final
+    {
+        return m_phast_sweep ? &*m_phast_sweep : nullptr;
+    }
+
+  private:
+    EdgeID BeginEdges(const NodeID node) const
+    {
+        return m_compressed_graph ? m_compressed_graph->BeginEdges(node)
+                                  : m_query_graph.BeginEdges(node);
+    }
+
+    EdgeID EndEdges(const NodeID node) const
+    {
+        return m_compressed_graph ? m_compressed_graph->EndEdges(node)
+                                  : m_query_graph.EndEdges(node);
     }
 };
 
@@ -404,6 +501,25 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
             input_coordinate, approach, max_distance, bearing, use_all_edges);
     }
 
+    std::vector<std::vector<PhantomNodeWithDistance>>
+    NearestPhantomNodes(const std::vector<NearestQuery> &queries,
+                        const size_t max_results) const override final
+    {
+        BOOST_ASSERT(m_geospatial_query.get());
+
+        return m_geospatial_query->NearestPhantomNodes(queries, max_results, std::nullopt);
+    }
+
+    std::vector<PhantomCandidateAlternatives>
+    NearestCandidatesWithAlternativeFromBigComponent(const std::vector<NearestQuery> &queries,
+                                                     const bool use_all_edges) const override final
+    {
+        BOOST_ASSERT(m_geospatial_query.get());
+
+        return m_geospatial_query->NearestCandidatesWithAlternativeFromBigComponent(queries,
+                                                                                   use_all_edges);
+    }
+
     std::uint32_t GetCheckSum() const override final { return m_check_sum; }
 
     std::string GetTimestamp() const override final
@@ -624,7 +740,7 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
 template <typename AlgorithmT> class ContiguousInternalMemoryDataFacade;
 
 template <>
-class ContiguousInternalMemoryDataFacade<CH>
+class ContiguousInternalMemoryDataFacade<CH> final
     : public ContiguousInternalMemoryDataFacadeBase,
       public ContiguousInternalMemoryAlgorithmDataFacade<CH>
 {
@@ -648,7 +764,9 @@ template <> class ContiguousInternalMemoryAlgorithmDataFacade<MLD> : public Algo
     using GraphNode = QueryGraph::NodeArrayEntry;
     using GraphEdge = QueryGraph::EdgeArrayEntry;
 
+    // A dataset has either the query graph or the compressed graph
     QueryGraph query_graph;
+    std::optional<customizer::CompressedMultiLevelEdgeBasedGraphView> compressed_graph;
 
     void InitializeInternalPointers(const storage::SharedDataIndex &index,
                                     const std::string &metric_name,
@@ -658,7 +776,15 @@ template <> class ContiguousInternalMemoryAlgorithmDataFacade<MLD> : public Algo
         mld_cell_metric =
             make_filtered_cell_metric_view(index, "/mld/metrics/" + metric_name, exclude_index);
         mld_cell_storage = make_cell_storage_view(index, "/mld/cellstorage");
-        query_graph = make_multi_level_graph_view(index, "/mld/multilevelgraph");
+        if (has_compressed_multi_level_graph(index, "/mld/compressedmultilevelgraph"))
+        {
+            compressed_graph =
+                make_compressed_multi_level_graph_view(index, "/mld/compressedmultilevelgraph");
+        }
+        else
+        {
+            query_graph = make_multi_level_graph_view(index, "/mld/multilevelgraph");
+        }
     }
 
     // allocator that keeps the allocation data
@@ -674,78 +800,120 @@ template <> class ContiguousInternalMemoryAlgorithmDataFacade<MLD> : public Algo
         InitializeInternalPointers(allocator->GetIndex(), metric_name, exclude_index);
     }
 
-    const partitioner::MultiLevelPartitionView &GetMultiLevelPartition() const override
+    const partitioner::MultiLevelPartitionView &GetMultiLevelPartition() const override final
     {
         return mld_partition;
     }
 
-    const partitioner::CellStorageView &GetCellStorage() const override { return mld_cell_storage; }
+    const partitioner::CellStorageView &GetCellStorage() const override final
+    {
+        return mld_cell_storage;
+    }
 
-    const customizer::CellMetricView &GetCellMetric() const override { return mld_cell_metric; }
+    const customizer::CellMetricView &GetCellMetric() const override final
+    {
+        return mld_cell_metric;
+    }
 
     // search graph access
-    unsigned GetNumberOfNodes() const override final { return query_graph.GetNumberOfNodes(); }
+    unsigned GetNumberOfNodes() const override final
+    {
+        return compressed_graph ? compressed_graph->GetNumberOfNodes()
+                                : query_graph.GetNumberOfNodes();
+    }
 
-    unsigned GetMaxBorderNodeID() const override final { return query_graph.GetMaxBorderNodeID(); }
+    unsigned GetMaxBorderNodeID() const override final
+    {
+        return compressed_graph ? compressed_graph->GetMaxBorderNodeID()
+                                : query_graph.GetMaxBorderNodeID();
+    }
 
-    unsigned GetNumberOfEdges() const override final { return query_graph.GetNumberOfEdges(); }
+    unsigned GetNumberOfEdges() const override final
+    {
+        return compressed_graph ? compressed_graph->GetNumberOfEdges()
+                                : query_graph.GetNumberOfEdges();
+    }
 
     unsigned GetOutDegree(const NodeID edge_based_node_id) const override final
     {
-        return query_graph.GetOutDegree(edge_based_node_id);
+        return compressed_graph ? compressed_graph->GetOutDegree(edge_based_node_id)
+                                : query_graph.GetOutDegree(edge_based_node_id);
     }
 
     EdgeRange GetAdjacentEdgeRange(const NodeID edge_based_node_id) const override final
     {
-        return query_graph.GetAdjacentEdgeRange(edge_based_node_id);
+        return compressed_graph ? compressed_graph->GetAdjacentEdgeRange(edge_based_node_id)
+                                : query_graph.GetAdjacentEdgeRange(edge_based_node_id);
     }
 
     EdgeWeight GetNodeWeight(const NodeID edge_based_node_id) const override final
     {
-        return query_graph.GetNodeWeight(edge_based_node_id);
+        return compressed_graph ? compressed_graph->GetNodeWeight(edge_based_node_id)
+                                : query_graph.GetNodeWeight(edge_based_node_id);
     }
 
     EdgeDuration GetNodeDuration(const NodeID edge_based_node_id) const override final
     {
-        return query_graph.GetNodeDuration(edge_based_node_id);
+        return compressed_graph ? compressed_graph->GetNodeDuration(edge_based_node_id)
+                                : query_graph.GetNodeDuration(edge_based_node_id);
     }
 
     EdgeDistance GetNodeDistance(const NodeID edge_based_node_id) const override final
     {
-        return query_graph.GetNodeDistance(edge_based_node_id);
+        return compressed_graph ? compressed_graph->GetNodeDistance(edge_based_node_id)
+                                : query_graph.GetNodeDistance(edge_based_node_id);
     }
 
     bool IsForwardEdge(const NodeID edge_based_node_id) const override final
     {
-        return query_graph.IsForwardEdge(edge_based_node_id);
+        return compressed_graph ? compressed_graph->IsForwardEdge(edge_based_node_id)
+                                : query_graph.IsForwardEdge(edge_based_node_id);
     }
 
     bool IsBackwardEdge(const NodeID edge_based_node_id) const override final
     {
-        return query_graph.IsBackwardEdge(edge_based_node_id);
+        return compressed_graph ? compressed_graph->IsBackwardEdge(edge_based_node_id)
+                                : query_graph.IsBackwardEdge(edge_based_node_id);
     }
 
     NodeID GetTarget(const EdgeID edge_based_edge_id) const override final
     {
-        return query_graph.GetTarget(edge_based_edge_id);
+        return compressed_graph ? compressed_graph->GetTarget(edge_based_edge_id)
+                                : query_graph.GetTarget(edge_based_edge_id);
     }
 
-    const EdgeData &GetEdgeData(const EdgeID edge_based_edge_id) const override final
+    EdgeData GetEdgeData(const EdgeID edge_based_edge_id) const override final
     {
-        return query_graph.GetEdgeData(edge_based_edge_id);
+        return compressed_graph ? compressed_graph->GetEdgeData(edge_based_edge_id)
+                                : query_graph.GetEdgeData(edge_based_edge_id);
     }
 
     EdgeRange GetBorderEdgeRange(const LevelID level,
                                  const NodeID edge_based_node_id) const override final
     {
-        return query_graph.GetBorderEdgeRange(level, edge_based_node_id);
+        return compressed_graph ? compressed_graph->GetBorderEdgeRange(level, edge_based_node_id)
+                                : query_graph.GetBorderEdgeRange(level, edge_based_node_id);
+    }
+
+    AdjacentEdgeRange GetBorderEdges(const LevelID level,
+                                     const NodeID edge_based_node_id) const override final
+    {
+        const auto *compressed = compressed_graph ? &*compressed_graph : nullptr;
+        const auto edges = GetBorderEdgeRange(level, edge_based_node_id);
+        return AdjacentEdgeRange{
+            customizer::AdjacentEdgeIterator{
+                &query_graph, compressed, edge_based_node_id, *edges.begin()},
+            customizer::AdjacentEdgeIterator{
+                &query_graph, compressed, edge_based_node_id, *edges.end()}};
     }
 
     // searches for a specific edge
     EdgeID FindEdge(const NodeID edge_based_node_from,
                     const NodeID edge_based_node_to) const override final
     {
-        return query_graph.FindEdge(edge_based_node_from, edge_based_node_to);
+        return compressed_graph
+                   ? compressed_graph->FindEdge(edge_based_node_from, edge_based_node_to)
+                   : query_graph.FindEdge(edge_based_node_from, edge_based_node_to);
     }
 };
 
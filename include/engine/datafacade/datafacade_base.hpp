@@ -143,6 +143,16 @@ class BaseDataFacade
                                                      const Approach approach,
                                                      const bool use_all_edges) const = 0;
 
+    // Batched versions of the nearest queries that share the R-tree traversal between the
+    // coordinates of a request
+    virtual std::vector<std::vector<PhantomNodeWithDistance>>
+    NearestPhantomNodes(const std::vector<NearestQuery> &queries,
+                        const size_t max_results) const = 0;
+
+    virtual std::vector<PhantomCandidateAlternatives>
+    NearestCandidatesWithAlternativeFromBigComponent(const std::vector<NearestQuery> &queries,
+                                                     const bool use_all_edges) const = 0;
+
     virtual bool HasLaneData(const EdgeID edge_based_edge_id) const = 0;
     virtual util::guidance::LaneTupleIdPair GetLaneData(const EdgeID edge_based_edge_id) const = 0;
     virtual extractor::TurnLaneDescription
@@ -0,0 +1,79 @@
+#ifndef OSRM_ENGINE_DATASET_SNAPSHOT_HPP
+#define OSRM_ENGINE_DATASET_SNAPSHOT_HPP
+
+#include <memory>
+#include <mutex>
+
+namespace osrm::engine
+{
+
+/**
+ * Lets several queries use the same dataset, e.g. the queries of a batch request, even if
+ * osrm-datastore publishes a new dataset while they run. The first query that asks for the
+ * data pins it, all later queries of the snapshot get the pinned data.
+ *
+ * Only providers that can swap their data look at the snapshot, the data of the others never
+ * changes anyway.
+ */
+class DatasetSnapshot
+{
+  public:
+    DatasetSnapshot() = default;
+
+    DatasetSnapshot(const DatasetSnapshot &) = delete;
+    DatasetSnapshot &operator=(const DatasetSnapshot &) = delete;
+
+    // Returns the data the provider pinned, loads and pins it on the first call. Data of any
+    // other provider than the first one is loaded every time.
+    template <typename T, typename Load>
+    std::shared_ptr<const T> Pin(const void *provider, Load &&load)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!data)
+        {
+            owner = provider;
+            data = load();
+        }
+        else if (owner != provider)
+        {
+            return load();
+        }
+        return std::static_pointer_cast<const T>(data);
+    }
+
+  private:
+    std::mutex mutex;
+    const void *owner = nullptr;
+    std::shared_ptr<const void> data;
+};
+
+namespace detail
+{
+inline thread_local DatasetSnapshot *current_dataset_snapshot = nullptr;
+} // namespace detail
+
+// Snapshot of the queries handled by this thread, nullptr if there is none
+inline DatasetSnapshot *CurrentDatasetSnapshot() { return detail::current_dataset_snapshot; }
+
+// Makes the snapshot the one of the queries handled by this thread until it is destroyed.
+// Tasks that run queries of the same snapshot on other threads install it there too.
+class ScopedDatasetSnapshot
+{
+  public:
+    explicit ScopedDatasetSnapshot(DatasetSnapshot *snapshot)
+        : previous(detail::current_dataset_snapshot)
+    {
+        detail::current_dataset_snapshot = snapshot;
+    }
+
+    ~ScopedDatasetSnapshot() { detail::current_dataset_snapshot = previous; }
+
+    ScopedDatasetSnapshot(const ScopedDatasetSnapshot &) = delete;
+    ScopedDatasetSnapshot &operator=(const ScopedDatasetSnapshot &) = delete;
+
+  private:
+    DatasetSnapshot *previous;
+};
+} // namespace osrm::engine
+
+#endif // OSRM_ENGINE_DATASET_SNAPSHOT_HPP
@@ -1,26 +1,34 @@
 #ifndef ENGINE_HPP
 #define ENGINE_HPP
 
+#include "engine/api/isochrone_parameters.hpp"
 #include "engine/api/match_parameters.hpp"
 #include "engine/api/nearest_parameters.hpp"
 #include "engine/api/route_parameters.hpp"
 #include "engine/api/table_parameters.hpp"
 #include "engine/api/tile_parameters.hpp"
 #include "engine/api/trip_parameters.hpp"
+#include "engine/cancellation.hpp"
 #include "engine/datafacade_provider.hpp"
 #include "engine/engine_config.hpp"
+#include "engine/plugins/isochrone.hpp"
 #include "engine/plugins/match.hpp"
 #include "engine/plugins/nearest.hpp"
 #include "engine/plugins/table.hpp"
 #include "engine/plugins/tile.hpp"
 #include "engine/plugins/trip.hpp"
 #include "engine/plugins/viaroute.hpp"
+#include "engine/route_cache.hpp"
 #include "engine/routing_algorithms.hpp"
+#include "engine/snapping_cache.hpp"
 #include "engine/status.hpp"
 
 #include "util/json_container.hpp"
 
 #include <memory>
+#include <string>
+#include <type_traits>
+#include <variant>
 
 namespace osrm::engine
 {
@@ -36,6 +44,8 @@ class EngineInterface
     virtual Status Trip(const api::TripParameters &parameters, api::ResultT &result) const = 0;
     virtual Status Match(const api::MatchParameters &parameters, api::ResultT &result) const = 0;
     virtual Status Tile(const api::TileParameters &parameters, api::ResultT &result) const = 0;
+    virtual Status Isochrone(const api::IsochroneParameters &parameters,
+                             api::ResultT &result) const = 0;
 };
 
 template <typename Algorithm> class Engine final : public EngineInterface
@@ -45,15 +55,44 @@ template <typename Algorithm> class Engine final : public EngineInterface
         : route_plugin(config.max_locations_viaroute,
                        config.max_alternatives,
                        config.default_radius),                                      //
-          table_plugin(config.max_locations_distance_table, config.default_radius), //
+          table_plugin(config.max_locations_distance_table,
+                       config.phast_min_targets,
+                       config.default_radius),                                      //
           nearest_plugin(config.max_results_nearest, config.default_radius),        //
           trip_plugin(config.max_locations_trip, config.default_radius),            //
           match_plugin(config.max_locations_map_matching,
                        config.max_radius_map_matching,
                        config.default_radius), //
-          tile_plugin()                        //
-
+          tile_plugin(),                       //
+          isochrone_plugin(config.max_duration_isochrone, config.default_radius)
     {
+        if (config.snapping_cache_size > 0)
+        {
+            snapping_cache = std::make_unique<SnappingCache>(
+                static_cast<std::size_t>(config.snapping_cache_size));
+        }
+        if (config.route_cache_size > 0)
+        {
+            route_cache =
+                std::make_unique<RouteCache>(static_cast<std::size_t>(config.route_cache_size));
+        }
+
+        heaps.many_to_many_threads = static_cast<unsigned>(config.many_to_many_threads);
+        if (config.max_heap_memory_mb != -1)
+        {
+            heaps.max_heap_memory =
+                static_cast<std::size_t>(config.max_heap_memory_mb) * 1024 * 1024;
+        }
+
+        if constexpr (std::is_same_v<Algorithm, routing_algorithms::ch::Algorithm>)
+        {
+            heaps.use_array_heap_storage = config.use_array_heap_storage;
+        }
+        else if (config.use_array_heap_storage)
+        {
+            util::Log(logWARNING) << "Array heap storage is only supported with CH, ignoring";
+        }
+
         if (config.use_shared_memory)
         {
             util::Log(logDEBUG) << "Using shared memory with name \"" << config.dataset_name
@@ -88,11 +127,39 @@ template <typename Algorithm> class Engine final : public EngineInterface
 
     Status Route(const api::RouteParameters &params, api::ResultT &result) const override final
     {
-        return route_plugin.HandleRequest(GetAlgorithms(params), params, result);
+        const ScopedCancellation cancellation(params.cancellation.get());
+        const ScopedHeapTrim<Algorithm> trim(heaps);
+        // the response is computed on this facade even if the dataset is swapped meanwhile
+        const auto facade = facade_provider->Get(params);
+        // only responses that are rendered in the engine can be cached
+        const bool use_route_cache =
+            route_cache && facade && std::holds_alternative<api::RenderedJSON>(result);
+
+        std::string key;
+        if (use_route_cache)
+        {
+            key = RouteCache::MakeKey(params);
+            if (auto response = route_cache->Find(facade, key))
+            {
+                std::get<api::RenderedJSON>(result).content = std::move(*response);
+                return Status::Ok;
+            }
+        }
+
+        const auto status = route_plugin.HandleRequest(
+            RoutingAlgorithms<Algorithm>{heaps, facade, snapping_cache.get()}, params, result);
+        if (use_route_cache && status == Status::Ok)
+        {
+            route_cache->Insert(
+                facade, std::move(key), std::get<api::RenderedJSON>(result).content);
+        }
+        return status;
     }
 
     Status Table(const api::TableParameters &params, api::ResultT &result) const override final
     {
+        const ScopedCancellation cancellation(params.cancellation.get());
+        const ScopedHeapTrim<Algorithm> trim(heaps);
         return table_plugin.HandleRequest(GetAlgorithms(params), params, result);
     }
 
@@ -103,11 +170,15 @@ template <typename Algorithm> class Engine final : public EngineInterface
 
     Status Trip(const api::TripParameters &params, api::ResultT &result) const override final
     {
+        const ScopedCancellation cancellation(params.cancellation.get());
+        const ScopedHeapTrim<Algorithm> trim(heaps);
         return trip_plugin.HandleRequest(GetAlgorithms(params), params, result);
     }
 
     Status Match(const api::MatchParameters &params, api::ResultT &result) const override final
     {
+        const ScopedCancellation cancellation(params.cancellation.get());
+        const ScopedHeapTrim<Algorithm> trim(heaps);
         return match_plugin.HandleRequest(GetAlgorithms(params), params, result);
     }
 
@@ -116,10 +187,19 @@ template <typename Algorithm> class Engine final : public EngineInterface
         return tile_plugin.HandleRequest(GetAlgorithms(params), params, result);
     }
 
+    Status Isochrone(const api::IsochroneParameters &params,
+                     api::ResultT &result) const override final
+    {
+        const ScopedCancellation cancellation(params.cancellation.get());
+        const ScopedHeapTrim<Algorithm> trim(heaps);
+        return isochrone_plugin.HandleRequest(GetAlgorithms(params), params, result);
+    }
+
   private:
     template <typename ParametersT> auto GetAlgorithms(const ParametersT &params) const
     {
-        return RoutingAlgorithms<Algorithm>{heaps, facade_provider->Get(params)};
+        return RoutingAlgorithms<Algorithm>{
+            heaps, facade_provider->Get(params), snapping_cache.get()};
     }
     std::unique_ptr<DataFacadeProvider<Algorithm>> facade_provider;
     mutable SearchEngineData<Algorithm> heaps;
@@ -130,6 +210,12 @@ template <typename Algorithm> class Engine final : public EngineInterface
     const plugins::TripPlugin trip_plugin;
     const plugins::MatchPlugin match_plugin;
     const plugins::TilePlugin tile_plugin;
+    const plugins::IsochronePlugin isochrone_plugin;
+
+    // nullptr unless EngineConfig::snapping_cache_size is set
+    std::unique_ptr<SnappingCache> snapping_cache;
+    // nullptr unless EngineConfig::route_cache_size is set
+    std::unique_ptr<RouteCache> route_cache;
 };
 } // namespace osrm::engine
 
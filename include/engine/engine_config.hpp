@@ -50,6 +50,8 @@ namespace osrm::engine
  *  - Match
  *  - Nearest
  *
+ * The Isochrone service (MLD only) is limited by max_duration_isochrone in seconds instead.
+ *
  * In addition, shared memory can be used for datasets loaded with osrm-datastore.
  *
  * You can chose between two algorithms:
@@ -59,6 +61,29 @@ namespace osrm::engine
  *  - Algorithm::MLD
  *      Multi Level Dijkstra, moderately fast in both pre-processing and query.
  *
+ * Query heaps are thread-local and keep their largest allocation between requests.
+ * max_heap_memory_mb (-1 for unlimited) limits the memory all heaps of a thread keep after a
+ * request, the largest ones are released until they fit; HeapMemoryStatistics reports the
+ * largest memory of the heaps of a thread seen so far.
+ *
+ * Many-to-many searches (table and trip requests) run on the request thread unless
+ * many_to_many_threads is larger than 1. Then the backward and forward searches of larger
+ * matrices are spread over a task arena of up to that many threads, which lowers the latency of
+ * a single request at the expense of overall throughput.
+ *
+ * Datasets contracted with `osrm-contract --phast` can answer CH table requests with at least
+ * phast_min_targets destinations (-1 to disable) by PHAST sweeps instead of bucket searches.
+ *
+ * For CH the query heaps can be indexed by flat arrays instead of hash maps
+ * (use_array_heap_storage). This is faster, but each worker thread then holds several arrays
+ * with one entry per node of the graph.
+ *
+ * snapping_cache_size (-1 to disable) keeps the snapping results of that many coordinates of
+ * route, table, trip and isochrone requests; SnappingCacheStatistics counts hits and misses.
+ *
+ * route_cache_size (-1 to disable) keeps the rendered JSON responses of that many route requests
+ * of the HTTP server. Entries of a dataset are dropped once it is replaced.
+ *
  * \see OSRM, StorageConfig
  */
 struct EngineConfig final
@@ -77,13 +102,20 @@ struct EngineConfig final
     int max_locations_distance_table = -1;
     int max_locations_map_matching = -1;
     double max_radius_map_matching = -1.0;
+    double max_duration_isochrone = -1.0;
     int max_results_nearest = -1;
     double default_radius = -1.0;
     int max_alternatives = 3; // set an arbitrary upper bound; can be adjusted by user
+    int max_heap_memory_mb = -1;
+    int many_to_many_threads = 1;
+    int phast_min_targets = -1;
+    int snapping_cache_size = -1;
+    int route_cache_size = -1;
     bool use_shared_memory = true;
     std::filesystem::path memory_file;
     bool use_mmap = true;
     Algorithm algorithm = Algorithm::CH;
+    bool use_array_heap_storage = false;
     std::vector<storage::FeatureDataset> disable_feature_dataset;
     std::string verbosity;
     std::string dataset_name;
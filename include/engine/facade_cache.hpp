@@ -0,0 +1,139 @@
+#ifndef OSRM_ENGINE_FACADE_CACHE_HPP
+#define OSRM_ENGINE_FACADE_CACHE_HPP
+
+#include "util/std_hash.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace osrm::engine
+{
+
+/**
+ * Least recently used cache for results that only hold for the facade they were computed on.
+ *
+ * Every entry remembers its facade. Requests with exclude flags use a different facade and never
+ * share entries with other requests, and once the DataWatchdog swaps in a new dataset all entries
+ * of the old one turn stale and are dropped when they are found. Until then they age out like
+ * every other entry.
+ *
+ * The capacity is split over shards with their own lock, so concurrent requests rarely wait for
+ * each other.
+ */
+template <typename KeyT, typename ValueT, typename HashT = std::hash<KeyT>> class FacadeCache
+{
+  public:
+    explicit FacadeCache(const std::size_t capacity)
+        : shard_capacity(std::max<std::size_t>(1, capacity / NUMBER_OF_SHARDS))
+    {
+    }
+
+    std::optional<ValueT> Find(const std::shared_ptr<const void> &facade, const KeyT &key)
+    {
+        const Slot slot{facade.get(), key};
+        auto &shard = GetShard(slot);
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        const auto found = shard.index.find(slot);
+        if (found == shard.index.end())
+        {
+            return std::nullopt;
+        }
+
+        const auto entry = found->second;
+        // the address of a released facade can be reused by the next one
+        if (entry->facade.expired())
+        {
+            shard.index.erase(found);
+            shard.entries.erase(entry);
+            return std::nullopt;
+        }
+
+        shard.entries.splice(shard.entries.begin(), shard.entries, entry);
+        return entry->value;
+    }
+
+    // Returns the number of entries that were evicted to make room
+    std::size_t Insert(const std::shared_ptr<const void> &facade, KeyT key, ValueT value)
+    {
+        Slot slot{facade.get(), std::move(key)};
+        auto &shard = GetShard(slot);
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        const auto found = shard.index.find(slot);
+        if (found != shard.index.end())
+        {
+            // another request computed the same result in the meantime
+            found->second->facade = facade;
+            found->second->value = std::move(value);
+            shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+            return 0;
+        }
+
+        shard.entries.push_front(Entry{slot, facade, std::move(value)});
+        shard.index.emplace(std::move(slot), shard.entries.begin());
+
+        if (shard.entries.size() <= shard_capacity)
+        {
+            return 0;
+        }
+        shard.index.erase(shard.entries.back().slot);
+        shard.entries.pop_back();
+        return 1;
+    }
+
+  private:
+    static constexpr std::size_t NUMBER_OF_SHARDS = 16;
+
+    struct Slot
+    {
+        // only compared, the entry holds a weak reference to tell if it is still alive
+        const void *facade;
+        KeyT key;
+
+        bool operator==(const Slot &other) const
+        {
+            return facade == other.facade && key == other.key;
+        }
+    };
+
+    struct SlotHash
+    {
+        std::size_t operator()(const Slot &slot) const
+        {
+            std::size_t seed = HashT{}(slot.key);
+            hash_combine(seed, slot.facade);
+            return seed;
+        }
+    };
+
+    struct Entry
+    {
+        Slot slot;
+        std::weak_ptr<const void> facade;
+        ValueT value;
+    };
+
+    struct Shard
+    {
+        std::mutex mutex;
+        // most recently used entry first
+        std::list<Entry> entries;
+        std::unordered_map<Slot, typename std::list<Entry>::iterator, SlotHash> index;
+    };
+
+    Shard &GetShard(const Slot &slot) { return shards[SlotHash{}(slot) % NUMBER_OF_SHARDS]; }
+
+    const std::size_t shard_capacity;
+    std::array<Shard, NUMBER_OF_SHARDS> shards;
+};
+} // namespace osrm::engine
+
+#endif // OSRM_ENGINE_FACADE_CACHE_HPP
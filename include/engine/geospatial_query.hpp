@@ -36,6 +36,7 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
     using EdgeData = typename RTreeT::EdgeData;
     using CoordinateList = typename RTreeT::CoordinateList;
     using CandidateSegment = typename RTreeT::CandidateSegment;
+    using LeafCache = typename RTreeT::LeafCache;
 
   public:
     GeospatialQuery(RTreeT &rtree_, const CoordinateList &coordinates_, DataFacadeT &datafacade_)
@@ -86,7 +87,8 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
                         const size_t max_results,
                         const std::optional<double> max_distance,
                         const std::optional<Bearing> bearing_with_range,
-                        const std::optional<bool> use_all_edges) const
+                        const std::optional<bool> use_all_edges,
+                        LeafCache *leaf_cache = nullptr) const
     {
         auto results = rtree.Nearest(
             input_coordinate,
@@ -107,11 +109,34 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
                 return (num_results >= max_results) ||
                        (max_distance && max_distance != -1.0 &&
                         CheckSegmentDistance(input_coordinate, segment, *max_distance));
-            });
+            },
+            leaf_cache);
 
         return MakePhantomNodes(input_coordinate, results);
     }
 
+    // Batched version of NearestPhantomNodes that shares the R-tree traversal of the queries
+    std::vector<std::vector<PhantomNodeWithDistance>>
+    NearestPhantomNodes(const std::vector<NearestQuery> &queries,
+                        const size_t max_results,
+                        const std::optional<bool> use_all_edges) const
+    {
+        std::vector<std::vector<PhantomNodeWithDistance>> results(queries.size());
+        rtree.BatchNearest(GetInputCoordinates(queries),
+                           [&](const std::size_t index, LeafCache &leaf_cache)
+                           {
+                               const auto &query = queries[index];
+                               results[index] = NearestPhantomNodes(query.input_coordinate,
+                                                                    query.approach,
+                                                                    max_results,
+                                                                    query.max_distance,
+                                                                    query.bearing,
+                                                                    use_all_edges,
+                                                                    &leaf_cache);
+                           });
+        return results;
+    }
+
     // Returns a list of phantom node candidates from the nearest location that are valid
     // within the provided parameters. If there is tie between equidistant locations,
     // we only pick candidates from one location.
@@ -122,7 +147,8 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
         const Approach approach,
         const std::optional<double> max_distance,
         const std::optional<Bearing> bearing_with_range,
-        const std::optional<bool> use_all_edges) const
+        const std::optional<bool> use_all_edges,
+        LeafCache *leaf_cache = nullptr) const
     {
         bool has_nearest = false;
         bool has_big_component = false;
@@ -206,12 +232,47 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
                 // than that node.
                 // 2. We're further away from the input then our max allowed distance.
                 return no_more_candidates || too_far_away;
-            });
+            },
+            leaf_cache);
 
         return MakeAlternativeBigCandidates(input_coordinate, nearest_coord, results);
     }
 
+    // Batched version of NearestCandidatesWithAlternativeFromBigComponent that shares the
+    // R-tree traversal of the queries
+    std::vector<PhantomCandidateAlternatives>
+    NearestCandidatesWithAlternativeFromBigComponent(const std::vector<NearestQuery> &queries,
+                                                     const std::optional<bool> use_all_edges) const
+    {
+        std::vector<PhantomCandidateAlternatives> results(queries.size());
+        rtree.BatchNearest(
+            GetInputCoordinates(queries),
+            [&](const std::size_t index, LeafCache &leaf_cache)
+            {
+                const auto &query = queries[index];
+                results[index] = NearestCandidatesWithAlternativeFromBigComponent(
+                    query.input_coordinate,
+                    query.approach,
+                    query.max_distance,
+                    query.bearing,
+                    use_all_edges,
+                    &leaf_cache);
+            });
+        return results;
+    }
+
   private:
+    static std::vector<util::Coordinate>
+    GetInputCoordinates(const std::vector<NearestQuery> &queries)
+    {
+        std::vector<util::Coordinate> input_coordinates(queries.size());
+        std::transform(queries.begin(),
+                       queries.end(),
+                       input_coordinates.begin(),
+                       [](const NearestQuery &query) { return query.input_coordinate; });
+        return input_coordinates;
+    }
+
     PhantomCandidateAlternatives
     MakeAlternativeBigCandidates(const util::Coordinate input_coordinate,
                                  const Coordinate nearest_coord,
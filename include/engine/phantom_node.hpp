@@ -28,8 +28,11 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef OSRM_ENGINE_PHANTOM_NODE_H
 #define OSRM_ENGINE_PHANTOM_NODE_H
 
+#include <optional>
 #include <vector>
 
+#include "engine/approach.hpp"
+#include "engine/bearing.hpp"
 #include "extractor/travel_mode.hpp"
 
 #include "util/bearing.hpp"
@@ -233,6 +236,15 @@ struct PhantomNodeWithDistance
     double distance;
 };
 
+// Snapping parameters of one coordinate of a batch of nearest queries
+struct NearestQuery
+{
+    util::Coordinate input_coordinate;
+    std::optional<double> max_distance;
+    std::optional<Bearing> bearing;
+    Approach approach;
+};
+
 struct PhantomEndpointCandidates
 {
     const PhantomNodeCandidates &source_phantoms;
@@ -0,0 +1,27 @@
+#ifndef ISOCHRONE_HPP
+#define ISOCHRONE_HPP
+
+#include "engine/api/isochrone_parameters.hpp"
+#include "engine/plugins/plugin_base.hpp"
+#include "engine/routing_algorithms.hpp"
+
+#include "util/json_container.hpp"
+
+namespace osrm::engine::plugins
+{
+
+class IsochronePlugin final : public BasePlugin
+{
+  public:
+    explicit IsochronePlugin(const double max_duration, const std::optional<double> default_radius);
+
+    Status HandleRequest(const RoutingAlgorithmsInterface &algorithms,
+                         const api::IsochroneParameters &params,
+                         osrm::engine::api::ResultT &result) const;
+
+  private:
+    const double max_duration;
+};
+} // namespace osrm::engine::plugins
+
+#endif // ISOCHRONE_HPP
@@ -13,6 +13,8 @@
 #include "util/coordinate_calculation.hpp"
 #include "util/integer_range.hpp"
 #include "util/json_container.hpp"
+#include "util/json_renderer.hpp"
+#include "util/request_phases.hpp"
 
 #include <algorithm>
 #include <iterator>
@@ -89,6 +91,13 @@ class BasePlugin
         {
             str_result = str(boost::format("code=%1% message=%2%") % code % message);
         };
+        void operator()(api::RenderedJSON &rendered_result)
+        {
+            util::json::Object json_result;
+            (*this)(json_result);
+            rendered_result.content.clear();
+            util::json::render(rendered_result.content, json_result);
+        };
     };
 
     Status Error(const std::string &code,
@@ -174,6 +183,7 @@ class BasePlugin
                            const std::vector<double> &radiuses,
                            bool use_all_edges = false) const
     {
+        const util::ScopedRequestPhase phase(util::RequestPhase::Snapping);
         std::vector<std::vector<PhantomNodeWithDistance>> phantom_nodes(
             parameters.coordinates.size());
         BOOST_ASSERT(radiuses.size() == parameters.coordinates.size());
@@ -214,6 +224,7 @@ class BasePlugin
                     const api::BaseParameters &parameters,
                     size_t number_of_results) const
     {
+        const util::ScopedRequestPhase phase(util::RequestPhase::Snapping);
         std::vector<std::vector<PhantomNodeWithDistance>> phantom_nodes(
             parameters.coordinates.size());
 
@@ -223,6 +234,8 @@ class BasePlugin
         const bool use_approaches = !parameters.approaches.empty();
 
         BOOST_ASSERT(parameters.IsValid());
+        std::vector<std::size_t> query_indexes;
+        std::vector<NearestQuery> queries;
         for (const auto i : util::irange<std::size_t>(0UL, parameters.coordinates.size()))
         {
             if (use_hints && parameters.hints[i] && !parameters.hints[i]->segment_hints.empty() &&
@@ -238,27 +251,31 @@ class BasePlugin
                 continue;
             }
 
-            phantom_nodes[i] = facade.NearestPhantomNodes(
+            query_indexes.push_back(i);
+            queries.push_back(NearestQuery{
                 parameters.coordinates[i],
-                number_of_results,
                 use_radiuses ? parameters.radiuses[i] : default_radius,
                 use_bearings ? parameters.bearings[i] : std::nullopt,
                 use_approaches && parameters.approaches[i] ? parameters.approaches[i].value()
-                                                           : engine::Approach::UNRESTRICTED);
+                                                           : engine::Approach::UNRESTRICTED});
+        }
 
-            // we didn't find a fitting node, return error
-            if (phantom_nodes[i].empty())
-            {
-                break;
-            }
+        // all coordinates without a hint are snapped at once
+        auto nearest_phantom_nodes = facade.NearestPhantomNodes(queries, number_of_results);
+        for (const auto query : util::irange<std::size_t>(0UL, queries.size()))
+        {
+            phantom_nodes[query_indexes[query]] = std::move(nearest_phantom_nodes[query]);
         }
         return phantom_nodes;
     }
 
+    // Coordinates without a hint are looked up in the snapping cache of the engine first
     std::vector<PhantomCandidateAlternatives>
-    GetPhantomNodes(const datafacade::BaseDataFacade &facade,
+    GetPhantomNodes(const RoutingAlgorithmsInterface &algorithms,
                     const api::BaseParameters &parameters) const
     {
+        const util::ScopedRequestPhase phase(util::RequestPhase::Snapping);
+        const auto &facade = algorithms.GetFacade();
         std::vector<PhantomCandidateAlternatives> alternatives(parameters.coordinates.size());
 
         const bool use_hints = !parameters.hints.empty();
@@ -268,6 +285,8 @@ class BasePlugin
         const bool use_all_edges = parameters.snapping == api::BaseParameters::SnappingType::Any;
 
         BOOST_ASSERT(parameters.IsValid());
+        std::vector<std::size_t> query_indexes;
+        std::vector<NearestQuery> queries;
         for (const auto i : util::irange<std::size_t>(0UL, parameters.coordinates.size()))
         {
             if (use_hints && parameters.hints[i] && !parameters.hints[i]->segment_hints.empty() &&
@@ -281,24 +300,29 @@ class BasePlugin
                 continue;
             }
 
-            alternatives[i] = facade.NearestCandidatesWithAlternativeFromBigComponent(
+            query_indexes.push_back(i);
+            queries.push_back(NearestQuery{
                 parameters.coordinates[i],
                 use_radiuses ? parameters.radiuses[i] : default_radius,
                 use_bearings ? parameters.bearings[i] : std::nullopt,
                 use_approaches && parameters.approaches[i] ? parameters.approaches[i].value()
-                                                           : engine::Approach::UNRESTRICTED,
-                use_all_edges);
+                                                           : engine::Approach::UNRESTRICTED});
+        }
 
+        // all coordinates without a hint are snapped at once
+        auto nearest_alternatives =
+            algorithms.NearestCandidatesWithAlternativeFromBigComponent(queries, use_all_edges);
+        for (const auto query : util::irange<std::size_t>(0UL, queries.size()))
+        {
             // we didn't find a fitting node, return error
-            if (alternatives[i].first.empty())
+            if (nearest_alternatives[query].first.empty())
             {
                 // This ensures the list of phantom nodes only consists of valid nodes.
                 // We can use this on the call-site to detect an error.
                 alternatives.pop_back();
                 break;
             }
-
-            BOOST_ASSERT(!alternatives[i].first.empty());
+            alternatives[query_indexes[query]] = std::move(nearest_alternatives[query]);
         }
         return alternatives;
     }
@@ -15,6 +15,7 @@ class TablePlugin final : public BasePlugin
 {
   public:
     explicit TablePlugin(const int max_locations_distance_table,
+                         const int phast_min_targets,
                          const std::optional<double> default_radius);
 
     Status HandleRequest(const RoutingAlgorithmsInterface &algorithms,
@@ -23,6 +24,7 @@ class TablePlugin final : public BasePlugin
 
   private:
     const int max_locations_distance_table;
+    const int phast_min_targets;
 };
 } // namespace osrm::engine::plugins
 
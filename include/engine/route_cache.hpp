@@ -0,0 +1,58 @@
+#ifndef OSRM_ENGINE_ROUTE_CACHE_HPP
+#define OSRM_ENGINE_ROUTE_CACHE_HPP
+
+#include "engine/api/route_parameters.hpp"
+#include "engine/facade_cache.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace osrm::engine
+{
+
+// Process-wide counters of all route caches, exported on /metrics
+struct RouteCacheStatistics
+{
+    // Number of route requests answered from a cache
+    static std::atomic<std::uint64_t> hits;
+    // Number of cacheable route requests that had to be computed
+    static std::atomic<std::uint64_t> misses;
+    // Number of responses that were added to a cache
+    static std::atomic<std::uint64_t> admissions;
+    // Number of responses that were dropped to make room for newer ones
+    static std::atomic<std::uint64_t> evictions;
+};
+
+/**
+ * Rendered JSON responses of the least recently used route requests. Only successful responses
+ * are admitted, errors are cheap to compute again or depend on limits of the engine.
+ *
+ * Requests are identified by a canonical encoding of all their parameters. On the same facade
+ * these determine the snapped waypoints and so the whole response.
+ */
+class RouteCache
+{
+  public:
+    explicit RouteCache(std::size_t capacity);
+
+    std::optional<std::vector<char>> Find(const std::shared_ptr<const void> &facade,
+                                          const std::string &key);
+
+    void Insert(const std::shared_ptr<const void> &facade,
+                std::string key,
+                std::vector<char> response);
+
+    // Equal for two requests if and only if they have the same parameters
+    static std::string MakeKey(const api::RouteParameters &parameters);
+
+  private:
+    FacadeCache<std::string, std::vector<char>> cache;
+};
+} // namespace osrm::engine
+
+#endif // OSRM_ENGINE_ROUTE_CACHE_HPP
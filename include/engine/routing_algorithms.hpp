@@ -6,10 +6,17 @@
 #include "engine/phantom_node.hpp"
 #include "engine/routing_algorithms/alternative_path.hpp"
 #include "engine/routing_algorithms/direct_shortest_path.hpp"
+#include "engine/routing_algorithms/isochrone.hpp"
 #include "engine/routing_algorithms/many_to_many.hpp"
 #include "engine/routing_algorithms/map_matching.hpp"
 #include "engine/routing_algorithms/shortest_path.hpp"
 #include "engine/routing_algorithms/tile_turns.hpp"
+#include "engine/snapping_cache.hpp"
+
+#include "util/integer_range.hpp"
+#include "util/request_phases.hpp"
+
+#include <boost/core/ignore_unused.hpp>
 
 namespace osrm::engine
 {
@@ -36,6 +43,12 @@ class RoutingAlgorithmsInterface
                      const std::vector<std::size_t> &target_indices,
                      const bool calculate_distance) const = 0;
 
+    virtual std::pair<std::vector<EdgeDuration>, std::vector<EdgeDistance>>
+    PhastManyToManySearch(const std::vector<PhantomNodeCandidates> &candidates_list,
+                          const std::vector<std::size_t> &source_indices,
+                          const std::vector<std::size_t> &target_indices,
+                          const bool calculate_distance) const = 0;
+
     virtual routing_algorithms::SubMatchingList
     MapMatching(const routing_algorithms::CandidateLists &candidates_list,
                 const std::vector<util::Coordinate> &trace_coordinates,
@@ -47,6 +60,16 @@ class RoutingAlgorithmsInterface
     GetTileTurns(const std::vector<datafacade::BaseDataFacade::RTreeLeaf> &edges,
                  const std::vector<std::size_t> &sorted_edge_indexes) const = 0;
 
+    virtual std::vector<routing_algorithms::IsochroneNode>
+    IsochroneSearch(const PhantomNodeCandidates &source_candidates,
+                    const EdgeDuration max_duration,
+                    const bool descend_into_reached_cells) const = 0;
+
+    // Snaps like the facade does, but first looks for the coordinates in the snapping cache
+    virtual std::vector<PhantomCandidateAlternatives>
+    NearestCandidatesWithAlternativeFromBigComponent(const std::vector<NearestQuery> &queries,
+                                                     const bool use_all_edges) const = 0;
+
     virtual const DataFacadeBase &GetFacade() const = 0;
 
     virtual bool HasAlternativePathSearch() const = 0;
@@ -57,6 +80,8 @@ class RoutingAlgorithmsInterface
     virtual bool SupportsDistanceAnnotationType() const = 0;
     virtual bool HasGetTileTurns() const = 0;
     virtual bool HasExcludeFlags() const = 0;
+    virtual bool HasPhastSearch() const = 0;
+    virtual bool HasIsochroneSearch() const = 0;
     virtual bool IsValid() const = 0;
 };
 
@@ -65,8 +90,9 @@ template <typename Algorithm> class RoutingAlgorithms final : public RoutingAlgo
 {
   public:
     RoutingAlgorithms(SearchEngineData<Algorithm> &heaps,
-                      std::shared_ptr<const DataFacade<Algorithm>> facade)
-        : heaps(heaps), facade(facade)
+                      std::shared_ptr<const DataFacade<Algorithm>> facade,
+                      SnappingCache *snapping_cache = nullptr)
+        : heaps(heaps), facade(facade), snapping_cache(snapping_cache)
     {
     }
 
@@ -89,6 +115,12 @@ template <typename Algorithm> class RoutingAlgorithms final : public RoutingAlgo
                      const std::vector<std::size_t> &target_indices,
                      const bool calculate_distance) const final override;
 
+    std::pair<std::vector<EdgeDuration>, std::vector<EdgeDistance>>
+    PhastManyToManySearch(const std::vector<PhantomNodeCandidates> &candidates_list,
+                          const std::vector<std::size_t> &source_indices,
+                          const std::vector<std::size_t> &target_indices,
+                          const bool calculate_distance) const final override;
+
     routing_algorithms::SubMatchingList
     MapMatching(const routing_algorithms::CandidateLists &candidates_list,
                 const std::vector<util::Coordinate> &trace_coordinates,
@@ -100,6 +132,15 @@ template <typename Algorithm> class RoutingAlgorithms final : public RoutingAlgo
     GetTileTurns(const std::vector<datafacade::BaseDataFacade::RTreeLeaf> &edges,
                  const std::vector<std::size_t> &sorted_edge_indexes) const final override;
 
+    std::vector<routing_algorithms::IsochroneNode>
+    IsochroneSearch(const PhantomNodeCandidates &source_candidates,
+                    const EdgeDuration max_duration,
+                    const bool descend_into_reached_cells) const final override;
+
+    std::vector<PhantomCandidateAlternatives>
+    NearestCandidatesWithAlternativeFromBigComponent(const std::vector<NearestQuery> &queries,
+                                                     const bool use_all_edges) const final override;
+
     const DataFacadeBase &GetFacade() const final override { return *facade; }
 
     bool HasAlternativePathSearch() const final override
@@ -142,17 +183,38 @@ template <typename Algorithm> class RoutingAlgorithms final : public RoutingAlgo
         return routing_algorithms::HasExcludeFlags<Algorithm>::value;
     }
 
+    // Needs the optional PHAST sweep of the dataset in addition to algorithm support
+    bool HasPhastSearch() const final override
+    {
+        if constexpr (routing_algorithms::HasPhastSearch<Algorithm>::value)
+        {
+            return facade->GetPhastSweep() != nullptr;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    bool HasIsochroneSearch() const final override
+    {
+        return routing_algorithms::HasIsochroneSearch<Algorithm>::value;
+    }
+
     bool IsValid() const final override { return static_cast<bool>(facade); }
 
   private:
     SearchEngineData<Algorithm> &heaps;
     std::shared_ptr<const DataFacade<Algorithm>> facade;
+    // not owned, nullptr if the engine runs without a snapping cache
+    SnappingCache *snapping_cache;
 };
 
 template <typename Algorithm>
 InternalManyRoutesResult RoutingAlgorithms<Algorithm>::AlternativePathSearch(
     const PhantomEndpointCandidates &endpoint_candidates, unsigned number_of_alternatives) const
 {
+    const util::ScopedRequestPhase phase(util::RequestPhase::Search);
     return routing_algorithms::alternativePathSearch(
         heaps, *facade, endpoint_candidates, number_of_alternatives);
 }
@@ -162,6 +224,7 @@ InternalRouteResult RoutingAlgorithms<Algorithm>::ShortestPathSearch(
     const std::vector<PhantomNodeCandidates> &waypoint_candidates,
     const std::optional<bool> continue_straight_at_waypoint) const
 {
+    const util::ScopedRequestPhase phase(util::RequestPhase::Search);
     return routing_algorithms::shortestPathSearch(
         heaps, *facade, waypoint_candidates, continue_straight_at_waypoint);
 }
@@ -170,6 +233,7 @@ template <typename Algorithm>
 InternalRouteResult RoutingAlgorithms<Algorithm>::DirectShortestPathSearch(
     const PhantomEndpointCandidates &endpoint_candidates) const
 {
+    const util::ScopedRequestPhase phase(util::RequestPhase::Search);
     return routing_algorithms::directShortestPathSearch(heaps, *facade, endpoint_candidates);
 }
 
@@ -181,6 +245,7 @@ inline routing_algorithms::SubMatchingList RoutingAlgorithms<Algorithm>::MapMatc
     const std::vector<std::optional<double>> &trace_gps_precision,
     const bool allow_splitting) const
 {
+    const util::ScopedRequestPhase phase(util::RequestPhase::Search);
     return routing_algorithms::mapMatching(heaps,
                                            *facade,
                                            candidates_list,
@@ -198,6 +263,7 @@ RoutingAlgorithms<Algorithm>::ManyToManySearch(
     const std::vector<std::size_t> &_target_indices,
     const bool calculate_distance) const
 {
+    const util::ScopedRequestPhase phase(util::RequestPhase::Search);
     BOOST_ASSERT(!candidates_list.empty());
 
     auto source_indices = _source_indices;
@@ -222,6 +288,48 @@ RoutingAlgorithms<Algorithm>::ManyToManySearch(
                                                 calculate_distance);
 }
 
+template <typename Algorithm>
+std::pair<std::vector<EdgeDuration>, std::vector<EdgeDistance>>
+RoutingAlgorithms<Algorithm>::PhastManyToManySearch(
+    const std::vector<PhantomNodeCandidates> &candidates_list,
+    const std::vector<std::size_t> &_source_indices,
+    const std::vector<std::size_t> &_target_indices,
+    const bool calculate_distance) const
+{
+    const util::ScopedRequestPhase phase(util::RequestPhase::Search);
+    if constexpr (routing_algorithms::HasPhastSearch<Algorithm>::value)
+    {
+        BOOST_ASSERT(!candidates_list.empty());
+        BOOST_ASSERT(HasPhastSearch());
+
+        auto source_indices = _source_indices;
+        auto target_indices = _target_indices;
+
+        if (source_indices.empty())
+        {
+            source_indices.resize(candidates_list.size());
+            std::iota(source_indices.begin(), source_indices.end(), 0);
+        }
+        if (target_indices.empty())
+        {
+            target_indices.resize(candidates_list.size());
+            std::iota(target_indices.begin(), target_indices.end(), 0);
+        }
+
+        return routing_algorithms::phastManyToManySearch(heaps,
+                                                         *facade,
+                                                         candidates_list,
+                                                         std::move(source_indices),
+                                                         std::move(target_indices),
+                                                         calculate_distance);
+    }
+    else
+    {
+        return ManyToManySearch(
+            candidates_list, _source_indices, _target_indices, calculate_distance);
+    }
+}
+
 template <typename Algorithm>
 inline std::vector<routing_algorithms::TurnData> RoutingAlgorithms<Algorithm>::GetTileTurns(
     const std::vector<datafacade::BaseDataFacade::RTreeLeaf> &edges,
@@ -230,6 +338,61 @@ inline std::vector<routing_algorithms::TurnData> RoutingAlgorithms<Algorithm>::G
     return routing_algorithms::getTileTurns(*facade, edges, sorted_edge_indexes);
 }
 
+template <typename Algorithm>
+std::vector<routing_algorithms::IsochroneNode>
+RoutingAlgorithms<Algorithm>::IsochroneSearch(const PhantomNodeCandidates &source_candidates,
+                                              const EdgeDuration max_duration,
+                                              const bool descend_into_reached_cells) const
+{
+    const util::ScopedRequestPhase phase(util::RequestPhase::Search);
+    if constexpr (routing_algorithms::HasIsochroneSearch<Algorithm>::value)
+    {
+        return routing_algorithms::isochroneSearch(
+            heaps, *facade, source_candidates, max_duration, descend_into_reached_cells);
+    }
+    else
+    {
+        boost::ignore_unused(source_candidates, max_duration, descend_into_reached_cells);
+        BOOST_ASSERT_MSG(false, "Isochrone search is only implemented for MLD");
+        return {};
+    }
+}
+
+template <typename Algorithm>
+std::vector<PhantomCandidateAlternatives>
+RoutingAlgorithms<Algorithm>::NearestCandidatesWithAlternativeFromBigComponent(
+    const std::vector<NearestQuery> &queries, const bool use_all_edges) const
+{
+    if (!snapping_cache)
+    {
+        return facade->NearestCandidatesWithAlternativeFromBigComponent(queries, use_all_edges);
+    }
+
+    std::vector<PhantomCandidateAlternatives> alternatives(queries.size());
+    std::vector<std::size_t> miss_indexes;
+    std::vector<NearestQuery> misses;
+    for (const auto i : util::irange<std::size_t>(0UL, queries.size()))
+    {
+        auto cached = snapping_cache->Find(facade, queries[i], use_all_edges);
+        if (cached)
+        {
+            alternatives[i] = std::move(*cached);
+            continue;
+        }
+        miss_indexes.push_back(i);
+        misses.push_back(queries[i]);
+    }
+
+    // the coordinates that are not cached are still snapped at once
+    auto snapped = facade->NearestCandidatesWithAlternativeFromBigComponent(misses, use_all_edges);
+    for (const auto miss : util::irange<std::size_t>(0UL, misses.size()))
+    {
+        snapping_cache->Insert(facade, misses[miss], use_all_edges, snapped[miss]);
+        alternatives[miss_indexes[miss]] = std::move(snapped[miss]);
+    }
+    return alternatives;
+}
+
 } // namespace osrm::engine
 
 #endif
@@ -0,0 +1,39 @@
+#ifndef OSRM_ENGINE_ROUTING_ALGORITHMS_ISOCHRONE_HPP
+#define OSRM_ENGINE_ROUTING_ALGORITHMS_ISOCHRONE_HPP
+
+#include "engine/algorithm.hpp"
+#include "engine/datafacade.hpp"
+#include "engine/phantom_node.hpp"
+#include "engine/search_engine_data.hpp"
+
+#include "util/typedefs.hpp"
+
+#include <vector>
+
+namespace osrm::engine::routing_algorithms
+{
+
+// Edge-based node reached within the duration budget of an isochrone search
+struct IsochroneNode
+{
+    NodeID node;
+    // Duration from the source to the start of the node's segment. Negative for the source
+    // segments themselves, as the search starts in their middle.
+    EdgeDuration duration;
+};
+
+// Finds all nodes whose shortest path from the source takes at most max_duration.
+//
+// Cells of the overlay are only searched in full if some of their border nodes are out of the
+// budget or if descend_into_reached_cells is set. Otherwise only the border nodes of a cell that
+// is completely reached are returned, which is enough to outline the reachable area.
+template <typename Algorithm>
+std::vector<IsochroneNode> isochroneSearch(SearchEngineData<Algorithm> &engine_working_data,
+                                           const DataFacade<Algorithm> &facade,
+                                           const PhantomNodeCandidates &source_candidates,
+                                           const EdgeDuration max_duration,
+                                           const bool descend_into_reached_cells);
+
+} // namespace osrm::engine::routing_algorithms
+
+#endif
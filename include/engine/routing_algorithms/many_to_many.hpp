@@ -2,11 +2,20 @@
 #define MANY_TO_MANY_ROUTING_HPP
 
 #include "engine/algorithm.hpp"
+#include "engine/cancellation.hpp"
 #include "engine/datafacade.hpp"
 #include "engine/search_engine_data.hpp"
 
 #include "util/typedefs.hpp"
 
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+#include <tbb/task_arena.h>
+
+#include <algorithm>
+#include <cstdint>
 #include <vector>
 
 namespace osrm::engine::routing_algorithms
@@ -84,6 +93,125 @@ struct NodeBucket
         }
     };
 };
+
+// Matrices smaller than this are computed on the calling thread, for them the
+// task scheduling overhead outweighs the parallel speed-up
+constexpr std::size_t MIN_PARALLEL_MANY_TO_MANY_ENTRIES = 64 * 64;
+
+inline unsigned getManyToManyThreads(const unsigned max_threads,
+                                     const std::size_t number_of_entries)
+{
+    return number_of_entries < MIN_PARALLEL_MANY_TO_MANY_ENTRIES ? 1 : std::max(max_threads, 1u);
+}
+
+// Runs the backward search of every column and returns the sorted bucket list.
+// With more than one thread the columns are spread over a task arena of that size. Every worker
+// appends to its own bucket shard, the shards are concatenated afterwards. Since each
+// (middle_node, column_index) pair is unique, the sorted result does not depend on the schedule.
+// The workers trim their thread-local heaps once their share of the searches is done, the
+// calling thread trims its own at the end of the request.
+template <typename Algorithm, typename BackwardSearch>
+std::vector<NodeBucket> computeSortedBuckets(SearchEngineData<Algorithm> &engine_working_data,
+                                             const unsigned threads,
+                                             const std::size_t number_of_columns,
+                                             const BackwardSearch &backward_search)
+{
+    std::vector<NodeBucket> buckets;
+
+    if (threads <= 1)
+    {
+        for (std::uint32_t column_index = 0; column_index < number_of_columns; ++column_index)
+        {
+            backward_search(column_index, buckets);
+        }
+        std::sort(buckets.begin(), buckets.end());
+        return buckets;
+    }
+
+    // the searches on the workers check the cancellation token of the request
+    const auto cancellation = CurrentCancellationToken();
+    tbb::task_arena arena(static_cast<int>(threads));
+    arena.execute(
+        [&]
+        {
+            tbb::enumerable_thread_specific<std::vector<NodeBucket>> shards;
+            tbb::parallel_for(tbb::blocked_range<std::uint32_t>(0, number_of_columns),
+                              [&](const tbb::blocked_range<std::uint32_t> &range)
+                              {
+                                  const ScopedCancellation scoped_cancellation(cancellation);
+                                  const ScopedHeapTrim<Algorithm> trim(engine_working_data);
+                                  auto &shard = shards.local();
+                                  for (auto column_index = range.begin();
+                                       column_index != range.end();
+                                       ++column_index)
+                                  {
+                                      backward_search(column_index, shard);
+                                  }
+                              });
+
+            std::size_t number_of_buckets = 0;
+            for (const auto &shard : shards)
+            {
+                number_of_buckets += shard.size();
+            }
+            buckets.reserve(number_of_buckets);
+            for (const auto &shard : shards)
+            {
+                buckets.insert(buckets.end(), shard.begin(), shard.end());
+            }
+
+            tbb::parallel_sort(buckets.begin(), buckets.end());
+        });
+
+    return buckets;
+}
+
+// Runs the forward search of every row, on a task arena if more than one thread is requested.
+// Each row only writes its own cells of the result tables, so no synchronisation is needed.
+// The token of the request is checked before every row, since a row can end with a sweep over
+// the whole graph that does not settle any nodes. The heaps are trimmed like those of
+// computeSortedBuckets.
+template <typename Algorithm, typename ForwardSearch>
+void computeRows(SearchEngineData<Algorithm> &engine_working_data,
+                 const unsigned threads,
+                 const std::size_t number_of_rows,
+                 const ForwardSearch &forward_search)
+{
+    const auto cancellation = CurrentCancellationToken();
+    if (threads <= 1)
+    {
+        for (std::uint32_t row_index = 0; row_index < number_of_rows; ++row_index)
+        {
+            if (cancellation)
+            {
+                cancellation->ThrowIfCancelled();
+            }
+            forward_search(row_index);
+        }
+        return;
+    }
+
+    tbb::task_arena arena(static_cast<int>(threads));
+    arena.execute(
+        [&]
+        {
+            tbb::parallel_for(tbb::blocked_range<std::uint32_t>(0, number_of_rows),
+                              [&](const tbb::blocked_range<std::uint32_t> &range)
+                              {
+                                  const ScopedCancellation scoped_cancellation(cancellation);
+                                  const ScopedHeapTrim<Algorithm> trim(engine_working_data);
+                                  for (auto row_index = range.begin(); row_index != range.end();
+                                       ++row_index)
+                                  {
+                                      if (cancellation)
+                                      {
+                                          cancellation->ThrowIfCancelled();
+                                      }
+                                      forward_search(row_index);
+                                  }
+                              });
+        });
+}
 } // namespace
 
 template <typename Algorithm>
@@ -95,6 +223,19 @@ manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
                  const std::vector<std::size_t> &target_indices,
                  const bool calculate_distance);
 
+// Same result as manyToManySearch, but computed per source by an upward search followed by a
+// linear sweep over the downward edges of all nodes (PHAST). The cost of a row does not depend
+// on the number of targets, so this pays off once the targets cover a large part of the graph.
+// Requires the PHAST sweep of the facade's exclude class.
+template <typename Algorithm>
+std::pair<std::vector<EdgeDuration>, std::vector<EdgeDistance>>
+phastManyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
+                      const DataFacade<Algorithm> &facade,
+                      const std::vector<PhantomNodeCandidates> &candidates_list,
+                      const std::vector<std::size_t> &source_indices,
+                      const std::vector<std::size_t> &target_indices,
+                      const bool calculate_distance);
+
 } // namespace osrm::engine::routing_algorithms
 
 #endif
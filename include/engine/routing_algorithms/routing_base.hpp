@@ -5,6 +5,7 @@
 #include "guidance/turn_instruction.hpp"
 
 #include "engine/algorithm.hpp"
+#include "engine/cancellation.hpp"
 #include "engine/datafacade.hpp"
 #include "engine/internal_route_result.hpp"
 #include "engine/phantom_node.hpp"
@@ -6,6 +6,7 @@
 #include "engine/routing_algorithms/routing_base.hpp"
 #include "engine/search_engine_data.hpp"
 
+#include "util/request_phases.hpp"
 #include "util/typedefs.hpp"
 
 #include <boost/assert.hpp>
@@ -19,12 +20,12 @@ bool stallAtNode(const DataFacade<Algorithm> &facade,
                  const typename HeapT::HeapNode &heapNode,
                  const HeapT &query_heap)
 {
-    for (auto edge : facade.GetAdjacentEdgeRange(heapNode.node))
+    for (const auto &edge : facade.GetAdjacentEdges(heapNode.node))
     {
-        const auto &data = facade.GetEdgeData(edge);
+        const auto &data = edge.data;
         if (DIRECTION == REVERSE_DIRECTION ? data.forward : data.backward)
         {
-            const NodeID to = facade.GetTarget(edge);
+            const NodeID to = edge.target;
             const EdgeWeight edge_weight = data.weight;
             BOOST_ASSERT_MSG(edge_weight > EdgeWeight{0}, "edge_weight invalid");
             const auto toHeapNode = query_heap.GetHeapNodeIfWasInserted(to);
@@ -45,12 +46,12 @@ void relaxOutgoingEdges(const DataFacade<Algorithm> &facade,
                         const SearchEngineData<Algorithm>::QueryHeap::HeapNode &heapNode,
                         SearchEngineData<Algorithm>::QueryHeap &heap)
 {
-    for (const auto edge : facade.GetAdjacentEdgeRange(heapNode.node))
+    for (const auto &edge : facade.GetAdjacentEdges(heapNode.node))
     {
-        const auto &data = facade.GetEdgeData(edge);
+        const auto &data = edge.data;
         if (DIRECTION == FORWARD_DIRECTION ? data.forward : data.backward)
         {
-            const NodeID to = facade.GetTarget(edge);
+            const NodeID to = edge.target;
             const EdgeWeight edge_weight = data.weight;
 
             BOOST_ASSERT_MSG(edge_weight > EdgeWeight{0}, "edge_weight invalid");
@@ -114,6 +115,8 @@ void routingStep(const DataFacade<Algorithm> &facade,
                  EdgeWeight min_edge_offset,
                  const std::vector<NodeID> &force_step_nodes)
 {
+    CheckCancellation();
+
     auto heapNode = forward_heap.DeleteMinGetHeapNode();
     const auto reverseHeapNode = reverse_heap.GetHeapNodeIfWasInserted(heapNode.node);
 
@@ -129,12 +132,12 @@ void routingStep(const DataFacade<Algorithm> &facade,
             {
                 // Before forcing step, check whether there is a loop present at the node.
                 // We may find a valid weight path by following the loop.
-                for (const auto edge : facade.GetAdjacentEdgeRange(heapNode.node))
+                for (const auto &edge : facade.GetAdjacentEdges(heapNode.node))
                 {
-                    const auto &data = facade.GetEdgeData(edge);
+                    const auto &data = edge.data;
                     if (DIRECTION == FORWARD_DIRECTION ? data.forward : data.backward)
                     {
-                        const NodeID to = facade.GetTarget(edge);
+                        const NodeID to = edge.target;
                         if (to == heapNode.node)
                         {
                             const EdgeWeight edge_weight = data.weight;
@@ -366,6 +369,7 @@ void unpackPath(const FacadeT &facade,
                 const PhantomEndpoints &route_endpoints,
                 std::vector<PathData> &unpacked_path)
 {
+    const util::ScopedRequestPhase phase(util::RequestPhase::Unpacking);
     const auto nodes_number = std::distance(packed_path_begin, packed_path_end);
     BOOST_ASSERT(nodes_number > 0);
 
@@ -484,12 +488,12 @@ std::tuple<EdgeMetric, EdgeDistance> getLoopMetric(const DataFacade<Algorithm> &
         loop_metric = INVALID_EDGE_WEIGHT;
     }
     EdgeDistance loop_distance = MAXIMAL_EDGE_DISTANCE;
-    for (auto edge : facade.GetAdjacentEdgeRange(node))
+    for (const auto &edge : facade.GetAdjacentEdges(node))
     {
-        const auto &data = facade.GetEdgeData(edge);
+        const auto &data = edge.data;
         if (data.forward)
         {
-            const NodeID to = facade.GetTarget(edge);
+            const NodeID to = edge.target;
             if (to == node)
             {
                 EdgeMetric value;
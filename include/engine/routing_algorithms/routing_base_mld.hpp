@@ -6,6 +6,7 @@
 #include "engine/routing_algorithms/routing_base.hpp"
 #include "engine/search_engine_data.hpp"
 
+#include "util/request_phases.hpp"
 #include "util/typedefs.hpp"
 
 #include <boost/assert.hpp>
@@ -404,14 +405,13 @@ void relaxOutgoingEdges(const DataFacade<Algorithm> &facade,
     }
 
     // Boundary edges
-    for (const auto edge : facade.GetBorderEdgeRange(level, heapNode.node))
+    for (const auto &edge : facade.GetBorderEdges(level, heapNode.node))
     {
-        const auto &edge_data = facade.GetEdgeData(edge);
+        const auto &edge_data = edge.data;
 
-        if ((DIRECTION == FORWARD_DIRECTION) ? facade.IsForwardEdge(edge)
-                                             : facade.IsBackwardEdge(edge))
+        if ((DIRECTION == FORWARD_DIRECTION) ? edge.forward : edge.backward)
         {
-            const NodeID to = facade.GetTarget(edge);
+            const NodeID to = edge.target;
 
             if (!facade.ExcludeNode(to) &&
                 checkParentCellRestriction(partition.GetCell(level + 1, to), args...))
@@ -452,6 +452,8 @@ void routingStep(const DataFacade<Algorithm> &facade,
                  const std::vector<NodeID> &force_step_nodes,
                  const Args &...args)
 {
+    CheckCancellation();
+
     const auto heapNode = forward_heap.DeleteMinGetHeapNode();
     const auto weight = heapNode.weight;
 
@@ -681,6 +683,7 @@ void unpackPath(const FacadeT &facade,
                 const PhantomEndpoints &route_endpoints,
                 std::vector<PathData> &unpacked_path)
 {
+    const util::ScopedRequestPhase phase(util::RequestPhase::Unpacking);
     const auto nodes_number = std::distance(packed_path_begin, packed_path_end);
     BOOST_ASSERT(nodes_number > 0);
 
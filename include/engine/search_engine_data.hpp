@@ -5,9 +5,24 @@
 #include "util/query_heap.hpp"
 #include "util/typedefs.hpp"
 
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+
 namespace osrm::engine
 {
 
+// Process-wide statistics over all thread-local query heaps, used to size
+// EngineConfig::max_heap_memory
+struct HeapMemoryStatistics
+{
+    // Largest memory footprint of the query heaps of a thread seen after a request, in bytes
+    static std::atomic<std::size_t> high_water_mark;
+    // Number of times a heap was released because the heaps of its thread grew beyond the limit
+    static std::atomic<std::size_t> trimmed_heaps;
+};
+
 // Algorithm-dependent heaps
 // - CH algorithms use CH heaps
 // - MLD algorithms use MLD heaps
@@ -35,13 +50,13 @@ struct ManyToManyHeapData : HeapData
 template <> struct SearchEngineData<routing_algorithms::ch::Algorithm>
 {
     using QueryHeap = util::
-        QueryHeap<NodeID, NodeID, EdgeWeight, HeapData, util::UnorderedMapStorage<NodeID, int>>;
+        QueryHeap<NodeID, NodeID, EdgeWeight, HeapData, util::ArrayOrMapStorage<NodeID, int>>;
 
     using ManyToManyQueryHeap = util::QueryHeap<NodeID,
                                                 NodeID,
                                                 EdgeWeight,
                                                 ManyToManyHeapData,
-                                                util::UnorderedMapStorage<NodeID, int>>;
+                                                util::ArrayOrMapStorage<NodeID, int>>;
 
     using SearchEngineHeapPtr = std::unique_ptr<QueryHeap>;
 
@@ -57,6 +72,16 @@ template <> struct SearchEngineData<routing_algorithms::ch::Algorithm>
     static thread_local SearchEngineHeapPtr map_matching_forward_heap_1;
     static thread_local SearchEngineHeapPtr map_matching_reverse_heap_1;
 
+    // Index the heaps with flat arrays of size number_of_nodes instead of hash maps.
+    // Faster relaxations and clears, but every thread-local heap holds one int per node.
+    bool use_array_heap_storage = false;
+
+    // Maximal number of threads a single many-to-many search may run on
+    unsigned many_to_many_threads = 1;
+
+    // Memory in bytes the heaps of a thread may keep after a request
+    std::size_t max_heap_memory = std::numeric_limits<std::size_t>::max();
+
     void InitializeOrClearMapMatchingThreadLocalStorage(unsigned number_of_nodes);
 
     void InitializeOrClearFirstThreadLocalStorage(unsigned number_of_nodes);
@@ -66,6 +91,10 @@ template <> struct SearchEngineData<routing_algorithms::ch::Algorithm>
     void InitializeOrClearThirdThreadLocalStorage(unsigned number_of_nodes);
 
     void InitializeOrClearManyToManyThreadLocalStorage(unsigned number_of_nodes);
+
+    // Releases the largest heaps of the calling thread until all of them together hold at most
+    // max_heap_memory bytes, updates HeapMemoryStatistics and returns the bytes they hold then
+    std::size_t TrimThreadLocalStorage(std::size_t max_heap_memory);
 };
 
 struct MultiLayerDijkstraHeapData
@@ -114,11 +143,13 @@ template <> struct SearchEngineData<routing_algorithms::mld::Algorithm>
                                       MultiLayerDijkstraHeapData,
                                       util::TwoLevelStorage<NodeID, int>>;
 
+    // One-to-many searches settle large parts of the overlay graph, where a radix heap is faster
     using ManyToManyQueryHeap = util::QueryHeap<NodeID,
                                                 NodeID,
                                                 EdgeWeight,
                                                 ManyToManyMultiLayerDijkstraHeapData,
-                                                util::TwoLevelStorage<NodeID, int>>;
+                                                util::TwoLevelStorage<NodeID, int>,
+                                                util::IntegerRadixHeap>;
     using MapMatchingQueryHeap = util::QueryHeap<NodeID,
                                                  NodeID,
                                                  EdgeWeight,
@@ -136,6 +167,12 @@ template <> struct SearchEngineData<routing_algorithms::mld::Algorithm>
 
     static thread_local ManyToManyHeapPtr many_to_many_heap;
 
+    // Maximal number of threads a single many-to-many search may run on
+    unsigned many_to_many_threads = 1;
+
+    // Memory in bytes the heaps of a thread may keep after a request
+    std::size_t max_heap_memory = std::numeric_limits<std::size_t>::max();
+
     void InitializeOrClearFirstThreadLocalStorage(unsigned number_of_nodes,
                                                   unsigned number_of_boundary_nodes);
     void InitializeOrClearMapMatchingThreadLocalStorage(unsigned number_of_nodes,
@@ -143,6 +180,26 @@ template <> struct SearchEngineData<routing_algorithms::mld::Algorithm>
 
     void InitializeOrClearManyToManyThreadLocalStorage(unsigned number_of_nodes,
                                                        unsigned number_of_boundary_nodes);
+
+    // Releases the largest heaps of the calling thread until all of them together hold at most
+    // max_heap_memory bytes, updates HeapMemoryStatistics and returns the bytes they hold then
+    std::size_t TrimThreadLocalStorage(std::size_t max_heap_memory);
+};
+
+// Trims the heaps of the calling thread to max_heap_memory once the request that filled them is
+// done, also if it was cancelled or failed with an exception
+template <typename Algorithm> class ScopedHeapTrim
+{
+  public:
+    explicit ScopedHeapTrim(SearchEngineData<Algorithm> &heaps) : heaps(heaps) {}
+
+    ~ScopedHeapTrim() { heaps.TrimThreadLocalStorage(heaps.max_heap_memory); }
+
+    ScopedHeapTrim(const ScopedHeapTrim &) = delete;
+    ScopedHeapTrim &operator=(const ScopedHeapTrim &) = delete;
+
+  private:
+    SearchEngineData<Algorithm> &heaps;
 };
 } // namespace osrm::engine
 
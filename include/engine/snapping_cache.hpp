@@ -0,0 +1,65 @@
+#ifndef OSRM_ENGINE_SNAPPING_CACHE_HPP
+#define OSRM_ENGINE_SNAPPING_CACHE_HPP
+
+#include "engine/facade_cache.hpp"
+#include "engine/phantom_node.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace osrm::engine
+{
+
+// Process-wide counters of all snapping caches, exported on /metrics
+struct SnappingCacheStatistics
+{
+    // Number of coordinates answered from a cache
+    static std::atomic<std::uint64_t> hits;
+    // Number of coordinates that had to be snapped on the R-tree
+    static std::atomic<std::uint64_t> misses;
+};
+
+/**
+ * Remembers the least recently used snapping results, so coordinates that show up in many
+ * requests (depots, stations, ...) are only snapped once.
+ *
+ * Entries are keyed by the coordinate and every parameter that changes the result of snapping:
+ * radius, bearing, approach and snapping type. Coordinates are fixed-point numbers, so a hit
+ * always returns exactly what snapping would have returned on the same facade.
+ */
+class SnappingCache
+{
+  public:
+    explicit SnappingCache(std::size_t capacity);
+
+    std::optional<PhantomCandidateAlternatives> Find(const std::shared_ptr<const void> &facade,
+                                                     const NearestQuery &query,
+                                                     const bool use_all_edges);
+
+    void Insert(const std::shared_ptr<const void> &facade,
+                const NearestQuery &query,
+                const bool use_all_edges,
+                PhantomCandidateAlternatives candidates);
+
+  private:
+    struct Key
+    {
+        NearestQuery query;
+        bool use_all_edges;
+
+        bool operator==(const Key &other) const;
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(const Key &key) const;
+    };
+
+    FacadeCache<Key, PhantomCandidateAlternatives, KeyHash> cache;
+};
+} // namespace osrm::engine
+
+#endif // OSRM_ENGINE_SNAPPING_CACHE_HPP
@@ -13,7 +13,7 @@ struct V8Renderer
 
     void operator()(const osrm::json::String &string) const
     {
-        out = Napi::String::New(env, string.value);
+        out = Napi::String::New(env, string.value.data(), string.value.size());
     }
 
     void operator()(const osrm::json::Number &number) const
@@ -89,9 +89,7 @@ inline bool IsUnsignedInteger(const Napi::Value &value)
 inline void ParseResult(const osrm::Status &result_status, osrm::json::Object &result)
 {
     const auto code_iter = result.values.find("code");
-    const auto end_iter = result.values.end();
-
-    BOOST_ASSERT(code_iter != end_iter);
+    BOOST_ASSERT(code_iter != result.values.end());
 
     if (result_status == osrm::Status::Error)
     {
@@ -100,7 +98,8 @@ inline void ParseResult(const osrm::Status &result_status, osrm::json::Object &r
 
     result.values.erase(code_iter);
     const auto message_iter = result.values.find("message");
-    if (message_iter != end_iter)
+    // erasing invalidates the end iterator of the flat object
+    if (message_iter != result.values.end())
     {
         result.values.erase(message_iter);
     }
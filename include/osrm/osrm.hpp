@@ -39,6 +39,7 @@ namespace osrm
 {
 namespace json = util::json;
 using engine::EngineConfig;
+using engine::api::IsochroneParameters;
 using engine::api::MatchParameters;
 using engine::api::NearestParameters;
 using engine::api::RouteParameters;
@@ -57,6 +58,7 @@ using engine::api::TripParameters;
  *  - Trip: shortest round trip between coordinates
  *  - Match: snaps noisy coordinate traces to the road network
  *  - Tile: vector tiles with internal graph representation
+ *  - Isochrone: area reachable from a coordinate within a travel time (MLD only)
  *
  *  All services take service-specific parameters, fill a JSON object, and return a status code.
  */
@@ -137,6 +139,16 @@ class OSRM final
     Status Tile(const TileParameters &parameters, std::string &result) const;
     Status Tile(const TileParameters &parameters, engine::api::ResultT &result) const;
 
+    /**
+     * Isochrone: area reachable from a coordinate within a travel time
+     *
+     * \param parameters isochrone query specific parameters
+     * \return Status indicating success for the query or failure
+     * \see Status, IsochroneParameters and json::Object
+     */
+    Status Isochrone(const IsochroneParameters &parameters, json::Object &result) const;
+    Status Isochrone(const IsochroneParameters &parameters, engine::api::ResultT &result) const;
+
   private:
     std::unique_ptr<engine::EngineInterface> engine_;
 };
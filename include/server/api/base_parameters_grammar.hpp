@@ -151,9 +151,12 @@ struct BaseParametersGrammar : boost::spirit::qi::grammar<Iterator, Signature>
                                               { return engine::decodePolyline<1000000>(polyline); },
                                               qi::_1)];
 
+        // 'body' leaves the coordinates to the body of a POST request, see parseBody()
         query_rule =
             ((location_rule % ';') | polyline_rule |
-             polyline6_rule)[ph::bind(&engine::api::BaseParameters::coordinates, qi::_r1) = qi::_1];
+             polyline6_rule)[ph::bind(&engine::api::BaseParameters::coordinates, qi::_r1) =
+                                 qi::_1] |
+            qi::lit("body");
 
         radiuses_rule =
             qi::lit("radiuses=") >
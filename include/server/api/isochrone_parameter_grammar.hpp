@@ -0,0 +1,49 @@
+#ifndef ISOCHRONE_PARAMETERS_GRAMMAR_HPP
+#define ISOCHRONE_PARAMETERS_GRAMMAR_HPP
+
+#include "server/api/base_parameters_grammar.hpp"
+#include "engine/api/isochrone_parameters.hpp"
+
+#include <boost/phoenix.hpp>
+#include <boost/spirit/include/qi.hpp>
+
+namespace osrm::server::api
+{
+
+namespace
+{
+namespace ph = boost::phoenix;
+namespace qi = boost::spirit::qi;
+} // namespace
+
+template <typename Iterator = std::string::iterator,
+          typename Signature = void(engine::api::IsochroneParameters &)>
+struct IsochroneParametersGrammar final : public BaseParametersGrammar<Iterator, Signature>
+{
+    using BaseGrammar = BaseParametersGrammar<Iterator, Signature>;
+
+    IsochroneParametersGrammar() : BaseGrammar(root_rule)
+    {
+        output_type.add("polygon", engine::api::IsochroneParameters::OutputType::Polygon)(
+            "edges", engine::api::IsochroneParameters::OutputType::Edges);
+
+        isochrone_rule =
+            (qi::lit("duration=") >
+             BaseGrammar::double_[ph::bind(&engine::api::IsochroneParameters::duration, qi::_r1) =
+                                      qi::_1]) |
+            (qi::lit("output=") >
+             output_type[ph::bind(&engine::api::IsochroneParameters::output, qi::_r1) = qi::_1]);
+
+        root_rule = BaseGrammar::query_rule(qi::_r1) > BaseGrammar::format_rule(qi::_r1) >
+                    -('?' > (isochrone_rule(qi::_r1) | BaseGrammar::base_rule(qi::_r1)) % '&');
+    }
+
+  private:
+    qi::rule<Iterator, Signature> root_rule;
+    qi::rule<Iterator, Signature> isochrone_rule;
+
+    qi::symbols<char, engine::api::IsochroneParameters::OutputType> output_type;
+};
+} // namespace osrm::server::api
+
+#endif
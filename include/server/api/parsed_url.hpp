@@ -4,6 +4,7 @@
 #include "util/coordinate.hpp"
 
 #include <string>
+#include <string_view>
 
 namespace osrm::server::api
 {
@@ -15,6 +16,8 @@ struct ParsedURL final
     std::string profile;
     std::string query;
     std::size_t prefix_length;
+    // Body of a POST request, refers to the request
+    std::string_view body{};
 };
 
 } // namespace osrm::server::api
@@ -0,0 +1,20 @@
+#ifndef SERVER_API_REQUEST_BODY_PARSER_HPP
+#define SERVER_API_REQUEST_BODY_PARSER_HPP
+
+#include "engine/api/base_parameters.hpp"
+#include "engine/api/match_parameters.hpp"
+
+#include <string>
+#include <string_view>
+
+namespace osrm::server::api
+{
+
+// Reads the coordinates and the values per coordinate of a FlatBuffers request body (see
+// fbrequest.fbs) into the parameters, the values of the body replace those of the URL. Returns
+// false and describes the problem in help if the body can not be used.
+bool parseBody(std::string_view body, engine::api::BaseParameters &parameters, std::string &help);
+bool parseBody(std::string_view body, engine::api::MatchParameters &parameters, std::string &help);
+} // namespace osrm::server::api
+
+#endif
@@ -0,0 +1,137 @@
+#ifndef SERVER_COMPUTE_POOL_HPP
+#define SERVER_COMPUTE_POOL_HPP
+
+#include "util/latency_histogram.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace osrm::server
+{
+
+// Priority classes of requests, a class is only started when no higher one is waiting
+enum class RequestPriority : std::uint8_t
+{
+    Interactive,
+    Batch
+};
+
+inline constexpr std::size_t NUMBER_OF_REQUEST_PRIORITIES = 2;
+inline constexpr std::array<std::string_view, NUMBER_OF_REQUEST_PRIORITIES>
+    REQUEST_PRIORITY_NAMES = {"interactive", "batch"};
+
+struct ComputePoolStatistics
+{
+    template <typename T> using PerPriority = std::array<T, NUMBER_OF_REQUEST_PRIORITIES>;
+
+    // Number of compute threads of all pools
+    static std::atomic<std::uint64_t> threads;
+    // Number of tasks waiting for a compute thread
+    static PerPriority<std::atomic<std::uint64_t>> queued;
+    // Sum of the costs of the waiting tasks
+    static PerPriority<std::atomic<std::uint64_t>> queued_cost;
+    // Number of tasks a compute thread is working on
+    static PerPriority<std::atomic<std::uint64_t>> in_flight;
+    // Number of tasks that were not queued because the queue was full
+    static PerPriority<std::atomic<std::uint64_t>> rejected;
+    // Time from posting a task until a compute thread started it
+    static PerPriority<util::LatencyHistogram> wait_durations;
+};
+
+/**
+ * Fixed number of threads that handle the requests, so a slow request does not keep the I/O
+ * threads from accepting connections, reading requests and writing replies.
+ *
+ * Every priority class has its own queue. Tasks of a class are started in the order they were
+ * posted, but only while no task of a higher class is waiting and fewer tasks of the class than
+ * its limit are running. A class can also limit the summed cost of its waiting tasks, then
+ * tasks that do not fit into the queue any more are rejected instead of waiting.
+ *
+ * Tasks that are still queued when the pool is destroyed are dropped.
+ *
+ * A task can split its work with ParallelFor(). It works on the parts itself and posts helpers
+ * that work on them too, but it only waits for the parts that were started. A helper that did
+ * not get a thread before all parts were started never blocks it, so tasks waiting for helpers
+ * can not fill up the pool and wait for each other. Helpers are not counted in
+ * ComputePoolStatistics, which only accounts the posted tasks.
+ */
+class ComputePool
+{
+  public:
+    using Task = std::function<void()>;
+
+    struct Limits
+    {
+        // Number of tasks of the class that may run at the same time, 0 for all threads
+        std::size_t max_in_flight = 0;
+        // Summed cost of the waiting tasks of the class, 0 for no limit. A task is always
+        // queued if no other task of its class is waiting.
+        std::uint64_t max_queued_cost = 0;
+    };
+
+    explicit ComputePool(unsigned number_of_threads);
+    ~ComputePool();
+
+    ComputePool(const ComputePool &) = delete;
+    ComputePool &operator=(const ComputePool &) = delete;
+
+    void SetLimits(RequestPriority priority, const Limits &limits);
+
+    // Returns false if the task was rejected because the queue of its class is full
+    bool Post(Task task,
+              RequestPriority priority = RequestPriority::Interactive,
+              std::uint64_t cost = 1);
+
+    // Calls body for every index from 0 to count on this thread and on up to Size() - 1 helper
+    // tasks of the priority class, which bypass the queue limits. Returns once all calls are
+    // done and rethrows the first exception one of them threw.
+    void ParallelFor(std::size_t count,
+                     const std::function<void(std::size_t)> &body,
+                     RequestPriority priority = RequestPriority::Interactive);
+
+    std::size_t Size() const { return threads.size(); }
+
+  private:
+    struct QueuedTask
+    {
+        Task task;
+        std::uint64_t cost;
+        std::chrono::steady_clock::time_point posted;
+        // helpers of ParallelFor() are left out of ComputePoolStatistics
+        bool helper;
+    };
+
+    struct PriorityClass
+    {
+        Limits limits;
+        std::deque<QueuedTask> queue;
+        std::uint64_t queued_cost = 0;
+        std::size_t in_flight = 0;
+    };
+
+    void Enqueue(Task task, std::size_t priority, std::uint64_t cost, bool helper);
+
+    // Highest class with a waiting task that may be started, needs the lock
+    std::optional<std::size_t> NextPriority() const;
+
+    void Work();
+
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::array<PriorityClass, NUMBER_OF_REQUEST_PRIORITIES> classes;
+    bool stopping = false;
+    std::vector<std::thread> threads;
+};
+} // namespace osrm::server
+
+#endif // SERVER_COMPUTE_POOL_HPP
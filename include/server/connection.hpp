@@ -9,13 +9,17 @@
 #include <boost/array.hpp>
 #include <boost/asio.hpp>
 #include <boost/config.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
 #include <boost/version.hpp>
 
+#include <atomic>
+#include <string>
 #include <vector>
 
 namespace osrm::server
 {
 
+class ComputePool;
 class RequestHandler;
 
 /// Represents a single connection from a client.
@@ -24,6 +28,7 @@ class Connection : public std::enable_shared_from_this<Connection>
   public:
     explicit Connection(boost::asio::io_context &io_context,
                         RequestHandler &handler,
+                        ComputePool &compute_pool,
                         short keepalive_timeout);
     Connection(const Connection &) = delete;
     Connection &operator=(const Connection &) = delete;
@@ -36,9 +41,27 @@ class Connection : public std::enable_shared_from_this<Connection>
   private:
     void handle_read(const boost::system::error_code &e, std::size_t bytes_transferred);
 
+    /// Keep a read pending while the request is handled to notice if the client goes away.
+    void watch_peer();
+
+    /// Handle completion of the read of watch_peer().
+    void handle_peer_read(const boost::system::error_code &e, std::size_t bytes_transferred);
+
+    /// Compress the reply of a handled request if requested and write it, back on the strand.
+    void write_reply(const http::compression_type compression_type);
+
     /// Handle completion of a write operation.
     void handle_write(const boost::system::error_code &e);
 
+    /// Continue reading the body of a request once the client was told to send it.
+    void handle_continue_write(const boost::system::error_code &e);
+
+    /// Compress the next part of the reply and write it as a chunk, appended to output_buffer.
+    void write_next_chunk();
+
+    /// Handle completion of a chunk that was not the last one.
+    void handle_chunk_write(const boost::system::error_code &e);
+
     /// Handle read timeout
     void handle_timeout(boost::system::error_code);
 
@@ -47,15 +70,29 @@ class Connection : public std::enable_shared_from_this<Connection>
     std::vector<char> compress_buffers(const std::vector<char> &uncompressed_data,
                                        const http::compression_type compression_type);
 
+    void start_compression(const http::compression_type compression_type);
+
     boost::asio::strand<boost::asio::io_context::executor_type> strand;
     boost::asio::ip::tcp::socket TCP_socket;
     boost::asio::deadline_timer timer;
     RequestHandler &request_handler;
+    ComputePool &compute_pool;
     RequestParser request_parser;
     boost::array<char, 8192> incoming_data_buffer;
+    // Watching the client while a request is handled: data that arrived meanwhile and whether
+    // the connection was closed, which is read by the compute thread
+    boost::array<char, 8192> peer_buffer;
+    std::size_t peer_bytes = 0;
+    bool handling_request = false;
+    bool watching_peer = false;
+    std::atomic<bool> peer_closed = false;
     http::request current_request;
     http::reply current_reply;
     std::vector<char> compressed_output;
+    // Chunked replies: compressor that appends to compressed_output and the progress in content
+    boost::iostreams::filtering_ostream compression_stream;
+    std::size_t compressed_bytes = 0;
+    std::string chunk_header;
     // Header compression_header;
     std::vector<boost::asio::const_buffer> output_buffer;
     // Keep alive support
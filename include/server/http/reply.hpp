@@ -17,7 +17,8 @@ class reply
     {
         ok = 200,
         bad_request = 400,
-        internal_server_error = 500
+        internal_server_error = 500,
+        service_unavailable = 503
     } status;
 
     std::vector<header> headers;
@@ -27,6 +28,9 @@ class reply
     static reply stock_reply(const status_type status);
     void set_size(const std::size_t size);
     void set_uncompressed_size();
+    // Replaces the Content-Length by chunked transfer encoding and answers with HTTP/1.1
+    void set_chunked();
+    bool chunked;
 
     reply();
 
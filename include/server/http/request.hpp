@@ -10,10 +10,16 @@ namespace osrm::server::http
 
 struct request
 {
+    std::string method;
     std::string uri;
     std::string referrer;
     std::string agent;
     std::string connection;
+    std::string content_type;
+    // Body of requests with a Content-Length, e.g. POST requests
+    std::string body;
+    unsigned http_version_major = 0;
+    unsigned http_version_minor = 0;
     boost::asio::ip::address endpoint;
 };
 } // namespace osrm::server::http
@@ -1,17 +1,42 @@
 #ifndef REQUEST_HANDLER_HPP
 #define REQUEST_HANDLER_HPP
 
+#include "server/compute_pool.hpp"
+#include "server/request_metrics.hpp"
 #include "server/service_handler.hpp"
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
 namespace osrm::server
 {
 
+namespace api
+{
+struct ParsedURL;
+}
+
 namespace http
 {
 class reply;
 struct request;
 } // namespace http
 
+// Priority class of a request and an estimate of the work it takes
+struct RequestClass
+{
+    RequestPriority priority;
+    // number of coordinates of the request
+    std::uint64_t cost;
+};
+
 class RequestHandler
 {
 
@@ -22,10 +47,56 @@ class RequestHandler
 
     void RegisterServiceHandler(std::unique_ptr<ServiceHandlerInterface> service_handler);
 
-    void HandleRequest(const http::request &current_request, http::reply &current_reply);
+    // Accounts the phases of every request to serve them on /metrics and/or to send them in a
+    // Server-Timing header of the reply
+    void EnableMetrics(bool metrics_endpoint, bool server_timing);
+
+    // Gives up the searches of a request once it took longer than the timeout, and if enabled
+    // once the probe passed to HandleRequest reports that the client closed the connection
+    void EnableCancellation(std::optional<std::chrono::milliseconds> request_timeout,
+                            bool cancel_on_disconnect);
+
+    // Whether connections have to watch their client while its request is handled
+    bool CancelsOnDisconnect() const { return cancel_on_disconnect; }
+
+    // Requests of these services are batch requests, all others are interactive
+    void SetBatchServices(std::vector<std::string> services);
+
+    // Runs the queries of batch requests in parallel on the pool, without one they run one
+    // after another on the thread of the request
+    void SetComputePool(ComputePool *compute_pool);
+
+    // Batch requests with more queries are answered with a TooBig error
+    void SetMaxBatchSize(std::size_t max_batch_size);
+
+    // Finds the priority class and the cost of a request before it is queued
+    RequestClass Classify(const http::request &current_request) const;
+
+    // Answers a request whose priority class had no room for it in the queue
+    void Reject(const http::request &current_request,
+                RequestPriority priority,
+                http::reply &current_reply) const;
+
+    void HandleRequest(const http::request &current_request,
+                       http::reply &current_reply,
+                       std::function<bool()> is_disconnected = {});
 
   private:
+    RequestPriority PriorityOf(std::string_view service) const;
+
+    // Answers a /batch/v1/{profile}/{service} request, whose body lists queries of the service
+    engine::Status RunBatch(const api::ParsedURL &parsed_url,
+                            ServiceHandler::ResultT &result) const;
+
     std::unique_ptr<ServiceHandlerInterface> service_handler;
+    std::unique_ptr<RequestMetrics> metrics;
+    bool metrics_endpoint = false;
+    bool server_timing = false;
+    std::optional<std::chrono::milliseconds> request_timeout;
+    bool cancel_on_disconnect = false;
+    std::vector<std::string> batch_services;
+    ComputePool *compute_pool = nullptr;
+    std::size_t max_batch_size = 1000;
 };
 } // namespace osrm::server
 
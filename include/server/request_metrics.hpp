@@ -0,0 +1,56 @@
+#ifndef SERVER_REQUEST_METRICS_HPP
+#define SERVER_REQUEST_METRICS_HPP
+
+#include "engine/cancellation.hpp"
+
+#include "util/latency_histogram.hpp"
+#include "util/request_phases.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace osrm::server
+{
+
+// Latency histograms of every service and request phase. Recording is lock-free, so all
+// request threads can share one instance.
+class RequestMetrics
+{
+  public:
+    // Requests with an invalid URL or an unknown service are accounted to the last entry
+    static constexpr std::array<std::string_view, 9> SERVICES = {
+        "route", "nearest", "table", "match", "trip", "tile", "isochrone", "batch", "invalid"};
+
+    // HTTP status codes of the replies, requests are accounted by service and status
+    static constexpr std::array<unsigned, 4> STATUSES = {200, 400, 503, 500};
+
+    void Record(std::string_view service,
+                unsigned status,
+                std::chrono::nanoseconds total,
+                const util::RequestPhaseDurations &phases);
+
+    // Counts a request whose searches were given up
+    void RecordCancellation(engine::CancellationReason reason);
+
+    // All histograms, counters and gauges in the Prometheus text exposition format
+    std::string RenderPrometheus() const;
+
+    // Value of a Server-Timing header with the duration of every phase in milliseconds
+    static std::string RenderServerTiming(std::chrono::nanoseconds total,
+                                          const util::RequestPhaseDurations &phases);
+
+  private:
+    std::array<std::array<util::LatencyHistogram, STATUSES.size()>, SERVICES.size()> totals;
+    std::array<std::array<util::LatencyHistogram, util::NUMBER_OF_REQUEST_PHASES>,
+               SERVICES.size()>
+        phase_durations;
+    // Cancelled requests by reason, timeouts first
+    std::array<std::atomic<std::uint64_t>, 2> cancellations{};
+};
+} // namespace osrm::server
+
+#endif // SERVER_REQUEST_METRICS_HPP
@@ -4,6 +4,7 @@
 #include "server/http/compression_type.hpp"
 #include "server/http/header.hpp"
 
+#include <cstddef>
 #include <tuple>
 
 namespace osrm::server
@@ -17,6 +18,9 @@ struct request;
 class RequestParser
 {
   public:
+    // Requests with a larger body are invalid
+    static constexpr std::size_t MAX_BODY_SIZE = 64 * 1024 * 1024;
+
     RequestParser();
 
     enum class RequestStatus : char
@@ -29,6 +33,10 @@ class RequestParser
     std::tuple<RequestStatus, http::compression_type>
     parse(http::request &current_request, char *begin, char *end);
 
+    // True once after the header of a request that waits for a 100 Continue before it sends
+    // its body has been parsed
+    bool expects_continue();
+
   private:
     RequestStatus consume(http::request &current_request, const char input);
 
@@ -61,11 +69,14 @@ class RequestParser
         header_name,
         header_value,
         expecting_newline_2,
-        expecting_newline_3
+        expecting_newline_3,
+        body
     } state;
 
     http::header current_header;
     http::compression_type selected_compression;
+    std::size_t content_length;
+    bool expect_continue;
 };
 } // namespace osrm::server
 
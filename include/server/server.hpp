@@ -1,10 +1,13 @@
 #ifndef SERVER_HPP
 #define SERVER_HPP
 
+#include "server/compute_pool.hpp"
 #include "server/connection.hpp"
 #include "server/request_handler.hpp"
 #include "server/service_handler.hpp"
 
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
 #include "util/integer_range.hpp"
 #include "util/log.hpp"
 
@@ -18,7 +21,16 @@
 #include <sys/types.h>
 #endif
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
 #include <memory>
+#include <optional>
 #include <string>
 #include <thread>
 #include <vector>
@@ -33,41 +45,95 @@ class Server
     static std::shared_ptr<Server> CreateServer(std::string &ip_address,
                                                 int ip_port,
                                                 unsigned requested_num_threads,
-                                                short keepalive_timeout)
+                                                unsigned requested_num_io_threads,
+                                                short keepalive_timeout,
+                                                bool listener_per_thread = false,
+                                                bool pin_io_threads = false)
     {
         util::Log() << "http 1.1 compression handled by zlib version " << zlibVersion();
         const unsigned hardware_threads = std::max(1u, std::thread::hardware_concurrency());
-        const unsigned real_num_threads = std::min(hardware_threads, requested_num_threads);
-        return std::make_shared<Server>(ip_address, ip_port, real_num_threads, keepalive_timeout);
+        const unsigned real_num_threads =
+            std::max(1u, std::min(hardware_threads, requested_num_threads));
+        const unsigned real_num_io_threads =
+            std::max(1u, std::min(hardware_threads, requested_num_io_threads));
+#ifndef SO_REUSEPORT
+        if (listener_per_thread)
+        {
+            util::Log(logWARNING) << "SO_REUSEPORT is not supported, all I/O threads share one "
+                                     "listening socket";
+            listener_per_thread = false;
+        }
+#endif
+        return std::make_shared<Server>(ip_address,
+                                        ip_port,
+                                        real_num_threads,
+                                        real_num_io_threads,
+                                        keepalive_timeout,
+                                        listener_per_thread,
+                                        pin_io_threads);
     }
 
+    // Requests are read and replies written by the I/O threads, the requests themselves are
+    // handled by the threads of the compute pool.
+    //
+    // By default the I/O threads share one io_context and one listening socket. With a listener
+    // per thread every I/O thread runs its own io_context with its own SO_REUSEPORT socket, so
+    // the kernel spreads the connections over the threads and they share no event queue.
     explicit Server(const std::string &address,
                     const int port,
+                    const unsigned compute_pool_size,
                     const unsigned thread_pool_size,
-                    const short keepalive_timeout)
+                    const short keepalive_timeout,
+                    const bool listener_per_thread = false,
+                    const bool pin_io_threads = false)
         : thread_pool_size(thread_pool_size), keepalive_timeout(keepalive_timeout),
-          acceptor(io_context), new_connection(std::make_shared<Connection>(
-                                    io_context, request_handler, keepalive_timeout))
+          pin_io_threads(pin_io_threads), compute_pool(compute_pool_size)
     {
-        const auto port_string = std::to_string(port);
+        request_handler.SetComputePool(&compute_pool);
 
-        boost::asio::ip::tcp::resolver resolver(io_context);
+        const auto number_of_listeners = listener_per_thread ? thread_pool_size : 1;
+        for (unsigned i = 0; i < number_of_listeners; ++i)
+        {
+            listeners.push_back(std::make_unique<Listener>());
+        }
+
+        const auto port_string = std::to_string(port);
+        boost::asio::ip::tcp::resolver resolver(listeners.front()->io_context);
         boost::asio::ip::tcp::endpoint endpoint = *resolver.resolve(address, port_string).begin();
 
-        acceptor.open(endpoint.protocol());
+        for (auto &listener : listeners)
+        {
+            auto &acceptor = listener->acceptor;
+            acceptor.open(endpoint.protocol());
 #ifdef SO_REUSEPORT
-        const int option = 1;
-        setsockopt(acceptor.native_handle(), SOL_SOCKET, SO_REUSEPORT, &option, sizeof(option));
+            // only the listeners of one server may share the port, a second osrm-routed on it
+            // has to fail to bind
+            const int option = 1;
+            if (listener_per_thread &&
+                setsockopt(acceptor.native_handle(),
+                           SOL_SOCKET,
+                           SO_REUSEPORT,
+                           &option,
+                           sizeof(option)) != 0)
+            {
+                throw util::exception("Could not set SO_REUSEPORT on the listening socket: " +
+                                      std::string(std::strerror(errno)) + SOURCE_REF);
+            }
 #endif
-        acceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
-        acceptor.bind(endpoint);
-        acceptor.listen();
+            acceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+            acceptor.bind(endpoint);
+            acceptor.listen();
+            // all listeners take the port the first one got for port 0
+            endpoint = acceptor.local_endpoint();
 
-        util::Log() << "Listening on: " << acceptor.local_endpoint();
+            StartAccept(*listener);
+        }
 
-        acceptor.async_accept(
-            new_connection->socket(),
-            boost::bind(&Server::HandleAccept, this, boost::asio::placeholders::error));
+        util::Log() << "Listening on: " << endpoint;
+        if (listeners.size() > 1)
+        {
+            util::Log() << "Listening sockets: " << listeners.size();
+        }
     }
 
     void Run()
@@ -75,8 +141,13 @@ class Server
         std::vector<std::shared_ptr<std::thread>> threads;
         for (unsigned i = 0; i < thread_pool_size; ++i)
         {
+            auto &io_context = listeners[i % listeners.size()]->io_context;
             std::shared_ptr<std::thread> thread = std::make_shared<std::thread>(
                 boost::bind(&boost::asio::io_context::run, &io_context));
+            if (pin_io_threads)
+            {
+                PinToCore(*thread, i);
+            }
             threads.push_back(thread);
         }
         for (const auto &thread : threads)
@@ -85,24 +156,82 @@ class Server
         }
     }
 
-    void Stop() { io_context.stop(); }
+    void Stop()
+    {
+        for (auto &listener : listeners)
+        {
+            listener->io_context.stop();
+        }
+    }
+
+    unsigned short GetPort() const
+    {
+        return listeners.front()->acceptor.local_endpoint().port();
+    }
 
     void RegisterServiceHandler(std::unique_ptr<ServiceHandlerInterface> service_handler_)
     {
         request_handler.RegisterServiceHandler(std::move(service_handler_));
     }
 
+    void EnableMetrics(const bool metrics_endpoint, const bool server_timing)
+    {
+        request_handler.EnableMetrics(metrics_endpoint, server_timing);
+    }
+
+    void EnableCancellation(const std::optional<std::chrono::milliseconds> request_timeout,
+                            const bool cancel_on_disconnect)
+    {
+        request_handler.EnableCancellation(request_timeout, cancel_on_disconnect);
+    }
+
+    // Sorts the requests of the services into the batch priority class and limits the number
+    // of running and waiting requests of every class
+    void EnableScheduling(std::vector<std::string> batch_services,
+                          const ComputePool::Limits &interactive_limits,
+                          const ComputePool::Limits &batch_limits)
+    {
+        request_handler.SetBatchServices(std::move(batch_services));
+        compute_pool.SetLimits(RequestPriority::Interactive, interactive_limits);
+        compute_pool.SetLimits(RequestPriority::Batch, batch_limits);
+    }
+
+    // Limits the number of queries of a /batch request
+    void SetMaxBatchSize(const std::size_t max_batch_size)
+    {
+        request_handler.SetMaxBatchSize(max_batch_size);
+    }
+
   private:
-    void HandleAccept(const boost::system::error_code &e)
+    struct Listener
+    {
+        boost::asio::io_context io_context;
+        boost::asio::ip::tcp::acceptor acceptor{io_context};
+        std::shared_ptr<Connection> new_connection;
+    };
+
+    void StartAccept(Listener &listener)
+    {
+        listener.new_connection = std::make_shared<Connection>(
+            listener.io_context, request_handler, compute_pool, keepalive_timeout);
+        listener.acceptor.async_accept(
+            listener.new_connection->socket(),
+            boost::bind(
+                &Server::HandleAccept, this, std::ref(listener), boost::asio::placeholders::error));
+    }
+
+    void HandleAccept(Listener &listener, const boost::system::error_code &e)
     {
         if (!e)
         {
-            new_connection->start();
-            new_connection =
-                std::make_shared<Connection>(io_context, request_handler, keepalive_timeout);
-            acceptor.async_accept(
-                new_connection->socket(),
-                boost::bind(&Server::HandleAccept, this, boost::asio::placeholders::error));
+            // replies are written at once, waiting for more data only delays kept alive
+            // connections until the client acknowledges the previous reply
+            boost::system::error_code ignore_error;
+            // NOLINTNEXTLINE(bugprone-unused-return-value)
+            listener.new_connection->socket().set_option(boost::asio::ip::tcp::no_delay(true),
+                                                         ignore_error);
+            listener.new_connection->start();
+            StartAccept(listener);
         }
         else
         {
@@ -110,12 +239,30 @@ class Server
         }
     }
 
+    static void PinToCore([[maybe_unused]] std::thread &thread,
+                          [[maybe_unused]] const unsigned index)
+    {
+#ifdef __linux__
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(index % std::max(1u, std::thread::hardware_concurrency()), &cpus);
+        if (pthread_setaffinity_np(thread.native_handle(), sizeof(cpus), &cpus) != 0)
+        {
+            util::Log(logWARNING) << "Could not pin I/O thread " << index << " to a core";
+        }
+#else
+        util::Log(logWARNING) << "Pinning I/O threads to cores is only supported on Linux";
+#endif
+    }
+
     RequestHandler request_handler;
     unsigned thread_pool_size;
     short keepalive_timeout;
-    boost::asio::io_context io_context;
-    boost::asio::ip::tcp::acceptor acceptor;
-    std::shared_ptr<Connection> new_connection;
+    bool pin_io_threads;
+    // every listener has its own io_context, its connections only run on the threads of it
+    std::vector<std::unique_ptr<Listener>> listeners;
+    // destroyed before the I/O contexts and the request handler that its threads may still use
+    ComputePool compute_pool;
 };
 } // namespace osrm::server
 
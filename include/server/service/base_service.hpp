@@ -8,6 +8,7 @@
 #include <variant>
 
 #include <string>
+#include <string_view>
 
 namespace osrm::server::service
 {
@@ -18,8 +19,11 @@ class BaseService
     BaseService(OSRM &routing_machine) : routing_machine(routing_machine) {}
     virtual ~BaseService() = default;
 
-    virtual engine::Status
-    RunQuery(std::size_t prefix_length, std::string &query, osrm::engine::api::ResultT &result) = 0;
+    // The body of a POST request holds the coordinates if the query has 'body' in their place
+    virtual engine::Status RunQuery(std::size_t prefix_length,
+                                    std::string &query,
+                                    std::string_view body,
+                                    osrm::engine::api::ResultT &result) = 0;
 
     virtual unsigned GetVersion() = 0;
 
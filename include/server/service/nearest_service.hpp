@@ -8,6 +8,7 @@
 #include "util/coordinate.hpp"
 
 #include <string>
+#include <string_view>
 
 namespace osrm::server::service
 {
@@ -19,6 +20,7 @@ class NearestService final : public BaseService
 
     engine::Status RunQuery(std::size_t prefix_length,
                             std::string &query,
+                            std::string_view body,
                             osrm::engine::api::ResultT &result) final override;
 
     unsigned GetVersion() final override { return 1; }
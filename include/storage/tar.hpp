@@ -91,6 +91,19 @@ class FileReader
 
     ~FileReader() { mtar_close(&handle); }
 
+    // Checks for optional entries that older files might not contain
+    bool HasEntry(const std::string &name)
+    {
+        mtar_header_t header;
+        auto ret = mtar_find(&handle, name.c_str(), &header);
+        if (ret == MTAR_ENOTFOUND)
+        {
+            return false;
+        }
+        detail::checkMTarError(ret, path, name);
+        return true;
+    }
+
     std::uint64_t ReadElementCount64(const std::string &name)
     {
         std::uint64_t size;
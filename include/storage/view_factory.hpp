@@ -3,9 +3,11 @@
 
 #include "storage/shared_data_index.hpp"
 
+#include "contractor/compressed_query_graph.hpp"
 #include "contractor/contracted_metric.hpp"
 #include "contractor/query_graph.hpp"
 
+#include "customizer/compressed_multi_level_graph.hpp"
 #include "customizer/edge_based_graph.hpp"
 
 #include "extractor/class_data.hpp"
@@ -29,13 +31,13 @@
 
 #include "util/coordinate.hpp"
 #include "util/packed_vector.hpp"
+#include "util/patched_packed_vector.hpp"
 #include "util/range_table.hpp"
 #include "util/static_graph.hpp"
 #include "util/static_rtree.hpp"
 #include "util/typedefs.hpp"
 #include "util/vector_view.hpp"
 
-#include "util/filtered_graph.hpp"
 namespace osrm::storage
 {
 
@@ -65,6 +67,16 @@ util::PackedVectorView<T, Bits> make_packed_vector_view(const SharedDataIndex &i
     return V{packed_internal, std::numeric_limits<std::size_t>::max()};
 }
 
+template <std::size_t Bits>
+util::PatchedPackedVectorView<Bits> make_patched_packed_vector_view(const SharedDataIndex &index,
+                                                                    const std::string &name)
+{
+    auto values = make_packed_vector_view<std::uint64_t, Bits>(index, name + "/values");
+    auto exception_indices = make_vector_view<std::uint32_t>(index, name + "/exception_indices");
+    auto exception_values = make_vector_view<std::uint64_t>(index, name + "/exception_values");
+    return util::PatchedPackedVectorView<Bits>{values, exception_indices, exception_values};
+}
+
 inline auto make_name_table_view(const SharedDataIndex &index, const std::string &name)
 {
     auto blocks = make_vector_view<extractor::NameTableView::IndexedData::BlockReference>(
@@ -232,12 +244,63 @@ inline auto make_entry_classes_view(const SharedDataIndex &index, const std::str
     return make_vector_view<util::guidance::EntryClass>(index, name);
 }
 
+inline auto make_phast_sweep_view(const SharedDataIndex &index, const std::string &name)
+{
+    auto nodes = make_vector_view<NodeID>(index, name + "/nodes");
+    auto positions = make_vector_view<std::uint32_t>(index, name + "/positions");
+    auto first_arc = make_vector_view<std::uint32_t>(index, name + "/first_arc");
+    auto arcs = make_vector_view<contractor::PhastSweepView::Arc>(index, name + "/arcs");
+
+    return contractor::PhastSweepView{nodes, positions, first_arc, arcs};
+}
+
+inline auto make_query_graph_view(const SharedDataIndex &index, const std::string &name)
+{
+    auto node_list =
+        make_vector_view<contractor::QueryGraphView::NodeArrayEntry>(index, name + "/node_array");
+    auto edge_list =
+        make_vector_view<contractor::QueryGraphView::EdgeArrayEntry>(index, name + "/edge_array");
+
+    return contractor::QueryGraphView{node_list, edge_list};
+}
+
+inline auto make_compressed_query_graph_view(const SharedDataIndex &index,
+                                             const std::string &name)
+{
+    using Graph = contractor::CompressedQueryGraphView;
+    auto node_list = make_vector_view<Graph::NodeArrayEntry>(index, name + "/node_array");
+    auto targets = make_patched_packed_vector_view<Graph::TARGET_BITS>(index, name + "/targets");
+    auto turn_ids = make_patched_packed_vector_view<Graph::TURN_ID_BITS>(index, name + "/turn_ids");
+    auto weights = make_patched_packed_vector_view<Graph::WEIGHT_BITS>(index, name + "/weights");
+    auto durations =
+        make_patched_packed_vector_view<Graph::DURATION_BITS>(index, name + "/durations");
+    auto distances =
+        make_patched_packed_vector_view<Graph::DISTANCE_BITS>(index, name + "/distances");
+
+    return Graph{node_list, targets, turn_ids, weights, durations, distances};
+}
+
+// Datasets contracted with --compress-graph only have the compressed graph
+inline bool has_compressed_query_graph(const SharedDataIndex &index, const std::string &name)
+{
+    bool result = false;
+    index.List(name + "/compressed_graph/",
+               boost::make_function_output_iterator([&](const auto &) { result = true; }));
+    return result;
+}
+
 inline auto make_contracted_metric_view(const SharedDataIndex &index, const std::string &name)
 {
-    auto node_list = make_vector_view<contractor::QueryGraphView::NodeArrayEntry>(
-        index, name + "/contracted_graph/node_array");
-    auto edge_list = make_vector_view<contractor::QueryGraphView::EdgeArrayEntry>(
-        index, name + "/contracted_graph/edge_array");
+    contractor::QueryGraphView graph;
+    contractor::CompressedQueryGraphView compressed_graph;
+    if (has_compressed_query_graph(index, name))
+    {
+        compressed_graph = make_compressed_query_graph_view(index, name + "/compressed_graph");
+    }
+    else
+    {
+        graph = make_query_graph_view(index, name + "/contracted_graph");
+    }
 
     std::vector<util::vector_view<bool>> edge_filter;
     index.List(name + "/exclude",
@@ -245,7 +308,20 @@ inline auto make_contracted_metric_view(const SharedDataIndex &index, const std:
                    [&](const auto &filter_name)
                    { edge_filter.push_back(make_vector_view<bool>(index, filter_name)); }));
 
-    return contractor::ContractedMetricView{{node_list, edge_list}, std::move(edge_filter)};
+    // PHAST sweeps are optional, the directories are listed in no particular order
+    std::vector<std::string> phast_prefix_names;
+    index.List(name + "/phast/", std::back_inserter(phast_prefix_names));
+    std::vector<contractor::PhastSweepView> phast_sweeps;
+    for (const auto exclude_index : util::irange<std::size_t>(0, phast_prefix_names.size()))
+    {
+        phast_sweeps.push_back(
+            make_phast_sweep_view(index, name + "/phast/" + std::to_string(exclude_index)));
+    }
+
+    return contractor::ContractedMetricView{std::move(graph),
+                                            std::move(edge_filter),
+                                            std::move(phast_sweeps),
+                                            std::move(compressed_graph)};
 }
 
 inline auto make_partition_view(const SharedDataIndex &index, const std::string &name)
@@ -339,6 +415,35 @@ inline auto make_multi_level_graph_view(const SharedDataIndex &index, const std:
                                                     is_backward_edge);
 }
 
+inline auto make_compressed_multi_level_graph_view(const SharedDataIndex &index,
+                                                   const std::string &name)
+{
+    using Graph = customizer::CompressedMultiLevelEdgeBasedGraphView;
+    auto node_list = make_vector_view<Graph::NodeArrayEntry>(index, name + "/node_array");
+    auto targets = make_patched_packed_vector_view<Graph::TARGET_BITS>(index, name + "/targets");
+    auto turn_ids = make_patched_packed_vector_view<Graph::TURN_ID_BITS>(index, name + "/turn_ids");
+    auto node_to_offset =
+        make_vector_view<Graph::EdgeOffset>(index, name + "/node_to_edge_offset");
+    auto node_weights =
+        make_patched_packed_vector_view<Graph::WEIGHT_BITS>(index, name + "/node_weights");
+    auto node_durations =
+        make_patched_packed_vector_view<Graph::DURATION_BITS>(index, name + "/node_durations");
+    auto node_distances =
+        make_patched_packed_vector_view<Graph::DISTANCE_BITS>(index, name + "/node_distances");
+
+    return Graph{
+        node_list, targets, turn_ids, node_to_offset, node_weights, node_durations, node_distances};
+}
+
+// Datasets customized with --compress-graph only have the compressed graph
+inline bool has_compressed_multi_level_graph(const SharedDataIndex &index, const std::string &name)
+{
+    bool result = false;
+    index.List(name + "/",
+               boost::make_function_output_iterator([&](const auto &) { result = true; }));
+    return result;
+}
+
 inline auto make_maneuver_overrides_views(const SharedDataIndex &index, const std::string &name)
 {
     auto maneuver_overrides =
@@ -349,18 +454,12 @@ inline auto make_maneuver_overrides_views(const SharedDataIndex &index, const st
     return std::make_tuple(maneuver_overrides, maneuver_override_node_sequences);
 }
 
-inline auto make_filtered_graph_view(const SharedDataIndex &index,
-                                     const std::string &name,
-                                     const std::size_t exclude_index)
+inline auto make_edge_filter_view(const SharedDataIndex &index,
+                                  const std::string &name,
+                                  const std::size_t exclude_index)
 {
-    auto exclude_prefix = name + "/exclude/" + std::to_string(exclude_index);
-    auto edge_filter = make_vector_view<bool>(index, exclude_prefix + "/edge_filter");
-    auto node_list = make_vector_view<contractor::QueryGraphView::NodeArrayEntry>(
-        index, name + "/contracted_graph/node_array");
-    auto edge_list = make_vector_view<contractor::QueryGraphView::EdgeArrayEntry>(
-        index, name + "/contracted_graph/edge_array");
-
-    return util::FilteredGraphView<contractor::QueryGraphView>({node_list, edge_list}, edge_filter);
+    return make_vector_view<bool>(
+        index, name + "/exclude/" + std::to_string(exclude_index) + "/edge_filter");
 }
 } // namespace osrm::storage
 
@@ -42,6 +42,10 @@ template <typename HeapData, int Arity, typename Comparator = std::less<HeapData
 
     void clear() { heap.clear(); }
 
+    size_t capacity() const { return heap.capacity(); }
+
+    void shrink_to_fit() { heap.shrink_to_fit(); }
+
     template <typename ReorderHandler> void pop(ReorderHandler &&reorderHandler)
     {
         BOOST_ASSERT(!heap.empty());
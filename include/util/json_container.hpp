@@ -31,8 +31,15 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef JSON_CONTAINER_HPP
 #define JSON_CONTAINER_HPP
 
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory_resource>
+#include <stdexcept>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -44,6 +51,80 @@ namespace osrm::util::json
 struct Object;
 struct Array;
 
+namespace detail
+{
+inline thread_local std::pmr::memory_resource *memory_resource = nullptr;
+} // namespace detail
+
+/**
+ * Makes the JSON containers created on this thread allocate from the given memory resource
+ * until it is destroyed, e.g. from a std::pmr::monotonic_buffer_resource that frees a whole
+ * response at once. Containers keep the resource they were created with, so they have to be
+ * destroyed before the resource is.
+ */
+class ScopedMemoryResource
+{
+  public:
+    explicit ScopedMemoryResource(std::pmr::memory_resource *resource)
+        : previous(detail::memory_resource)
+    {
+        detail::memory_resource = resource;
+    }
+
+    ~ScopedMemoryResource() { detail::memory_resource = previous; }
+
+    ScopedMemoryResource(const ScopedMemoryResource &) = delete;
+    ScopedMemoryResource &operator=(const ScopedMemoryResource &) = delete;
+
+  private:
+    std::pmr::memory_resource *previous;
+};
+
+/**
+ * Allocator of the JSON containers. Unlike std::pmr::polymorphic_allocator it picks up the
+ * memory resource of the thread when it is created and moves along with the container.
+ */
+template <typename T> class Allocator
+{
+  public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    Allocator() noexcept
+        : resource(detail::memory_resource ? detail::memory_resource
+                                           : std::pmr::new_delete_resource())
+    {
+    }
+
+    template <typename U> Allocator(const Allocator<U> &other) noexcept : resource(other.resource)
+    {
+    }
+
+    T *allocate(const std::size_t n)
+    {
+        return static_cast<T *>(resource->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *pointer, const std::size_t n)
+    {
+        resource->deallocate(pointer, n * sizeof(T), alignof(T));
+    }
+
+    // a copy might outlive the resource of the original, e.g. the arena of a request
+    Allocator select_on_container_copy_construction() const { return {}; }
+
+    template <typename U> bool operator==(const Allocator<U> &other) const noexcept
+    {
+        return resource == other.resource || resource->is_equal(*other.resource);
+    }
+
+  private:
+    template <typename> friend class Allocator;
+
+    std::pmr::memory_resource *resource;
+};
+
 /**
  * Typed string wrapper.
  *
@@ -51,10 +132,13 @@ struct Array;
  */
 struct String
 {
+    using value_type = std::basic_string<char, std::char_traits<char>, Allocator<char>>;
+
     String() = default;
     String(const char *value_) : value{value_} {}
-    String(std::string value_) : value{std::move(value_)} {}
-    std::string value;
+    String(std::string_view value_) : value{value_} {}
+    String(const std::string &value_) : value{value_} {}
+    value_type value;
 };
 
 /**
@@ -97,6 +181,107 @@ struct Null
  */
 using Value = std::variant<String, Number, Object, Array, True, False, Null>;
 
+/**
+ * Key-value pairs in insertion order with the interface of a std::unordered_map. Objects only
+ * have a handful of keys, so a linear search beats hashing and all pairs share one allocation.
+ */
+template <typename T> class FlatMap
+{
+  public:
+    using key_type = std::string_view;
+    using mapped_type = T;
+    using value_type = std::pair<key_type, mapped_type>;
+    using container_type = std::vector<value_type, Allocator<value_type>>;
+    using size_type = typename container_type::size_type;
+    using iterator = typename container_type::iterator;
+    using const_iterator = typename container_type::const_iterator;
+
+    FlatMap() = default;
+
+    FlatMap(std::initializer_list<value_type> init)
+    {
+        values.reserve(init.size());
+        for (const auto &key_value : init)
+        {
+            emplace(key_value.first, key_value.second);
+        }
+    }
+
+    iterator begin() { return values.begin(); }
+    iterator end() { return values.end(); }
+    const_iterator begin() const { return values.begin(); }
+    const_iterator end() const { return values.end(); }
+    const_iterator cbegin() const { return values.cbegin(); }
+    const_iterator cend() const { return values.cend(); }
+
+    size_type size() const { return values.size(); }
+    bool empty() const { return values.empty(); }
+    void reserve(const size_type count) { values.reserve(count); }
+
+    iterator find(const key_type key)
+    {
+        return std::find_if(values.begin(),
+                            values.end(),
+                            [key](const value_type &key_value) { return key_value.first == key; });
+    }
+
+    const_iterator find(const key_type key) const
+    {
+        return std::find_if(values.begin(),
+                            values.end(),
+                            [key](const value_type &key_value) { return key_value.first == key; });
+    }
+
+    size_type count(const key_type key) const { return find(key) == end() ? 0 : 1; }
+
+    mapped_type &at(const key_type key)
+    {
+        const auto iter = find(key);
+        if (iter == end())
+        {
+            throw std::out_of_range("No such key in JSON object");
+        }
+        return iter->second;
+    }
+
+    const mapped_type &at(const key_type key) const
+    {
+        const auto iter = find(key);
+        if (iter == end())
+        {
+            throw std::out_of_range("No such key in JSON object");
+        }
+        return iter->second;
+    }
+
+    mapped_type &operator[](const key_type key)
+    {
+        const auto iter = find(key);
+        if (iter == end())
+        {
+            return values.emplace_back(key, mapped_type{}).second;
+        }
+        return iter->second;
+    }
+
+    // Like std::unordered_map::emplace this keeps the value of an existing key
+    template <typename Arg> std::pair<iterator, bool> emplace(const key_type key, Arg &&arg)
+    {
+        const auto iter = find(key);
+        if (iter != end())
+        {
+            return {iter, false};
+        }
+        values.emplace_back(key, std::forward<Arg>(arg));
+        return {std::prev(values.end()), true};
+    }
+
+    iterator erase(const_iterator position) { return values.erase(position); }
+
+  private:
+    container_type values;
+};
+
 /**
  * Typed Object.
  *
@@ -104,7 +289,7 @@ using Value = std::variant<String, Number, Object, Array, True, False, Null>;
  */
 struct Object
 {
-    std::unordered_map<std::string_view, Value> values;
+    FlatMap<Value> values;
 };
 
 /**
@@ -114,7 +299,7 @@ struct Object
  */
 struct Array
 {
-    std::vector<Value> values;
+    std::vector<Value, Allocator<Value>> values;
 };
 
 } // namespace osrm::util::json
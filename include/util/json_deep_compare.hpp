@@ -23,8 +23,8 @@ struct Comparator
         bool is_same = lhs.value == rhs.value;
         if (!is_same)
         {
-            reason = lhs_path + " (= \"" + lhs.value + "\") != " + rhs_path + " (= \"" + rhs.value +
-                     "\")";
+            reason = lhs_path + " (= \"" + std::string(lhs.value) + "\") != " + rhs_path +
+                     " (= \"" + std::string(rhs.value) + "\")";
         }
         return is_same;
     }
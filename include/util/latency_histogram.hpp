@@ -0,0 +1,88 @@
+#ifndef OSRM_UTIL_LATENCY_HISTOGRAM_HPP
+#define OSRM_UTIL_LATENCY_HISTOGRAM_HPP
+
+#include "util/integer_range.hpp"
+
+#include <boost/assert.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+namespace osrm::util
+{
+
+/**
+ * Histogram of durations with fixed buckets. Unlike TimedHistogram it takes no lock, every
+ * bucket is a relaxed atomic counter, so a snapshot taken during updates can miss the
+ * measurements that are recorded at the same time.
+ */
+class LatencyHistogram
+{
+  public:
+    // Upper bounds of the buckets in seconds, the last bucket is unbounded
+    static constexpr std::array<double, 15> BUCKET_BOUNDS = {
+        0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5,
+        5};
+
+    void Record(const std::chrono::nanoseconds duration)
+    {
+        const auto seconds = std::chrono::duration<double>(duration).count();
+        const auto bucket =
+            std::lower_bound(BUCKET_BOUNDS.begin(), BUCKET_BOUNDS.end(), seconds) -
+            BUCKET_BOUNDS.begin();
+        counts[bucket].fetch_add(1, std::memory_order_relaxed);
+        total_nanoseconds.fetch_add(duration.count(), std::memory_order_relaxed);
+    }
+
+    std::uint64_t Count() const
+    {
+        std::uint64_t count = 0;
+        for (const auto &bucket_count : counts)
+        {
+            count += bucket_count.load(std::memory_order_relaxed);
+        }
+        return count;
+    }
+
+    // Appends the histogram in the Prometheus text format. The labels are a non-empty list like
+    // service="route",phase="search" and the caller writes the HELP and TYPE lines.
+    void RenderPrometheus(std::string &out, std::string_view name, std::string_view labels) const
+    {
+        BOOST_ASSERT(!labels.empty());
+        auto inserter = std::back_inserter(out);
+
+        std::uint64_t cumulative_count = 0;
+        for (const auto bucket : irange<std::size_t>(0, BUCKET_BOUNDS.size()))
+        {
+            cumulative_count += counts[bucket].load(std::memory_order_relaxed);
+            fmt::format_to(inserter,
+                           "{}_bucket{{{},le=\"{}\"}} {}\n",
+                           name,
+                           labels,
+                           BUCKET_BOUNDS[bucket],
+                           cumulative_count);
+        }
+        cumulative_count += counts.back().load(std::memory_order_relaxed);
+        fmt::format_to(
+            inserter, "{}_bucket{{{},le=\"+Inf\"}} {}\n", name, labels, cumulative_count);
+
+        const auto total_seconds = total_nanoseconds.load(std::memory_order_relaxed) / 1e9;
+        fmt::format_to(inserter, "{}_sum{{{}}} {}\n", name, labels, total_seconds);
+        fmt::format_to(inserter, "{}_count{{{}}} {}\n", name, labels, cumulative_count);
+    }
+
+  private:
+    std::array<std::atomic<std::uint64_t>, BUCKET_BOUNDS.size() + 1> counts{};
+    std::atomic<std::uint64_t> total_nanoseconds{0};
+};
+} // namespace osrm::util
+
+#endif
@@ -0,0 +1,126 @@
+#ifndef OSRM_UTIL_PATCHED_PACKED_VECTOR_HPP
+#define OSRM_UTIL_PATCHED_PACKED_VECTOR_HPP
+
+#include "util/packed_vector.hpp"
+#include "util/vector_view.hpp"
+
+#include "storage/shared_memory_ownership.hpp"
+#include "storage/tar_fwd.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+namespace osrm::util
+{
+namespace detail
+{
+template <std::size_t Bits, storage::Ownership Ownership> class PatchedPackedVector;
+} // namespace detail
+
+namespace serialization
+{
+template <std::size_t Bits, storage::Ownership Ownership>
+inline void read(storage::tar::FileReader &reader,
+                 const std::string &name,
+                 detail::PatchedPackedVector<Bits, Ownership> &vec);
+
+template <std::size_t Bits, storage::Ownership Ownership>
+inline void write(storage::tar::FileWriter &writer,
+                  const std::string &name,
+                  const detail::PatchedPackedVector<Bits, Ownership> &vec);
+} // namespace serialization
+
+// Maps signed differences to unsigned integers, small magnitudes to small values
+inline std::uint64_t zigzagEncode(const std::int64_t value)
+{
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+inline std::int64_t zigzagDecode(const std::uint64_t value)
+{
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+namespace detail
+{
+// Stores unsigned integers in Bits bits each. Values that do not fit are replaced by an escape
+// code and kept in a sorted list of exceptions ("patched" packing). This allows to choose the
+// width for the common values without losing the rare large ones.
+template <std::size_t Bits, storage::Ownership Ownership> class PatchedPackedVector
+{
+    template <typename T> using Vector = util::ViewOrVector<T, Ownership>;
+
+  public:
+    static constexpr std::uint64_t ESCAPE = (std::uint64_t{1} << Bits) - 1;
+
+    PatchedPackedVector() = default;
+
+    PatchedPackedVector(PackedVector<std::uint64_t, Bits, Ownership> packed_,
+                        Vector<std::uint32_t> exception_indices_,
+                        Vector<std::uint64_t> exception_values_)
+        : packed(std::move(packed_)), exception_indices(std::move(exception_indices_)),
+          exception_values(std::move(exception_values_))
+    {
+        BOOST_ASSERT(exception_indices.size() == exception_values.size());
+    }
+
+    std::uint64_t operator[](const std::size_t index) const
+    {
+        const std::uint64_t value = packed[index];
+        if (value != ESCAPE)
+        {
+            return value;
+        }
+        return GetException(index);
+    }
+
+    void push_back(const std::uint64_t value)
+    {
+        if (value >= ESCAPE)
+        {
+            exception_indices.push_back(packed.size());
+            exception_values.push_back(value);
+            packed.push_back(ESCAPE);
+        }
+        else
+        {
+            packed.push_back(value);
+        }
+    }
+
+    void reserve(const std::size_t capacity) { packed.reserve(capacity); }
+
+    std::size_t GetNumberOfExceptions() const { return exception_values.size(); }
+
+    friend void serialization::read<Bits, Ownership>(storage::tar::FileReader &reader,
+                                                     const std::string &name,
+                                                     PatchedPackedVector &vec);
+    friend void serialization::write<Bits, Ownership>(storage::tar::FileWriter &writer,
+                                                      const std::string &name,
+                                                      const PatchedPackedVector &vec);
+
+  private:
+    std::uint64_t GetException(const std::size_t index) const
+    {
+        const auto position =
+            std::lower_bound(exception_indices.begin(), exception_indices.end(), index);
+        BOOST_ASSERT(position != exception_indices.end() && *position == index);
+        return exception_values[std::distance(exception_indices.begin(), position)];
+    }
+
+    PackedVector<std::uint64_t, Bits, Ownership> packed;
+    Vector<std::uint32_t> exception_indices;
+    Vector<std::uint64_t> exception_values;
+};
+} // namespace detail
+
+template <std::size_t Bits>
+using PatchedPackedVector = detail::PatchedPackedVector<Bits, storage::Ownership::Container>;
+template <std::size_t Bits>
+using PatchedPackedVectorView = detail::PatchedPackedVector<Bits, storage::Ownership::View>;
+} // namespace osrm::util
+
+#endif
@@ -5,6 +5,7 @@
 #include <boost/heap/d_ary_heap.hpp>
 
 #include "d_ary_heap.hpp"
+#include "radix_heap.hpp"
 #include <algorithm>
 #include <limits>
 #include <optional>
@@ -25,6 +26,11 @@ template <typename NodeID, typename Key> class ArrayStorage
 
     void Clear() {}
 
+    // The positions array is sized once for the graph and does not grow with the search space
+    std::size_t MemoryUsage() const { return 0; }
+
+    void ReleaseMemory() {}
+
   private:
     std::vector<Key> positions;
 };
@@ -54,10 +60,69 @@ template <typename NodeID, typename Key> class UnorderedMapStorage
 
     void Clear() { nodes.clear(); }
 
+    // Approximation: one pointer per bucket plus the node allocated for each entry
+    std::size_t MemoryUsage() const
+    {
+        using Entry = typename std::unordered_map<NodeID, Key>::value_type;
+        return nodes.bucket_count() * sizeof(void *) +
+               nodes.size() * (sizeof(Entry) + 2 * sizeof(void *));
+    }
+
+    void ReleaseMemory()
+    {
+        std::unordered_map<NodeID, Key>().swap(nodes);
+        nodes.rehash(1000);
+    }
+
   private:
     std::unordered_map<NodeID, Key> nodes;
 };
 
+// Keeps the node positions either in a flat array indexed by node id or in a hash map, which one
+// is decided at construction time. The array has O(1) lookups and an O(1) Clear(): positions left
+// over from previous queries are rejected by QueryHeap because they don't point to an inserted
+// node with the same id. The price is one Key per node of the graph, for every heap.
+template <typename NodeID, typename Key> class ArrayOrMapStorage
+{
+  public:
+    explicit ArrayOrMapStorage(std::size_t number_of_nodes, bool use_array = false)
+        : number_of_nodes(number_of_nodes), use_array(use_array),
+          array(use_array ? number_of_nodes : 0), map(number_of_nodes)
+    {
+    }
+
+    Key &operator[](const NodeID node) { return use_array ? array[node] : map[node]; }
+
+    Key peek_index(const NodeID node) const
+    {
+        return use_array ? array.peek_index(node) : map.peek_index(node);
+    }
+
+    void Clear()
+    {
+        if (!use_array)
+        {
+            map.Clear();
+        }
+    }
+
+    std::size_t MemoryUsage() const { return map.MemoryUsage(); }
+
+    void ReleaseMemory() { map.ReleaseMemory(); }
+
+    // Whether this storage can be reused for a graph with `nodes` nodes in the given mode
+    bool IsCompatible(std::size_t nodes, bool array_requested) const
+    {
+        return use_array == array_requested && (!use_array || nodes <= number_of_nodes);
+    }
+
+  private:
+    std::size_t number_of_nodes;
+    bool use_array;
+    ArrayStorage<NodeID, Key> array;
+    UnorderedMapStorage<NodeID, Key> map;
+};
+
 template <typename NodeID,
           typename Key,
           template <typename N, typename K> class BaseIndexStorage = UnorderedMapStorage,
@@ -113,17 +178,32 @@ class TwoLevelStorage
         overlay.Clear();
     }
 
+    std::size_t MemoryUsage() const { return base.MemoryUsage() + overlay.MemoryUsage(); }
+
+    void ReleaseMemory()
+    {
+        base.ReleaseMemory();
+        overlay.ReleaseMemory();
+    }
+
   private:
     const std::size_t number_of_overlay_nodes;
     BaseIndexStorage<NodeID, Key> base;
     OverlayIndexStorage<NodeID, Key> overlay;
 };
 
+// Heap containers for QueryHeap, the 4-ary heap is a good fit for every search. The radix heap
+// needs integer weights and is faster for searches that settle many nodes in weight order, see
+// RadixHeap for the details.
+template <typename HeapData> using QuaternaryHeap = DAryHeap<HeapData, 4>;
+template <typename HeapData> using IntegerRadixHeap = RadixHeap<HeapData>;
+
 template <typename NodeID,
           typename Key,
           typename Weight,
           typename Data,
-          typename IndexStorage = ArrayStorage<NodeID, NodeID>>
+          typename IndexStorage = ArrayStorage<NodeID, NodeID>,
+          template <typename> class HeapContainerT = QuaternaryHeap>
 class QueryHeap
 {
   private:
@@ -141,7 +221,7 @@ class QueryHeap
             return weight < other.weight;
         }
     };
-    using HeapContainer = DAryHeap<HeapData, 4>;
+    using HeapContainer = HeapContainerT<HeapData>;
     using HeapHandle = typename HeapContainer::HeapHandle;
 
   public:
@@ -170,6 +250,26 @@ class QueryHeap
 
     std::size_t Size() const { return heap.size(); }
 
+    // Bytes held for the search space: inserted nodes, the heap itself and the growing part of
+    // the index storage. Capacity is kept across Clear() calls, so this is the largest search
+    // space since construction or the last ReleaseMemory().
+    std::size_t MemoryUsage() const
+    {
+        return inserted_nodes.capacity() * sizeof(HeapNode) +
+               heap.capacity() * sizeof(HeapData) + node_index.MemoryUsage();
+    }
+
+    // Clears the heap and gives the memory grown by previous searches back to the allocator
+    void ReleaseMemory()
+    {
+        Clear();
+        inserted_nodes.shrink_to_fit();
+        heap.shrink_to_fit();
+        node_index.ReleaseMemory();
+    }
+
+    const IndexStorage &GetIndexStorage() const { return node_index; }
+
     bool Empty() const { return 0 == Size(); }
 
     void Insert(NodeID node, Weight weight, const Data &data)
@@ -191,13 +291,20 @@ class QueryHeap
     void checkInvariants()
     {
 #ifndef NDEBUG
-        for (size_t handle = 0; handle < heap.size(); ++handle)
+        std::size_t number_in_heap = 0;
+        for (std::size_t index = 0; index < inserted_nodes.size(); ++index)
         {
-            auto &in_heap = heap[handle];
-            auto &inserted = inserted_nodes[in_heap.index];
+            const auto &inserted = inserted_nodes[index];
+            if (inserted.handle == HeapContainer::INVALID_HANDLE)
+            {
+                continue;
+            }
+            const auto &in_heap = heap[inserted.handle];
             BOOST_ASSERT(in_heap.weight == inserted.weight);
-            BOOST_ASSERT(inserted.handle == handle);
+            BOOST_ASSERT(static_cast<std::size_t>(in_heap.index) == index);
+            ++number_in_heap;
         }
+        BOOST_ASSERT(number_in_heap == heap.size());
 #endif // !NDEBUG
     }
 
@@ -0,0 +1,234 @@
+#ifndef OSRM_UTIL_RADIX_HEAP_HPP
+#define OSRM_UTIL_RADIX_HEAP_HPP
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace osrm::util
+{
+
+// Maps the `weight` member of the heap data to an unsigned key with the same order
+struct RadixWeightKey
+{
+    template <typename HeapData> auto operator()(const HeapData &data) const
+    {
+        return toKey(data.weight);
+    }
+
+  private:
+    template <typename T> static auto toKey(const T &weight)
+    {
+        if constexpr (std::is_integral_v<T>)
+        {
+            using Key = std::make_unsigned_t<T>;
+            // flipping the sign bit keeps negative weights in front of positive ones
+            constexpr Key SIGN_BIT = std::is_signed_v<T> ? Key{1} << (sizeof(T) * 8 - 1) : 0;
+            return static_cast<Key>(static_cast<Key>(weight) ^ SIGN_BIT);
+        }
+        else
+        {
+            static_assert(std::is_integral_v<typename T::value_type>,
+                          "radix heaps need integer weights");
+            return toKey(static_cast<typename T::value_type>(weight));
+        }
+    }
+};
+
+/**
+ * Radix heap with the interface of DAryHeap, usable as the heap container of QueryHeap.
+ *
+ * Elements are kept in buckets by the highest bit in which their key differs from the key of the
+ * last removed minimum, so pushes and decreases are O(1) and every element is moved to a lower
+ * bucket at most once per bit of the key when a minimum is removed. This only pays off for
+ * monotone searches like Dijkstra, where no key is smaller than the last removed one. A smaller
+ * key is still handled correctly, but makes the heap redistribute all of its elements.
+ *
+ * Elements with equal keys are not ordered by their index, so ties can be settled in a different
+ * order than with DAryHeap.
+ */
+template <typename HeapData, typename KeyOf = RadixWeightKey> class RadixHeap
+{
+    using Key = decltype(KeyOf{}(std::declval<const HeapData &>()));
+
+  public:
+    using HeapHandle = std::size_t;
+
+    static constexpr HeapHandle INVALID_HANDLE = std::numeric_limits<std::size_t>::max();
+
+  public:
+    // Bucket 0 holds the current minimum whenever the heap is not empty
+    const HeapData &top() const
+    {
+        BOOST_ASSERT(!buckets[0].empty());
+        return buckets[0].back();
+    }
+
+    std::size_t size() const { return number_of_elements; }
+
+    bool empty() const { return number_of_elements == 0; }
+
+    const HeapData &operator[](HeapHandle handle) const
+    {
+        return buckets[handle % NUMBER_OF_BUCKETS][handle / NUMBER_OF_BUCKETS];
+    }
+
+    template <typename ReorderHandler>
+    void emplace(HeapData &&data, ReorderHandler &&reorderHandler)
+    {
+        ++number_of_elements;
+        push(std::forward<HeapData>(data), reorderHandler);
+    }
+
+    template <typename ReorderHandler>
+    void decrease(HeapHandle handle, HeapData &&data, ReorderHandler &&reorderHandler)
+    {
+        BOOST_ASSERT(KeyOf{}(data) <= KeyOf{}((*this)[handle]));
+        remove(handle, reorderHandler);
+        push(std::forward<HeapData>(data), reorderHandler);
+    }
+
+    void clear()
+    {
+        for (auto &bucket : buckets)
+        {
+            bucket.clear();
+        }
+        number_of_elements = 0;
+    }
+
+    std::size_t capacity() const
+    {
+        std::size_t capacity = spill.capacity();
+        for (const auto &bucket : buckets)
+        {
+            capacity += bucket.capacity();
+        }
+        return capacity;
+    }
+
+    void shrink_to_fit()
+    {
+        for (auto &bucket : buckets)
+        {
+            bucket.shrink_to_fit();
+        }
+        spill.shrink_to_fit();
+    }
+
+    template <typename ReorderHandler> void pop(ReorderHandler &&reorderHandler)
+    {
+        BOOST_ASSERT(!empty());
+        buckets[0].pop_back();
+        --number_of_elements;
+        if (buckets[0].empty() && !empty())
+        {
+            redistribute(reorderHandler);
+        }
+    }
+
+  private:
+    static constexpr std::size_t NUMBER_OF_BUCKETS = std::numeric_limits<Key>::digits + 1;
+
+    std::size_t bucketOf(const Key key) const
+    {
+        return NUMBER_OF_BUCKETS - 1 - std::countl_zero(static_cast<Key>(key ^ last_key));
+    }
+
+    template <typename ReorderHandler> void push(HeapData &&data, ReorderHandler &reorderHandler)
+    {
+        const auto key = KeyOf{}(data);
+        if (number_of_elements == 1)
+        {
+            // the first element of a search decides where the buckets start
+            last_key = key;
+        }
+        else if (key < last_key)
+        {
+            rebuild(key, reorderHandler);
+        }
+
+        const auto bucket = bucketOf(key);
+        buckets[bucket].push_back(std::move(data));
+        reorderHandler(buckets[bucket].back(), handleOf(bucket, buckets[bucket].size() - 1));
+    }
+
+    template <typename ReorderHandler>
+    void remove(const HeapHandle handle, ReorderHandler &reorderHandler)
+    {
+        auto &bucket = buckets[handle % NUMBER_OF_BUCKETS];
+        const auto position = handle / NUMBER_OF_BUCKETS;
+        if (position + 1 != bucket.size())
+        {
+            bucket[position] = std::move(bucket.back());
+            reorderHandler(bucket[position], handle);
+        }
+        bucket.pop_back();
+    }
+
+    // Moves the elements of the first non-empty bucket into lower buckets, which puts the new
+    // minimum into bucket 0
+    template <typename ReorderHandler> void redistribute(ReorderHandler &reorderHandler)
+    {
+        auto first = std::find_if(
+            buckets.begin() + 1, buckets.end(), [](const auto &bucket) { return !bucket.empty(); });
+        BOOST_ASSERT(first != buckets.end());
+
+        last_key = std::numeric_limits<Key>::max();
+        for (const auto &element : *first)
+        {
+            last_key = std::min(last_key, KeyOf{}(element));
+        }
+
+        std::swap(*first, spill);
+        moveAll(spill, reorderHandler);
+    }
+
+    // Starts the buckets over at a key below the current minimum
+    template <typename ReorderHandler>
+    void rebuild(const Key key, ReorderHandler &reorderHandler)
+    {
+        for (auto &bucket : buckets)
+        {
+            std::move(bucket.begin(), bucket.end(), std::back_inserter(spill));
+            bucket.clear();
+        }
+        last_key = key;
+        moveAll(spill, reorderHandler);
+    }
+
+    template <typename ReorderHandler>
+    void moveAll(std::vector<HeapData> &elements, ReorderHandler &reorderHandler)
+    {
+        for (auto &element : elements)
+        {
+            const auto bucket = bucketOf(KeyOf{}(element));
+            buckets[bucket].push_back(std::move(element));
+            reorderHandler(buckets[bucket].back(), handleOf(bucket, buckets[bucket].size() - 1));
+        }
+        elements.clear();
+    }
+
+    static HeapHandle handleOf(const std::size_t bucket, const std::size_t position)
+    {
+        return position * NUMBER_OF_BUCKETS + bucket;
+    }
+
+    std::array<std::vector<HeapData>, NUMBER_OF_BUCKETS> buckets;
+    // reused when elements move between buckets
+    std::vector<HeapData> spill;
+    Key last_key = 0;
+    std::size_t number_of_elements = 0;
+};
+} // namespace osrm::util
+
+#endif // OSRM_UTIL_RADIX_HEAP_HPP
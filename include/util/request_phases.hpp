@@ -0,0 +1,106 @@
+#ifndef OSRM_UTIL_REQUEST_PHASES_HPP
+#define OSRM_UTIL_REQUEST_PHASES_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace osrm::util
+{
+
+// Phases of a request that are accounted separately, in the order they usually run
+enum class RequestPhase : std::uint8_t
+{
+    Snapping,
+    Search,
+    Unpacking,
+    Assembly,
+    Rendering
+};
+
+inline constexpr std::size_t NUMBER_OF_REQUEST_PHASES = 5;
+inline constexpr std::array<std::string_view, NUMBER_OF_REQUEST_PHASES> REQUEST_PHASE_NAMES = {
+    "snapping", "search", "unpacking", "assembly", "rendering"};
+
+using RequestPhaseDurations = std::array<std::chrono::nanoseconds, NUMBER_OF_REQUEST_PHASES>;
+
+namespace detail
+{
+struct RequestPhaseTracker
+{
+    // Accounts the time since the last switch to the current phase and continues with the next
+    void Switch(const std::optional<RequestPhase> next)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (current)
+        {
+            durations[static_cast<std::size_t>(*current)] += now - since;
+        }
+        current = next;
+        since = now;
+    }
+
+    bool enabled = false;
+    std::optional<RequestPhase> current;
+    std::chrono::steady_clock::time_point since;
+    RequestPhaseDurations durations{};
+};
+
+inline thread_local RequestPhaseTracker request_phase_tracker;
+} // namespace detail
+
+// Starts accounting the phases of a request handled by this thread
+inline void StartRequestPhases()
+{
+    detail::request_phase_tracker = {};
+    detail::request_phase_tracker.enabled = true;
+}
+
+// Stops accounting and returns the time spent in every phase
+inline RequestPhaseDurations StopRequestPhases()
+{
+    detail::request_phase_tracker.enabled = false;
+    return detail::request_phase_tracker.durations;
+}
+
+/**
+ * Accounts the time until it is destroyed to a phase of the current request. A nested phase
+ * pauses the enclosing one, so every phase only gets its own time. Does nothing unless the
+ * thread accounts a request, e.g. when the engine is used as a library.
+ */
+class ScopedRequestPhase
+{
+  public:
+    explicit ScopedRequestPhase(const RequestPhase phase)
+    {
+        auto &tracker = detail::request_phase_tracker;
+        if (tracker.enabled)
+        {
+            active = true;
+            previous = tracker.current;
+            tracker.Switch(phase);
+        }
+    }
+
+    ~ScopedRequestPhase()
+    {
+        auto &tracker = detail::request_phase_tracker;
+        if (active && tracker.enabled)
+        {
+            tracker.Switch(previous);
+        }
+    }
+
+    ScopedRequestPhase(const ScopedRequestPhase &) = delete;
+    ScopedRequestPhase &operator=(const ScopedRequestPhase &) = delete;
+
+  private:
+    bool active = false;
+    std::optional<RequestPhase> previous;
+};
+} // namespace osrm::util
+
+#endif
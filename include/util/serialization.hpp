@@ -4,6 +4,7 @@
 #include "util/dynamic_graph.hpp"
 #include "util/indexed_data.hpp"
 #include "util/packed_vector.hpp"
+#include "util/patched_packed_vector.hpp"
 #include "util/range_table.hpp"
 #include "util/static_graph.hpp"
 #include "util/static_rtree.hpp"
@@ -52,6 +53,26 @@ inline void write(storage::tar::FileWriter &writer,
     storage::serialization::write(writer, name + "/packed", vec.vec);
 }
 
+template <std::size_t Bits, storage::Ownership Ownership>
+inline void read(storage::tar::FileReader &reader,
+                 const std::string &name,
+                 detail::PatchedPackedVector<Bits, Ownership> &vec)
+{
+    read(reader, name + "/values", vec.packed);
+    storage::serialization::read(reader, name + "/exception_indices", vec.exception_indices);
+    storage::serialization::read(reader, name + "/exception_values", vec.exception_values);
+}
+
+template <std::size_t Bits, storage::Ownership Ownership>
+inline void write(storage::tar::FileWriter &writer,
+                  const std::string &name,
+                  const detail::PatchedPackedVector<Bits, Ownership> &vec)
+{
+    write(writer, name + "/values", vec.packed);
+    storage::serialization::write(writer, name + "/exception_indices", vec.exception_indices);
+    storage::serialization::write(writer, name + "/exception_values", vec.exception_values);
+}
+
 template <typename EdgeDataT, storage::Ownership Ownership>
 inline void read(storage::tar::FileReader &reader,
                  const std::string &name,
@@ -244,7 +244,8 @@ class StaticGraph
         return current_iterator;
     }
 
-    void Renumber(const std::vector<NodeID> &old_to_new_node)
+    // Returns the permutation of the edges, for data that is indexed by edge
+    std::vector<EdgeID> Renumber(const std::vector<NodeID> &old_to_new_node)
     {
         std::vector<NodeID> new_to_old_node(number_of_nodes);
         for (auto node : util::irange<NodeID>(0, number_of_nodes))
@@ -271,6 +272,7 @@ class StaticGraph
                      old_to_new_edge.end());
 
         util::inplacePermutation(edge_array.begin(), edge_array.end(), old_to_new_edge);
+        return old_to_new_edge;
     }
 
     friend void serialization::read<EdgeDataT, Ownership>(storage::tar::FileReader &reader,
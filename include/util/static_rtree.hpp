@@ -27,6 +27,8 @@
 #include <tbb/parallel_sort.h>
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <filesystem>
 #include <limits>
 #include <queue>
@@ -153,6 +155,8 @@ class StaticRTree
     static_assert(LEAF_PAGE_SIZE >= sizeof(EdgeDataT), "page size is too small");
     static_assert(((LEAF_PAGE_SIZE - 1) & LEAF_PAGE_SIZE) == 0, "page size is not a power of 2");
     static constexpr std::uint32_t LEAF_NODE_SIZE = (LEAF_PAGE_SIZE / sizeof(EdgeDataT));
+    // Number of queries of a batch that run on one thread and share a leaf cache
+    static constexpr std::size_t BATCH_BLOCK_SIZE = 256;
 
     struct CandidateSegment
     {
@@ -184,6 +188,52 @@ class StaticRTree
         Rectangle minimum_bounding_rectangle;
     };
 
+    // Web Mercator projections of the segment end points of a leaf as a struct of arrays
+    struct ProjectedLeaf
+    {
+        std::array<double, LEAF_NODE_SIZE> u_lon;
+        std::array<double, LEAF_NODE_SIZE> u_lat;
+        std::array<double, LEAF_NODE_SIZE> v_lon;
+        std::array<double, LEAF_NODE_SIZE> v_lat;
+    };
+
+    /**
+     * Projected segments of recently explored leaves. The queries of a batch run in Hilbert
+     * order, so consecutive queries mostly explore the same leaves and only project their
+     * segments once. Every leaf maps to a single slot that keeps the leaf explored last.
+     */
+    class LeafCache
+    {
+      public:
+        static constexpr std::size_t NUMBER_OF_SLOTS = 32;
+
+        explicit LeafCache(const StaticRTree &rtree_)
+            : rtree(rtree_), leaf_offsets(NUMBER_OF_SLOTS, INVALID_LEAF_OFFSET),
+              projected_leaves(NUMBER_OF_SLOTS)
+        {
+        }
+
+        const ProjectedLeaf &Get(const TreeIndex &leaf_id)
+        {
+            BOOST_ASSERT(rtree.is_leaf(leaf_id));
+            const auto slot = leaf_id.offset % NUMBER_OF_SLOTS;
+            if (leaf_offsets[slot] != leaf_id.offset)
+            {
+                rtree.ProjectLeaf(leaf_id, projected_leaves[slot]);
+                leaf_offsets[slot] = leaf_id.offset;
+            }
+            return projected_leaves[slot];
+        }
+
+      private:
+        static constexpr std::uint32_t INVALID_LEAF_OFFSET =
+            std::numeric_limits<std::uint32_t>::max();
+
+        const StaticRTree &rtree;
+        std::vector<std::uint32_t> leaf_offsets;
+        std::vector<ProjectedLeaf> projected_leaves;
+    };
+
   private:
     /**
      * A lightweight wrapper for the Hilbert Code for each EdgeDataT object
@@ -540,11 +590,56 @@ class StaticRTree
         return results;
     }
 
+    /**
+     * Runs query(index, leaf_cache) for every input coordinate, where the query is expected to
+     * call Nearest with the leaf cache. The queries run in the Hilbert order of the inputs, so
+     * that consecutive queries explore the same tree nodes while they are still in the CPU
+     * cache and share the projected segments of the leaves. Large batches are split into blocks
+     * that run in parallel, each with its own leaf cache.
+     */
+    template <typename QueryT>
+    void BatchNearest(const std::vector<Coordinate> &input_coordinates, const QueryT &query) const
+    {
+        // the tree is packed in the Hilbert order of the projected segment centroids
+        std::vector<WrappedInputElement> hilbert_order(input_coordinates.size());
+        for (const auto index : irange<std::size_t>(0, input_coordinates.size()))
+        {
+            Coordinate projected_coordinate = input_coordinates[index];
+            projected_coordinate.lat = FixedLatitude{static_cast<std::int32_t>(
+                COORDINATE_PRECISION * web_mercator::latToY(toFloating(projected_coordinate.lat)))};
+            hilbert_order[index] = WrappedInputElement{GetHilbertCode(projected_coordinate),
+                                                       static_cast<std::uint32_t>(index)};
+        }
+        std::sort(hilbert_order.begin(), hilbert_order.end());
+
+        const auto run_queries = [this, &hilbert_order, &query](const std::size_t begin,
+                                                                const std::size_t end)
+        {
+            LeafCache leaf_cache(*this);
+            for (const auto position : irange<std::size_t>(begin, end))
+            {
+                query(hilbert_order[position].m_original_index, leaf_cache);
+            }
+        };
+
+        if (hilbert_order.size() <= BATCH_BLOCK_SIZE)
+        {
+            run_queries(0, hilbert_order.size());
+            return;
+        }
+        tbb::parallel_for(
+            tbb::blocked_range<std::size_t>(0, hilbert_order.size(), BATCH_BLOCK_SIZE),
+            [&run_queries](const tbb::blocked_range<std::size_t> &range)
+            { run_queries(range.begin(), range.end()); });
+    }
+
     // Return edges in distance order with the coordinate of the closest point on the edge.
+    // The leaf cache of a batch shares the projected segments with the queries of the batch.
     template <typename FilterT, typename TerminationT>
     std::vector<CandidateSegment> Nearest(const Coordinate input_coordinate,
                                           const FilterT filter,
-                                          const TerminationT terminate) const
+                                          const TerminationT terminate,
+                                          LeafCache *leaf_cache = nullptr) const
     {
         std::vector<CandidateSegment> results;
 
@@ -553,6 +648,8 @@ class StaticRTree
 
         // we re-use queue for each query to avoid re-allocating memory
         static thread_local util::BinaryHeap<QueryCandidate> traversal_queue;
+        // projections of the explored leaf when there is no cache
+        ProjectedLeaf projected_leaf;
 
         traversal_queue.clear();
         // initialize queue with root element
@@ -571,6 +668,8 @@ class StaticRTree
                     ExploreLeafNode(current_tree_index,
                                     fixed_projected_coordinate,
                                     projected_coordinate,
+                                    leaf_cache ? leaf_cache->Get(current_tree_index)
+                                               : ProjectLeaf(current_tree_index, projected_leaf),
                                     traversal_queue);
                 }
                 else
@@ -678,6 +777,16 @@ class StaticRTree
         }
     }
 
+    // Squared distances of the query to the segments of a leaf and the closest points on them
+    struct LeafDistances
+    {
+        std::array<double, LEAF_NODE_SIZE> nearest_lon;
+        std::array<double, LEAF_NODE_SIZE> nearest_lat;
+        std::array<std::int32_t, LEAF_NODE_SIZE> fixed_nearest_lon;
+        std::array<std::int32_t, LEAF_NODE_SIZE> fixed_nearest_lat;
+        std::array<std::uint64_t, LEAF_NODE_SIZE> squared_distances;
+    };
+
     /**
      * Iterates over all the objects in a leaf node and inserts them into our
      * search priority queue.  The speed of this function is very much governed
@@ -688,34 +797,110 @@ class StaticRTree
     void ExploreLeafNode(const TreeIndex &leaf_id,
                          const Coordinate &projected_input_coordinate_fixed,
                          const FloatCoordinate &projected_input_coordinate,
+                         const ProjectedLeaf &projected_leaf,
                          QueueT &traversal_queue) const
     {
         // Check that we're actually looking at the bottom level of the tree
         BOOST_ASSERT(is_leaf(leaf_id));
 
-        for (const auto i : child_indexes(leaf_id))
+        const auto children = child_indexes(leaf_id);
+        LeafDistances distances;
+        ComputeLeafDistances(projected_leaf,
+                             children.size(),
+                             projected_input_coordinate,
+                             projected_input_coordinate_fixed,
+                             distances);
+
+        for (const auto i : children)
         {
-            const auto &current_edge = m_objects[i];
+            BOOST_ASSERT(i < std::numeric_limits<std::uint32_t>::max());
+            const auto index = i - children.front();
+            traversal_queue.emplace(
+                QueryCandidate{distances.squared_distances[index],
+                               leaf_id,
+                               static_cast<std::uint32_t>(i),
+                               Coordinate{FixedLongitude{distances.fixed_nearest_lon[index]},
+                                          FixedLatitude{distances.fixed_nearest_lat[index]}}});
+        }
+    }
 
-            const auto projected_u = web_mercator::fromWGS84(m_coordinate_list[current_edge.u]);
-            const auto projected_v = web_mercator::fromWGS84(m_coordinate_list[current_edge.v]);
+    /**
+     * Same computation as coordinate_calculation::projectPointOnSegment, toFixed and
+     * squaredEuclideanDistance for all segments of a leaf at once. The loops are free of
+     * branches and library calls and work on arrays, so that the compiler vectorizes them.
+     */
+    static void ComputeLeafDistances(const ProjectedLeaf &leaf,
+                                     const std::size_t size,
+                                     const FloatCoordinate &input,
+                                     const Coordinate &fixed_input,
+                                     LeafDistances &distances)
+    {
+        BOOST_ASSERT(size <= LEAF_NODE_SIZE);
+        const auto input_lon = static_cast<double>(input.lon);
+        const auto input_lat = static_cast<double>(input.lat);
+        constexpr auto EPSILON = std::numeric_limits<double>::epsilon();
 
-            FloatCoordinate projected_nearest;
-            std::tie(std::ignore, projected_nearest) =
-                coordinate_calculation::projectPointOnSegment(
-                    projected_u, projected_v, projected_input_coordinate);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            const double slope_lon = leaf.v_lon[i] - leaf.u_lon[i];
+            const double slope_lat = leaf.v_lat[i] - leaf.u_lat[i];
+            const double relative_lon = input_lon - leaf.u_lon[i];
+            const double relative_lat = input_lat - leaf.u_lat[i];
+            const double unnormed_ratio = slope_lon * relative_lon + slope_lat * relative_lat;
+            const double squared_length = slope_lon * slope_lon + slope_lat * slope_lat;
+
+            // degenerated segments snap to their source
+            const bool degenerated = squared_length < EPSILON;
+            double ratio = unnormed_ratio / (degenerated ? 1. : squared_length);
+            ratio = ratio < 0. ? 0. : ratio;
+            ratio = ratio > 1. ? 1. : ratio;
+            ratio = degenerated ? 0. : ratio;
+
+            distances.nearest_lon[i] = (1. - ratio) * leaf.u_lon[i] + leaf.v_lon[i] * ratio;
+            distances.nearest_lat[i] = (1. - ratio) * leaf.u_lat[i] + leaf.v_lat[i] * ratio;
+        }
 
-            const auto squared_distance = coordinate_calculation::squaredEuclideanDistance(
-                projected_input_coordinate_fixed, projected_nearest);
-            // distance must be non-negative
-            BOOST_ASSERT(0. <= squared_distance);
-            BOOST_ASSERT(i < std::numeric_limits<std::uint32_t>::max());
+        // std::round rounds halfway cases away from zero, the difference to the truncated value
+        // is exact and tells which way to go
+        const auto round = [](const double value)
+        {
+            const auto truncated = static_cast<std::int32_t>(value);
+            const double fraction = value - truncated;
+            return truncated + (fraction >= 0.5 ? 1 : 0) - (fraction <= -0.5 ? 1 : 0);
+        };
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            distances.fixed_nearest_lon[i] = round(distances.nearest_lon[i] * COORDINATE_PRECISION);
+            distances.fixed_nearest_lat[i] = round(distances.nearest_lat[i] * COORDINATE_PRECISION);
+        }
 
-            traversal_queue.emplace(QueryCandidate{squared_distance,
-                                                   leaf_id,
-                                                   static_cast<std::uint32_t>(i),
-                                                   Coordinate{projected_nearest}});
+        const auto fixed_input_lon = static_cast<std::int32_t>(fixed_input.lon);
+        const auto fixed_input_lat = static_cast<std::int32_t>(fixed_input.lat);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            const std::int64_t delta_lon = distances.fixed_nearest_lon[i] - fixed_input_lon;
+            const std::int64_t delta_lat = distances.fixed_nearest_lat[i] - fixed_input_lat;
+            distances.squared_distances[i] =
+                static_cast<std::uint64_t>(delta_lon * delta_lon + delta_lat * delta_lat);
+        }
+    }
+
+    const ProjectedLeaf &ProjectLeaf(const TreeIndex &leaf_id, ProjectedLeaf &projected_leaf) const
+    {
+        const auto children = child_indexes(leaf_id);
+        for (const auto i : children)
+        {
+            const auto &edge = m_objects[i];
+            const auto projected_u = web_mercator::fromWGS84(m_coordinate_list[edge.u]);
+            const auto projected_v = web_mercator::fromWGS84(m_coordinate_list[edge.v]);
+
+            const auto index = i - children.front();
+            projected_leaf.u_lon[index] = static_cast<double>(projected_u.lon);
+            projected_leaf.u_lat[index] = static_cast<double>(projected_u.lat);
+            projected_leaf.v_lon[index] = static_cast<double>(projected_v.lon);
+            projected_leaf.v_lat[index] = static_cast<double>(projected_v.lat);
         }
+        return projected_leaf;
     }
 
     /**
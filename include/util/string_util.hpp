@@ -6,6 +6,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <string>
+#include <string_view>
 
 namespace osrm::util
 {
@@ -26,7 +27,7 @@ inline static constexpr std::array<uint8_t, 256> json_quotable_character = []()
     return result;
 }();
 
-inline bool RequiresJSONStringEscaping(const std::string &string)
+inline bool RequiresJSONStringEscaping(const std::string_view string)
 {
     uint8_t needs = 0;
     for (uint8_t c : string)
@@ -36,7 +37,7 @@ inline bool RequiresJSONStringEscaping(const std::string &string)
     return needs;
 }
 
-inline void EscapeJSONString(const std::string &input, std::string &output)
+inline void EscapeJSONString(const std::string_view input, std::string &output)
 {
     for (const char letter : input)
     {
@@ -62,6 +62,10 @@ function run_benchmarks_for_folder {
     $BENCHMARKS_FOLDER/route-bench "$FOLDER/test/data/mld/monaco.osrm" mld > "$RESULTS_FOLDER/route_mld.bench"
     echo "Running route-bench CH"
     $BENCHMARKS_FOLDER/route-bench "$FOLDER/test/data/ch/monaco.osrm" ch > "$RESULTS_FOLDER/route_ch.bench"
+    echo "Running table-bench MLD"
+    $BENCHMARKS_FOLDER/table-bench "$FOLDER/test/data/mld/monaco.osrm" mld > "$RESULTS_FOLDER/table_mld.bench"
+    echo "Running table-bench CH"
+    $BENCHMARKS_FOLDER/table-bench "$FOLDER/test/data/ch/monaco.osrm" ch > "$RESULTS_FOLDER/table_ch.bench"
     echo "Running alias"
     $BENCHMARKS_FOLDER/alias-bench > "$RESULTS_FOLDER/alias.bench"
     echo "Running json-render-bench"
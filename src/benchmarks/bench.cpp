@@ -372,7 +372,8 @@ void runRouteBenchmark(const OSRM &osrm, const GPSTraces &gpsTraces, int iterati
                       if (rc != Status::Ok ||
                           json_result.values.find("routes") == json_result.values.end())
                       {
-                          auto code = std::get<json::String>(json_result.values["code"]).value;
+                          const std::string code{
+                              std::get<json::String>(json_result.values["code"]).value};
                           if (code != "NoSegment" && code != "NoRoute")
                           {
                               throw std::runtime_error{"Couldn't route: " + code};
@@ -430,7 +431,8 @@ void runMatchBenchmark(const OSRM &osrm, const GPSTraces &gpsTraces, int iterati
                       if (rc != Status::Ok ||
                           json_result.values.find("matchings") == json_result.values.end())
                       {
-                          auto code = std::get<json::String>(json_result.values["code"]).value;
+                          const std::string code{
+                              std::get<json::String>(json_result.values["code"]).value};
                           if (code != "NoSegment" && code != "NoMatch")
                           {
                               throw std::runtime_error{"Couldn't route: " + code};
@@ -483,7 +485,8 @@ void runNearestBenchmark(const OSRM &osrm, const GPSTraces &gpsTraces, int itera
                       if (rc != Status::Ok ||
                           json_result.values.find("waypoints") == json_result.values.end())
                       {
-                          auto code = std::get<json::String>(json_result.values["code"]).value;
+                          const std::string code{
+                              std::get<json::String>(json_result.values["code"]).value};
                           if (code != "NoSegment")
                           {
                               throw std::runtime_error{"Couldn't find nearest point"};
@@ -537,7 +540,8 @@ void runTripBenchmark(const OSRM &osrm, const GPSTraces &gpsTraces, int iteratio
                       if (rc != Status::Ok ||
                           json_result.values.find("trips") == json_result.values.end())
                       {
-                          auto code = std::get<json::String>(json_result.values["code"]).value;
+                          const std::string code{
+                              std::get<json::String>(json_result.values["code"]).value};
                           if (code != "NoSegment")
                           {
                               throw std::runtime_error{"Couldn't find trip"};
@@ -590,7 +594,8 @@ void runTableBenchmark(const OSRM &osrm, const GPSTraces &gpsTraces, int iterati
                       if (rc != Status::Ok ||
                           json_result.values.find("durations") == json_result.values.end())
                       {
-                          auto code = std::get<json::String>(json_result.values["code"]).value;
+                          const std::string code{
+                              std::get<json::String>(json_result.values["code"]).value};
                           if (code != "NoSegment")
                           {
                               throw std::runtime_error{"Couldn't compute table"};
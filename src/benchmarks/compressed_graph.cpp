@@ -0,0 +1,488 @@
+#include "contractor/compressed_query_graph.hpp"
+#include "contractor/contracted_metric.hpp"
+#include "contractor/files.hpp"
+#include "contractor/graph_contractor.hpp"
+#include "contractor/graph_contractor_adaptors.hpp"
+#include "contractor/query_edge.hpp"
+#include "contractor/query_graph.hpp"
+#include "customizer/cell_customizer.hpp"
+#include "customizer/compressed_multi_level_graph.hpp"
+#include "customizer/edge_based_graph.hpp"
+#include "customizer/files.hpp"
+#include "partitioner/cell_storage.hpp"
+#include "partitioner/edge_based_graph.hpp"
+#include "partitioner/files.hpp"
+#include "partitioner/multi_level_graph.hpp"
+#include "partitioner/multi_level_partition.hpp"
+#include "engine/datafacade/contiguous_block_allocator.hpp"
+#include "engine/datafacade/contiguous_internalmem_datafacade.hpp"
+#include "storage/shared_data_index.hpp"
+#include "storage/shared_datatype.hpp"
+#include "storage/storage.hpp"
+
+#include "util/integer_range.hpp"
+#include "util/log.hpp"
+#include "util/mmap_file.hpp"
+#include "util/query_heap.hpp"
+#include "util/timing_util.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace osrm;
+
+namespace
+{
+using CHFacade = engine::datafacade::ContiguousInternalMemoryAlgorithmDataFacade<
+    engine::routing_algorithms::ch::Algorithm>;
+using MLDFacade = engine::datafacade::ContiguousInternalMemoryAlgorithmDataFacade<
+    engine::routing_algorithms::mld::Algorithm>;
+
+using CHHeap = util::QueryHeap<NodeID, NodeID, EdgeWeight, NodeID, util::ArrayStorage<NodeID, int>>;
+struct MLDHeapData
+{
+    bool from_clique_arc;
+};
+using MLDHeap =
+    util::QueryHeap<NodeID, NodeID, EdgeWeight, MLDHeapData, util::ArrayStorage<NodeID, int>>;
+
+const std::string METRIC = "routability";
+
+// Resident set size of the process in KiB
+std::size_t residentMemory()
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.rfind("VmRSS:", 0) == 0)
+        {
+            return std::stoul(line.substr(6));
+        }
+    }
+    return 0;
+}
+
+// A file mapped into memory like osrm-routed --mmap does it
+struct MappedFile
+{
+    explicit MappedFile(std::filesystem::path path_) : path(std::move(path_))
+    {
+        data = util::mmapFile<char>(path, file).data();
+    }
+
+    std::filesystem::path path;
+    boost::iostreams::mapped_file_source file;
+    const char *data;
+};
+
+class MappedFileAllocator final : public engine::datafacade::ContiguousBlockAllocator
+{
+  public:
+    explicit MappedFileAllocator(const std::vector<const MappedFile *> &files)
+    {
+        std::vector<storage::SharedDataIndex::AllocatedRegion> allocated_regions;
+        for (const auto file : files)
+        {
+            std::unique_ptr<storage::BaseDataLayout> layout =
+                std::make_unique<storage::TarDataLayout>();
+            storage::populateLayoutFromFile(file->path, *layout);
+            allocated_regions.push_back({const_cast<char *>(file->data), std::move(layout)});
+        }
+        index = storage::SharedDataIndex{std::move(allocated_regions)};
+    }
+
+    const storage::SharedDataIndex &GetIndex() override { return index; }
+
+  private:
+    storage::SharedDataIndex index;
+};
+
+// Road-like grid with random weights, every node is connected to its four neighbours
+template <typename AddEdge>
+void forEachGridEdge(const unsigned width, std::mt19937 &generator, const AddEdge &add_edge)
+{
+    std::uniform_int_distribution<std::int32_t> weights(1, 1000);
+    for (const auto node : util::irange(0u, width * width))
+    {
+        if (node % width + 1 < width)
+        {
+            add_edge(node, node + 1, EdgeWeight{weights(generator)});
+        }
+        if (node + width < width * width)
+        {
+            add_edge(node, node + width, EdgeWeight{weights(generator)});
+        }
+    }
+}
+
+contractor::QueryGraph makeContractedGrid(const unsigned width, std::mt19937 &generator)
+{
+    std::vector<contractor::ContractorEdge> edges;
+    unsigned id = 0;
+    // every direction of a road is a forward edge at its source and a backward edge at its target
+    const auto add_direction = [&](const NodeID from, const NodeID to, const EdgeWeight weight)
+    {
+        const EdgeDuration duration{from_alias<EdgeDuration::value_type>(weight)};
+        const EdgeDistance distance{static_cast<float>(from_alias<std::int32_t>(weight))};
+        edges.push_back(contractor::ContractorEdge{
+            from,
+            to,
+            contractor::ContractorEdgeData{
+                weight, duration, distance, 1, id, false, true, false}});
+        edges.push_back(contractor::ContractorEdge{
+            to,
+            from,
+            contractor::ContractorEdgeData{
+                weight, duration, distance, 1, id++, false, false, true}});
+    };
+    forEachGridEdge(width,
+                    generator,
+                    [&](const NodeID from, const NodeID to, const EdgeWeight weight)
+                    {
+                        add_direction(from, to, weight);
+                        add_direction(to, from, weight);
+                    });
+    std::sort(edges.begin(), edges.end());
+
+    const auto number_of_nodes = width * width;
+    contractor::ContractorGraph contractor_graph{number_of_nodes, edges};
+    contractor::contractGraph(contractor_graph,
+                              std::vector<EdgeWeight>(number_of_nodes, EdgeWeight{1}));
+    return contractor::QueryGraph{
+        number_of_nodes, contractor::toEdges<contractor::QueryEdge>(std::move(contractor_graph))};
+}
+
+// Nested square cells of 8, 32 and 128 nodes width
+partitioner::MultiLevelPartition makeGridPartition(const unsigned width)
+{
+    std::vector<std::vector<CellID>> partitions;
+    std::vector<std::uint32_t> number_of_cells;
+    for (const unsigned cell_width : {8u, 32u, 128u})
+    {
+        const auto cells_per_row = (width + cell_width - 1) / cell_width;
+        std::vector<CellID> partition(width * width);
+        for (const auto node : util::irange(0u, width * width))
+        {
+            partition[node] = node % width / cell_width + node / width / cell_width * cells_per_row;
+        }
+        partitions.push_back(std::move(partition));
+        number_of_cells.push_back(cells_per_row * cells_per_row);
+    }
+    return partitioner::MultiLevelPartition{partitions, number_of_cells};
+}
+
+// Edge-based grid whose edges weigh as much as their source node, like the turns of osrm-extract
+partitioner::MultiLevelGraph<partitioner::EdgeBasedGraphEdgeData, storage::Ownership::Container>
+makeMultiLevelGrid(const unsigned width,
+                   const partitioner::MultiLevelPartition &partition,
+                   const std::vector<EdgeWeight> &node_weights,
+                   std::mt19937 &generator)
+{
+    using Edge =
+        util::static_graph_details::SortableEdgeWithData<partitioner::EdgeBasedGraphEdgeData>;
+    std::vector<Edge> edges;
+    NodeID turn_id = 0;
+    const auto add_direction = [&](const NodeID from, const NodeID to)
+    {
+        const auto weight = node_weights[from];
+        const EdgeDuration duration{from_alias<EdgeDuration::value_type>(weight)};
+        const EdgeDistance distance{static_cast<float>(from_alias<std::int32_t>(weight))};
+        edges.push_back(Edge{from, to, turn_id, weight, distance, duration, true, false});
+        edges.push_back(Edge{to, from, turn_id++, weight, distance, duration, false, true});
+    };
+    forEachGridEdge(width,
+                    generator,
+                    [&](const NodeID from, const NodeID to, const EdgeWeight)
+                    {
+                        add_direction(from, to);
+                        add_direction(to, from);
+                    });
+    std::sort(edges.begin(), edges.end());
+    return {partition, width * width, edges};
+}
+
+// Bidirectional CH query
+EdgeWeight chQuery(
+    const CHFacade &facade, CHHeap &forward, CHHeap &reverse, const NodeID from, const NodeID to)
+{
+    forward.Clear();
+    reverse.Clear();
+    forward.Insert(from, EdgeWeight{0}, from);
+    reverse.Insert(to, EdgeWeight{0}, to);
+
+    auto best = INVALID_EDGE_WEIGHT;
+    const auto step = [&](CHHeap &heap, const CHHeap &other, const bool forward_direction)
+    {
+        const auto weight = heap.MinKey();
+        const auto node = heap.DeleteMin();
+        if (weight >= best)
+        {
+            heap.DeleteAll();
+            return;
+        }
+        if (other.WasInserted(node))
+        {
+            best = std::min(best, weight + other.GetKey(node));
+        }
+        for (const auto &edge : facade.GetAdjacentEdges(node))
+        {
+            if (forward_direction ? !edge.data.forward : !edge.data.backward)
+            {
+                continue;
+            }
+            const auto to_weight = weight + edge.data.weight;
+            const auto target_node = heap.GetHeapNodeIfWasInserted(edge.target);
+            if (!target_node)
+            {
+                heap.Insert(edge.target, to_weight, node);
+            }
+            else if (to_weight < target_node->weight)
+            {
+                target_node->data = node;
+                target_node->weight = to_weight;
+                heap.DecreaseKey(*target_node);
+            }
+        }
+    };
+
+    while (!forward.Empty() || !reverse.Empty())
+    {
+        if (!forward.Empty())
+        {
+            step(forward, reverse, true);
+        }
+        if (!reverse.Empty())
+        {
+            step(reverse, forward, false);
+        }
+    }
+    return best;
+}
+
+// Unidirectional MLD query over the cells of the query levels
+EdgeWeight mldQuery(const MLDFacade &facade, MLDHeap &heap, const NodeID from, const NodeID to)
+{
+    const auto &partition = facade.GetMultiLevelPartition();
+    const auto &cells = facade.GetCellStorage();
+    const auto &metric = facade.GetCellMetric();
+
+    heap.Clear();
+    heap.Insert(from, EdgeWeight{0}, {false});
+
+    const auto relax = [&](const NodeID target, const EdgeWeight to_weight, const bool clique_arc)
+    {
+        const auto target_node = heap.GetHeapNodeIfWasInserted(target);
+        if (!target_node)
+        {
+            heap.Insert(target, to_weight, {clique_arc});
+        }
+        else if (to_weight < target_node->weight)
+        {
+            target_node->data = {clique_arc};
+            target_node->weight = to_weight;
+            heap.DecreaseKey(*target_node);
+        }
+    };
+
+    while (!heap.Empty())
+    {
+        const auto weight = heap.MinKey();
+        const auto node = heap.DeleteMin();
+        if (node == to)
+        {
+            return weight;
+        }
+
+        const auto level = partition.GetQueryLevel(from, to, node);
+        if (level >= 1 && !heap.GetData(node).from_clique_arc)
+        {
+            const auto cell = cells.GetCell(metric, level, partition.GetCell(level, node));
+            auto destination = cell.GetDestinationNodes().begin();
+            for (const auto shortcut_weight : cell.GetOutWeight(node))
+            {
+                if (shortcut_weight != INVALID_EDGE_WEIGHT && *destination != node)
+                {
+                    relax(*destination, weight + shortcut_weight, true);
+                }
+                ++destination;
+            }
+        }
+
+        const auto node_weight = facade.GetNodeWeight(node);
+        for (const auto &edge : facade.GetBorderEdges(level, node))
+        {
+            if (edge.forward)
+            {
+                relax(edge.target, weight + node_weight, false);
+            }
+        }
+    }
+    return INVALID_EDGE_WEIGHT;
+}
+
+// Maps the graph file next to the other files, runs the queries and reports the latency and how
+// much of the mapped graph became resident
+template <typename Facade, typename Query>
+void benchmark(const std::string &name,
+               const std::filesystem::path &graph_path,
+               const std::vector<const MappedFile *> &files,
+               const std::vector<std::pair<NodeID, NodeID>> &queries,
+               const Query &query)
+{
+    const auto rss_before = residentMemory();
+    std::size_t rss_mapped = 0;
+    {
+        const MappedFile graph_file(graph_path);
+        auto mapped_files = files;
+        mapped_files.push_back(&graph_file);
+        const Facade facade(std::make_shared<MappedFileAllocator>(mapped_files), METRIC, 0);
+
+        // the first run faults the pages in, the second one is timed
+        std::int64_t checksum = 0;
+        for (const auto &[from, to] : queries)
+        {
+            checksum += from_alias<std::int32_t>(query(facade, from, to));
+        }
+        rss_mapped = residentMemory();
+
+        TIMER_START(query);
+        for (const auto &[from, to] : queries)
+        {
+            query(facade, from, to);
+        }
+        TIMER_STOP(query);
+
+        std::cout << "  " << name << ": " << std::filesystem::file_size(graph_path) / 1024
+                  << " KiB, " << TIMER_MSEC(query) * 1000 / queries.size()
+                  << " us/query (checksum " << checksum << ")";
+    }
+    // unmapping drops exactly the pages of the graph that the queries touched
+    const auto rss_after = residentMemory();
+    std::cout << ", " << rss_mapped - rss_after << " KiB resident (RSS " << rss_before << " -> "
+              << rss_mapped << " KiB)" << std::endl;
+}
+
+std::vector<std::pair<NodeID, NodeID>>
+makeQueries(const std::size_t count, const unsigned number_of_nodes, std::mt19937 &generator)
+{
+    std::uniform_int_distribution<NodeID> nodes(0, number_of_nodes - 1);
+    std::vector<std::pair<NodeID, NodeID>> queries(count);
+    for (auto &[from, to] : queries)
+    {
+        from = nodes(generator);
+        to = nodes(generator);
+    }
+    return queries;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const unsigned width = argc > 1 ? std::stoul(argv[1]) : 200;
+    const auto number_of_nodes = width * width;
+
+    const auto directory = std::filesystem::temp_directory_path() /
+                           ("osrm-compressedgraph-bench-" + std::to_string(::getpid()));
+    std::filesystem::create_directories(directory);
+
+    std::mt19937 generator(1337);
+
+    // Both graphs are written to disk and mapped like osrm-routed --mmap does, only the
+    // touched pages count towards the resident set
+    {
+        auto graph = makeContractedGrid(width, generator);
+        std::vector<bool> edge_filter(graph.GetNumberOfEdges(), true);
+        auto compressed_graph = contractor::compressQueryGraph(graph);
+
+        std::unordered_map<std::string, contractor::ContractedMetric> metrics;
+        metrics[METRIC] = {std::move(graph), {edge_filter}};
+        contractor::files::writeGraph(directory / "static.hsgr", metrics, 0);
+        metrics[METRIC] = {{}, {edge_filter}, {}, std::move(compressed_graph)};
+        contractor::files::writeGraph(directory / "compressed.hsgr", metrics, 0);
+    }
+    {
+        const auto partition = makeGridPartition(width);
+        std::uniform_int_distribution<std::int32_t> weights(1, 1000);
+        std::vector<EdgeWeight> node_weights(number_of_nodes);
+        for (auto &weight : node_weights)
+        {
+            weight = EdgeWeight{weights(generator)};
+        }
+        std::vector<EdgeDuration> node_durations;
+        std::vector<EdgeDistance> node_distances;
+        for (const auto weight : node_weights)
+        {
+            node_durations.push_back(EdgeDuration{from_alias<EdgeDuration::value_type>(weight)});
+            node_distances.push_back(
+                EdgeDistance{static_cast<float>(from_alias<std::int32_t>(weight))});
+        }
+        auto partitioner_graph = makeMultiLevelGrid(width, partition, node_weights, generator);
+
+        partitioner::CellStorage cells(partition, partitioner_graph);
+        auto metric = cells.MakeMetric();
+        customizer::CellCustomizer{partition}.Customize(
+            partitioner_graph, cells, std::vector<bool>(number_of_nodes, true), metric);
+
+        partitioner::files::writePartition(directory / "grid.partition", partition);
+        partitioner::files::writeCells(directory / "grid.cells", cells);
+        std::unordered_map<std::string, std::vector<customizer::CellMetric>> metrics;
+        metrics[METRIC].push_back(std::move(metric));
+        customizer::files::writeCellMetrics(directory / "grid.cell_metrics", metrics);
+
+        const customizer::MultiLevelEdgeBasedGraph graph{std::move(partitioner_graph),
+                                                         std::move(node_weights),
+                                                         std::move(node_durations),
+                                                         std::move(node_distances)};
+        customizer::files::writeGraph(directory / "static.mldgr", graph, 0);
+        customizer::files::writeCompressedGraph(
+            directory / "compressed.mldgr", customizer::compressMultiLevelGraph(graph), 0);
+    }
+
+    util::LogPolicy::GetInstance().Unmute();
+
+    std::cout << "CH on a " << width << "x" << width << " grid, 10000 queries:" << std::endl;
+    {
+        CHHeap forward(number_of_nodes);
+        CHHeap reverse(number_of_nodes);
+        const auto queries = makeQueries(10000, number_of_nodes, generator);
+        const auto query = [&](const CHFacade &facade, const NodeID from, const NodeID to)
+        { return chQuery(facade, forward, reverse, from, to); };
+        benchmark<CHFacade>("static graph", directory / "static.hsgr", {}, queries, query);
+        benchmark<CHFacade>("compressed graph", directory / "compressed.hsgr", {}, queries, query);
+    }
+
+    std::cout << "MLD on a " << width << "x" << width << " grid, 1000 queries:" << std::endl;
+    {
+        const MappedFile partition_file(directory / "grid.partition");
+        const MappedFile cells_file(directory / "grid.cells");
+        const MappedFile metric_file(directory / "grid.cell_metrics");
+        const std::vector<const MappedFile *> files = {&partition_file, &cells_file, &metric_file};
+
+        MLDHeap heap(number_of_nodes);
+        const auto queries = makeQueries(1000, number_of_nodes, generator);
+        const auto query = [&](const MLDFacade &facade, const NodeID from, const NodeID to)
+        { return mldQuery(facade, heap, from, to); };
+        benchmark<MLDFacade>("static graph", directory / "static.mldgr", files, queries, query);
+        benchmark<MLDFacade>(
+            "compressed graph", directory / "compressed.mldgr", files, queries, query);
+    }
+
+    std::filesystem::remove_all(directory);
+
+    return EXIT_SUCCESS;
+}
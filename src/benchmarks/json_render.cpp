@@ -6,6 +6,7 @@
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <memory_resource>
 #include <rapidjson/document.h>
 #include <sstream>
 #include <stdexcept>
@@ -74,7 +75,42 @@ void convert(const rapidjson::Value &value, json::Value &result)
     }
 }
 
-json::Object load(const char *filename)
+// Counts the allocations that reach the upstream resource
+class CountingResource final : public std::pmr::memory_resource
+{
+  public:
+    explicit CountingResource(std::pmr::memory_resource *upstream_) : upstream(upstream_) {}
+
+    std::size_t allocations = 0;
+
+  private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++allocations;
+        return upstream->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *pointer, std::size_t bytes, std::size_t alignment) override
+    {
+        upstream->deallocate(pointer, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource *upstream;
+};
+
+json::Object load(const rapidjson::Document &document)
+{
+    json::Value result;
+    convert(document, result);
+    return std::get<json::Object>(std::move(result));
+}
+
+rapidjson::Document parse(const char *filename)
 {
     // load file to std string
     std::ifstream file(filename);
@@ -89,10 +125,15 @@ json::Object load(const char *filename)
     {
         throw std::runtime_error("Failed to parse JSON");
     }
+    return document;
+}
 
-    json::Value result;
-    convert(document, result);
-    return std::get<json::Object>(result);
+// Builds, renders and frees the tree like the server does for every response
+void respond(const rapidjson::Document &document)
+{
+    const auto obj = load(document);
+    std::vector<char> out;
+    json::render(out, obj);
 }
 
 } // namespace
@@ -105,7 +146,8 @@ int main(int argc, char **argv)
         return EXIT_FAILURE;
     }
 
-    const auto obj = load(argv[1]);
+    const auto document = parse(argv[1]);
+    const auto obj = load(document);
 
     TIMER_START(string);
     std::string out_str;
@@ -131,5 +173,32 @@ int main(int argc, char **argv)
         std::cerr << "Vector/string results are not equal\n";
         throw std::logic_error("Vector/stringstream/string results are not equal");
     }
+
+    constexpr int RESPONSES = 100;
+
+    CountingResource heap{std::pmr::new_delete_resource()};
+    TIMER_START(heap);
+    for (int response = 0; response < RESPONSES; ++response)
+    {
+        const json::ScopedMemoryResource scoped_heap{&heap};
+        respond(document);
+    }
+    TIMER_STOP(heap);
+    std::cout << "Heap: " << TIMER_MSEC(heap) / RESPONSES << "ms, "
+              << heap.allocations / RESPONSES << " allocations per response" << std::endl;
+
+    CountingResource arena_upstream{std::pmr::new_delete_resource()};
+    TIMER_START(arena);
+    for (int response = 0; response < RESPONSES; ++response)
+    {
+        std::pmr::monotonic_buffer_resource arena{64 * 1024, &arena_upstream};
+        const json::ScopedMemoryResource scoped_arena{&arena};
+        respond(document);
+    }
+    TIMER_STOP(arena);
+    std::cout << "Arena: " << TIMER_MSEC(arena) / RESPONSES << "ms, "
+              << arena_upstream.allocations / RESPONSES << " allocations per response"
+              << std::endl;
+
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,125 @@
+#include "util/integer_range.hpp"
+#include "util/log.hpp"
+#include "util/query_heap.hpp"
+#include "util/static_graph.hpp"
+#include "util/timing_util.hpp"
+#include "util/typedefs.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace osrm;
+
+namespace
+{
+struct EdgeData
+{
+    EdgeWeight weight;
+};
+
+using Graph = util::StaticGraph<EdgeData>;
+
+// Road-like grid with random weights, every node is connected to its four neighbours
+Graph makeGrid(const unsigned width, std::mt19937 &generator)
+{
+    std::uniform_int_distribution<std::int32_t> weights(1, 1000);
+    std::vector<util::static_graph_details::SortableEdgeWithData<EdgeData>> edges;
+    const auto number_of_nodes = width * width;
+    for (const auto node : util::irange(0u, number_of_nodes))
+    {
+        const auto add = [&](const NodeID target)
+        {
+            const EdgeWeight weight{weights(generator)};
+            edges.emplace_back(node, target, EdgeData{weight});
+            edges.emplace_back(target, node, EdgeData{weight});
+        };
+        if (node % width + 1 < width)
+        {
+            add(node + 1);
+        }
+        if (node + width < number_of_nodes)
+        {
+            add(node + width);
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    return Graph(number_of_nodes, edges);
+}
+
+template <template <typename> class HeapContainerT>
+void benchmark(const std::string &name,
+               const Graph &graph,
+               const std::vector<NodeID> &sources,
+               const std::size_t max_settled)
+{
+    util::QueryHeap<NodeID,
+                    NodeID,
+                    EdgeWeight,
+                    NodeID,
+                    util::ArrayStorage<NodeID, NodeID>,
+                    HeapContainerT>
+        heap(graph.GetNumberOfNodes());
+
+    std::int64_t checksum = 0;
+    TIMER_START(search);
+    for (const auto source : sources)
+    {
+        heap.Clear();
+        heap.Insert(source, EdgeWeight{0}, source);
+        for (std::size_t settled = 0; !heap.Empty() && settled < max_settled; ++settled)
+        {
+            const auto weight = heap.MinKey();
+            const auto node = heap.DeleteMin();
+            checksum += from_alias<std::int32_t>(weight);
+            for (const auto edge : graph.GetAdjacentEdgeRange(node))
+            {
+                const auto target = graph.GetTarget(edge);
+                const auto to_weight = weight + graph.GetEdgeData(edge).weight;
+                const auto target_node = heap.GetHeapNodeIfWasInserted(target);
+                if (!target_node)
+                {
+                    heap.Insert(target, to_weight, node);
+                }
+                else if (to_weight < target_node->weight)
+                {
+                    target_node->data = node;
+                    target_node->weight = to_weight;
+                    heap.DecreaseKey(*target_node);
+                }
+            }
+        }
+    }
+    TIMER_STOP(search);
+
+    std::cout << "  " << name << ": " << TIMER_MSEC(search) / sources.size()
+              << " ms/search (checksum " << checksum << ")" << std::endl;
+}
+} // namespace
+
+int main(int, char **)
+{
+    util::LogPolicy::GetInstance().Unmute();
+
+    std::mt19937 generator(1337);
+    const auto graph = makeGrid(500, generator);
+    std::uniform_int_distribution<NodeID> nodes(0, graph.GetNumberOfNodes() - 1);
+    std::vector<NodeID> sources(100);
+    for (auto &source : sources)
+    {
+        source = nodes(generator);
+    }
+
+    // small searches like CH queries, medium ones like the cells of the customizer and searches
+    // over the whole graph like one-to-many searches without a target
+    for (const std::size_t max_settled : {1000u, 25000u, 250000u})
+    {
+        std::cout << "Dijkstra settling up to " << max_settled << " nodes:" << std::endl;
+        benchmark<util::QuaternaryHeap>("4-ary heap", graph, sources, max_settled);
+        benchmark<util::IntegerRadixHeap>("radix heap", graph, sources, max_settled);
+    }
+    return EXIT_SUCCESS;
+}
@@ -38,9 +38,6 @@ try
                                                                    : EngineConfig::Algorithm::CH;
     config.use_shared_memory = false;
 
-    // Routing machine with several services (such as Route, Table, Nearest, Trip, Match)
-    OSRM osrm{config};
-
     struct Benchmark
     {
         std::string name;
@@ -51,7 +48,7 @@ try
         std::optional<double> radius = std::nullopt;
     };
 
-    auto run_benchmark = [&](const Benchmark &benchmark)
+    auto run_benchmark = [&](const OSRM &osrm, const Benchmark &benchmark)
     {
         RouteParameters params;
         params.overview = benchmark.overview;
@@ -116,9 +113,30 @@ try
 
     };
 
-    for (const auto &benchmark : benchmarks)
+    // CH can index its query heaps with hash maps (default) or flat arrays, measure both
+    std::vector<bool> heap_storages = {false};
+    if (config.algorithm == EngineConfig::Algorithm::CH)
+    {
+        heap_storages.push_back(true);
+    }
+
+    for (const auto use_array_heap_storage : heap_storages)
     {
-        run_benchmark(benchmark);
+        config.use_array_heap_storage = use_array_heap_storage;
+
+        // Routing machine with several services (such as Route, Table, Nearest, Trip, Match)
+        OSRM osrm{config};
+
+        if (config.algorithm == EngineConfig::Algorithm::CH)
+        {
+            std::cout << "Heap storage: " << (use_array_heap_storage ? "array" : "hash map")
+                      << std::endl;
+        }
+
+        for (const auto &benchmark : benchmarks)
+        {
+            run_benchmark(osrm, benchmark);
+        }
     }
 
     return EXIT_SUCCESS;
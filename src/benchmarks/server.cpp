@@ -0,0 +1,195 @@
+#include "server/api/parsed_url.hpp"
+#include "server/server.hpp"
+#include "server/service_handler.hpp"
+
+#include "util/json_container.hpp"
+#include "util/log.hpp"
+
+#include <boost/asio.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace osrm;
+
+namespace
+{
+// Answers every request at once, so only the network code of the server is measured
+class EchoServiceHandler final : public server::ServiceHandlerInterface
+{
+  public:
+    engine::Status RunQuery(server::api::ParsedURL, engine::api::ResultT &result) override
+    {
+        util::json::Object response;
+        response.values["code"] = "Ok";
+        result = std::move(response);
+        return engine::Status::Ok;
+    }
+};
+
+struct Result
+{
+    std::size_t requests = 0;
+    std::size_t errors = 0;
+    std::vector<std::chrono::nanoseconds> latencies;
+};
+
+// Reads one reply, the body either has a Content-Length or ends with the connection
+bool readReply(boost::asio::ip::tcp::socket &socket, std::string &buffer)
+{
+    boost::system::error_code error;
+    buffer.clear();
+    const auto header_size =
+        boost::asio::read_until(socket, boost::asio::dynamic_buffer(buffer), "\r\n\r\n", error);
+    if (error)
+    {
+        return false;
+    }
+
+    const auto length_position = buffer.find("Content-Length: ");
+    if (length_position == std::string::npos || length_position > header_size)
+    {
+        boost::asio::read(socket, boost::asio::dynamic_buffer(buffer), error);
+        return error == boost::asio::error::eof;
+    }
+    const auto content_length =
+        std::stoul(buffer.substr(length_position + std::string("Content-Length: ").size()));
+    if (buffer.size() < header_size + content_length)
+    {
+        boost::asio::read(socket,
+                          boost::asio::dynamic_buffer(buffer),
+                          boost::asio::transfer_exactly(header_size + content_length -
+                                                        buffer.size()),
+                          error);
+    }
+    return !error && buffer.compare(8, 5, " 200 ") == 0;
+}
+
+// Sends requests from every client for the duration. With churn every request opens a new
+// connection, like a load balancer that does not keep connections alive.
+Result runClients(const unsigned short port,
+                  const unsigned number_of_clients,
+                  const bool churn,
+                  const std::chrono::seconds duration)
+{
+    const auto request = std::string("GET /route/v1/driving/7.41,43.73;7.42,43.74 HTTP/1.1\r\n"
+                                     "Host: localhost\r\n") +
+                         (churn ? "Connection: close\r\n\r\n" : "Connection: keep-alive\r\n\r\n");
+    const boost::asio::ip::tcp::endpoint endpoint{boost::asio::ip::address_v4::loopback(), port};
+    const auto end = std::chrono::steady_clock::now() + duration;
+
+    std::vector<Result> results(number_of_clients);
+    std::vector<std::thread> clients;
+    for (unsigned client = 0; client < number_of_clients; ++client)
+    {
+        clients.emplace_back(
+            [&, client]
+            {
+                auto &result = results[client];
+                boost::asio::io_context io_context;
+                boost::asio::ip::tcp::socket socket(io_context);
+                std::string buffer;
+                while (std::chrono::steady_clock::now() < end)
+                {
+                    const auto start = std::chrono::steady_clock::now();
+                    boost::system::error_code error;
+                    if (!socket.is_open())
+                    {
+                        socket.connect(endpoint, error);
+                        socket.set_option(boost::asio::ip::tcp::no_delay(true), error);
+                    }
+                    if (!error)
+                    {
+                        boost::asio::write(socket, boost::asio::buffer(request), error);
+                    }
+                    if (error || !readReply(socket, buffer))
+                    {
+                        ++result.errors;
+                        socket.close(error);
+                        continue;
+                    }
+                    // the server closes kept alive connections after a number of requests
+                    if (churn || buffer.find(", max=0\r\n") != std::string::npos)
+                    {
+                        socket.close(error);
+                    }
+                    ++result.requests;
+                    result.latencies.push_back(std::chrono::steady_clock::now() - start);
+                }
+            });
+    }
+    for (auto &client : clients)
+    {
+        client.join();
+    }
+
+    Result total;
+    for (auto &result : results)
+    {
+        total.requests += result.requests;
+        total.errors += result.errors;
+        total.latencies.insert(
+            total.latencies.end(), result.latencies.begin(), result.latencies.end());
+    }
+    return total;
+}
+
+void report(const std::string &name, Result result, const std::chrono::seconds duration)
+{
+    const auto quantile = [&](const double q)
+    {
+        if (result.latencies.empty())
+        {
+            return 0.;
+        }
+        const auto nth = result.latencies.begin() +
+                         static_cast<std::size_t>(q * (result.latencies.size() - 1));
+        std::nth_element(result.latencies.begin(), nth, result.latencies.end());
+        return std::chrono::duration<double, std::milli>(*nth).count();
+    };
+
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed
+              << std::setprecision(0) << std::setw(10)
+              << static_cast<double>(result.requests) / duration.count() << " req/s"
+              << std::setprecision(3) << "  p50 " << quantile(0.5) << "ms  p99 "
+              << quantile(0.99) << "ms  errors " << result.errors << std::endl;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const auto hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+    const unsigned io_threads = argc > 1 ? std::stoul(argv[1]) : hardware_threads;
+    const unsigned clients = argc > 2 ? std::stoul(argv[2]) : 4 * io_threads;
+    const std::chrono::seconds duration{argc > 3 ? std::stoul(argv[3]) : 5};
+
+    util::LogPolicy::GetInstance().Mute();
+    std::cout << "I/O threads: " << io_threads << ", clients: " << clients
+              << ", duration: " << duration.count() << "s" << std::endl;
+
+    for (const auto listener_per_thread : {false, true})
+    {
+        std::string address = "127.0.0.1";
+        auto server = server::Server::CreateServer(
+            address, 0, io_threads, io_threads, 5, listener_per_thread);
+        server->RegisterServiceHandler(std::make_unique<EchoServiceHandler>());
+        std::thread server_thread([&] { server->Run(); });
+
+        const std::string mode = listener_per_thread ? "listener per thread" : "shared listener";
+        report(mode + ", keep-alive",
+               runClients(server->GetPort(), clients, false, duration),
+               duration);
+        report(mode + ", churn", runClients(server->GetPort(), clients, true, duration), duration);
+
+        server->Stop();
+        server_thread.join();
+    }
+
+    return EXIT_SUCCESS;
+}
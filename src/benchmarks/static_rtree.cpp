@@ -44,7 +44,35 @@ void benchmarkQuery(const std::vector<util::Coordinate> &queries,
 
     std::cout << name << ":\n"
               << TIMER_MSEC(query) << "ms"
-              << " ->  " << TIMER_MSEC(query) / queries.size() << " ms/query" << std::endl;
+              << " ->  " << TIMER_MSEC(query) / queries.size() << " ms/query"
+              << " ->  " << queries.size() / TIMER_SEC(query) << " queries/s" << std::endl;
+}
+
+void benchmarkBatchQuery(BenchStaticRTree &rtree,
+                         const std::vector<util::Coordinate> &queries,
+                         const std::string &name,
+                         const std::size_t max_results)
+{
+    const auto all_segments = [](const BenchStaticRTree::CandidateSegment &)
+    { return std::make_pair(true, true); };
+    const auto enough_results =
+        [max_results](const std::size_t num_results, const BenchStaticRTree::CandidateSegment &)
+    { return num_results >= max_results; };
+
+    TIMER_START(query);
+    rtree.BatchNearest(queries,
+                       [&](const std::size_t index, BenchStaticRTree::LeafCache &leaf_cache)
+                       {
+                           auto result = rtree.Nearest(
+                               queries[index], all_segments, enough_results, &leaf_cache);
+                           (void)result;
+                       });
+    TIMER_STOP(query);
+
+    std::cout << name << ":\n"
+              << TIMER_MSEC(query) << "ms"
+              << " ->  " << TIMER_MSEC(query) / queries.size() << " ms/query"
+              << " ->  " << queries.size() / TIMER_SEC(query) << " queries/s" << std::endl;
 }
 
 void benchmark(BenchStaticRTree &rtree, unsigned num_queries)
@@ -64,6 +92,8 @@ void benchmark(BenchStaticRTree &rtree, unsigned num_queries)
     benchmarkQuery(queries,
                    "10 results",
                    [&rtree](const util::Coordinate &q) { return rtree.Nearest(q, 10); });
+    benchmarkBatchQuery(rtree, queries, "1 result (batch)", 1);
+    benchmarkBatchQuery(rtree, queries, "10 results (batch)", 10);
 }
 } // namespace osrm::benchmarks
 
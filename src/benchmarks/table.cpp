@@ -0,0 +1,114 @@
+#include "engine/engine_config.hpp"
+#include "util/coordinate.hpp"
+#include "util/timing_util.hpp"
+
+#include "osrm/table_parameters.hpp"
+
+#include "osrm/coordinate.hpp"
+#include "osrm/engine_config.hpp"
+#include "osrm/json_container.hpp"
+
+#include "osrm/osrm.hpp"
+#include "osrm/status.hpp"
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+int main(int argc, const char *argv[])
+try
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " data.osrm [ch|mld] [phast-min-targets]\n";
+        return EXIT_FAILURE;
+    }
+
+    using namespace osrm;
+
+    // Configure based on a .osrm base path, and no datasets in shared mem from osrm-datastore
+    EngineConfig config;
+    config.storage_config = {argv[1]};
+    config.algorithm = (argc > 2 && std::string{argv[2]} == "mld") ? EngineConfig::Algorithm::MLD
+                                                                   : EngineConfig::Algorithm::CH;
+    config.use_shared_memory = false;
+    // Only has an effect on datasets contracted with --phast
+    config.phast_min_targets = argc > 3 ? std::stoi(argv[3]) : -1;
+
+    OSRM osrm{config};
+
+    struct Benchmark
+    {
+        std::string name;
+        std::size_t coordinates;
+        std::size_t iterations;
+        bool distances = false;
+    };
+
+    // Coordinates are spread uniformly over the Monaco bounding box, seeded so that
+    // runs are comparable with each other.
+    auto make_coordinates = [](const std::size_t count)
+    {
+        std::mt19937 generator(1337);
+        std::uniform_real_distribution<double> longitude(7.40, 7.44);
+        std::uniform_real_distribution<double> latitude(43.72, 43.75);
+
+        std::vector<util::Coordinate> coordinates;
+        coordinates.reserve(count);
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            coordinates.emplace_back(util::FloatLongitude{longitude(generator)},
+                                     util::FloatLatitude{latitude(generator)});
+        }
+        return coordinates;
+    };
+
+    auto run_benchmark = [&](const Benchmark &benchmark)
+    {
+        TableParameters params;
+        params.coordinates = make_coordinates(benchmark.coordinates);
+        params.annotations = benchmark.distances ? TableParameters::AnnotationsType::All
+                                                 : TableParameters::AnnotationsType::Duration;
+
+        TIMER_START(tables);
+        for (std::size_t i = 0; i < benchmark.iterations; ++i)
+        {
+            engine::api::ResultT result = json::Object();
+            const auto rc = osrm.Table(params, result);
+            auto &json_result = std::get<json::Object>(result);
+            if (rc != Status::Ok ||
+                json_result.values.find("durations") == json_result.values.end())
+            {
+                throw std::runtime_error{"Couldn't compute table"};
+            }
+        }
+        TIMER_STOP(tables);
+        std::cout << benchmark.name << std::endl;
+        std::cout << TIMER_MSEC(tables) << "ms" << std::endl;
+        std::cout << TIMER_MSEC(tables) / benchmark.iterations << "ms/req" << std::endl;
+    };
+
+    std::vector<Benchmark> benchmarks = {
+        {"100 tables, 100x100 coordinates, durations", 100, 100},
+        {"100 tables, 100x100 coordinates, durations and distances", 100, 100, true},
+        {"10 tables, 500x500 coordinates, durations", 500, 10},
+        {"10 tables, 500x500 coordinates, durations and distances", 500, 10, true},
+        {"2 tables, 2000x2000 coordinates, durations", 2000, 2},
+    };
+
+    for (const auto &benchmark : benchmarks)
+    {
+        run_benchmark(benchmark);
+    }
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,63 @@
+#include "contractor/compressed_query_graph.hpp"
+
+#include "util/integer_range.hpp"
+#include "util/log.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace osrm::contractor
+{
+
+CompressedQueryGraph compressQueryGraph(const QueryGraph &graph)
+{
+    const auto number_of_nodes = graph.GetNumberOfNodes();
+    const auto number_of_edges = graph.GetNumberOfEdges();
+
+    std::vector<CompressedQueryGraph::NodeArrayEntry> node_array;
+    node_array.reserve(number_of_nodes + 1);
+    util::PatchedPackedVector<CompressedQueryGraph::TARGET_BITS> targets;
+    util::PatchedPackedVector<CompressedQueryGraph::TURN_ID_BITS> turn_ids;
+    util::PatchedPackedVector<CompressedQueryGraph::WEIGHT_BITS> weights;
+    util::PatchedPackedVector<CompressedQueryGraph::DURATION_BITS> durations;
+    util::PatchedPackedVector<CompressedQueryGraph::DISTANCE_BITS> distances;
+    targets.reserve(number_of_edges);
+    turn_ids.reserve(number_of_edges);
+    weights.reserve(number_of_edges);
+    durations.reserve(number_of_edges);
+    distances.reserve(number_of_edges);
+
+    for (const auto node : util::irange(0u, number_of_nodes))
+    {
+        node_array.push_back({graph.BeginEdges(node)});
+        for (const auto edge : graph.GetAdjacentEdgeRange(node))
+        {
+            const auto &data = graph.GetEdgeData(edge);
+            const auto difference =
+                static_cast<std::int64_t>(graph.GetTarget(edge)) - static_cast<std::int64_t>(node);
+            targets.push_back(util::zigzagEncode(difference) << 3 | data.shortcut << 2 |
+                              data.forward << 1 | data.backward);
+            turn_ids.push_back(data.turn_id);
+            weights.push_back(static_cast<std::uint32_t>(from_alias<std::int32_t>(data.weight)));
+            durations.push_back(static_cast<std::uint32_t>(data.duration));
+            distances.push_back(std::bit_cast<std::uint32_t>(from_alias<float>(data.distance)));
+        }
+    }
+    node_array.push_back({number_of_edges});
+
+    util::Log() << "Compressed graph keeps " << targets.GetNumberOfExceptions() << " targets, "
+                << turn_ids.GetNumberOfExceptions() << " turn ids, "
+                << weights.GetNumberOfExceptions() << " weights, "
+                << durations.GetNumberOfExceptions() << " durations and "
+                << distances.GetNumberOfExceptions() << " distances of " << number_of_edges
+                << " edges as exceptions";
+
+    return CompressedQueryGraph{std::move(node_array),
+                                std::move(targets),
+                                std::move(turn_ids),
+                                std::move(weights),
+                                std::move(durations),
+                                std::move(distances)};
+}
+} // namespace osrm::contractor
@@ -1,15 +1,20 @@
 #include "contractor/contractor.hpp"
+#include "contractor/compressed_query_graph.hpp"
 #include "contractor/contract_excludable_graph.hpp"
 #include "contractor/contracted_edge_container.hpp"
 #include "contractor/files.hpp"
 #include "contractor/graph_contractor.hpp"
 #include "contractor/graph_contractor_adaptors.hpp"
+#include "contractor/phast_sweep.hpp"
+#include "contractor/renumber.hpp"
 
 #include "extractor/compressed_edge_container.hpp"
 #include "extractor/edge_based_graph_factory.hpp"
 #include "extractor/files.hpp"
 #include "extractor/node_based_edge.hpp"
 
+#include "partitioner/renumber.hpp"
+
 #include "storage/io.hpp"
 
 #include "updater/updater.hpp"
@@ -20,6 +25,8 @@
 #include "util/filtered_graph.hpp"
 #include "util/integer_range.hpp"
 #include "util/log.hpp"
+#include "util/mmap_file.hpp"
+#include "util/permutation.hpp"
 #include "util/static_graph.hpp"
 #include "util/string_util.hpp"
 #include "util/timing_util.hpp"
@@ -27,13 +34,95 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <filesystem>
 #include <iterator>
 #include <vector>
 
+#include <boost/iostreams/device/mapped_file.hpp>
+
 #include <tbb/global_control.h>
 
 namespace osrm::contractor
 {
+namespace
+{
+// Applies the permutation to every file that is indexed by edge-based node, like osrm-partition
+// does for its cell order
+void renumberEdgeBasedNodes(const ContractorConfig &config,
+                            const std::vector<std::uint32_t> &permutation)
+{
+    {
+        EdgeID number_of_edge_based_nodes;
+        std::vector<extractor::EdgeBasedEdge> edges;
+        std::uint32_t connectivity_checksum;
+        extractor::files::readEdgeBasedGraph(
+            config.GetPath(".osrm.ebg"), number_of_edge_based_nodes, edges, connectivity_checksum);
+        for (auto &edge : edges)
+        {
+            edge.source = permutation[edge.source];
+            edge.target = permutation[edge.target];
+        }
+        extractor::files::writeEdgeBasedGraph(
+            config.GetPath(".osrm.ebg"), number_of_edge_based_nodes, edges, connectivity_checksum);
+    }
+    {
+        std::vector<extractor::NBGToEBG> mapping;
+        extractor::files::readNBGMapping(config.GetPath(".osrm.cnbg_to_ebg").string(), mapping);
+        partitioner::renumber(mapping, permutation);
+        extractor::files::writeNBGMapping(config.GetPath(".osrm.cnbg_to_ebg").string(), mapping);
+    }
+    {
+        boost::iostreams::mapped_file segment_region;
+        auto segments = util::mmapFile<extractor::EdgeBasedNodeSegment>(
+            config.GetPath(".osrm.fileIndex"), segment_region);
+        partitioner::renumber(segments, permutation);
+    }
+    {
+        extractor::EdgeBasedNodeDataContainer node_data;
+        extractor::files::readNodeData(config.GetPath(".osrm.ebg_nodes"), node_data);
+        partitioner::renumber(node_data, permutation);
+        extractor::files::writeNodeData(config.GetPath(".osrm.ebg_nodes"), node_data);
+    }
+    {
+        std::vector<EdgeWeight> node_weights;
+        std::vector<EdgeDuration> node_durations;
+        std::vector<EdgeDistance> node_distances;
+        extractor::files::readEdgeBasedNodeWeightsDurations(
+            config.GetPath(".osrm.enw"), node_weights, node_durations);
+        extractor::files::readEdgeBasedNodeDistances(config.GetPath(".osrm.enw"), node_distances);
+        util::inplacePermutation(node_weights.begin(), node_weights.end(), permutation);
+        util::inplacePermutation(node_durations.begin(), node_durations.end(), permutation);
+        util::inplacePermutation(node_distances.begin(), node_distances.end(), permutation);
+        extractor::files::writeEdgeBasedNodeWeightsDurationsDistances(
+            config.GetPath(".osrm.enw"), node_weights, node_durations, node_distances);
+    }
+    {
+        const auto &filename = config.GetPath(".osrm.maneuver_overrides");
+        std::vector<extractor::StorageManeuverOverride> maneuver_overrides;
+        std::vector<NodeID> node_sequences;
+        extractor::files::readManeuverOverrides(filename, maneuver_overrides, node_sequences);
+        partitioner::renumber(maneuver_overrides, permutation);
+        partitioner::renumber(node_sequences, permutation);
+        // lookups do a binary search by start node
+        std::sort(maneuver_overrides.begin(),
+                  maneuver_overrides.end(),
+                  [](const auto &a, const auto &b) { return a.start_node < b.start_node; });
+        extractor::files::writeManeuverOverrides(filename, maneuver_overrides, node_sequences);
+    }
+
+    for (const auto &extension : {".osrm.partition", ".osrm.cells", ".osrm.mldgr"})
+    {
+        if (std::filesystem::exists(config.GetPath(extension)))
+        {
+            util::Log(logWARNING)
+                << "Found existing " << extension
+                << " file, removing. MLD data can not be used with renumbered nodes, run "
+                   "osrm-partition and osrm-customize on a separate extract.";
+            std::filesystem::remove(config.GetPath(extension));
+        }
+    }
+}
+} // namespace
 
 int Contractor::Run()
 {
@@ -104,8 +193,45 @@ int Contractor::Run()
     util::Log() << "Contracted graph has " << query_graph.GetNumberOfEdges() << " edges.";
     util::Log() << "Contraction took " << TIMER_SEC(contraction) << " sec";
 
+    if (config.renumber_nodes)
+    {
+        TIMER_START(renumber);
+        const auto permutation = makePermutation(query_graph);
+        renumber(query_graph, edge_filters, permutation);
+        renumberEdgeBasedNodes(config, permutation);
+        TIMER_STOP(renumber);
+        util::Log() << "Renumbered data in " << TIMER_SEC(renumber) << " seconds";
+    }
+
+    std::vector<PhastSweep> phast_sweeps;
+    if (config.build_phast_sweep)
+    {
+        TIMER_START(phast);
+        for (const auto &edge_filter : edge_filters)
+        {
+            phast_sweeps.push_back(buildPhastSweep(query_graph, edge_filter));
+        }
+        TIMER_STOP(phast);
+        util::Log() << "Computing PHAST sweeps took " << TIMER_SEC(phast) << " sec";
+    }
+
+    CompressedQueryGraph compressed_graph;
+    if (config.compress_graph)
+    {
+        TIMER_START(compress);
+        compressed_graph = compressQueryGraph(query_graph);
+        // only one of the graphs is written
+        query_graph = QueryGraph{};
+        TIMER_STOP(compress);
+        util::Log() << "Compressing the contracted graph took " << TIMER_SEC(compress) << " sec";
+    }
+
     std::unordered_map<std::string, ContractedMetric> metrics = {
-        {metric_name, {std::move(query_graph), std::move(edge_filters)}}};
+        {metric_name,
+         {std::move(query_graph),
+          std::move(edge_filters),
+          std::move(phast_sweeps),
+          std::move(compressed_graph)}}};
 
     files::writeGraph(config.GetPath(".osrm.hsgr"), metrics, connectivity_checksum);
 
@@ -0,0 +1,121 @@
+#include "contractor/phast_sweep.hpp"
+
+#include "util/exception.hpp"
+#include "util/integer_range.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+
+namespace osrm::contractor
+{
+
+PhastSweep buildPhastSweep(const QueryGraph &graph, const std::vector<bool> &edge_filter)
+{
+    const auto number_of_nodes = graph.GetNumberOfNodes();
+    BOOST_ASSERT(edge_filter.size() == graph.GetNumberOfEdges());
+
+    // Edges of a contraction hierarchy are stored at the lower node and point to the higher
+    // one. Peel off the highest nodes first: a node can be placed as soon as all nodes it has
+    // an upward edge to have been placed.
+    std::vector<std::uint32_t> remaining_upward(number_of_nodes, 0);
+    std::vector<std::uint32_t> first_lower(number_of_nodes + 1, 0);
+    for (const auto node : util::irange(0u, number_of_nodes))
+    {
+        for (const auto edge : graph.GetAdjacentEdgeRange(node))
+        {
+            const auto target = graph.GetTarget(edge);
+            if (edge_filter[edge] && target != node)
+            {
+                ++remaining_upward[node];
+                ++first_lower[target + 1];
+            }
+        }
+    }
+    std::partial_sum(first_lower.begin(), first_lower.end(), first_lower.begin());
+
+    std::vector<NodeID> lower_nodes(first_lower.back());
+    {
+        auto fill = first_lower;
+        for (const auto node : util::irange(0u, number_of_nodes))
+        {
+            for (const auto edge : graph.GetAdjacentEdgeRange(node))
+            {
+                const auto target = graph.GetTarget(edge);
+                if (edge_filter[edge] && target != node)
+                {
+                    lower_nodes[fill[target]++] = node;
+                }
+            }
+        }
+    }
+
+    PhastSweep sweep;
+    sweep.nodes.reserve(number_of_nodes);
+    for (const auto node : util::irange(0u, number_of_nodes))
+    {
+        if (remaining_upward[node] == 0)
+        {
+            sweep.nodes.push_back(node);
+        }
+    }
+    for (std::size_t position = 0; position < sweep.nodes.size(); ++position)
+    {
+        const auto node = sweep.nodes[position];
+        for (auto index = first_lower[node]; index < first_lower[node + 1]; ++index)
+        {
+            const auto lower = lower_nodes[index];
+            if (--remaining_upward[lower] == 0)
+            {
+                sweep.nodes.push_back(lower);
+            }
+        }
+    }
+
+    if (sweep.nodes.size() != number_of_nodes)
+    {
+        throw util::exception("Can not compute a PHAST sweep: " +
+                              std::to_string(number_of_nodes - sweep.nodes.size()) +
+                              " nodes are part of a cycle in the upward graph.");
+    }
+
+    sweep.positions.resize(number_of_nodes);
+    for (const auto position : util::irange<std::uint32_t>(0, number_of_nodes))
+    {
+        sweep.positions[sweep.nodes[position]] = position;
+    }
+
+    // An edge at node v to node u with the backward flag set describes the arc u -> v
+    sweep.first_arc.reserve(number_of_nodes + 1);
+    sweep.first_arc.push_back(0);
+    for (const auto position : util::irange<std::uint32_t>(0, number_of_nodes))
+    {
+        const auto node = sweep.nodes[position];
+        const auto begin = sweep.arcs.size();
+        for (const auto edge : graph.GetAdjacentEdgeRange(node))
+        {
+            const auto &data = graph.GetEdgeData(edge);
+            if (!edge_filter[edge] || !data.backward)
+            {
+                continue;
+            }
+
+            const auto tail = sweep.positions[graph.GetTarget(edge)];
+            BOOST_ASSERT(tail <= position);
+            sweep.arcs.push_back({tail,
+                                  data.weight,
+                                  to_alias<EdgeDuration>(data.duration),
+                                  data.distance});
+        }
+        // Reading the tails in ascending order keeps the sweep mostly sequential in memory
+        std::sort(sweep.arcs.begin() + begin,
+                  sweep.arcs.end(),
+                  [](const auto &lhs, const auto &rhs) { return lhs.tail < rhs.tail; });
+        sweep.first_arc.push_back(sweep.arcs.size());
+    }
+
+    return sweep;
+}
+} // namespace osrm::contractor
@@ -0,0 +1,164 @@
+#include "contractor/renumber.hpp"
+
+#include "util/integer_range.hpp"
+#include "util/permutation.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+namespace osrm::contractor
+{
+
+std::vector<std::uint32_t> makePermutation(const QueryGraph &graph)
+{
+    const auto number_of_nodes = graph.GetNumberOfNodes();
+
+    // Edges of a contraction hierarchy are stored at the lower node and point to the higher one
+    std::vector<std::uint32_t> remaining_lower(number_of_nodes, 0);
+    std::vector<std::uint32_t> first_lower(number_of_nodes + 1, 0);
+    for (const auto node : util::irange(0u, number_of_nodes))
+    {
+        for (const auto edge : graph.GetAdjacentEdgeRange(node))
+        {
+            const auto target = graph.GetTarget(edge);
+            if (target != node)
+            {
+                ++remaining_lower[target];
+                ++first_lower[target + 1];
+            }
+        }
+    }
+    std::partial_sum(first_lower.begin(), first_lower.end(), first_lower.begin());
+
+    std::vector<NodeID> lower_nodes(first_lower.back());
+    {
+        auto fill = first_lower;
+        for (const auto node : util::irange(0u, number_of_nodes))
+        {
+            for (const auto edge : graph.GetAdjacentEdgeRange(node))
+            {
+                const auto target = graph.GetTarget(edge);
+                if (target != node)
+                {
+                    lower_nodes[fill[target]++] = node;
+                }
+            }
+        }
+    }
+
+    // The level of a node is one more than the highest level of the nodes below it. Nodes are
+    // placed bottom-up as soon as all nodes below them are.
+    std::vector<std::uint32_t> level(number_of_nodes, 0);
+    std::vector<NodeID> bottom_up;
+    bottom_up.reserve(number_of_nodes);
+    for (const auto node : util::irange(0u, number_of_nodes))
+    {
+        if (remaining_lower[node] == 0)
+        {
+            bottom_up.push_back(node);
+        }
+    }
+    for (std::size_t index = 0; index < bottom_up.size(); ++index)
+    {
+        const auto node = bottom_up[index];
+        for (const auto edge : graph.GetAdjacentEdgeRange(node))
+        {
+            const auto target = graph.GetTarget(edge);
+            if (target != node)
+            {
+                level[target] = std::max(level[target], level[node] + 1);
+                if (--remaining_lower[target] == 0)
+                {
+                    bottom_up.push_back(target);
+                }
+            }
+        }
+    }
+
+    // The hierarchies of different exclude flags can order the nodes of their core
+    // differently, so the union of all edges may contain cycles. Such nodes are put on top.
+    const auto top_level =
+        bottom_up.empty() ? 0 : *std::max_element(level.begin(), level.end()) + 1;
+    for (const auto node : util::irange(0u, number_of_nodes))
+    {
+        if (remaining_lower[node] != 0)
+        {
+            level[node] = top_level;
+        }
+    }
+
+    std::vector<NodeID> ordering(number_of_nodes);
+    std::iota(ordering.begin(), ordering.end(), 0);
+    std::stable_sort(ordering.begin(),
+                     ordering.end(),
+                     [&level](const auto lhs, const auto rhs) { return level[lhs] > level[rhs]; });
+
+    // Depth-first search down the hierarchy, starting from the highest nodes
+    std::vector<std::uint32_t> dfs_order(number_of_nodes, SPECIAL_NODEID);
+    std::uint32_t next_order = 0;
+    std::vector<NodeID> stack;
+    for (const auto root : ordering)
+    {
+        if (dfs_order[root] != SPECIAL_NODEID)
+        {
+            continue;
+        }
+        stack.push_back(root);
+        while (!stack.empty())
+        {
+            const auto node = stack.back();
+            stack.pop_back();
+            if (dfs_order[node] != SPECIAL_NODEID)
+            {
+                continue;
+            }
+            dfs_order[node] = next_order++;
+            // reversed, so the first lower node is visited first
+            for (auto index = first_lower[node + 1]; index > first_lower[node]; --index)
+            {
+                const auto lower = lower_nodes[index - 1];
+                if (dfs_order[lower] == SPECIAL_NODEID)
+                {
+                    stack.push_back(lower);
+                }
+            }
+        }
+    }
+    BOOST_ASSERT(next_order == number_of_nodes);
+
+    std::sort(ordering.begin(),
+              ordering.end(),
+              [&](const auto lhs, const auto rhs)
+              {
+                  return level[lhs] > level[rhs] ||
+                         (level[lhs] == level[rhs] && dfs_order[lhs] < dfs_order[rhs]);
+              });
+
+    return util::orderingToPermutation(ordering);
+}
+
+void renumber(QueryGraph &graph,
+              std::vector<std::vector<bool>> &edge_filters,
+              const std::vector<std::uint32_t> &permutation)
+{
+    const auto edge_permutation = graph.Renumber(permutation);
+    for (auto &edge_filter : edge_filters)
+    {
+        util::inplacePermutation(edge_filter.begin(), edge_filter.end(), edge_permutation);
+    }
+
+    for (const auto node : util::irange(0u, graph.GetNumberOfNodes()))
+    {
+        for (const auto edge : graph.GetAdjacentEdgeRange(node))
+        {
+            auto &data = graph.GetEdgeData(edge);
+            if (data.shortcut)
+            {
+                data.turn_id = permutation[data.turn_id];
+            }
+        }
+    }
+}
+} // namespace osrm::contractor
@@ -0,0 +1,83 @@
+#include "customizer/compressed_multi_level_graph.hpp"
+
+#include "util/integer_range.hpp"
+#include "util/log.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace osrm::customizer
+{
+
+CompressedMultiLevelEdgeBasedGraph compressMultiLevelGraph(const MultiLevelEdgeBasedGraph &graph)
+{
+    using Graph = CompressedMultiLevelEdgeBasedGraph;
+
+    const auto number_of_nodes = graph.GetNumberOfNodes();
+    const auto number_of_edges = graph.GetNumberOfEdges();
+    const auto number_of_levels = graph.GetNumberOfLevels();
+    const auto max_border_node_id = graph.GetMaxBorderNodeID();
+
+    std::vector<Graph::NodeArrayEntry> node_array;
+    node_array.reserve(number_of_nodes + 1);
+    util::PatchedPackedVector<Graph::TARGET_BITS> targets;
+    util::PatchedPackedVector<Graph::TURN_ID_BITS> turn_ids;
+    util::PatchedPackedVector<Graph::WEIGHT_BITS> node_weights;
+    util::PatchedPackedVector<Graph::DURATION_BITS> node_durations;
+    util::PatchedPackedVector<Graph::DISTANCE_BITS> node_distances;
+    targets.reserve(number_of_edges);
+    turn_ids.reserve(number_of_edges);
+    node_weights.reserve(number_of_nodes);
+    node_durations.reserve(number_of_nodes);
+    node_distances.reserve(number_of_nodes);
+
+    for (const auto node : util::irange(0u, number_of_nodes))
+    {
+        node_array.push_back({graph.BeginEdges(node)});
+        for (const auto edge : graph.GetAdjacentEdgeRange(node))
+        {
+            const auto difference =
+                static_cast<std::int64_t>(graph.GetTarget(edge)) - static_cast<std::int64_t>(node);
+            targets.push_back(util::zigzagEncode(difference) << 2 |
+                              graph.IsForwardEdge(edge) << 1 | graph.IsBackwardEdge(edge));
+            turn_ids.push_back(graph.GetEdgeData(edge).turn_id);
+        }
+        node_weights.push_back(
+            static_cast<std::uint32_t>(from_alias<std::int32_t>(graph.GetNodeWeight(node))));
+        node_durations.push_back(
+            static_cast<std::uint32_t>(from_alias<std::int32_t>(graph.GetNodeDuration(node))));
+        node_distances.push_back(
+            std::bit_cast<std::uint32_t>(from_alias<float>(graph.GetNodeDistance(node))));
+    }
+    node_array.push_back({number_of_edges});
+
+    // the offsets are only stored for the border nodes, the number of levels is the sentinel
+    std::vector<Graph::EdgeOffset> node_to_edge_offset;
+    node_to_edge_offset.reserve(number_of_levels * (max_border_node_id + 1) + 1);
+    for (const auto node : util::irange<NodeID>(0, max_border_node_id + 1))
+    {
+        for (const auto level : util::irange<LevelID>(0, number_of_levels))
+        {
+            node_to_edge_offset.push_back(graph.BeginBorderEdges(level, node) -
+                                          graph.BeginEdges(node));
+        }
+    }
+    node_to_edge_offset.push_back(number_of_levels);
+
+    util::Log() << "Compressed graph keeps " << targets.GetNumberOfExceptions() << " targets and "
+                << turn_ids.GetNumberOfExceptions() << " turn ids of " << number_of_edges
+                << " edges and " << node_weights.GetNumberOfExceptions() << " weights, "
+                << node_durations.GetNumberOfExceptions() << " durations and "
+                << node_distances.GetNumberOfExceptions() << " distances of " << number_of_nodes
+                << " nodes as exceptions";
+
+    return Graph{std::move(node_array),
+                 std::move(targets),
+                 std::move(turn_ids),
+                 std::move(node_to_edge_offset),
+                 std::move(node_weights),
+                 std::move(node_durations),
+                 std::move(node_distances)};
+}
+} // namespace osrm::customizer
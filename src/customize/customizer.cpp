@@ -1,6 +1,7 @@
 #include "extractor/node_data_container.hpp"
 
 #include "customizer/cell_customizer.hpp"
+#include "customizer/compressed_multi_level_graph.hpp"
 #include "customizer/customizer.hpp"
 #include "customizer/edge_based_graph.hpp"
 #include "customizer/files.hpp"
@@ -174,8 +175,17 @@ int Customizer::Run(const CustomizationConfig &config)
                                           std::move(node_weights),
                                           std::move(node_durations),
                                           std::move(node_distances)};
-    customizer::files::writeGraph(
-        config.GetPath(".osrm.mldgr"), shaved_graph, connectivity_checksum);
+    if (config.compress_graph)
+    {
+        customizer::files::writeCompressedGraph(config.GetPath(".osrm.mldgr"),
+                                                compressMultiLevelGraph(shaved_graph),
+                                                connectivity_checksum);
+    }
+    else
+    {
+        customizer::files::writeGraph(
+            config.GetPath(".osrm.mldgr"), shaved_graph, connectivity_checksum);
+    }
     TIMER_STOP(writing_graph);
     util::Log() << "Graph writing took " << TIMER_SEC(writing_graph) << " seconds";
 
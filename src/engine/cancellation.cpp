@@ -0,0 +1,10 @@
+#include "engine/cancellation.hpp"
+
+namespace osrm::engine
+{
+
+// This function exists to 'anchor' the class, and stop the compiler from
+// copying vtable and RTTI info into every object file that includes
+// this header. (Caught by -Wweak-vtables under Clang.)
+void RequestCancelledException::anchor() const {}
+} // namespace osrm::engine
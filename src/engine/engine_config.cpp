@@ -15,10 +15,16 @@ bool EngineConfig::IsValid() const
     const bool limits_valid = unlimited_or_more_than(max_locations_distance_table, 2) &&
                               unlimited_or_more_than(max_locations_map_matching, 2) &&
                               unlimited_or_more_than(max_radius_map_matching, 0) &&
+                              unlimited_or_more_than(max_duration_isochrone, 0) &&
                               unlimited_or_more_than(max_locations_trip, 2) &&
                               unlimited_or_more_than(max_locations_viaroute, 2) &&
                               unlimited_or_more_than(max_results_nearest, 0) &&
-                              unlimited_or_more_than(default_radius, 0) && max_alternatives >= 0;
+                              unlimited_or_more_than(default_radius, 0) &&
+                              unlimited_or_more_than(max_heap_memory_mb, 0) &&
+                              unlimited_or_more_than(phast_min_targets, 0) &&
+                              unlimited_or_more_than(snapping_cache_size, 0) &&
+                              unlimited_or_more_than(route_cache_size, 0) &&
+                              many_to_many_threads >= 1 && max_alternatives >= 0;
 
     return ((use_shared_memory && all_path_are_empty) || (use_mmap && storage_config.IsValid()) ||
             storage_config.IsValid()) &&
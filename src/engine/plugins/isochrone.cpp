@@ -0,0 +1,80 @@
+#include "engine/plugins/isochrone.hpp"
+#include "engine/api/isochrone_api.hpp"
+#include "engine/api/isochrone_parameters.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include <boost/assert.hpp>
+
+namespace osrm::engine::plugins
+{
+
+IsochronePlugin::IsochronePlugin(const double max_duration_,
+                                 const std::optional<double> default_radius_)
+    : BasePlugin(default_radius_), max_duration{max_duration_}
+{
+}
+
+Status IsochronePlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
+                                      const api::IsochroneParameters &params,
+                                      osrm::engine::api::ResultT &result) const
+{
+    BOOST_ASSERT(params.IsValid());
+
+    if (!algorithms.HasIsochroneSearch())
+    {
+        return Error("NotImplemented",
+                     "Isochrone search is not implemented for the chosen search algorithm.",
+                     result);
+    }
+
+    if (!CheckAlgorithms(params, algorithms, result))
+        return Status::Error;
+
+    if (!std::holds_alternative<util::json::Object>(result) &&
+        !std::holds_alternative<api::RenderedJSON>(result))
+    {
+        return Error("InvalidOptions", "Isochrones are only available as JSON", result);
+    }
+
+    if (!CheckAllCoordinates(params.coordinates))
+        return Error("InvalidOptions", "Coordinates are invalid", result);
+
+    if (params.coordinates.size() != 1)
+    {
+        return Error("InvalidOptions", "Only one input coordinate is supported", result);
+    }
+
+    if (max_duration > 0 && params.duration > max_duration)
+    {
+        return Error("TooBig",
+                     "Duration " + std::to_string(params.duration) +
+                         " is higher than current maximum (" + std::to_string(max_duration) + ")",
+                     result);
+    }
+
+    const auto &facade = algorithms.GetFacade();
+    auto phantom_nodes = GetPhantomNodes(algorithms, params);
+    if (phantom_nodes.size() != params.coordinates.size())
+    {
+        return Error(
+            "NoSegment", MissingPhantomErrorMessage(phantom_nodes, params.coordinates), result);
+    }
+    auto snapped_phantoms = SnapPhantomNodes(std::move(phantom_nodes));
+
+    // Durations are stored in deciseconds
+    const auto max_edge_duration = to_alias<EdgeDuration>(
+        std::min(std::floor(params.duration * 10), from_alias<double>(MAXIMAL_EDGE_DURATION)));
+    const bool polygon = params.output == api::IsochroneParameters::OutputType::Polygon;
+    const auto reached =
+        algorithms.IsochroneSearch(snapped_phantoms.front(), max_edge_duration, !polygon);
+
+    api::IsochroneAPI isochrone_api(facade, params);
+    const util::ScopedRequestPhase assembly(util::RequestPhase::Assembly);
+    isochrone_api.MakeResponse(snapped_phantoms.front(), reached, result);
+
+    return Status::Ok;
+}
+} // namespace osrm::engine::plugins
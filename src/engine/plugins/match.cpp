@@ -311,6 +311,7 @@ Status MatchPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
     }
 
     api::MatchAPI match_api{facade, parameters, tidied};
+    const util::ScopedRequestPhase assembly(util::RequestPhase::Assembly);
     match_api.MakeResponse(sub_matchings, sub_routes, result);
 
     return Status::Ok;
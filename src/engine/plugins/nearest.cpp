@@ -52,6 +52,7 @@ Status NearestPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms
     BOOST_ASSERT(phantom_nodes.front().size() > 0);
 
     api::NearestAPI nearest_api(facade, params);
+    const util::ScopedRequestPhase assembly(util::RequestPhase::Assembly);
     nearest_api.MakeResponse(phantom_nodes, result);
 
     return Status::Ok;
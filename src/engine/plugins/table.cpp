@@ -15,8 +15,10 @@ namespace osrm::engine::plugins
 {
 
 TablePlugin::TablePlugin(const int max_locations_distance_table,
+                         const int phast_min_targets,
                          const std::optional<double> default_radius)
-    : BasePlugin(default_radius), max_locations_distance_table(max_locations_distance_table)
+    : BasePlugin(default_radius), max_locations_distance_table(max_locations_distance_table),
+      phast_min_targets(phast_min_targets)
 {
 }
 
@@ -62,7 +64,7 @@ Status TablePlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
         return Status::Error;
 
     const auto &facade = algorithms.GetFacade();
-    auto phantom_nodes = GetPhantomNodes(facade, params);
+    auto phantom_nodes = GetPhantomNodes(algorithms, params);
 
     if (phantom_nodes.size() != params.coordinates.size())
     {
@@ -75,8 +77,16 @@ Status TablePlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
     bool request_distance = params.annotations & api::TableParameters::AnnotationsType::Distance;
     bool request_duration = params.annotations & api::TableParameters::AnnotationsType::Duration;
 
-    auto result_tables_pair = algorithms.ManyToManySearch(
-        snapped_phantoms, params.sources, params.destinations, request_distance);
+    // The cost of a PHAST row does not depend on the number of targets, so it only pays off for
+    // tables whose targets cover a large part of the graph
+    const bool use_phast = phast_min_targets > 0 &&
+                           num_destinations >= static_cast<std::size_t>(phast_min_targets) &&
+                           algorithms.HasPhastSearch();
+    auto result_tables_pair =
+        use_phast ? algorithms.PhastManyToManySearch(
+                        snapped_phantoms, params.sources, params.destinations, request_distance)
+                  : algorithms.ManyToManySearch(
+                        snapped_phantoms, params.sources, params.destinations, request_distance);
 
     if ((request_duration && result_tables_pair.first.empty()) ||
         (request_distance && result_tables_pair.second.empty()))
@@ -150,6 +160,7 @@ Status TablePlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
     }
 
     api::TableAPI table_api{facade, params};
+    const util::ScopedRequestPhase assembly(util::RequestPhase::Assembly);
     table_api.MakeResponse(result_tables_pair, snapped_phantoms, estimated_pairs, result);
 
     return Status::Ok;
@@ -192,7 +192,7 @@ Status TripPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
         return Status::Error;
 
     const auto &facade = algorithms.GetFacade();
-    auto phantom_node_pairs = GetPhantomNodes(facade, parameters);
+    auto phantom_node_pairs = GetPhantomNodes(algorithms, parameters);
     if (phantom_node_pairs.size() != number_of_locations)
     {
         return Error("NoSegment",
@@ -288,6 +288,7 @@ Status TripPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
     const std::vector<std::vector<NodeID>> trips = {duration_trip};
     const std::vector<InternalRouteResult> routes = {route};
     api::TripAPI trip_api{facade, parameters};
+    const util::ScopedRequestPhase assembly(util::RequestPhase::Assembly);
     trip_api.MakeResponse(trips, routes, snapped_phantoms, result);
 
     return Status::Ok;
@@ -83,7 +83,7 @@ Status ViaRoutePlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithm
         return Status::Error;
 
     const auto &facade = algorithms.GetFacade();
-    auto phantom_node_pairs = GetPhantomNodes(facade, route_parameters);
+    auto phantom_node_pairs = GetPhantomNodes(algorithms, route_parameters);
     if (phantom_node_pairs.size() != route_parameters.coordinates.size())
     {
         return Error("NoSegment",
@@ -152,6 +152,7 @@ Status ViaRoutePlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithm
             }
         }
 
+        const util::ScopedRequestPhase assembly(util::RequestPhase::Assembly);
         route_api.MakeResponse(routes, snapped_phantoms, result);
     }
     else
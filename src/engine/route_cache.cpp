@@ -0,0 +1,109 @@
+#include "engine/route_cache.hpp"
+
+#include <type_traits>
+
+namespace osrm::engine
+{
+
+std::atomic<std::uint64_t> RouteCacheStatistics::hits{0};
+std::atomic<std::uint64_t> RouteCacheStatistics::misses{0};
+std::atomic<std::uint64_t> RouteCacheStatistics::admissions{0};
+std::atomic<std::uint64_t> RouteCacheStatistics::evictions{0};
+
+namespace
+{
+// Values are appended with their size or a presence flag, so different parameters can never
+// result in the same key
+template <typename T> void append(std::string &key, const T value)
+{
+    static_assert(std::is_trivially_copyable_v<T> && std::has_unique_object_representations_v<T>,
+                  "only values without padding can be appended as bytes");
+    key.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void append(std::string &key, const double value)
+{
+    key.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void append(std::string &key, const std::string &value)
+{
+    append(key, value.size());
+    key += value;
+}
+
+void append(std::string &key, const Hint &hint) { append(key, hint.ToBase64()); }
+
+template <typename T> void append(std::string &key, const std::optional<T> &value)
+{
+    append(key, value.has_value());
+    if (value)
+    {
+        append(key, *value);
+    }
+}
+
+template <typename T> void append(std::string &key, const std::vector<T> &values)
+{
+    append(key, values.size());
+    for (const auto &value : values)
+    {
+        append(key, value);
+    }
+}
+} // namespace
+
+RouteCache::RouteCache(const std::size_t capacity) : cache(capacity) {}
+
+std::optional<std::vector<char>> RouteCache::Find(const std::shared_ptr<const void> &facade,
+                                                  const std::string &key)
+{
+    auto response = cache.Find(facade, key);
+    if (response)
+    {
+        RouteCacheStatistics::hits.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        RouteCacheStatistics::misses.fetch_add(1, std::memory_order_relaxed);
+    }
+    return response;
+}
+
+void RouteCache::Insert(const std::shared_ptr<const void> &facade,
+                        std::string key,
+                        std::vector<char> response)
+{
+    const auto evicted = cache.Insert(facade, std::move(key), std::move(response));
+    RouteCacheStatistics::admissions.fetch_add(1, std::memory_order_relaxed);
+    RouteCacheStatistics::evictions.fetch_add(evicted, std::memory_order_relaxed);
+}
+
+std::string RouteCache::MakeKey(const api::RouteParameters &parameters)
+{
+    std::string key;
+
+    append(key, parameters.coordinates);
+    append(key, parameters.hints);
+    append(key, parameters.radiuses);
+    append(key, parameters.bearings);
+    append(key, parameters.approaches);
+    append(key, parameters.exclude);
+    append(key, parameters.format);
+    append(key, parameters.generate_hints);
+    append(key, parameters.skip_waypoints);
+    append(key, parameters.snapping);
+
+    append(key, parameters.steps);
+    append(key, parameters.alternatives);
+    append(key, parameters.number_of_alternatives);
+    append(key, parameters.annotations);
+    append(key, parameters.annotations_type);
+    append(key, parameters.geometries);
+    append(key, parameters.overview);
+    append(key, parameters.continue_straight);
+    append(key, parameters.waypoints);
+
+    return key;
+}
+} // namespace osrm::engine
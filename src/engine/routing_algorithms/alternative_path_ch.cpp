@@ -57,6 +57,8 @@ void alternativeRoutingStep(const DataFacade<Algorithm> &facade,
     QueryHeap &forward_heap = DIRECTION == FORWARD_DIRECTION ? heap1 : heap2;
     QueryHeap &reverse_heap = DIRECTION == FORWARD_DIRECTION ? heap2 : heap1;
 
+    CheckCancellation();
+
     // Take a copy (no ref &) of the extracted node because otherwise could be modified later if
     // toHeapNode is the same
     const auto heapNode = forward_heap.DeleteMinGetHeapNode();
@@ -100,12 +102,12 @@ void alternativeRoutingStep(const DataFacade<Algorithm> &facade,
         }
     }
 
-    for (auto edge : facade.GetAdjacentEdgeRange(heapNode.node))
+    for (const auto &edge : facade.GetAdjacentEdges(heapNode.node))
     {
-        const auto &data = facade.GetEdgeData(edge);
+        const auto &data = edge.data;
         if (DIRECTION == FORWARD_DIRECTION ? data.forward : data.backward)
         {
-            const NodeID to = facade.GetTarget(edge);
+            const NodeID to = edge.target;
             const EdgeWeight edge_weight = data.weight;
 
             BOOST_ASSERT(edge_weight > EdgeWeight{0});
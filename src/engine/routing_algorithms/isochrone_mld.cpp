@@ -0,0 +1,282 @@
+#include "engine/routing_algorithms/isochrone.hpp"
+#include "engine/routing_algorithms/routing_base_mld.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+namespace osrm::engine::routing_algorithms
+{
+
+namespace mld
+{
+namespace
+{
+using IsochroneHeap = SearchEngineData<Algorithm>::ManyToManyQueryHeap;
+
+struct SettledNode
+{
+    NodeID node;
+    LevelID level;
+    EdgeWeight weight;
+    EdgeDuration duration;
+};
+
+// Cell of the overlay that still has to be searched on the level below, starting from the
+// nodes of the cell that were settled by the search on its own level
+struct CellSearch
+{
+    LevelID level;
+    CellID cell;
+    std::vector<SettledNode> seeds;
+};
+
+// Forward relaxation of many_to_many_mld.cpp without distances. Args are either the source
+// candidates for the unrestricted search or a level and a parent cell for searches inside a cell.
+template <typename... Args>
+void relaxIsochroneEdges(const DataFacade<Algorithm> &facade,
+                         const IsochroneHeap::HeapNode &heapNode,
+                         const LevelID level,
+                         IsochroneHeap &query_heap,
+                         const Args &...args)
+{
+    const auto &partition = facade.GetMultiLevelPartition();
+
+    if (level >= 1 && !heapNode.data.from_clique_arc)
+    {
+        const auto &cells = facade.GetCellStorage();
+        const auto &metric = facade.GetCellMetric();
+        const auto &cell = cells.GetCell(metric, level, partition.GetCell(level, heapNode.node));
+
+        auto destination = cell.GetDestinationNodes().begin();
+        auto shortcut_durations = cell.GetOutDuration(heapNode.node);
+        for (auto shortcut_weight : cell.GetOutWeight(heapNode.node))
+        {
+            BOOST_ASSERT(destination != cell.GetDestinationNodes().end());
+            BOOST_ASSERT(!shortcut_durations.empty());
+            const NodeID to = *destination;
+
+            if (shortcut_weight != INVALID_EDGE_WEIGHT && heapNode.node != to)
+            {
+                insertOrUpdate(query_heap,
+                               to,
+                               heapNode.weight + shortcut_weight,
+                               {heapNode.node,
+                                true,
+                                heapNode.data.duration + shortcut_durations.front(),
+                                EdgeDistance{0}});
+            }
+            ++destination;
+            shortcut_durations.advance(1);
+        }
+    }
+
+    const auto node_weight = facade.GetNodeWeight(heapNode.node);
+    const auto node_duration = facade.GetNodeDuration(heapNode.node);
+    for (const auto &edge : facade.GetBorderEdges(level, heapNode.node))
+    {
+        if (!edge.forward)
+        {
+            continue;
+        }
+
+        const NodeID to = edge.target;
+        if (facade.ExcludeNode(to) ||
+            !checkParentCellRestriction(partition.GetCell(level + 1, to), args...))
+        {
+            continue;
+        }
+
+        const auto turn_id = edge.data.turn_id;
+        const auto to_weight = heapNode.weight + node_weight +
+                               alias_cast<EdgeWeight>(facade.GetWeightPenaltyForEdgeID(turn_id));
+        const auto to_duration =
+            heapNode.data.duration + node_duration +
+            alias_cast<EdgeDuration>(facade.GetDurationPenaltyForEdgeID(turn_id));
+
+        insertOrUpdate(
+            query_heap, to, to_weight, {heapNode.node, false, to_duration, EdgeDistance{0}});
+    }
+}
+
+// Runs the search until the heap is exhausted. The duration along a shortest path never
+// decreases, so nothing behind a node that is out of the budget can be within it again.
+template <typename... Args>
+std::vector<SettledNode> boundedSearch(const DataFacade<Algorithm> &facade,
+                                       IsochroneHeap &query_heap,
+                                       const EdgeDuration max_duration,
+                                       const Args &...args)
+{
+    const auto &partition = facade.GetMultiLevelPartition();
+
+    std::vector<SettledNode> settled;
+    while (!query_heap.Empty())
+    {
+        CheckCancellation();
+
+        const auto heapNode = query_heap.DeleteMinGetHeapNode();
+        if (heapNode.data.duration > max_duration)
+        {
+            continue;
+        }
+
+        const auto level = getNodeQueryLevel(partition, heapNode.node, args...);
+        BOOST_ASSERT(level != INVALID_LEVEL_ID);
+
+        settled.push_back({heapNode.node, level, heapNode.weight, heapNode.data.duration});
+        relaxIsochroneEdges(facade, heapNode, level, query_heap, args...);
+    }
+    return settled;
+}
+
+bool isReached(const IsochroneHeap &query_heap, const NodeID node, const EdgeDuration max_duration)
+{
+    return query_heap.WasInserted(node) && query_heap.GetData(node).duration <= max_duration;
+}
+
+// Splits the settled nodes of a finished search into the nodes of the base graph and the cells
+// that have to be searched on the next lower level. The heap of the search must still be intact.
+void collectSettledNodes(const DataFacade<Algorithm> &facade,
+                         const IsochroneHeap &query_heap,
+                         const EdgeDuration max_duration,
+                         const bool descend_into_reached_cells,
+                         std::vector<SettledNode> settled,
+                         std::vector<IsochroneNode> &reached,
+                         std::vector<CellSearch> &pending)
+{
+    const auto &partition = facade.GetMultiLevelPartition();
+    const auto &cells = facade.GetCellStorage();
+    const auto &metric = facade.GetCellMetric();
+
+    auto cell_of = [&partition](const SettledNode &settled_node)
+    {
+        return std::make_tuple(settled_node.level,
+                               settled_node.level == 0
+                                   ? CellID{0}
+                                   : partition.GetCell(settled_node.level, settled_node.node));
+    };
+    std::sort(settled.begin(),
+              settled.end(),
+              [&](const auto &lhs, const auto &rhs) { return cell_of(lhs) < cell_of(rhs); });
+
+    auto begin = settled.begin();
+    while (begin != settled.end())
+    {
+        const auto key = cell_of(*begin);
+        const auto end = std::find_if(begin,
+                                      settled.end(),
+                                      [&](const auto &settled_node)
+                                      { return cell_of(settled_node) != key; });
+        const auto [level, cell_id] = key;
+
+        bool descend = level > 0;
+        if (descend && !descend_into_reached_cells)
+        {
+            const auto &cell = cells.GetCell(metric, level, cell_id);
+            const auto reached_border = [&](const NodeID node)
+            { return isReached(query_heap, node, max_duration); };
+            descend = !std::all_of(cell.GetSourceNodes().begin(),
+                                   cell.GetSourceNodes().end(),
+                                   reached_border) ||
+                      !std::all_of(cell.GetDestinationNodes().begin(),
+                                   cell.GetDestinationNodes().end(),
+                                   reached_border);
+        }
+
+        if (descend)
+        {
+            pending.push_back({level, cell_id, std::vector<SettledNode>(begin, end)});
+        }
+        else
+        {
+            std::transform(begin,
+                           end,
+                           std::back_inserter(reached),
+                           [](const SettledNode &settled_node) {
+                               return IsochroneNode{settled_node.node, settled_node.duration};
+                           });
+        }
+        begin = end;
+    }
+}
+} // namespace
+} // namespace mld
+
+//
+// Bounded one-to-all search on the multi-level overlay. The first search runs on the overlay
+// like a one-to-many search and skips the inside of all cells that do not contain the source.
+// Every cell it touches is then searched on the next lower level, restricted to the cell and
+// seeded with the nodes settled on its border, until the base graph is reached.
+//
+template <>
+std::vector<IsochroneNode> isochroneSearch(SearchEngineData<mld::Algorithm> &engine_working_data,
+                                           const DataFacade<mld::Algorithm> &facade,
+                                           const PhantomNodeCandidates &source_candidates,
+                                           const EdgeDuration max_duration,
+                                           const bool descend_into_reached_cells)
+{
+    engine_working_data.InitializeOrClearManyToManyThreadLocalStorage(
+        facade.GetNumberOfNodes(), facade.GetMaxBorderNodeID() + 1);
+    auto &query_heap = *(engine_working_data.many_to_many_heap);
+
+    for (const auto &phantom_node : source_candidates)
+    {
+        if (phantom_node.IsValidForwardSource())
+        {
+            mld::insertOrUpdate(query_heap,
+                                phantom_node.forward_segment_id.id,
+                                EdgeWeight{0} - phantom_node.GetForwardWeightPlusOffset(),
+                                {phantom_node.forward_segment_id.id,
+                                 EdgeDuration{0} - phantom_node.GetForwardDuration(),
+                                 EdgeDistance{0}});
+        }
+        if (phantom_node.IsValidReverseSource())
+        {
+            mld::insertOrUpdate(query_heap,
+                                phantom_node.reverse_segment_id.id,
+                                EdgeWeight{0} - phantom_node.GetReverseWeightPlusOffset(),
+                                {phantom_node.reverse_segment_id.id,
+                                 EdgeDuration{0} - phantom_node.GetReverseDuration(),
+                                 EdgeDistance{0}});
+        }
+    }
+
+    std::vector<IsochroneNode> reached;
+    std::vector<mld::CellSearch> pending;
+    auto settled = mld::boundedSearch(facade, query_heap, max_duration, source_candidates);
+    mld::collectSettledNodes(facade,
+                             query_heap,
+                             max_duration,
+                             descend_into_reached_cells,
+                             std::move(settled),
+                             reached,
+                             pending);
+
+    while (!pending.empty())
+    {
+        auto search = std::move(pending.back());
+        pending.pop_back();
+
+        query_heap.Clear();
+        for (const auto &seed : search.seeds)
+        {
+            query_heap.Insert(seed.node, seed.weight, {seed.node, seed.duration, EdgeDistance{0}});
+        }
+
+        const LevelID level = search.level - 1;
+        settled = mld::boundedSearch(facade, query_heap, max_duration, level, search.cell);
+        mld::collectSettledNodes(facade,
+                                 query_heap,
+                                 max_duration,
+                                 descend_into_reached_cells,
+                                 std::move(settled),
+                                 reached,
+                                 pending);
+    }
+
+    return reached;
+}
+
+} // namespace osrm::engine::routing_algorithms
@@ -4,6 +4,7 @@
 #include <boost/assert.hpp>
 #include <ranges>
 
+#include <algorithm>
 #include <vector>
 
 namespace osrm::engine::routing_algorithms
@@ -50,12 +51,12 @@ void relaxOutgoingEdges(
         return;
     }
 
-    for (auto edge : facade.GetAdjacentEdgeRange(heapNode.node))
+    for (const auto &edge : facade.GetAdjacentEdges(heapNode.node))
     {
-        const auto &data = facade.GetEdgeData(edge);
+        const auto &data = edge.data;
         if (DIRECTION == FORWARD_DIRECTION ? data.forward : data.backward)
         {
-            const NodeID to = facade.GetTarget(edge);
+            const NodeID to = edge.target;
             const auto edge_weight = data.weight;
 
             const auto edge_duration = data.duration;
@@ -95,6 +96,8 @@ void forwardRoutingStep(const DataFacade<Algorithm> &facade,
                         std::vector<NodeID> &middle_nodes_table,
                         const PhantomNodeCandidates &candidates)
 {
+    CheckCancellation();
+
     // Take a copy of the extracted node because otherwise could be modified later if toHeapNode is
     // the same
     const auto heapNode = query_heap.DeleteMinGetHeapNode();
@@ -154,6 +157,8 @@ void backwardRoutingStep(const DataFacade<Algorithm> &facade,
                          std::vector<NodeBucket> &search_space_with_buckets,
                          const PhantomNodeCandidates &candidates)
 {
+    CheckCancellation();
+
     // Take a copy (no ref &) of the extracted node because otherwise could be modified later if
     // toHeapNode is the same
     const auto heapNode = query_heap.DeleteMinGetHeapNode();
@@ -169,6 +174,201 @@ void backwardRoutingStep(const DataFacade<Algorithm> &facade,
     relaxOutgoingEdges<REVERSE_DIRECTION>(facade, heapNode, query_heap, candidates);
 }
 
+// Labels of all nodes indexed by sweep position, reused for all rows handled by a thread
+struct PhastLabels
+{
+    std::vector<EdgeWeight> weights;
+    std::vector<EdgeDuration> durations;
+    std::vector<EdgeDistance> distances;
+};
+
+// A candidate node of a target together with the offsets of the target on it
+struct PhastTarget
+{
+    std::uint32_t position;
+    EdgeWeight weight;
+    EdgeDuration duration;
+    EdgeDistance distance;
+};
+
+void phastSweep(const contractor::PhastSweepView &sweep,
+                PhastLabels &labels,
+                const bool calculate_distance)
+{
+    const auto number_of_positions = static_cast<std::uint32_t>(sweep.nodes.size());
+    for (std::uint32_t position = 0; position < number_of_positions; ++position)
+    {
+        auto weight = labels.weights[position];
+        auto duration = labels.durations[position];
+        auto distance = calculate_distance ? labels.distances[position] : EdgeDistance{0};
+
+        const auto end = sweep.first_arc[position + 1];
+        for (auto arc_index = sweep.first_arc[position]; arc_index < end; ++arc_index)
+        {
+            const auto &arc = sweep.arcs[arc_index];
+            const auto tail_weight = labels.weights[arc.tail];
+            if (tail_weight == INVALID_EDGE_WEIGHT)
+            {
+                continue;
+            }
+
+            const auto new_weight = tail_weight + arc.weight;
+            const auto new_duration = labels.durations[arc.tail] + arc.duration;
+            if (std::tie(new_weight, new_duration) < std::tie(weight, duration))
+            {
+                weight = new_weight;
+                duration = new_duration;
+                if (calculate_distance)
+                {
+                    distance = labels.distances[arc.tail] + arc.distance;
+                }
+            }
+        }
+
+        labels.weights[position] = weight;
+        labels.durations[position] = duration;
+        if (calculate_distance)
+        {
+            labels.distances[position] = distance;
+        }
+    }
+}
+
+void phastRow(const DataFacade<Algorithm> &facade,
+              const contractor::PhastSweepView &sweep,
+              const std::size_t row_index,
+              const std::vector<std::size_t> &first_target,
+              const std::vector<PhastTarget> &targets,
+              typename SearchEngineData<Algorithm>::ManyToManyQueryHeap &query_heap,
+              PhastLabels &labels,
+              std::vector<EdgeWeight> &weights_table,
+              std::vector<EdgeDuration> &durations_table,
+              std::vector<EdgeDistance> &distances_table,
+              const PhantomNodeCandidates &candidates)
+{
+    const bool calculate_distance = !distances_table.empty();
+    const auto number_of_positions = sweep.nodes.size();
+    labels.weights.assign(number_of_positions, INVALID_EDGE_WEIGHT);
+    labels.durations.assign(number_of_positions, MAXIMAL_EDGE_DURATION);
+    labels.distances.assign(calculate_distance ? number_of_positions : 0, MAXIMAL_EDGE_DISTANCE);
+
+    // Upward search: nodes on the upward part of a shortest path are never stalled, so the
+    // settled labels are a valid starting point for the sweep
+    insertSourceInHeap(query_heap, candidates);
+    while (!query_heap.Empty())
+    {
+        CheckCancellation();
+
+        const auto heapNode = query_heap.DeleteMinGetHeapNode();
+        const auto position = sweep.positions[heapNode.node];
+        labels.weights[position] = heapNode.weight;
+        labels.durations[position] = heapNode.data.duration;
+        if (calculate_distance)
+        {
+            labels.distances[position] = heapNode.data.distance;
+        }
+
+        relaxOutgoingEdges<FORWARD_DIRECTION>(facade, heapNode, query_heap, candidates);
+    }
+
+    phastSweep(sweep, labels, calculate_distance);
+
+    // Source nodes start with a negative weight. A target behind the source on the same node
+    // can only be reached by leaving the node and coming back, which the label of the node
+    // itself does not cover. Recompute the best way back from the final labels of its arcs.
+    std::vector<PhastTarget> returning;
+    for (const auto &phantom_node : candidates)
+    {
+        for (const auto segment : {phantom_node.forward_segment_id,
+                                   phantom_node.reverse_segment_id})
+        {
+            if (segment.enabled)
+            {
+                returning.push_back({sweep.positions[segment.id],
+                                     INVALID_EDGE_WEIGHT,
+                                     MAXIMAL_EDGE_DURATION,
+                                     MAXIMAL_EDGE_DISTANCE});
+            }
+        }
+    }
+    for (auto &node : returning)
+    {
+        for (auto arc_index = sweep.first_arc[node.position];
+             arc_index < sweep.first_arc[node.position + 1];
+             ++arc_index)
+        {
+            const auto &arc = sweep.arcs[arc_index];
+            const auto tail_weight = labels.weights[arc.tail];
+            if (tail_weight == INVALID_EDGE_WEIGHT)
+            {
+                continue;
+            }
+            const auto new_weight = tail_weight + arc.weight;
+            const auto new_duration = labels.durations[arc.tail] + arc.duration;
+            if (std::tie(new_weight, new_duration) < std::tie(node.weight, node.duration))
+            {
+                node.weight = new_weight;
+                node.duration = new_duration;
+                if (calculate_distance)
+                {
+                    node.distance = labels.distances[arc.tail] + arc.distance;
+                }
+            }
+        }
+    }
+
+    const auto number_of_targets = first_target.size() - 1;
+    const auto row_offset = row_index * number_of_targets;
+    for (const auto column_index : util::irange<std::size_t>(0, number_of_targets))
+    {
+        const auto table_index = row_offset + column_index;
+        auto &current_weight = weights_table[table_index];
+        auto &current_duration = durations_table[table_index];
+
+        for (auto index = first_target[column_index]; index < first_target[column_index + 1];
+             ++index)
+        {
+            const auto &target = targets[index];
+            auto weight = labels.weights[target.position];
+            auto duration = labels.durations[target.position];
+            auto distance =
+                calculate_distance ? labels.distances[target.position] : EdgeDistance{0};
+            if (weight == INVALID_EDGE_WEIGHT)
+            {
+                continue;
+            }
+
+            if (weight + target.weight < EdgeWeight{0})
+            {
+                const auto way_back = std::find_if(returning.begin(),
+                                                   returning.end(),
+                                                   [&](const auto &node)
+                                                   { return node.position == target.position; });
+                if (way_back == returning.end() || way_back->weight == INVALID_EDGE_WEIGHT)
+                {
+                    continue;
+                }
+                weight = way_back->weight;
+                duration = way_back->duration;
+                distance = way_back->distance;
+            }
+
+            const auto new_weight = weight + target.weight;
+            const auto new_duration = duration + target.duration;
+            if (new_weight >= EdgeWeight{0} &&
+                std::tie(new_weight, new_duration) < std::tie(current_weight, current_duration))
+            {
+                current_weight = new_weight;
+                current_duration = new_duration;
+                if (calculate_distance)
+                {
+                    distances_table[table_index] = distance + target.distance;
+                }
+            }
+        }
+    }
+}
+
 } // namespace ch
 
 template <>
@@ -190,57 +390,140 @@ manyToManySearch(SearchEngineData<ch::Algorithm> &engine_working_data,
                                               MAXIMAL_EDGE_DISTANCE);
     std::vector<NodeID> middle_nodes_table(number_of_entries, SPECIAL_NODEID);
 
-    std::vector<NodeBucket> search_space_with_buckets;
+    const auto threads =
+        getManyToManyThreads(engine_working_data.many_to_many_threads, number_of_entries);
 
     // Populate buckets with paths from all accessible nodes to destinations via backward searches
-    for (std::uint32_t column_index = 0; column_index < target_indices.size(); ++column_index)
-    {
-        const auto index = target_indices[column_index];
-        const auto &target_candidates = candidates_list[index];
-
-        engine_working_data.InitializeOrClearManyToManyThreadLocalStorage(
-            facade.GetNumberOfNodes());
-        auto &query_heap = *(engine_working_data.many_to_many_heap);
-        insertTargetInHeap(query_heap, target_candidates);
-
-        // Explore search space
-        while (!query_heap.Empty())
+    auto search_space_with_buckets = computeSortedBuckets(
+        engine_working_data,
+        threads,
+        number_of_targets,
+        [&](const std::uint32_t column_index, std::vector<NodeBucket> &buckets)
         {
-            backwardRoutingStep(
-                facade, column_index, query_heap, search_space_with_buckets, target_candidates);
-        }
-    }
+            const auto index = target_indices[column_index];
+            const auto &target_candidates = candidates_list[index];
 
-    // Order lookup buckets
-    std::sort(search_space_with_buckets.begin(), search_space_with_buckets.end());
+            engine_working_data.InitializeOrClearManyToManyThreadLocalStorage(
+                facade.GetNumberOfNodes());
+            auto &query_heap = *(engine_working_data.many_to_many_heap);
+            insertTargetInHeap(query_heap, target_candidates);
+
+            // Explore search space
+            while (!query_heap.Empty())
+            {
+                backwardRoutingStep(facade, column_index, query_heap, buckets, target_candidates);
+            }
+        });
 
     // Find shortest paths from sources to all accessible nodes
-    for (std::uint32_t row_index = 0; row_index < source_indices.size(); ++row_index)
-    {
-        const auto source_index = source_indices[row_index];
-        const auto &source_candidates = candidates_list[source_index];
+    computeRows(engine_working_data,
+                threads,
+                number_of_sources,
+                [&](const std::uint32_t row_index)
+                {
+                    const auto source_index = source_indices[row_index];
+                    const auto &source_candidates = candidates_list[source_index];
+
+                    // Clear heap and insert source nodes
+                    engine_working_data.InitializeOrClearManyToManyThreadLocalStorage(
+                        facade.GetNumberOfNodes());
+                    auto &query_heap = *(engine_working_data.many_to_many_heap);
+                    insertSourceInHeap(query_heap, source_candidates);
+
+                    // Explore search space
+                    while (!query_heap.Empty())
+                    {
+                        forwardRoutingStep(facade,
+                                           row_index,
+                                           number_of_targets,
+                                           query_heap,
+                                           search_space_with_buckets,
+                                           weights_table,
+                                           durations_table,
+                                           distances_table,
+                                           middle_nodes_table,
+                                           source_candidates);
+                    }
+                });
+
+    return std::make_pair(std::move(durations_table), std::move(distances_table));
+}
+
+template <>
+std::pair<std::vector<EdgeDuration>, std::vector<EdgeDistance>>
+phastManyToManySearch(SearchEngineData<ch::Algorithm> &engine_working_data,
+                      const DataFacade<ch::Algorithm> &facade,
+                      const std::vector<PhantomNodeCandidates> &candidates_list,
+                      const std::vector<std::size_t> &source_indices,
+                      const std::vector<std::size_t> &target_indices,
+                      const bool calculate_distance)
+{
+    const auto *sweep = facade.GetPhastSweep();
+    BOOST_ASSERT(sweep);
+
+    const auto number_of_sources = source_indices.size();
+    const auto number_of_targets = target_indices.size();
+    const auto number_of_entries = number_of_sources * number_of_targets;
 
-        // Clear heap and insert source nodes
-        engine_working_data.InitializeOrClearManyToManyThreadLocalStorage(
-            facade.GetNumberOfNodes());
-        auto &query_heap = *(engine_working_data.many_to_many_heap);
-        insertSourceInHeap(query_heap, source_candidates);
+    std::vector<EdgeWeight> weights_table(number_of_entries, INVALID_EDGE_WEIGHT);
+    std::vector<EdgeDuration> durations_table(number_of_entries, MAXIMAL_EDGE_DURATION);
+    std::vector<EdgeDistance> distances_table(calculate_distance ? number_of_entries : 0,
+                                              MAXIMAL_EDGE_DISTANCE);
 
-        // Explore search space
-        while (!query_heap.Empty())
+    // The target side is the same for every row
+    std::vector<std::size_t> first_target;
+    std::vector<ch::PhastTarget> targets;
+    first_target.reserve(number_of_targets + 1);
+    for (const auto index : target_indices)
+    {
+        first_target.push_back(targets.size());
+        for (const auto &phantom_node : candidates_list[index])
         {
-            forwardRoutingStep(facade,
-                               row_index,
-                               number_of_targets,
-                               query_heap,
-                               search_space_with_buckets,
-                               weights_table,
-                               durations_table,
-                               distances_table,
-                               middle_nodes_table,
-                               source_candidates);
+            if (phantom_node.IsValidForwardTarget())
+            {
+                targets.push_back({sweep->positions[phantom_node.forward_segment_id.id],
+                                   phantom_node.GetForwardWeightPlusOffset(),
+                                   phantom_node.GetForwardDuration(),
+                                   phantom_node.GetForwardDistance()});
+            }
+            if (phantom_node.IsValidReverseTarget())
+            {
+                targets.push_back({sweep->positions[phantom_node.reverse_segment_id.id],
+                                   phantom_node.GetReverseWeightPlusOffset(),
+                                   phantom_node.GetReverseDuration(),
+                                   phantom_node.GetReverseDistance()});
+            }
         }
     }
+    first_target.push_back(targets.size());
+
+    const auto threads =
+        getManyToManyThreads(engine_working_data.many_to_many_threads, number_of_entries);
+
+    tbb::enumerable_thread_specific<ch::PhastLabels> labels;
+    computeRows(engine_working_data,
+                threads,
+                number_of_sources,
+                [&](const std::uint32_t row_index)
+                {
+                    const auto &source_candidates = candidates_list[source_indices[row_index]];
+
+                    engine_working_data.InitializeOrClearManyToManyThreadLocalStorage(
+                        facade.GetNumberOfNodes());
+                    auto &query_heap = *(engine_working_data.many_to_many_heap);
+
+                    ch::phastRow(facade,
+                                 *sweep,
+                                 row_index,
+                                 first_target,
+                                 targets,
+                                 query_heap,
+                                 labels.local(),
+                                 weights_table,
+                                 durations_table,
+                                 distances_table,
+                                 source_candidates);
+                });
 
     return std::make_pair(std::move(durations_table), std::move(distances_table));
 }
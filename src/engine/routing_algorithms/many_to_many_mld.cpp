@@ -38,20 +38,19 @@ void relaxBorderEdges(const DataFacade<mld::Algorithm> &facade,
                       typename SearchEngineData<mld::Algorithm>::ManyToManyQueryHeap &query_heap,
                       LevelID level)
 {
-    for (const auto edge : facade.GetBorderEdgeRange(level, node))
+    for (const auto &edge : facade.GetBorderEdges(level, node))
     {
-        const auto &data = facade.GetEdgeData(edge);
-        if ((DIRECTION == FORWARD_DIRECTION) ? facade.IsForwardEdge(edge)
-                                             : facade.IsBackwardEdge(edge))
+        const auto &data = edge.data;
+        if ((DIRECTION == FORWARD_DIRECTION) ? edge.forward : edge.backward)
         {
-            const NodeID to = facade.GetTarget(edge);
+            const NodeID to = edge.target;
             if (facade.ExcludeNode(to))
             {
                 continue;
             }
 
             const auto turn_id = data.turn_id;
-            const auto node_id = DIRECTION == FORWARD_DIRECTION ? node : facade.GetTarget(edge);
+            const auto node_id = DIRECTION == FORWARD_DIRECTION ? node : to;
             const auto node_weight = facade.GetNodeWeight(node_id);
             const auto node_duration = facade.GetNodeDuration(node_id);
             const auto node_distance = facade.GetNodeDistance(node_id);
@@ -382,6 +381,8 @@ oneToManySearch(SearchEngineData<Algorithm> &engine_working_data,
 
     while (!query_heap.Empty() && !target_nodes_index.empty())
     {
+        CheckCancellation();
+
         // Extract node from the heap. Take a copy (no ref) because otherwise can be modified later
         // if toHeapNode is the same
         const auto heapNode = query_heap.DeleteMinGetHeapNode();
@@ -414,6 +415,8 @@ void forwardRoutingStep(const DataFacade<Algorithm> &facade,
                         std::vector<NodeID> &middle_nodes_table,
                         const PhantomNodeCandidates &candidates)
 {
+    CheckCancellation();
+
     // Take a copy of the extracted node because otherwise could be modified later if toHeapNode is
     // the same
     const auto heapNode = query_heap.DeleteMinGetHeapNode();
@@ -469,6 +472,8 @@ void backwardRoutingStep(const DataFacade<Algorithm> &facade,
                          std::vector<NodeBucket> &search_space_with_buckets,
                          const PhantomNodeCandidates &candidates)
 {
+    CheckCancellation();
+
     // Take a copy of the extracted node because otherwise could be modified later if toHeapNode is
     // the same
     const auto heapNode = query_heap.DeleteMinGetHeapNode();
@@ -543,67 +548,72 @@ manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
                                               INVALID_EDGE_DISTANCE);
     std::vector<NodeID> middle_nodes_table(number_of_entries, SPECIAL_NODEID);
 
-    std::vector<NodeBucket> search_space_with_buckets;
+    const auto threads =
+        getManyToManyThreads(engine_working_data.many_to_many_threads, number_of_entries);
 
     // Populate buckets with paths from all accessible nodes to destinations via backward searches
-    for (std::uint32_t column_idx = 0; column_idx < target_indices.size(); ++column_idx)
-    {
-        const auto index = target_indices[column_idx];
-        const auto &target_candidates = candidates_list[index];
+    const auto search_space_with_buckets = computeSortedBuckets(
+        engine_working_data,
+        threads,
+        number_of_targets,
+        [&](const std::uint32_t column_idx, std::vector<NodeBucket> &buckets)
+        {
+            const auto index = target_indices[column_idx];
+            const auto &target_candidates = candidates_list[index];
 
-        engine_working_data.InitializeOrClearManyToManyThreadLocalStorage(
-            facade.GetNumberOfNodes(), facade.GetMaxBorderNodeID() + 1);
-        auto &query_heap = *(engine_working_data.many_to_many_heap);
+            engine_working_data.InitializeOrClearManyToManyThreadLocalStorage(
+                facade.GetNumberOfNodes(), facade.GetMaxBorderNodeID() + 1);
+            auto &query_heap = *(engine_working_data.many_to_many_heap);
 
-        if (DIRECTION == FORWARD_DIRECTION)
-            insertTargetInHeap(query_heap, target_candidates);
-        else
-            insertSourceInHeap(query_heap, target_candidates);
-
-        // explore search space
-        while (!query_heap.Empty())
-        {
-            backwardRoutingStep<DIRECTION>(
-                facade, column_idx, query_heap, search_space_with_buckets, target_candidates);
-        }
-    }
+            if (DIRECTION == FORWARD_DIRECTION)
+                insertTargetInHeap(query_heap, target_candidates);
+            else
+                insertSourceInHeap(query_heap, target_candidates);
 
-    // Order lookup buckets
-    std::sort(search_space_with_buckets.begin(), search_space_with_buckets.end());
+            // explore search space
+            while (!query_heap.Empty())
+            {
+                backwardRoutingStep<DIRECTION>(
+                    facade, column_idx, query_heap, buckets, target_candidates);
+            }
+        });
 
     // Find shortest paths from sources to all accessible nodes
-    for (std::uint32_t row_idx = 0; row_idx < source_indices.size(); ++row_idx)
-    {
-        const auto source_index = source_indices[row_idx];
-        const auto &source_candidates = candidates_list[source_index];
+    computeRows(engine_working_data,
+                threads,
+                number_of_sources,
+                [&](const std::uint32_t row_idx)
+                {
+                    const auto source_index = source_indices[row_idx];
+                    const auto &source_candidates = candidates_list[source_index];
 
-        // Clear heap and insert source nodes
-        engine_working_data.InitializeOrClearManyToManyThreadLocalStorage(
-            facade.GetNumberOfNodes(), facade.GetMaxBorderNodeID() + 1);
+                    // Clear heap and insert source nodes
+                    engine_working_data.InitializeOrClearManyToManyThreadLocalStorage(
+                        facade.GetNumberOfNodes(), facade.GetMaxBorderNodeID() + 1);
 
-        auto &query_heap = *(engine_working_data.many_to_many_heap);
+                    auto &query_heap = *(engine_working_data.many_to_many_heap);
 
-        if (DIRECTION == FORWARD_DIRECTION)
-            insertSourceInHeap(query_heap, source_candidates);
-        else
-            insertTargetInHeap(query_heap, source_candidates);
+                    if (DIRECTION == FORWARD_DIRECTION)
+                        insertSourceInHeap(query_heap, source_candidates);
+                    else
+                        insertTargetInHeap(query_heap, source_candidates);
 
-        // Explore search space
-        while (!query_heap.Empty())
-        {
-            forwardRoutingStep<DIRECTION>(facade,
-                                          row_idx,
-                                          number_of_sources,
-                                          number_of_targets,
-                                          query_heap,
-                                          search_space_with_buckets,
-                                          weights_table,
-                                          durations_table,
-                                          distances_table,
-                                          middle_nodes_table,
-                                          source_candidates);
-        }
-    }
+                    // Explore search space
+                    while (!query_heap.Empty())
+                    {
+                        forwardRoutingStep<DIRECTION>(facade,
+                                                      row_idx,
+                                                      number_of_sources,
+                                                      number_of_targets,
+                                                      query_heap,
+                                                      search_space_with_buckets,
+                                                      weights_table,
+                                                      durations_table,
+                                                      distances_table,
+                                                      middle_nodes_table,
+                                                      source_candidates);
+                    }
+                });
 
     return std::make_pair(std::move(durations_table), std::move(distances_table));
 }
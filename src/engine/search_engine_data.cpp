@@ -1,8 +1,83 @@
 #include "engine/search_engine_data.hpp"
 
+#include "util/log.hpp"
+
+#include <algorithm>
+#include <array>
+
 namespace osrm::engine
 {
 
+std::atomic<std::size_t> HeapMemoryStatistics::high_water_mark{0};
+std::atomic<std::size_t> HeapMemoryStatistics::trimmed_heaps{0};
+
+namespace
+{
+// A heap of the calling thread, type-erased so that heaps of different types can be trimmed
+// together
+struct HeapUsage
+{
+    std::size_t bytes;
+    void *heap;
+    // releases the memory of the heap and returns what it holds afterwards
+    std::size_t (*release)(void *heap);
+};
+
+template <typename HeapPtr> HeapUsage usageOf(HeapPtr &heap)
+{
+    using Heap = typename HeapPtr::element_type;
+    return {heap ? heap->MemoryUsage() : 0,
+            heap.get(),
+            [](void *erased_heap)
+            {
+                auto &heap = *static_cast<Heap *>(erased_heap);
+                heap.ReleaseMemory();
+                return heap.MemoryUsage();
+            }};
+}
+
+// Releases the largest heaps until all of them together hold at most max_heap_memory bytes
+template <typename... HeapPtrs>
+std::size_t trimHeaps(const std::size_t max_heap_memory, HeapPtrs &...heap_ptrs)
+{
+    std::array<HeapUsage, sizeof...(HeapPtrs)> heaps{usageOf(heap_ptrs)...};
+
+    std::size_t usage = 0;
+    for (const auto &heap : heaps)
+    {
+        usage += heap.bytes;
+    }
+
+    auto high_water_mark = HeapMemoryStatistics::high_water_mark.load(std::memory_order_relaxed);
+    while (usage > high_water_mark &&
+           !HeapMemoryStatistics::high_water_mark.compare_exchange_weak(
+               high_water_mark, usage, std::memory_order_relaxed))
+    {
+    }
+
+    if (usage <= max_heap_memory)
+    {
+        return usage;
+    }
+
+    std::sort(heaps.begin(),
+              heaps.end(),
+              [](const HeapUsage &lhs, const HeapUsage &rhs) { return lhs.bytes > rhs.bytes; });
+    for (const auto &heap : heaps)
+    {
+        if (usage <= max_heap_memory || heap.bytes == 0)
+        {
+            break;
+        }
+
+        util::Log(logDEBUG) << "Releasing query heap holding " << heap.bytes / 1024 << " KiB";
+        usage = usage - heap.bytes + heap.release(heap.heap);
+        HeapMemoryStatistics::trimmed_heaps.fetch_add(1, std::memory_order_relaxed);
+    }
+    return usage;
+}
+} // namespace
+
 // CH heaps
 using CH = routing_algorithms::ch::Algorithm;
 thread_local SearchEngineData<CH>::SearchEngineHeapPtr SearchEngineData<CH>::forward_heap_1;
@@ -18,100 +93,67 @@ thread_local SearchEngineData<CH>::SearchEngineHeapPtr
 
 thread_local SearchEngineData<CH>::ManyToManyHeapPtr SearchEngineData<CH>::many_to_many_heap;
 
-void SearchEngineData<CH>::InitializeOrClearMapMatchingThreadLocalStorage(unsigned number_of_nodes)
+namespace
 {
-    if (map_matching_forward_heap_1.get())
-    {
-        map_matching_forward_heap_1->Clear();
-    }
-    else
-    {
-        map_matching_forward_heap_1.reset(new QueryHeap(number_of_nodes));
-    }
+template <typename HeapPtr>
+void initializeOrClearHeap(HeapPtr &heap, unsigned number_of_nodes, bool use_array_storage)
+{
+    using Heap = typename HeapPtr::element_type;
 
-    if (map_matching_reverse_heap_1.get())
+    // Heaps are thread-local and outlive the engine that created them, so they have to be
+    // rebuilt if the storage mode changed or the array is too small for the current dataset.
+    if (heap.get() && heap->GetIndexStorage().IsCompatible(number_of_nodes, use_array_storage))
     {
-        map_matching_reverse_heap_1->Clear();
+        heap->Clear();
     }
     else
     {
-        map_matching_reverse_heap_1.reset(new QueryHeap(number_of_nodes));
+        heap.reset(new Heap(number_of_nodes, use_array_storage));
     }
 }
+} // namespace
 
-void SearchEngineData<CH>::InitializeOrClearFirstThreadLocalStorage(unsigned number_of_nodes)
+void SearchEngineData<CH>::InitializeOrClearMapMatchingThreadLocalStorage(unsigned number_of_nodes)
 {
-    if (forward_heap_1.get())
-    {
-        forward_heap_1->Clear();
-    }
-    else
-    {
-        forward_heap_1.reset(new QueryHeap(number_of_nodes));
-    }
+    initializeOrClearHeap(map_matching_forward_heap_1, number_of_nodes, use_array_heap_storage);
+    initializeOrClearHeap(map_matching_reverse_heap_1, number_of_nodes, use_array_heap_storage);
+}
 
-    if (reverse_heap_1.get())
-    {
-        reverse_heap_1->Clear();
-    }
-    else
-    {
-        reverse_heap_1.reset(new QueryHeap(number_of_nodes));
-    }
+void SearchEngineData<CH>::InitializeOrClearFirstThreadLocalStorage(unsigned number_of_nodes)
+{
+    initializeOrClearHeap(forward_heap_1, number_of_nodes, use_array_heap_storage);
+    initializeOrClearHeap(reverse_heap_1, number_of_nodes, use_array_heap_storage);
 }
 
 void SearchEngineData<CH>::InitializeOrClearSecondThreadLocalStorage(unsigned number_of_nodes)
 {
-    if (forward_heap_2.get())
-    {
-        forward_heap_2->Clear();
-    }
-    else
-    {
-        forward_heap_2.reset(new QueryHeap(number_of_nodes));
-    }
-
-    if (reverse_heap_2.get())
-    {
-        reverse_heap_2->Clear();
-    }
-    else
-    {
-        reverse_heap_2.reset(new QueryHeap(number_of_nodes));
-    }
+    initializeOrClearHeap(forward_heap_2, number_of_nodes, use_array_heap_storage);
+    initializeOrClearHeap(reverse_heap_2, number_of_nodes, use_array_heap_storage);
 }
 
 void SearchEngineData<CH>::InitializeOrClearThirdThreadLocalStorage(unsigned number_of_nodes)
 {
-    if (forward_heap_3.get())
-    {
-        forward_heap_3->Clear();
-    }
-    else
-    {
-        forward_heap_3.reset(new QueryHeap(number_of_nodes));
-    }
-
-    if (reverse_heap_3.get())
-    {
-        reverse_heap_3->Clear();
-    }
-    else
-    {
-        reverse_heap_3.reset(new QueryHeap(number_of_nodes));
-    }
+    initializeOrClearHeap(forward_heap_3, number_of_nodes, use_array_heap_storage);
+    initializeOrClearHeap(reverse_heap_3, number_of_nodes, use_array_heap_storage);
 }
 
 void SearchEngineData<CH>::InitializeOrClearManyToManyThreadLocalStorage(unsigned number_of_nodes)
 {
-    if (many_to_many_heap.get())
-    {
-        many_to_many_heap->Clear();
-    }
-    else
-    {
-        many_to_many_heap.reset(new ManyToManyQueryHeap(number_of_nodes));
-    }
+    initializeOrClearHeap(many_to_many_heap, number_of_nodes, use_array_heap_storage);
+}
+
+std::size_t SearchEngineData<CH>::TrimThreadLocalStorage(std::size_t max_heap_memory)
+{
+    return trimHeaps(max_heap_memory,
+                     forward_heap_1,
+                     reverse_heap_1,
+                     forward_heap_2,
+                     reverse_heap_2,
+                     forward_heap_3,
+                     reverse_heap_3,
+                     many_to_many_heap,
+                     map_matching_forward_heap_1,
+                     map_matching_reverse_heap_1);
 }
 
 // MLD
@@ -182,4 +224,14 @@ void SearchEngineData<MLD>::InitializeOrClearManyToManyThreadLocalStorage(
         many_to_many_heap.reset(new ManyToManyQueryHeap(number_of_nodes, number_of_boundary_nodes));
     }
 }
-} // namespace osrm::engine
\ No newline at end of file
+
+std::size_t SearchEngineData<MLD>::TrimThreadLocalStorage(std::size_t max_heap_memory)
+{
+    return trimHeaps(max_heap_memory,
+                     forward_heap_1,
+                     reverse_heap_1,
+                     map_matching_forward_heap_1,
+                     map_matching_reverse_heap_1,
+                     many_to_many_heap);
+}
+} // namespace osrm::engine
@@ -0,0 +1,56 @@
+#include "engine/snapping_cache.hpp"
+
+#include "util/std_hash.hpp"
+
+namespace osrm::engine
+{
+
+std::atomic<std::uint64_t> SnappingCacheStatistics::hits{0};
+std::atomic<std::uint64_t> SnappingCacheStatistics::misses{0};
+
+bool SnappingCache::Key::operator==(const Key &other) const
+{
+    return query.input_coordinate == other.query.input_coordinate &&
+           query.max_distance == other.query.max_distance && query.bearing == other.query.bearing &&
+           query.approach == other.query.approach && use_all_edges == other.use_all_edges;
+}
+
+std::size_t SnappingCache::KeyHash::operator()(const Key &key) const
+{
+    const auto bearing = key.query.bearing.value_or(Bearing{-1, -1});
+    return hash_val(key.query.input_coordinate.lon,
+                    key.query.input_coordinate.lat,
+                    key.query.max_distance,
+                    bearing.bearing,
+                    bearing.range,
+                    static_cast<std::uint8_t>(key.query.approach),
+                    key.use_all_edges);
+}
+
+SnappingCache::SnappingCache(const std::size_t capacity) : cache(capacity) {}
+
+std::optional<PhantomCandidateAlternatives>
+SnappingCache::Find(const std::shared_ptr<const void> &facade,
+                    const NearestQuery &query,
+                    const bool use_all_edges)
+{
+    auto candidates = cache.Find(facade, Key{query, use_all_edges});
+    if (candidates)
+    {
+        SnappingCacheStatistics::hits.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        SnappingCacheStatistics::misses.fetch_add(1, std::memory_order_relaxed);
+    }
+    return candidates;
+}
+
+void SnappingCache::Insert(const std::shared_ptr<const void> &facade,
+                           const NearestQuery &query,
+                           const bool use_all_edges,
+                           PhantomCandidateAlternatives candidates)
+{
+    cache.Insert(facade, Key{query, use_all_edges}, std::move(candidates));
+}
+} // namespace osrm::engine
@@ -1,5 +1,6 @@
 #include "server/api/parameters_parser.hpp"
 
+#include "server/api/isochrone_parameter_grammar.hpp"
 #include "server/api/match_parameter_grammar.hpp"
 #include "server/api/nearest_parameter_grammar.hpp"
 #include "server/api/route_parameters_grammar.hpp"
@@ -22,7 +23,8 @@ using is_grammar_t =
                                std::is_same<NearestParametersGrammar<>, T>::value ||
                                std::is_same<TripParametersGrammar<>, T>::value ||
                                std::is_same<MatchParametersGrammar<>, T>::value ||
-                               std::is_same<TileParametersGrammar<>, T>::value>;
+                               std::is_same<TileParametersGrammar<>, T>::value ||
+                               std::is_same<IsochroneParametersGrammar<>, T>::value>;
 
 template <typename ParameterT,
           typename GrammarT,
@@ -106,4 +108,12 @@ std::optional<engine::api::TileParameters> parseParameters(std::string::iterator
     return detail::parseParameters<engine::api::TileParameters, TileParametersGrammar<>>(iter, end);
 }
 
+template <>
+std::optional<engine::api::IsochroneParameters> parseParameters(std::string::iterator &iter,
+                                                                const std::string::iterator end)
+{
+    return detail::parseParameters<engine::api::IsochroneParameters,
+                                   IsochroneParametersGrammar<>>(iter, end);
+}
+
 } // namespace osrm::server::api
@@ -0,0 +1,103 @@
+#include "server/api/request_body_parser.hpp"
+
+#include "engine/api/flatbuffers/fbrequest_generated.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace osrm::server::api
+{
+
+namespace
+{
+const engine::api::fbrequest::FBRequest *getRequest(const std::string_view body)
+{
+    const auto data = reinterpret_cast<const std::uint8_t *>(body.data());
+    flatbuffers::Verifier verifier(data, body.size());
+    if (!engine::api::fbrequest::VerifyFBRequestBuffer(verifier))
+    {
+        return nullptr;
+    }
+    return engine::api::fbrequest::GetFBRequest(data);
+}
+
+void parseBaseBody(const engine::api::fbrequest::FBRequest &request,
+                    engine::api::BaseParameters &parameters)
+{
+    if (const auto coordinates = request.coordinates(); coordinates && coordinates->size() > 0)
+    {
+        parameters.coordinates.resize(coordinates->size());
+        std::transform(coordinates->begin(),
+                       coordinates->end(),
+                       parameters.coordinates.begin(),
+                       [](const engine::api::fbrequest::Coordinate *coordinate)
+                       {
+                           return util::Coordinate{util::FixedLongitude{coordinate->longitude()},
+                                                   util::FixedLatitude{coordinate->latitude()}};
+                       });
+    }
+
+    if (const auto radiuses = request.radiuses(); radiuses && radiuses->size() > 0)
+    {
+        parameters.radiuses.resize(radiuses->size());
+        std::transform(radiuses->begin(),
+                       radiuses->end(),
+                       parameters.radiuses.begin(),
+                       [](const double radius)
+                       { return radius >= 0 ? std::make_optional(radius) : std::nullopt; });
+    }
+
+    if (const auto bearings = request.bearings(); bearings && bearings->size() > 0)
+    {
+        parameters.bearings.resize(bearings->size());
+        std::transform(bearings->begin(),
+                       bearings->end(),
+                       parameters.bearings.begin(),
+                       [](const engine::api::fbrequest::Bearing *bearing)
+                       {
+                           return bearing->bearing() >= 0
+                                      ? std::make_optional(
+                                            engine::Bearing{bearing->bearing(), bearing->range()})
+                                      : std::nullopt;
+                       });
+    }
+}
+} // namespace
+
+bool parseBody(const std::string_view body,
+               engine::api::BaseParameters &parameters,
+               std::string &help)
+{
+    const auto request = getRequest(body);
+    if (!request)
+    {
+        help = "Request body is no valid FBRequest";
+        return false;
+    }
+    if (request->timestamps() && request->timestamps()->size() > 0)
+    {
+        help = "Only the match service supports timestamps";
+        return false;
+    }
+    parseBaseBody(*request, parameters);
+    return true;
+}
+
+bool parseBody(const std::string_view body,
+               engine::api::MatchParameters &parameters,
+               std::string &help)
+{
+    const auto request = getRequest(body);
+    if (!request)
+    {
+        help = "Request body is no valid FBRequest";
+        return false;
+    }
+    if (const auto timestamps = request->timestamps(); timestamps && timestamps->size() > 0)
+    {
+        parameters.timestamps.assign(timestamps->begin(), timestamps->end());
+    }
+    parseBaseBody(*request, parameters);
+    return true;
+}
+} // namespace osrm::server::api
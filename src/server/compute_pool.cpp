@@ -0,0 +1,247 @@
+#include "server/compute_pool.hpp"
+
+#include "util/integer_range.hpp"
+#include "util/log.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <memory>
+
+namespace osrm::server
+{
+
+std::atomic<std::uint64_t> ComputePoolStatistics::threads{0};
+ComputePoolStatistics::PerPriority<std::atomic<std::uint64_t>> ComputePoolStatistics::queued{};
+ComputePoolStatistics::PerPriority<std::atomic<std::uint64_t>>
+    ComputePoolStatistics::queued_cost{};
+ComputePoolStatistics::PerPriority<std::atomic<std::uint64_t>> ComputePoolStatistics::in_flight{};
+ComputePoolStatistics::PerPriority<std::atomic<std::uint64_t>> ComputePoolStatistics::rejected{};
+ComputePoolStatistics::PerPriority<util::LatencyHistogram> ComputePoolStatistics::wait_durations;
+
+ComputePool::ComputePool(const unsigned number_of_threads)
+{
+    BOOST_ASSERT(number_of_threads > 0);
+    threads.reserve(number_of_threads);
+    for (unsigned i = 0; i < number_of_threads; ++i)
+    {
+        threads.emplace_back([this] { Work(); });
+    }
+    ComputePoolStatistics::threads.fetch_add(number_of_threads, std::memory_order_relaxed);
+}
+
+ComputePool::~ComputePool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeup.notify_all();
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    for (const auto priority : util::irange<std::size_t>(0, NUMBER_OF_REQUEST_PRIORITIES))
+    {
+        const auto &queue = classes[priority].queue;
+        ComputePoolStatistics::queued[priority].fetch_sub(
+            std::count_if(queue.begin(),
+                          queue.end(),
+                          [](const QueuedTask &queued) { return !queued.helper; }),
+            std::memory_order_relaxed);
+        ComputePoolStatistics::queued_cost[priority].fetch_sub(classes[priority].queued_cost,
+                                                               std::memory_order_relaxed);
+    }
+    ComputePoolStatistics::threads.fetch_sub(threads.size(), std::memory_order_relaxed);
+}
+
+void ComputePool::SetLimits(const RequestPriority priority, const Limits &limits)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        classes[static_cast<std::size_t>(priority)].limits = limits;
+    }
+    // a higher limit can allow waiting tasks to start
+    wakeup.notify_all();
+}
+
+bool ComputePool::Post(Task task, const RequestPriority priority, const std::uint64_t cost)
+{
+    const auto index = static_cast<std::size_t>(priority);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto &priority_class = classes[index];
+        const auto max_queued_cost = priority_class.limits.max_queued_cost;
+        if (max_queued_cost > 0 && !priority_class.queue.empty() &&
+            priority_class.queued_cost + cost > max_queued_cost)
+        {
+            ComputePoolStatistics::rejected[index].fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+    Enqueue(std::move(task), index, cost, false);
+    return true;
+}
+
+void ComputePool::Enqueue(Task task,
+                          const std::size_t priority,
+                          const std::uint64_t cost,
+                          const bool helper)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto &priority_class = classes[priority];
+        priority_class.queue.push_back(
+            {std::move(task), cost, std::chrono::steady_clock::now(), helper});
+        priority_class.queued_cost += cost;
+    }
+    if (!helper)
+    {
+        ComputePoolStatistics::queued[priority].fetch_add(1, std::memory_order_relaxed);
+        ComputePoolStatistics::queued_cost[priority].fetch_add(cost, std::memory_order_relaxed);
+    }
+    wakeup.notify_one();
+}
+
+void ComputePool::ParallelFor(const std::size_t count,
+                              const std::function<void(std::size_t)> &body,
+                              const RequestPriority priority)
+{
+    // shared with the helpers, which may only start after this call returned
+    struct State
+    {
+        std::size_t count;
+        const std::function<void(std::size_t)> *body;
+        std::atomic<std::size_t> next{0};
+        std::mutex mutex;
+        std::condition_variable all_done;
+        std::size_t done = 0;
+        std::exception_ptr error;
+    };
+    const auto state = std::make_shared<State>();
+    state->count = count;
+    state->body = &body;
+
+    // the body is only called for indices below count, so not after the last call returned
+    const auto work = [](State &state)
+    {
+        for (auto index = state.next.fetch_add(1); index < state.count;
+             index = state.next.fetch_add(1))
+        {
+            std::exception_ptr error;
+            try
+            {
+                (*state.body)(index);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(state.mutex);
+            if (error && !state.error)
+            {
+                state.error = error;
+            }
+            if (++state.done == state.count)
+            {
+                state.all_done.notify_all();
+            }
+        }
+    };
+
+    const auto helpers = count > 1 ? std::min<std::size_t>(count, Size()) - 1 : 0;
+    for (std::size_t helper = 0; helper < helpers; ++helper)
+    {
+        Enqueue([state, work] { work(*state); }, static_cast<std::size_t>(priority), 0, true);
+    }
+    work(*state);
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->all_done.wait(lock, [&] { return state->done == state->count; });
+    if (state->error)
+    {
+        std::rethrow_exception(state->error);
+    }
+}
+
+std::optional<std::size_t> ComputePool::NextPriority() const
+{
+    for (const auto priority : util::irange<std::size_t>(0, NUMBER_OF_REQUEST_PRIORITIES))
+    {
+        const auto &priority_class = classes[priority];
+        if (priority_class.queue.empty())
+        {
+            continue;
+        }
+        const auto max_in_flight = priority_class.limits.max_in_flight;
+        if (max_in_flight == 0 || priority_class.in_flight < max_in_flight)
+        {
+            return priority;
+        }
+    }
+    return std::nullopt;
+}
+
+void ComputePool::Work()
+{
+    while (true)
+    {
+        std::size_t priority;
+        QueuedTask next;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            std::optional<std::size_t> next_priority;
+            wakeup.wait(lock,
+                        [&]
+                        {
+                            next_priority = NextPriority();
+                            return stopping || next_priority;
+                        });
+            if (stopping)
+            {
+                return;
+            }
+            priority = *next_priority;
+            auto &priority_class = classes[priority];
+            next = std::move(priority_class.queue.front());
+            priority_class.queue.pop_front();
+            priority_class.queued_cost -= next.cost;
+            ++priority_class.in_flight;
+        }
+        // helpers are part of a task that is already accounted, and many of them find no work
+        // left once they start
+        if (!next.helper)
+        {
+            ComputePoolStatistics::queued[priority].fetch_sub(1, std::memory_order_relaxed);
+            ComputePoolStatistics::queued_cost[priority].fetch_sub(next.cost,
+                                                                   std::memory_order_relaxed);
+            ComputePoolStatistics::in_flight[priority].fetch_add(1, std::memory_order_relaxed);
+            ComputePoolStatistics::wait_durations[priority].Record(
+                std::chrono::steady_clock::now() - next.posted);
+        }
+
+        try
+        {
+            next.task();
+        }
+        catch (const std::exception &e)
+        {
+            // the request handler answers its own errors, this only keeps the thread alive
+            util::Log(logERROR) << "Compute task failed: " << e.what();
+        }
+
+        // this thread looks for the next task right away, so nobody else needs to be woken up
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --classes[priority].in_flight;
+        }
+        if (!next.helper)
+        {
+            ComputePoolStatistics::in_flight[priority].fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+}
+} // namespace osrm::server
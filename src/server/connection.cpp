@@ -1,23 +1,55 @@
 #include "server/connection.hpp"
+#include "server/compute_pool.hpp"
 #include "server/request_handler.hpp"
 #include "server/request_parser.hpp"
 
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/bind.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
 #include <boost/iostreams/filter/gzip.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
 
 #include <fmt/format.h>
+#include <algorithm>
+#include <utility>
 #include <vector>
 
 namespace osrm::server
 {
 
+namespace
+{
+// Compressed replies larger than this are sent with chunked transfer encoding, one chunk for
+// every CHUNK_SIZE bytes of uncompressed content
+constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+
+const char chunk_end[] = {'\r', '\n'};
+const char continue_reply[] = "HTTP/1.1 100 Continue\r\n\r\n";
+const char last_chunk[] = {'0', '\r', '\n', '\r', '\n'};
+
+boost::iostreams::gzip_params
+makeCompressionParameters(const http::compression_type compression_type)
+{
+    boost::iostreams::gzip_params compression_parameters;
+
+    // there's a trade-off between speed and size. speed wins
+    compression_parameters.level = boost::iostreams::zlib::best_speed;
+    // check which compression flavor is used
+    if (http::deflate_rfc1951 == compression_type)
+    {
+        compression_parameters.noheader = true;
+    }
+    return compression_parameters;
+}
+
+} // namespace
+
 Connection::Connection(boost::asio::io_context &io_context,
                        RequestHandler &handler,
+                       ComputePool &compute_pool,
                        short keepalive_timeout)
     : strand(boost::asio::make_strand(io_context)), TCP_socket(strand), timer(strand),
-      request_handler(handler), keepalive_timeout(keepalive_timeout)
+      request_handler(handler), compute_pool(compute_pool), keepalive_timeout(keepalive_timeout)
 {
 }
 
@@ -26,11 +58,24 @@ boost::asio::ip::tcp::socket &Connection::socket() { return TCP_socket; }
 /// Start the first asynchronous operation for the connection.
 void Connection::start()
 {
-    TCP_socket.async_read_some(boost::asio::buffer(incoming_data_buffer),
-                               boost::bind(&Connection::handle_read,
-                                           this->shared_from_this(),
-                                           boost::asio::placeholders::error,
-                                           boost::asio::placeholders::bytes_transferred));
+    if (peer_bytes > 0)
+    {
+        // data of the next request that arrived while the last one was handled
+        std::copy_n(peer_buffer.begin(), peer_bytes, incoming_data_buffer.begin());
+        boost::asio::post(strand,
+                          boost::bind(&Connection::handle_read,
+                                      this->shared_from_this(),
+                                      boost::system::error_code(),
+                                      std::exchange(peer_bytes, 0)));
+    }
+    else if (!watching_peer)
+    {
+        TCP_socket.async_read_some(boost::asio::buffer(incoming_data_buffer),
+                                   boost::bind(&Connection::handle_read,
+                                               this->shared_from_this(),
+                                               boost::asio::placeholders::error,
+                                               boost::asio::placeholders::bytes_transferred));
+    }
 
     if (keep_alive)
     {
@@ -81,54 +126,35 @@ void Connection::handle_read(const boost::system::error_code &error, std::size_t
             handle_shutdown();
             return;
         }
-        request_handler.HandleRequest(current_request, current_reply);
 
-        if (boost::iequals(current_request.connection, "close"))
+        // The compute thread can use the request and reply until it posts back to the strand,
+        // the only operation of the connection meanwhile is the read that watches for the end
+        // of the connection
+        const auto request_class = request_handler.Classify(current_request);
+        handling_request = true;
+        const auto queued = compute_pool.Post(
+            [self = this->shared_from_this(), compression_type]
+            {
+                self->request_handler.HandleRequest(
+                    self->current_request,
+                    self->current_reply,
+                    [connection = self.get()]
+                    { return connection->peer_closed.load(std::memory_order_relaxed); });
+                boost::asio::post(self->strand,
+                                  [self, compression_type]
+                                  { self->write_reply(compression_type); });
+            },
+            request_class.priority,
+            request_class.cost);
+        if (!queued)
         {
-            current_reply.headers.emplace_back("Connection", "close");
+            request_handler.Reject(current_request, request_class.priority, current_reply);
+            write_reply(compression_type);
         }
-        else
+        else if (request_handler.CancelsOnDisconnect())
         {
-            keep_alive = true;
-            current_reply.headers.emplace_back("Connection", "keep-alive");
-            current_reply.headers.emplace_back("Keep-Alive",
-                                               "timeout=" + fmt::to_string(keepalive_timeout) +
-                                                   ", max=" + fmt::to_string(processed_requests));
+            watch_peer();
         }
-
-        // compress the result w/ gzip/deflate if requested
-        switch (compression_type)
-        {
-        case http::deflate_rfc1951:
-            // use deflate for compression
-            current_reply.headers.insert(current_reply.headers.begin(),
-                                         {"Content-Encoding", "deflate"});
-            compressed_output = compress_buffers(current_reply.content, compression_type);
-            current_reply.set_size(static_cast<unsigned>(compressed_output.size()));
-            output_buffer = current_reply.headers_to_buffers();
-            output_buffer.push_back(boost::asio::buffer(compressed_output));
-            break;
-        case http::gzip_rfc1952:
-            // use gzip for compression
-            current_reply.headers.insert(current_reply.headers.begin(),
-                                         {"Content-Encoding", "gzip"});
-            compressed_output = compress_buffers(current_reply.content, compression_type);
-            current_reply.set_size(static_cast<unsigned>(compressed_output.size()));
-            output_buffer = current_reply.headers_to_buffers();
-            output_buffer.push_back(boost::asio::buffer(compressed_output));
-            break;
-        case http::no_compression:
-            // don't use any compression
-            current_reply.set_uncompressed_size();
-            output_buffer = current_reply.to_buffers();
-            break;
-        }
-        // write result to stream
-        boost::asio::async_write(TCP_socket,
-                                 output_buffer,
-                                 boost::bind(&Connection::handle_write,
-                                             this->shared_from_this(),
-                                             boost::asio::placeholders::error));
     }
     else if (result == RequestParser::RequestStatus::invalid)
     { // request is not parseable
@@ -140,6 +166,16 @@ void Connection::handle_read(const boost::system::error_code &error, std::size_t
                                              this->shared_from_this(),
                                              boost::asio::placeholders::error));
     }
+    else if (request_parser.expects_continue() && current_request.http_version_major == 1 &&
+             current_request.http_version_minor >= 1)
+    {
+        // the client waits for this before it sends the body
+        boost::asio::async_write(TCP_socket,
+                                 boost::asio::buffer(continue_reply, sizeof(continue_reply) - 1),
+                                 boost::bind(&Connection::handle_continue_write,
+                                             this->shared_from_this(),
+                                             boost::asio::placeholders::error));
+    }
     else
     {
         // we don't have a result yet, so continue reading
@@ -151,6 +187,112 @@ void Connection::handle_read(const boost::system::error_code &error, std::size_t
     }
 }
 
+void Connection::watch_peer()
+{
+    watching_peer = true;
+    TCP_socket.async_read_some(boost::asio::buffer(peer_buffer),
+                               boost::bind(&Connection::handle_peer_read,
+                                           this->shared_from_this(),
+                                           boost::asio::placeholders::error,
+                                           boost::asio::placeholders::bytes_transferred));
+}
+
+void Connection::handle_peer_read(const boost::system::error_code &error,
+                                  std::size_t bytes_transferred)
+{
+    watching_peer = false;
+
+    if (!handling_request)
+    {
+        // The reply was written while the read was pending, so it is the read of the next
+        // request
+        std::copy_n(peer_buffer.begin(), bytes_transferred, incoming_data_buffer.begin());
+        handle_read(error, bytes_transferred);
+        return;
+    }
+
+    if (error)
+    {
+        // The end of the stream counts as well, so a client that shuts down its sending side
+        // after the request is taken for gone
+        util::Log(logDEBUG) << "Connection closed during request: " << error.message();
+        peer_closed.store(true, std::memory_order_relaxed);
+        return;
+    }
+
+    // The client sent the next request before it got this reply and is still there. Keep the
+    // data for after the reply and stop watching.
+    peer_bytes = bytes_transferred;
+}
+
+void Connection::write_reply(const http::compression_type compression_type)
+{
+    handling_request = false;
+
+    if (boost::iequals(current_request.connection, "close"))
+    {
+        current_reply.headers.emplace_back("Connection", "close");
+    }
+    else
+    {
+        keep_alive = true;
+        current_reply.headers.emplace_back("Connection", "keep-alive");
+        current_reply.headers.emplace_back("Keep-Alive",
+                                           "timeout=" + fmt::to_string(keepalive_timeout) +
+                                               ", max=" + fmt::to_string(processed_requests));
+    }
+
+    // compress the result w/ gzip/deflate if requested
+    switch (compression_type)
+    {
+    case http::deflate_rfc1951:
+        // use deflate for compression
+        current_reply.headers.insert(current_reply.headers.begin(),
+                                     {"Content-Encoding", "deflate"});
+        break;
+    case http::gzip_rfc1952:
+        // use gzip for compression
+        current_reply.headers.insert(current_reply.headers.begin(),
+                                     {"Content-Encoding", "gzip"});
+        break;
+    case http::no_compression:
+        // don't use any compression
+        break;
+    }
+
+    if (compression_type == http::no_compression)
+    {
+        current_reply.set_uncompressed_size();
+        output_buffer = current_reply.to_buffers();
+    }
+    else if (current_reply.content.size() > CHUNK_SIZE &&
+             (current_request.http_version_major > 1 ||
+              (current_request.http_version_major == 1 &&
+               current_request.http_version_minor >= 1)))
+    {
+        // Large replies are compressed while they are written, so only one compressed chunk
+        // is held in memory and the first bytes leave before the whole reply is compressed
+        current_reply.set_chunked();
+        start_compression(compression_type);
+        output_buffer = current_reply.headers_to_buffers();
+        write_next_chunk();
+        return;
+    }
+    else
+    {
+        compressed_output = compress_buffers(current_reply.content, compression_type);
+        current_reply.set_size(static_cast<unsigned>(compressed_output.size()));
+        output_buffer = current_reply.headers_to_buffers();
+        output_buffer.push_back(boost::asio::buffer(compressed_output));
+    }
+    // write result to stream
+    boost::asio::async_write(TCP_socket,
+                             output_buffer,
+                             boost::bind(&Connection::handle_write,
+                                         this->shared_from_this(),
+                                         boost::asio::placeholders::error));
+}
+
 /// Handle completion of a write operation.
 void Connection::handle_write(const boost::system::error_code &error)
 {
@@ -177,6 +319,80 @@ void Connection::handle_write(const boost::system::error_code &error)
     }
 }
 
+void Connection::handle_continue_write(const boost::system::error_code &error)
+{
+    if (error)
+    {
+        util::Log(logDEBUG) << "Connection write error: " << error.message();
+        return;
+    }
+
+    TCP_socket.async_read_some(boost::asio::buffer(incoming_data_buffer),
+                               boost::bind(&Connection::handle_read,
+                                           this->shared_from_this(),
+                                           boost::asio::placeholders::error,
+                                           boost::asio::placeholders::bytes_transferred));
+}
+
+void Connection::write_next_chunk()
+{
+    const auto &content = current_reply.content;
+
+    // The compressor keeps a window of its input, feed it until it emits something
+    compressed_output.clear();
+    while (compressed_output.empty() && compressed_bytes < content.size())
+    {
+        const auto size = std::min(CHUNK_SIZE, content.size() - compressed_bytes);
+        compression_stream.write(content.data() + compressed_bytes, size);
+        compressed_bytes += size;
+    }
+
+    const bool is_last_chunk = compressed_bytes == content.size();
+    if (is_last_chunk)
+    {
+        // flushes the remaining output and the trailer
+        boost::iostreams::close(compression_stream);
+    }
+
+    if (!compressed_output.empty())
+    {
+        chunk_header = fmt::format("{:x}\r\n", compressed_output.size());
+        output_buffer.push_back(boost::asio::buffer(chunk_header));
+        output_buffer.push_back(boost::asio::buffer(compressed_output));
+        output_buffer.push_back(boost::asio::buffer(chunk_end));
+    }
+
+    if (is_last_chunk)
+    {
+        output_buffer.push_back(boost::asio::buffer(last_chunk));
+        boost::asio::async_write(TCP_socket,
+                                 output_buffer,
+                                 boost::bind(&Connection::handle_write,
+                                             this->shared_from_this(),
+                                             boost::asio::placeholders::error));
+    }
+    else
+    {
+        boost::asio::async_write(TCP_socket,
+                                 output_buffer,
+                                 boost::bind(&Connection::handle_chunk_write,
+                                             this->shared_from_this(),
+                                             boost::asio::placeholders::error));
+    }
+}
+
+void Connection::handle_chunk_write(const boost::system::error_code &error)
+{
+    if (error)
+    {
+        util::Log(logDEBUG) << "Connection write error: " << error.message();
+        return;
+    }
+
+    output_buffer.clear();
+    write_next_chunk();
+}
+
 /// Handle completion of a timeout timer..
 void Connection::handle_timeout(boost::system::error_code ec)
 {
@@ -205,24 +421,25 @@ void Connection::handle_shutdown()
 std::vector<char> Connection::compress_buffers(const std::vector<char> &uncompressed_data,
                                                const http::compression_type compression_type)
 {
-    boost::iostreams::gzip_params compression_parameters;
-
-    // there's a trade-off between speed and size. speed wins
-    compression_parameters.level = boost::iostreams::zlib::best_speed;
-    // check which compression flavor is used
-    if (http::deflate_rfc1951 == compression_type)
-    {
-        compression_parameters.noheader = true;
-    }
-
     std::vector<char> compressed_data;
     // plug data into boost's compression stream
     boost::iostreams::filtering_ostream gzip_stream;
-    gzip_stream.push(boost::iostreams::gzip_compressor(compression_parameters));
+    gzip_stream.push(
+        boost::iostreams::gzip_compressor(makeCompressionParameters(compression_type)));
     gzip_stream.push(boost::iostreams::back_inserter(compressed_data));
     gzip_stream.write(uncompressed_data.data(), uncompressed_data.size());
     boost::iostreams::close(gzip_stream);
 
     return compressed_data;
 }
+
+void Connection::start_compression(const http::compression_type compression_type)
+{
+    compressed_output.clear();
+    compressed_bytes = 0;
+    compression_stream.reset();
+    compression_stream.push(
+        boost::iostreams::gzip_compressor(makeCompressionParameters(compression_type)));
+    compression_stream.push(boost::iostreams::back_inserter(compressed_output));
+}
 } // namespace osrm::server
@@ -1,6 +1,7 @@
 #include "server/http/reply.hpp"
 
 #include <string>
+#include <vector>
 
 namespace osrm::server::http
 {
@@ -9,11 +10,18 @@ const char ok_html[] = "";
 const char bad_request_html[] = "";
 const char internal_server_error_html[] =
     "{\"code\": \"InternalError\",\"message\":\"Internal Server Error\"}";
+const char service_unavailable_html[] = "";
 const char seperators[] = {':', ' '};
 const char crlf[] = {'\r', '\n'};
 const std::string http_ok_string = "HTTP/1.0 200 OK\r\n";
 const std::string http_bad_request_string = "HTTP/1.0 400 Bad Request\r\n";
 const std::string http_internal_server_error_string = "HTTP/1.0 500 Internal Server Error\r\n";
+const std::string http_service_unavailable_string = "HTTP/1.0 503 Service Unavailable\r\n";
+const std::string http_1_1_ok_string = "HTTP/1.1 200 OK\r\n";
+const std::string http_1_1_bad_request_string = "HTTP/1.1 400 Bad Request\r\n";
+const std::string http_1_1_internal_server_error_string =
+    "HTTP/1.1 500 Internal Server Error\r\n";
+const std::string http_1_1_service_unavailable_string = "HTTP/1.1 503 Service Unavailable\r\n";
 
 void reply::set_size(const std::size_t size)
 {
@@ -28,6 +36,13 @@ void reply::set_size(const std::size_t size)
 
 void reply::set_uncompressed_size() { set_size(content.size()); }
 
+void reply::set_chunked()
+{
+    chunked = true;
+    std::erase_if(headers, [](const header &h) { return "Content-Length" == h.name; });
+    headers.emplace_back("Transfer-Encoding", "chunked");
+}
+
 std::vector<boost::asio::const_buffer> reply::to_buffers()
 {
     std::vector<boost::asio::const_buffer> buffers;
@@ -83,6 +98,10 @@ std::string reply::status_to_string(const reply::status_type status)
     {
         return bad_request_html;
     }
+    if (reply::service_unavailable == status)
+    {
+        return service_unavailable_html;
+    }
     return internal_server_error_html;
 }
 
@@ -90,14 +109,20 @@ boost::asio::const_buffer reply::status_to_buffer(const reply::status_type statu
 {
     if (reply::ok == status)
     {
-        return boost::asio::buffer(http_ok_string);
+        return boost::asio::buffer(chunked ? http_1_1_ok_string : http_ok_string);
     }
     if (reply::internal_server_error == status)
     {
-        return boost::asio::buffer(http_internal_server_error_string);
+        return boost::asio::buffer(chunked ? http_1_1_internal_server_error_string
+                                           : http_internal_server_error_string);
+    }
+    if (reply::service_unavailable == status)
+    {
+        return boost::asio::buffer(chunked ? http_1_1_service_unavailable_string
+                                           : http_service_unavailable_string);
     }
-    return boost::asio::buffer(http_bad_request_string);
+    return boost::asio::buffer(chunked ? http_1_1_bad_request_string : http_bad_request_string);
 }
 
-reply::reply() : status(ok) {}
+reply::reply() : status(ok), chunked(false) {}
 } // namespace osrm::server::http
@@ -5,38 +5,328 @@
 #include "server/http/reply.hpp"
 #include "server/http/request.hpp"
 
+#include "util/integer_range.hpp"
 #include "util/json_renderer.hpp"
 #include "util/log.hpp"
 #include "util/string_util.hpp"
 #include "util/timing_util.hpp"
 
+#include "engine/api/flatbuffers/fbrequest_generated.h"
+#include "engine/cancellation.hpp"
+#include "engine/dataset_snapshot.hpp"
 #include "engine/status.hpp"
 #include "osrm/osrm.hpp"
 #include "util/json_container.hpp"
 
 #include <boost/iostreams/copy.hpp>
 
+#include <rapidjson/document.h>
+
 #include <ctime>
 
 #include <algorithm>
+#include <cctype>
+#include <memory_resource>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <utility>
 #include <variant>
+#include <vector>
 
 namespace osrm::server
 {
 
+namespace
+{
+// enough for the response of a short route with steps, longer ones grow the arena
+constexpr std::size_t JSON_ARENA_INITIAL_SIZE = 64 * 1024;
+
+// The cost estimates below are used by Classify on the I/O threads. They look at every character
+// of the request at most once, without parsing or copying it.
+
+// Calls visit with every character of a percent encoded text until it returns false
+template <typename Visit> void forEachDecoded(const std::string_view text, const Visit &visit)
+{
+    const auto hex = [](const char digit) { return digit < 58 ? digit - 48 : (digit | 32) - 87; };
+    for (std::size_t position = 0; position < text.size(); ++position)
+    {
+        auto character = text[position];
+        if (character == '%' && position + 2 < text.size() &&
+            std::isxdigit(static_cast<unsigned char>(text[position + 1])) &&
+            std::isxdigit(static_cast<unsigned char>(text[position + 2])))
+        {
+            character = static_cast<char>(16 * hex(text[position + 1]) + hex(text[position + 2]));
+            position += 2;
+        }
+        if (!visit(character))
+        {
+            return;
+        }
+    }
+}
+
+// Number of coordinates of a percent encoded query, the coordinates come first followed by the
+// options
+std::uint64_t queryCost(const std::string_view query)
+{
+    std::uint64_t cost = 1;
+    if (query.starts_with("polyline"))
+    {
+        // the last character of every value of an encoded polyline is below '_', the others
+        // are not, and every coordinate has two values
+        std::uint64_t values = 0;
+        bool inside = false;
+        forEachDecoded(query,
+                       [&](const char character)
+                       {
+                           values += inside && character >= '?' && character < '_';
+                           inside = inside || character == '(';
+                           return character != ')';
+                       });
+        cost = values / 2;
+    }
+    else
+    {
+        forEachDecoded(query,
+                       [&](const char character)
+                       {
+                           cost += character == ';';
+                           return character != '?';
+                       });
+    }
+    return std::max<std::uint64_t>(cost, 1);
+}
+
+// Number of coordinates of the queries of a batch request body plus one for the request itself.
+// Every string of the body but the "queries" key is a query.
+std::uint64_t batchCost(const std::string_view body)
+{
+    std::uint64_t cost = 1;
+    auto begin = body.find('"');
+    while (begin != std::string_view::npos)
+    {
+        auto end = begin + 1;
+        while (end < body.size() && body[end] != '"')
+        {
+            end += body[end] == '\\' ? 2 : 1;
+        }
+        if (end >= body.size())
+        {
+            break;
+        }
+        const auto string = body.substr(begin + 1, end - begin - 1);
+        if (string != "queries")
+        {
+            cost += queryCost(string);
+        }
+        begin = body.find('"', end + 1);
+    }
+    return cost;
+}
+
+// Service and query of the target of a request, /{service}/v{version}/{profile}/{query}
+std::optional<std::pair<std::string_view, std::string_view>> splitTarget(std::string_view target)
+{
+    if (!target.starts_with('/'))
+    {
+        return std::nullopt;
+    }
+    target.remove_prefix(1);
+
+    const auto service = target.substr(0, target.find('/'));
+    for (int part = 0; part < 3; ++part)
+    {
+        const auto slash = target.find('/');
+        if (slash == std::string_view::npos)
+        {
+            return std::nullopt;
+        }
+        target.remove_prefix(slash + 1);
+    }
+    return std::make_pair(service, target);
+}
+
+// Queries of the body of a batch request: {"queries": ["7.41,43.73;7.42,43.74?steps=true"]}
+std::optional<std::vector<std::string>> parseBatchQueries(const std::string_view body)
+{
+    rapidjson::Document document;
+    document.Parse(body.data(), body.size());
+    if (document.HasParseError() || !document.IsObject())
+    {
+        return std::nullopt;
+    }
+    const auto queries = document.FindMember("queries");
+    if (queries == document.MemberEnd() || !queries->value.IsArray())
+    {
+        return std::nullopt;
+    }
+
+    std::vector<std::string> decoded_queries;
+    decoded_queries.reserve(queries->value.Size());
+    for (const auto &query : queries->value.GetArray())
+    {
+        if (!query.IsString())
+        {
+            return std::nullopt;
+        }
+        // percent encoded like the query of a URL
+        util::URIDecode(std::string(query.GetString(), query.GetStringLength()),
+                        decoded_queries.emplace_back());
+    }
+    return decoded_queries;
+}
+
+// Renders the response of a query of a batch request into its part of the batch response
+void renderBatchResponse(ServiceHandler::ResultT &result, std::vector<char> &response)
+{
+    if (std::holds_alternative<util::json::Object>(result))
+    {
+        util::json::render(response, std::get<util::json::Object>(result));
+    }
+    else if (std::holds_alternative<engine::api::RenderedJSON>(result))
+    {
+        response = std::move(std::get<engine::api::RenderedJSON>(result).content);
+    }
+    else
+    {
+        util::json::Object error;
+        error.values["code"] = "InvalidQuery";
+        error.values["message"] = "Queries of batch requests can only be answered in JSON";
+        util::json::render(response, error);
+    }
+}
+
+// Accounts the phases of a request until it was answered, on every way out of HandleRequest,
+// and records them with the status of the reply
+class ScopedRequestMetrics
+{
+  public:
+    ScopedRequestMetrics(RequestMetrics *metrics, const bool server_timing, http::reply &reply)
+        : metrics(metrics), server_timing(server_timing), reply(reply),
+          start(std::chrono::steady_clock::now())
+    {
+        if (metrics)
+        {
+            util::StartRequestPhases();
+        }
+    }
+
+    ~ScopedRequestMetrics()
+    {
+        if (!metrics)
+        {
+            return;
+        }
+        const auto phases = util::StopRequestPhases();
+        const auto total = std::chrono::steady_clock::now() - start;
+        metrics->Record(service, reply.status, total, phases);
+        if (server_timing)
+        {
+            reply.headers.emplace_back("Server-Timing",
+                                       RequestMetrics::RenderServerTiming(total, phases));
+        }
+    }
+
+    ScopedRequestMetrics(const ScopedRequestMetrics &) = delete;
+    ScopedRequestMetrics &operator=(const ScopedRequestMetrics &) = delete;
+
+    // known once the URL was parsed
+    std::string service = "invalid";
+
+  private:
+    RequestMetrics *metrics;
+    const bool server_timing;
+    http::reply &reply;
+    const std::chrono::steady_clock::time_point start;
+};
+} // namespace
+
 void RequestHandler::RegisterServiceHandler(
     std::unique_ptr<ServiceHandlerInterface> service_handler_)
 {
     service_handler = std::move(service_handler_);
 }
 
+void RequestHandler::EnableMetrics(const bool metrics_endpoint_, const bool server_timing_)
+{
+    metrics_endpoint = metrics_endpoint_;
+    server_timing = server_timing_;
+    if (metrics_endpoint || server_timing)
+    {
+        metrics = std::make_unique<RequestMetrics>();
+    }
+}
+
+void RequestHandler::EnableCancellation(
+    const std::optional<std::chrono::milliseconds> request_timeout_,
+    const bool cancel_on_disconnect_)
+{
+    request_timeout = request_timeout_;
+    cancel_on_disconnect = cancel_on_disconnect_;
+}
+
+void RequestHandler::SetBatchServices(std::vector<std::string> services)
+{
+    batch_services = std::move(services);
+}
+
+void RequestHandler::SetComputePool(ComputePool *compute_pool_) { compute_pool = compute_pool_; }
+
+void RequestHandler::SetMaxBatchSize(const std::size_t max_batch_size_)
+{
+    max_batch_size = max_batch_size_;
+}
+
+RequestPriority RequestHandler::PriorityOf(const std::string_view service) const
+{
+    return std::find(batch_services.begin(), batch_services.end(), service) != batch_services.end()
+               ? RequestPriority::Batch
+               : RequestPriority::Interactive;
+}
+
+RequestClass RequestHandler::Classify(const http::request &current_request) const
+{
+    const auto target = splitTarget(current_request.uri);
+    if (!target)
+    {
+        // answered at once with an error
+        return {RequestPriority::Interactive, 1};
+    }
+
+    const auto [service, query] = *target;
+    const auto priority = PriorityOf(service);
+    if (service == "batch")
+    {
+        return {priority, batchCost(current_request.body)};
+    }
+    // the coordinates of a request with a body are in the body, which is verified only by the
+    // service. Every coordinate takes 8 bytes, so its size bounds their number.
+    if (!current_request.body.empty())
+    {
+        return {priority,
+                std::max<std::uint64_t>(current_request.body.size() /
+                                            sizeof(engine::api::fbrequest::Coordinate),
+                                        1)};
+    }
+    return {priority, queryCost(query)};
+}
+
+void SendMetrics(const RequestMetrics &metrics, http::reply &current_reply)
+{
+    const auto text = metrics.RenderPrometheus();
+    current_reply.content.assign(text.begin(), text.end());
+    current_reply.headers.emplace_back("Content-Type", "text/plain; version=0.0.4; charset=utf-8");
+    current_reply.headers.emplace_back("Content-Length",
+                                       std::to_string(current_reply.content.size()));
+}
+
 void SendResponse(ServiceHandler::ResultT &result, http::reply &current_reply)
 {
 
     current_reply.headers.emplace_back("Access-Control-Allow-Origin", "*");
-    current_reply.headers.emplace_back("Access-Control-Allow-Methods", "GET");
+    current_reply.headers.emplace_back("Access-Control-Allow-Methods", "GET, POST");
     current_reply.headers.emplace_back("Access-Control-Allow-Headers",
                                        "X-Requested-With, Content-Type");
     if (std::holds_alternative<util::json::Object>(result))
@@ -47,13 +337,19 @@ void SendResponse(ServiceHandler::ResultT &result, http::reply &current_reply)
 
         util::json::render(current_reply.content, std::get<util::json::Object>(result));
     }
+    else if (std::holds_alternative<engine::api::RenderedJSON>(result))
+    {
+        current_reply.headers.emplace_back("Content-Type", "application/json; charset=UTF-8");
+        current_reply.headers.emplace_back("Content-Disposition",
+                                           "inline; filename=\"response.json\"");
+
+        current_reply.content = std::move(std::get<engine::api::RenderedJSON>(result).content);
+    }
     else if (std::holds_alternative<flatbuffers::FlatBufferBuilder>(result))
     {
         auto &buffer = std::get<flatbuffers::FlatBufferBuilder>(result);
-        current_reply.content.resize(buffer.GetSize());
-        std::copy(buffer.GetBufferPointer(),
-                  buffer.GetBufferPointer() + buffer.GetSize(),
-                  current_reply.content.begin());
+        current_reply.content.assign(buffer.GetBufferPointer(),
+                                     buffer.GetBufferPointer() + buffer.GetSize());
 
         current_reply.headers.emplace_back(
             "Content-Type", "application/x-flatbuffers;schema=osrm.engine.api.fbresult");
@@ -74,7 +370,117 @@ void SendResponse(ServiceHandler::ResultT &result, http::reply &current_reply)
                                        std::to_string(current_reply.content.size()));
 }
 
-void RequestHandler::HandleRequest(const http::request &current_request, http::reply &current_reply)
+engine::Status RequestHandler::RunBatch(const api::ParsedURL &parsed_url,
+                                       ServiceHandler::ResultT &result) const
+{
+    const auto error = [&](const char *code, const std::string &message)
+    {
+        result = util::json::Object();
+        auto &json_result = std::get<util::json::Object>(result);
+        json_result.values["code"] = code;
+        json_result.values["message"] = message;
+        return engine::Status::Error;
+    };
+
+    if (parsed_url.version != 1)
+    {
+        return error("InvalidVersion", "Service batch not found!");
+    }
+    // the service of the queries takes the place of the coordinates in the URL
+    const auto &service = parsed_url.query;
+    if (service == "batch" || service == "tile")
+    {
+        return error("InvalidService", "Batch requests can not contain " + service + " queries");
+    }
+    auto queries = parseBatchQueries(parsed_url.body);
+    if (!queries)
+    {
+        return error("InvalidBody",
+                     "Batch requests need a body like {\"queries\": [\"7.41,43.73;7.42,43.74\"]}");
+    }
+    if (queries->size() > max_batch_size)
+    {
+        return error("TooBig",
+                     "Number of queries " + std::to_string(queries->size()) +
+                         " is higher than current maximum (" + std::to_string(max_batch_size) +
+                         ")");
+    }
+
+    // all queries see the same dataset and give up together once the request is cancelled
+    engine::DatasetSnapshot snapshot;
+    const auto *cancellation = engine::CurrentCancellationToken();
+    std::vector<std::vector<char>> responses(queries->size());
+    const auto run_query = [&](const std::size_t index)
+    {
+        const engine::ScopedCancellation scoped_cancellation(cancellation);
+        const engine::ScopedDatasetSnapshot scoped_snapshot(&snapshot);
+        std::pmr::monotonic_buffer_resource json_arena{JSON_ARENA_INITIAL_SIZE};
+        const util::json::ScopedMemoryResource scoped_json_arena{&json_arena};
+
+        api::ParsedURL query_url{
+            service, parsed_url.version, parsed_url.profile, std::move((*queries)[index]), 0};
+        ServiceHandler::ResultT query_result;
+        service_handler->RunQuery(std::move(query_url), query_result);
+        renderBatchResponse(query_result, responses[index]);
+    };
+    if (compute_pool)
+    {
+        compute_pool->ParallelFor(responses.size(), run_query, PriorityOf("batch"));
+    }
+    else
+    {
+        for (const auto index : util::irange<std::size_t>(0, responses.size()))
+        {
+            run_query(index);
+        }
+    }
+
+    // every query has its own code, the batch itself succeeded
+    constexpr std::string_view prefix = R"({"code":"Ok","results":[)";
+    constexpr std::string_view suffix = "]}";
+    std::size_t size = prefix.size() + responses.size() + suffix.size();
+    for (const auto &response : responses)
+    {
+        size += response.size();
+    }
+
+    engine::api::RenderedJSON rendered;
+    auto &content = rendered.content;
+    content.reserve(size);
+    content.insert(content.end(), prefix.begin(), prefix.end());
+    for (const auto index : util::irange<std::size_t>(0, responses.size()))
+    {
+        if (index > 0)
+        {
+            content.push_back(',');
+        }
+        content.insert(content.end(), responses[index].begin(), responses[index].end());
+    }
+    content.insert(content.end(), suffix.begin(), suffix.end());
+    result = std::move(rendered);
+    return engine::Status::Ok;
+}
+
+void RequestHandler::Reject(const http::request &current_request,
+                            const RequestPriority priority,
+                            http::reply &current_reply) const
+{
+    current_reply.status = http::reply::service_unavailable;
+
+    ServiceHandler::ResultT result = util::json::Object();
+    auto &json_result = std::get<util::json::Object>(result);
+    json_result.values["code"] = "TooManyRequests";
+    json_result.values["message"] =
+        "Too many " + std::string(REQUEST_PRIORITY_NAMES[static_cast<std::size_t>(priority)]) +
+        " requests are waiting, try again later";
+    SendResponse(result, current_reply);
+
+    util::Log(logDEBUG) << "[rejected] code: TooManyRequests, uri: " << current_request.uri;
+}
+
+void RequestHandler::HandleRequest(const http::request &current_request,
+                                   http::reply &current_reply,
+                                   std::function<bool()> is_disconnected)
 {
     if (!service_handler)
     {
@@ -83,8 +489,30 @@ void RequestHandler::HandleRequest(const http::request &current_request, http::r
         return;
     }
 
+    if (metrics_endpoint && current_request.uri == "/metrics")
+    {
+        SendMetrics(*metrics, current_reply);
+        return;
+    }
+
     const auto tid = std::this_thread::get_id();
 
+    // the searches of the request look at this token every few hundred settled nodes
+    std::optional<engine::CancellationToken> cancellation;
+    if (request_timeout || cancel_on_disconnect)
+    {
+        std::optional<engine::CancellationToken::Clock::time_point> deadline;
+        if (request_timeout)
+        {
+            deadline = engine::CancellationToken::Clock::now() + *request_timeout;
+        }
+        cancellation.emplace(deadline,
+                             cancel_on_disconnect ? std::move(is_disconnected)
+                                                  : std::function<bool()>{});
+    }
+    const engine::ScopedCancellation scoped_cancellation(cancellation ? &*cancellation : nullptr);
+    ScopedRequestMetrics scoped_metrics(metrics.get(), server_timing, current_reply);
+
     // parse command
     try
     {
@@ -96,14 +524,21 @@ void RequestHandler::HandleRequest(const http::request &current_request, http::r
 
         auto api_iterator = request_string.begin();
         auto maybe_parsed_url = api::parseURL(api_iterator, request_string.end());
+
+        // the JSON tree of the response is freed at once after it has been rendered
+        std::pmr::monotonic_buffer_resource json_arena{JSON_ARENA_INITIAL_SIZE};
+        const util::json::ScopedMemoryResource scoped_json_arena{&json_arena};
         ServiceHandler::ResultT result;
 
         // check if the was an error with the request
         if (maybe_parsed_url && api_iterator == request_string.end())
         {
-
+            scoped_metrics.service = maybe_parsed_url->service;
+            maybe_parsed_url->body = current_request.body;
             const engine::Status status =
-                service_handler->RunQuery(*std::move(maybe_parsed_url), result);
+                scoped_metrics.service == "batch"
+                    ? RunBatch(*maybe_parsed_url, result)
+                    : service_handler->RunQuery(*std::move(maybe_parsed_url), result);
             if (status != engine::Status::Ok)
             {
                 // 4xx bad request return code
@@ -134,7 +569,10 @@ void RequestHandler::HandleRequest(const http::request &current_request, http::r
                                             std::to_string(position) + ": \"" + context + "\"";
         }
 
-        SendResponse(result, current_reply);
+        {
+            const util::ScopedRequestPhase rendering(util::RequestPhase::Rendering);
+            SendResponse(result, current_reply);
+        }
 
         if (!std::getenv("DISABLE_ACCESS_LOGGING"))
         {
@@ -183,6 +621,25 @@ void RequestHandler::HandleRequest(const http::request &current_request, http::r
         util::Log(logWARNING) << "[disabled dataset error][" << tid << "] code: DisabledDataset_"
                               << e.Dataset() << ", uri: " << current_request.uri;
     }
+    catch (const engine::RequestCancelledException &e)
+    {
+        current_reply.status = http::reply::service_unavailable;
+
+        const auto timeout = e.Reason() == engine::CancellationReason::Timeout;
+        ServiceHandler::ResultT result = util::json::Object();
+        auto &json_result = std::get<util::json::Object>(result);
+        json_result.values["code"] = timeout ? "RequestTimeout" : "RequestCancelled";
+        json_result.values["message"] = e.what();
+        SendResponse(result, current_reply);
+
+        if (metrics)
+        {
+            metrics->RecordCancellation(e.Reason());
+        }
+        util::Log(logWARNING) << "[cancelled][" << tid
+                              << "] code: " << (timeout ? "RequestTimeout" : "RequestCancelled")
+                              << ", uri: " << current_request.uri;
+    }
     catch (const std::exception &e)
     {
         current_reply = http::reply::stock_reply(http::reply::internal_server_error);
@@ -0,0 +1,215 @@
+#include "server/request_metrics.hpp"
+#include "server/compute_pool.hpp"
+
+#include "engine/route_cache.hpp"
+#include "engine/search_engine_data.hpp"
+#include "engine/snapping_cache.hpp"
+
+#include "util/integer_range.hpp"
+
+#include <boost/assert.hpp>
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace osrm::server
+{
+
+void RequestMetrics::Record(const std::string_view service,
+                            const unsigned status,
+                            const std::chrono::nanoseconds total,
+                            const util::RequestPhaseDurations &phases)
+{
+    const auto index = std::find(SERVICES.begin(), SERVICES.end() - 1, service) - SERVICES.begin();
+    BOOST_ASSERT(std::find(STATUSES.begin(), STATUSES.end(), status) != STATUSES.end());
+    const auto status_index =
+        std::find(STATUSES.begin(), STATUSES.end() - 1, status) - STATUSES.begin();
+
+    totals[index][status_index].Record(total);
+    for (const auto phase : util::irange<std::size_t>(0, util::NUMBER_OF_REQUEST_PHASES))
+    {
+        // only phases the request went through
+        if (phases[phase].count() > 0)
+        {
+            phase_durations[index][phase].Record(phases[phase]);
+        }
+    }
+}
+
+void RequestMetrics::RecordCancellation(const engine::CancellationReason reason)
+{
+    BOOST_ASSERT(reason != engine::CancellationReason::None);
+    const auto index = reason == engine::CancellationReason::Timeout ? 0 : 1;
+    cancellations[index].fetch_add(1, std::memory_order_relaxed);
+}
+
+std::string RequestMetrics::RenderPrometheus() const
+{
+    std::string out;
+
+    out += "# HELP osrm_request_duration_seconds Time to answer a request.\n"
+           "# TYPE osrm_request_duration_seconds histogram\n";
+    for (const auto service : util::irange<std::size_t>(0, SERVICES.size()))
+    {
+        for (const auto status : util::irange<std::size_t>(0, STATUSES.size()))
+        {
+            // successful requests are always reported, failed ones once they happened
+            if (status > 0 && totals[service][status].Count() == 0)
+            {
+                continue;
+            }
+            totals[service][status].RenderPrometheus(
+                out,
+                "osrm_request_duration_seconds",
+                fmt::format(
+                    "service=\"{}\",status=\"{}\"", SERVICES[service], STATUSES[status]));
+        }
+    }
+
+    out += "# HELP osrm_request_phase_duration_seconds Time spent in a phase of a request.\n"
+           "# TYPE osrm_request_phase_duration_seconds histogram\n";
+    for (const auto service : util::irange<std::size_t>(0, SERVICES.size()))
+    {
+        for (const auto phase : util::irange<std::size_t>(0, util::NUMBER_OF_REQUEST_PHASES))
+        {
+            // most services never go through some of the phases
+            if (phase_durations[service][phase].Count() == 0)
+            {
+                continue;
+            }
+            phase_durations[service][phase].RenderPrometheus(
+                out,
+                "osrm_request_phase_duration_seconds",
+                fmt::format("service=\"{}\",phase=\"{}\"",
+                            SERVICES[service],
+                            util::REQUEST_PHASE_NAMES[phase]));
+        }
+    }
+
+    // counters are process-wide, so they are also reported without the caches
+    fmt::format_to(std::back_inserter(out),
+                   "# HELP osrm_snapping_cache_hits_total Coordinates answered from the snapping "
+                   "cache.\n"
+                   "# TYPE osrm_snapping_cache_hits_total counter\n"
+                   "osrm_snapping_cache_hits_total {}\n"
+                   "# HELP osrm_snapping_cache_misses_total Coordinates not found in the snapping "
+                   "cache.\n"
+                   "# TYPE osrm_snapping_cache_misses_total counter\n"
+                   "osrm_snapping_cache_misses_total {}\n",
+                   engine::SnappingCacheStatistics::hits.load(std::memory_order_relaxed),
+                   engine::SnappingCacheStatistics::misses.load(std::memory_order_relaxed));
+    fmt::format_to(std::back_inserter(out),
+                   "# HELP osrm_route_cache_hits_total Route requests answered from the route "
+                   "cache.\n"
+                   "# TYPE osrm_route_cache_hits_total counter\n"
+                   "osrm_route_cache_hits_total {}\n"
+                   "# HELP osrm_route_cache_misses_total Route requests not found in the route "
+                   "cache.\n"
+                   "# TYPE osrm_route_cache_misses_total counter\n"
+                   "osrm_route_cache_misses_total {}\n"
+                   "# HELP osrm_route_cache_admissions_total Route responses added to the route "
+                   "cache.\n"
+                   "# TYPE osrm_route_cache_admissions_total counter\n"
+                   "osrm_route_cache_admissions_total {}\n"
+                   "# HELP osrm_route_cache_evictions_total Route responses evicted from the route "
+                   "cache.\n"
+                   "# TYPE osrm_route_cache_evictions_total counter\n"
+                   "osrm_route_cache_evictions_total {}\n",
+                   engine::RouteCacheStatistics::hits.load(std::memory_order_relaxed),
+                   engine::RouteCacheStatistics::misses.load(std::memory_order_relaxed),
+                   engine::RouteCacheStatistics::admissions.load(std::memory_order_relaxed),
+                   engine::RouteCacheStatistics::evictions.load(std::memory_order_relaxed));
+    fmt::format_to(
+        std::back_inserter(out),
+        "# HELP osrm_query_heap_high_water_mark_bytes Largest memory of the query heaps of a "
+        "thread seen after a request.\n"
+        "# TYPE osrm_query_heap_high_water_mark_bytes gauge\n"
+        "osrm_query_heap_high_water_mark_bytes {}\n"
+        "# HELP osrm_query_heap_trims_total Query heaps released because they exceeded "
+        "--max-heap-memory.\n"
+        "# TYPE osrm_query_heap_trims_total counter\n"
+        "osrm_query_heap_trims_total {}\n",
+        engine::HeapMemoryStatistics::high_water_mark.load(std::memory_order_relaxed),
+        engine::HeapMemoryStatistics::trimmed_heaps.load(std::memory_order_relaxed));
+    fmt::format_to(std::back_inserter(out),
+                   "# HELP osrm_cancelled_requests_total Requests whose searches were given up.\n"
+                   "# TYPE osrm_cancelled_requests_total counter\n"
+                   "osrm_cancelled_requests_total{{reason=\"timeout\"}} {}\n"
+                   "osrm_cancelled_requests_total{{reason=\"cancelled\"}} {}\n",
+                   cancellations[0].load(std::memory_order_relaxed),
+                   cancellations[1].load(std::memory_order_relaxed));
+
+    fmt::format_to(std::back_inserter(out),
+                   "# HELP osrm_compute_threads Threads that handle requests.\n"
+                   "# TYPE osrm_compute_threads gauge\n"
+                   "osrm_compute_threads {}\n",
+                   ComputePoolStatistics::threads.load(std::memory_order_relaxed));
+    const auto render_per_priority =
+        [&](const std::string_view name,
+            const std::string_view help,
+            const std::string_view type,
+            const ComputePoolStatistics::PerPriority<std::atomic<std::uint64_t>> &values)
+    {
+        fmt::format_to(
+            std::back_inserter(out), "# HELP {} {}\n# TYPE {} {}\n", name, help, name, type);
+        for (const auto priority : util::irange<std::size_t>(0, NUMBER_OF_REQUEST_PRIORITIES))
+        {
+            fmt::format_to(std::back_inserter(out),
+                           "{}{{priority=\"{}\"}} {}\n",
+                           name,
+                           REQUEST_PRIORITY_NAMES[priority],
+                           values[priority].load(std::memory_order_relaxed));
+        }
+    };
+    render_per_priority("osrm_compute_queue_depth",
+                        "Requests waiting for a compute thread.",
+                        "gauge",
+                        ComputePoolStatistics::queued);
+    render_per_priority("osrm_compute_queue_cost",
+                        "Coordinates of the requests waiting for a compute thread.",
+                        "gauge",
+                        ComputePoolStatistics::queued_cost);
+    render_per_priority("osrm_compute_in_flight",
+                        "Requests a compute thread is working on.",
+                        "gauge",
+                        ComputePoolStatistics::in_flight);
+    render_per_priority("osrm_compute_rejected_total",
+                        "Requests rejected because their queue was full.",
+                        "counter",
+                        ComputePoolStatistics::rejected);
+    out += "# HELP osrm_compute_queue_wait_seconds Time requests waited for a compute thread.\n"
+           "# TYPE osrm_compute_queue_wait_seconds histogram\n";
+    for (const auto priority : util::irange<std::size_t>(0, NUMBER_OF_REQUEST_PRIORITIES))
+    {
+        ComputePoolStatistics::wait_durations[priority].RenderPrometheus(
+            out,
+            "osrm_compute_queue_wait_seconds",
+            fmt::format("priority=\"{}\"", REQUEST_PRIORITY_NAMES[priority]));
+    }
+
+    return out;
+}
+
+std::string RequestMetrics::RenderServerTiming(const std::chrono::nanoseconds total,
+                                               const util::RequestPhaseDurations &phases)
+{
+    const auto to_milliseconds = [](const std::chrono::nanoseconds duration)
+    { return std::chrono::duration<double, std::milli>(duration).count(); };
+
+    std::string out;
+    auto inserter = std::back_inserter(out);
+    for (const auto phase : util::irange<std::size_t>(0, util::NUMBER_OF_REQUEST_PHASES))
+    {
+        if (phases[phase].count() > 0)
+        {
+            fmt::format_to(inserter,
+                           "{};dur={:.3f}, ",
+                           util::REQUEST_PHASE_NAMES[phase],
+                           to_milliseconds(phases[phase]));
+        }
+    }
+    fmt::format_to(inserter, "total;dur={:.3f}", to_milliseconds(total));
+    return out;
+}
+} // namespace osrm::server
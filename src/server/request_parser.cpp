@@ -6,12 +6,20 @@
 
 #include <boost/algorithm/string/predicate.hpp>
 
+#include <algorithm>
+
 namespace osrm::server
 {
 
+namespace
+{
+// Memory reserved for a body before its bytes arrive, larger bodies grow as they are received
+constexpr std::size_t MAX_BODY_RESERVATION = 64 * 1024;
+} // namespace
+
 RequestParser::RequestParser()
     : state(internal_state::method_start), current_header({"", ""}),
-      selected_compression(http::no_compression)
+      selected_compression(http::no_compression), content_length(0), expect_continue(false)
 {
 }
 
@@ -20,6 +28,17 @@ RequestParser::parse(http::request &current_request, char *begin, char *end)
 {
     while (begin != end)
     {
+        if (state == internal_state::body)
+        {
+            // the body is copied as a whole instead of char by char
+            const auto missing = content_length - current_request.body.size();
+            const auto available = static_cast<std::size_t>(end - begin);
+            current_request.body.append(begin, std::min(missing, available));
+            return std::make_tuple(missing <= available ? RequestStatus::valid
+                                                        : RequestStatus::indeterminate,
+                                   selected_compression);
+        }
+
         RequestStatus result = consume(current_request, *begin++);
         if (result != RequestStatus::indeterminate)
         {
@@ -31,6 +50,13 @@ RequestParser::parse(http::request &current_request, char *begin, char *end)
     return std::make_tuple(result, selected_compression);
 }
 
+bool RequestParser::expects_continue()
+{
+    const bool expects = expect_continue && state == internal_state::body;
+    expect_continue = false;
+    return expects;
+}
+
 RequestParser::RequestStatus RequestParser::consume(http::request &current_request,
                                                     const char input)
 {
@@ -42,6 +68,7 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
             return RequestStatus::invalid;
         }
         state = internal_state::method;
+        current_request.method.push_back(input);
         return RequestStatus::indeterminate;
     case internal_state::method:
         if (input == ' ')
@@ -53,6 +80,7 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
         {
             return RequestStatus::invalid;
         }
+        current_request.method.push_back(input);
         return RequestStatus::indeterminate;
     case internal_state::uri_start:
         if (is_CTL(input))
@@ -112,6 +140,7 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
     case internal_state::http_version_major_start:
         if (is_digit(input))
         {
+            current_request.http_version_major = input - '0';
             state = internal_state::http_version_major;
             return RequestStatus::indeterminate;
         }
@@ -124,12 +153,15 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
         }
         if (is_digit(input))
         {
+            current_request.http_version_major =
+                current_request.http_version_major * 10 + (input - '0');
             return RequestStatus::indeterminate;
         }
         return RequestStatus::invalid;
     case internal_state::http_version_minor_start:
         if (is_digit(input))
         {
+            current_request.http_version_minor = input - '0';
             state = internal_state::http_version_minor;
             return RequestStatus::indeterminate;
         }
@@ -142,6 +174,8 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
         }
         if (is_digit(input))
         {
+            current_request.http_version_minor =
+                current_request.http_version_minor * 10 + (input - '0');
             return RequestStatus::indeterminate;
         }
         return RequestStatus::invalid;
@@ -181,6 +215,39 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
             current_request.connection = current_header.value;
         }
 
+        if (boost::iequals(current_header.name, "Content-Type"))
+        {
+            current_request.content_type = current_header.value;
+        }
+
+        if (boost::iequals(current_header.name, "Content-Length"))
+        {
+            if (current_header.value.empty() ||
+                !std::all_of(current_header.value.begin(),
+                             current_header.value.end(),
+                             [this](const char c) { return is_digit(c); }) ||
+                current_header.value.size() > 9)
+            {
+                return RequestStatus::invalid;
+            }
+            content_length = std::stoul(current_header.value);
+            if (content_length > MAX_BODY_SIZE)
+            {
+                return RequestStatus::invalid;
+            }
+        }
+
+        // bodies are only read with a Content-Length
+        if (boost::iequals(current_header.name, "Transfer-Encoding"))
+        {
+            return RequestStatus::invalid;
+        }
+
+        if (boost::iequals(current_header.name, "Expect"))
+        {
+            expect_continue = boost::iequals(current_header.value, "100-continue");
+        }
+
         if (input == '\r')
         {
             state = internal_state::expecting_newline_3;
@@ -246,8 +313,22 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
             return RequestStatus::indeterminate;
         }
         return RequestStatus::invalid;
-    default: // expecting_newline_3
-        return input == '\n' ? RequestStatus::valid : RequestStatus::invalid;
+    case internal_state::expecting_newline_3:
+        if (input != '\n')
+        {
+            return RequestStatus::invalid;
+        }
+        if (content_length == 0)
+        {
+            return RequestStatus::valid;
+        }
+        state = internal_state::body;
+        current_request.body.reserve(std::min(content_length, MAX_BODY_RESERVATION));
+        return RequestStatus::indeterminate;
+    default: // body
+        current_request.body.push_back(input);
+        return current_request.body.size() == content_length ? RequestStatus::valid
+                                                               : RequestStatus::indeterminate;
     }
 }
 
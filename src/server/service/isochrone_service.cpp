@@ -0,0 +1,84 @@
+#include "server/service/isochrone_service.hpp"
+#include "server/service/utils.hpp"
+
+#include "server/api/parameters_parser.hpp"
+#include "server/api/request_body_parser.hpp"
+#include "engine/api/isochrone_parameters.hpp"
+
+#include "util/json_container.hpp"
+
+namespace osrm::server::service
+{
+
+namespace
+{
+std::string getWrongOptionHelp(const engine::api::IsochroneParameters &parameters)
+{
+    std::string help;
+
+    const auto coord_size = parameters.coordinates.size();
+
+    constrainParamSize(PARAMETER_SIZE_MISMATCH_MSG, "hints", parameters.hints, coord_size, help);
+    constrainParamSize(
+        PARAMETER_SIZE_MISMATCH_MSG, "bearings", parameters.bearings, coord_size, help);
+    constrainParamSize(
+        PARAMETER_SIZE_MISMATCH_MSG, "radiuses", parameters.radiuses, coord_size, help);
+    constrainParamSize(
+        PARAMETER_SIZE_MISMATCH_MSG, "approaches", parameters.approaches, coord_size, help);
+
+    if (help.empty() && !(parameters.duration > 0))
+    {
+        help = "Duration must be a positive number of seconds";
+    }
+
+    return help;
+}
+} // namespace
+
+engine::Status IsochroneService::RunQuery(std::size_t prefix_length,
+                                          std::string &query,
+                                          std::string_view body,
+                                          osrm::engine::api::ResultT &result)
+{
+    result = util::json::Object();
+    auto &json_result = std::get<util::json::Object>(result);
+
+    auto query_iterator = query.begin();
+    auto parameters =
+        api::parseParameters<engine::api::IsochroneParameters>(query_iterator, query.end());
+    if (!parameters || query_iterator != query.end())
+    {
+        const auto position = std::distance(query.begin(), query_iterator);
+        json_result.values["code"] = "InvalidQuery";
+        json_result.values["message"] =
+            "Query string malformed close to position " + std::to_string(prefix_length + position);
+        return engine::Status::Error;
+    }
+    BOOST_ASSERT(parameters);
+
+    std::string body_help;
+    if (!body.empty() && !api::parseBody(body, *parameters, body_help))
+    {
+        json_result.values["code"] = "InvalidBody";
+        json_result.values["message"] = body_help;
+        return engine::Status::Error;
+    }
+
+    if (!parameters->IsValid())
+    {
+        json_result.values["code"] = "InvalidOptions";
+        json_result.values["message"] = getWrongOptionHelp(*parameters);
+        return engine::Status::Error;
+    }
+    BOOST_ASSERT(parameters->IsValid());
+
+    if (parameters->format &&
+        parameters->format == engine::api::BaseParameters::OutputFormatType::FLATBUFFERS)
+    {
+        json_result.values["code"] = "InvalidOptions";
+        json_result.values["message"] = "Isochrones are only available as JSON";
+        return engine::Status::Error;
+    }
+    return BaseService::routing_machine.Isochrone(*parameters, result);
+}
+} // namespace osrm::server::service
@@ -1,6 +1,7 @@
 #include "server/service/match_service.hpp"
 
 #include "server/api/parameters_parser.hpp"
+#include "server/api/request_body_parser.hpp"
 #include "server/service/utils.hpp"
 #include "engine/api/match_parameters.hpp"
 
@@ -37,6 +38,7 @@ std::string getWrongOptionHelp(const engine::api::MatchParameters &parameters)
 
 engine::Status MatchService::RunQuery(std::size_t prefix_length,
                                       std::string &query,
+                                      std::string_view body,
                                       osrm::engine::api::ResultT &result)
 {
     result = util::json::Object();
@@ -55,6 +57,14 @@ engine::Status MatchService::RunQuery(std::size_t prefix_length,
     }
 
     BOOST_ASSERT(parameters);
+
+    std::string body_help;
+    if (!body.empty() && !api::parseBody(body, *parameters, body_help))
+    {
+        json_result.values["code"] = "InvalidBody";
+        json_result.values["message"] = body_help;
+        return engine::Status::Error;
+    }
     if (!parameters->IsValid())
     {
         json_result.values["code"] = "InvalidOptions";
@@ -2,6 +2,7 @@
 #include "server/service/utils.hpp"
 
 #include "server/api/parameters_parser.hpp"
+#include "server/api/request_body_parser.hpp"
 #include "engine/api/route_parameters.hpp"
 
 #include "util/json_container.hpp"
@@ -37,6 +38,7 @@ std::string getWrongOptionHelp(const engine::api::RouteParameters &parameters)
 
 engine::Status RouteService::RunQuery(std::size_t prefix_length,
                                       std::string &query,
+                                      std::string_view body,
                                       osrm::engine::api::ResultT &result)
 {
     result = util::json::Object();
@@ -55,6 +57,14 @@ engine::Status RouteService::RunQuery(std::size_t prefix_length,
     }
     BOOST_ASSERT(parameters);
 
+    std::string body_help;
+    if (!body.empty() && !api::parseBody(body, *parameters, body_help))
+    {
+        json_result.values["code"] = "InvalidBody";
+        json_result.values["message"] = body_help;
+        return engine::Status::Error;
+    }
+
     if (!parameters->IsValid())
     {
         json_result.values["code"] = "InvalidOptions";
@@ -63,12 +73,15 @@ engine::Status RouteService::RunQuery(std::size_t prefix_length,
     }
     BOOST_ASSERT(parameters->IsValid());
 
-    if (parameters->format)
+    if (parameters->format == engine::api::BaseParameters::OutputFormatType::FLATBUFFERS)
+    {
+        result = flatbuffers::FlatBufferBuilder();
+    }
+    else
     {
-        if (parameters->format == engine::api::BaseParameters::OutputFormatType::FLATBUFFERS)
-        {
-            result = flatbuffers::FlatBufferBuilder();
-        }
+        // Routes are only sent over the wire, render them in the engine so that the route
+        // cache can keep the bytes
+        result = engine::api::RenderedJSON();
     }
     return BaseService::routing_machine.Route(*parameters, result);
 }
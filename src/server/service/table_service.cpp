@@ -1,6 +1,7 @@
 #include "server/service/table_service.hpp"
 
 #include "server/api/parameters_parser.hpp"
+#include "server/api/request_body_parser.hpp"
 #include "engine/api/table_parameters.hpp"
 
 #include "util/json_container.hpp"
@@ -68,6 +69,7 @@ std::string getWrongOptionHelp(const engine::api::TableParameters &parameters)
 
 engine::Status TableService::RunQuery(std::size_t prefix_length,
                                       std::string &query,
+                                      std::string_view body,
                                       osrm::engine::api::ResultT &result)
 {
     result = util::json::Object();
@@ -86,6 +88,14 @@ engine::Status TableService::RunQuery(std::size_t prefix_length,
     }
     BOOST_ASSERT(parameters);
 
+    std::string body_help;
+    if (!body.empty() && !api::parseBody(body, *parameters, body_help))
+    {
+        json_result.values["code"] = "InvalidBody";
+        json_result.values["message"] = body_help;
+        return engine::Status::Error;
+    }
+
     if (!parameters->IsValid())
     {
         json_result.values["code"] = "InvalidOptions";
@@ -94,12 +104,14 @@ engine::Status TableService::RunQuery(std::size_t prefix_length,
     }
     BOOST_ASSERT(parameters->IsValid());
 
-    if (parameters->format)
+    if (parameters->format == engine::api::BaseParameters::OutputFormatType::FLATBUFFERS)
+    {
+        result = flatbuffers::FlatBufferBuilder();
+    }
+    else
     {
-        if (parameters->format == engine::api::BaseParameters::OutputFormatType::FLATBUFFERS)
-        {
-            result = flatbuffers::FlatBufferBuilder();
-        }
+        // Tables are only sent over the wire, render them without a JSON tree
+        result = engine::api::RenderedJSON();
     }
     return BaseService::routing_machine.Table(*parameters, result);
 }
@@ -11,8 +11,18 @@ namespace osrm::server::service
 
 engine::Status TileService::RunQuery(std::size_t prefix_length,
                                      std::string &query,
+                                     std::string_view body,
                                      osrm::engine::api::ResultT &result)
 {
+    if (!body.empty())
+    {
+        result = util::json::Object();
+        auto &json_result = std::get<util::json::Object>(result);
+        json_result.values["code"] = "InvalidBody";
+        json_result.values["message"] = "The tile service does not take a request body";
+        return engine::Status::Error;
+    }
+
     auto query_iterator = query.begin();
     auto parameters =
         api::parseParameters<engine::api::TileParameters>(query_iterator, query.end());
@@ -576,10 +576,20 @@ void Storage::PopulateUpdatableData(const SharedDataIndex &index)
 
     if (std::filesystem::exists(config.GetPath(".osrm.mldgr")))
     {
-        auto graph_view = make_multi_level_graph_view(index, "/mld/multilevelgraph");
         std::uint32_t graph_connectivity_checksum = 0;
-        customizer::files::readGraph(
-            config.GetPath(".osrm.mldgr"), graph_view, graph_connectivity_checksum);
+        if (has_compressed_multi_level_graph(index, "/mld/compressedmultilevelgraph"))
+        {
+            auto graph_view =
+                make_compressed_multi_level_graph_view(index, "/mld/compressedmultilevelgraph");
+            customizer::files::readCompressedGraph(
+                config.GetPath(".osrm.mldgr"), graph_view, graph_connectivity_checksum);
+        }
+        else
+        {
+            auto graph_view = make_multi_level_graph_view(index, "/mld/multilevelgraph");
+            customizer::files::readGraph(
+                config.GetPath(".osrm.mldgr"), graph_view, graph_connectivity_checksum);
+        }
 
         if (config.IsRequiredConfiguredInput("osrm.edges"))
         {
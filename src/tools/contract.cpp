@@ -69,7 +69,20 @@ return_code parseArguments(int argc,
         "time-zone-file",
         boost::program_options::value<std::string>(&contractor_config.updater_config.tz_file_path),
         "Required for conditional turn restriction parsing, provide a geojson file containing "
-        "time zone boundaries");
+        "time zone boundaries")(
+        "phast",
+        boost::program_options::bool_switch(&contractor_config.build_phast_sweep)
+            ->default_value(false),
+        "Store the downward edges in sweep order so large tables can use PHAST queries")(
+        "renumber-nodes",
+        boost::program_options::bool_switch(&contractor_config.renumber_nodes)
+            ->default_value(false),
+        "Renumber the nodes by contraction level for faster queries. Rewrites the extracted "
+        "data and removes MLD data, the dataset can only be used with CH afterwards")(
+        "compress-graph",
+        boost::program_options::bool_switch(&contractor_config.compress_graph)
+            ->default_value(false),
+        "Store the contracted graph compressed, which needs less memory but makes queries slower");
 
     // hidden options, will be allowed on command line, but will not be shown to the user
     boost::program_options::options_description hidden_options("Hidden options");
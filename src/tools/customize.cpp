@@ -69,7 +69,12 @@ return_code parseArguments(int argc,
                 &customization_config.updater_config.tz_file_path)
                 ->default_value(""),
             "Required for conditional turn restriction parsing, provide a geojson file containing "
-            "time zone boundaries");
+            "time zone boundaries")(
+            "compress-graph",
+            boost::program_options::bool_switch(&customization_config.compress_graph)
+                ->default_value(false),
+            "Store the multi-level graph compressed, which needs less memory but makes queries "
+            "slower");
 
     // hidden options, will be allowed on command line, but will not be
     // shown to the user
@@ -20,13 +20,16 @@
 #include <signal.h>
 
 #include <chrono>
+#include <cstdint>
 #include <exception>
 #include <filesystem>
 #include <future>
 #include <iostream>
 #include <new>
+#include <optional>
 #include <string>
 #include <thread>
+#include <vector>
 
 #ifdef _WIN32
 boost::function0<void> console_ctrl_function;
@@ -108,7 +111,18 @@ inline unsigned generateServerProgramOptions(const int argc,
                                              bool &trial,
                                              EngineConfig &config,
                                              int &requested_thread_num,
-                                             short &keepalive_timeout)
+                                             int &requested_io_thread_num,
+                                             bool &listener_per_thread,
+                                             bool &pin_io_threads,
+                                             short &keepalive_timeout,
+                                             bool &metrics_endpoint,
+                                             bool &server_timing,
+                                             double &request_timeout,
+                                             bool &cancel_on_disconnect,
+                                             std::vector<std::string> &batch_services,
+                                             std::size_t &max_batch_size,
+                                             server::ComputePool::Limits &interactive_limits,
+                                             server::ComputePool::Limits &batch_limits)
 {
     using boost::program_options::value;
     using std::filesystem::path;
@@ -140,10 +154,60 @@ inline unsigned generateServerProgramOptions(const int argc,
          "TCP/IP port") //
         ("threads,t",
          value<int>(&requested_thread_num)->default_value(hardware_threads),
-         "Number of threads to use") //
+         "Number of threads that handle requests") //
+        ("io-threads",
+         value<int>(&requested_io_thread_num)->default_value(1),
+         "Number of threads that accept connections, read requests and write replies") //
+        ("listener-per-thread",
+         value<bool>(&listener_per_thread)->implicit_value(true)->default_value(false),
+         "Give every I/O thread its own event loop and SO_REUSEPORT listening socket, so the "
+         "kernel spreads the connections over the threads.") //
+        ("pin-io-threads",
+         value<bool>(&pin_io_threads)->implicit_value(true)->default_value(false),
+         "Pin every I/O thread to its own core (Linux only).") //
         ("keepalive-timeout,k",
          value<short>(&keepalive_timeout)->default_value(5),
          "Default keepalive-timeout. Default: 5 seconds.") //
+        ("metrics",
+         value<bool>(&metrics_endpoint)->implicit_value(true)->default_value(false),
+         "Serve latency histograms of every service and request phase on /metrics in the "
+         "Prometheus text format.") //
+        ("server-timing",
+         value<bool>(&server_timing)->implicit_value(true)->default_value(false),
+         "Send the duration of every request phase in a Server-Timing header.") //
+        ("request-timeout",
+         value<double>(&request_timeout)->default_value(-1.0),
+         "Give up the searches of a request after this many seconds and reply with a 503 "
+         "RequestTimeout error. Default: -1 = no timeout.") //
+        ("cancel-on-disconnect",
+         value<bool>(&cancel_on_disconnect)->implicit_value(true)->default_value(false),
+         "Give up the searches of a request once its client closed the connection. Clients "
+         "that shut down their sending side after the request count as gone.") //
+        ("batch-services",
+         value<std::vector<std::string>>(&batch_services)
+             ->multitoken()
+             ->default_value(std::vector<std::string>{}, ""),
+         "Services whose requests only start while no interactive request is waiting, e.g. "
+         "table match trip isochrone batch. None by default.") //
+        ("max-batch-size",
+         value<std::size_t>(&max_batch_size)->default_value(1000),
+         "Max. number of queries of a /batch request.") //
+        ("max-interactive-in-flight",
+         value<std::size_t>(&interactive_limits.max_in_flight)->default_value(0),
+         "Max. number of interactive requests handled at the same time. Default: 0 = all "
+         "threads.") //
+        ("max-batch-in-flight",
+         value<std::size_t>(&batch_limits.max_in_flight)->default_value(0),
+         "Max. number of batch requests handled at the same time, fewer than --threads keeps "
+         "threads free for interactive requests. Default: 0 = all threads.") //
+        ("max-interactive-queue",
+         value<std::uint64_t>(&interactive_limits.max_queued_cost)->default_value(0),
+         "Max. number of coordinates of all waiting interactive requests, more are rejected "
+         "with a 503 TooManyRequests error. Default: 0 = unlimited.") //
+        ("max-batch-queue",
+         value<std::uint64_t>(&batch_limits.max_queued_cost)->default_value(0),
+         "Max. number of coordinates of all waiting batch requests, more are rejected with a "
+         "503 TooManyRequests error. Default: 0 = unlimited.") //
         ("shared-memory,s",
          value<bool>(&config.use_shared_memory)->implicit_value(true)->default_value(false),
          "Load data from shared memory") //
@@ -160,6 +224,10 @@ inline unsigned generateServerProgramOptions(const int argc,
          value<EngineConfig::Algorithm>(&config.algorithm)
              ->default_value(EngineConfig::Algorithm::CH, "CH"),
          "Algorithm to use for the data. Can be CH, MLD.") //
+        ("array-heap-storage",
+         value<bool>(&config.use_array_heap_storage)->implicit_value(true)->default_value(false),
+         "Index CH query heaps with per-thread arrays sized to the graph instead of hash maps. "
+         "Faster, but uses more memory per thread.") //
         ("disable-feature-dataset",
          value<std::vector<storage::FeatureDataset>>(&config.disable_feature_dataset)->multitoken(),
          "Disables a feature dataset from being loaded into memory if not needed. Options: "
@@ -185,9 +253,30 @@ inline unsigned generateServerProgramOptions(const int argc,
         ("max-matching-radius",
          value<double>(&config.max_radius_map_matching)->default_value(-1.0),
          "Max. radius size supported in map matching query. Default: unlimited.") //
+        ("max-isochrone-duration",
+         value<double>(&config.max_duration_isochrone)->default_value(3600),
+         "Max. duration in seconds supported in isochrone query") //
         ("default-radius",
          value<double>(&config.default_radius)->default_value(-1.0),
-         "Default radius size for queries. Default: unlimited.");
+         "Default radius size for queries. Default: unlimited.") //
+        ("table-threads",
+         value<int>(&config.many_to_many_threads)->default_value(1),
+         "Max. number of threads a single table or trip request may use. Default: 1.") //
+        ("phast-min-targets",
+         value<int>(&config.phast_min_targets)->default_value(-1),
+         "Min. number of destinations for which CH table requests use PHAST sweeps. Needs a "
+         "dataset contracted with --phast. Default: disabled.") //
+        ("max-heap-memory",
+         value<int>(&config.max_heap_memory_mb)->default_value(-1),
+         "Max. memory in MiB all query heaps of a thread may keep after a request. The largest "
+         "heaps are released until they fit. Default: unlimited.") //
+        ("snapping-cache-size",
+         value<int>(&config.snapping_cache_size)->default_value(-1),
+         "Number of snapped coordinates to keep for route, table, trip and isochrone requests. "
+         "Default: disabled.") //
+        ("route-cache-size",
+         value<int>(&config.route_cache_size)->default_value(-1),
+         "Number of route responses to keep for repeated requests. Default: disabled.");
 
     // hidden options, will be allowed on command line, but will not be shown to the user
     boost::program_options::options_description hidden_options("Hidden options");
@@ -270,7 +359,18 @@ try
     std::filesystem::path base_path;
 
     int requested_thread_num = 1;
+    int requested_io_thread_num = 1;
+    bool listener_per_thread = false;
+    bool pin_io_threads = false;
     short keepalive_timeout = 5;
+    bool metrics_endpoint = false;
+    bool server_timing = false;
+    double request_timeout = -1.0;
+    bool cancel_on_disconnect = false;
+    std::vector<std::string> batch_services;
+    std::size_t max_batch_size = 1000;
+    server::ComputePool::Limits interactive_limits;
+    server::ComputePool::Limits batch_limits;
     const unsigned init_result = generateServerProgramOptions(argc,
                                                               argv,
                                                               base_path,
@@ -279,7 +379,18 @@ try
                                                               trial_run,
                                                               config,
                                                               requested_thread_num,
-                                                              keepalive_timeout);
+                                                              requested_io_thread_num,
+                                                              listener_per_thread,
+                                                              pin_io_threads,
+                                                              keepalive_timeout,
+                                                              metrics_endpoint,
+                                                              server_timing,
+                                                              request_timeout,
+                                                              cancel_on_disconnect,
+                                                              batch_services,
+                                                              max_batch_size,
+                                                              interactive_limits,
+                                                              batch_limits);
     if (init_result == INIT_OK_DO_NOT_START_ENGINE)
     {
         return EXIT_SUCCESS;
@@ -317,9 +428,14 @@ try
     }
 
     util::Log() << "Threads: " << requested_thread_num;
+    util::Log() << "I/O threads: " << requested_io_thread_num;
     util::Log() << "IP address: " << ip_address;
     util::Log() << "IP port: " << ip_port;
     util::Log() << "Keepalive timeout: " << keepalive_timeout;
+    if (request_timeout > 0)
+    {
+        util::Log() << "Request timeout: " << request_timeout << "s";
+    }
 
 #ifndef _WIN32
     int sig = 0;
@@ -332,10 +448,24 @@ try
 #endif
 
     auto service_handler = std::make_unique<server::ServiceHandler>(config);
-    auto routing_server =
-        server::Server::CreateServer(ip_address, ip_port, requested_thread_num, keepalive_timeout);
+    auto routing_server = server::Server::CreateServer(ip_address,
+                                                       ip_port,
+                                                       requested_thread_num,
+                                                       requested_io_thread_num,
+                                                       keepalive_timeout,
+                                                       listener_per_thread,
+                                                       pin_io_threads);
 
     routing_server->RegisterServiceHandler(std::move(service_handler));
+    routing_server->EnableMetrics(metrics_endpoint, server_timing);
+    routing_server->EnableCancellation(
+        request_timeout > 0
+            ? std::make_optional(std::chrono::duration_cast<std::chrono::milliseconds>(
+                  std::chrono::duration<double>(request_timeout)))
+            : std::nullopt,
+        cancel_on_disconnect);
+    routing_server->EnableScheduling(batch_services, interactive_limits, batch_limits);
+    routing_server->SetMaxBatchSize(max_batch_size);
 
     if (trial_run)
     {
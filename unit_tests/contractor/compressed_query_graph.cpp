@@ -0,0 +1,143 @@
+#include "contractor/compressed_query_graph.hpp"
+#include "contractor/graph_contractor.hpp"
+#include "contractor/graph_contractor_adaptors.hpp"
+
+#include "helper.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <tbb/global_control.h>
+
+#include <cstdint>
+#include <ranges>
+#include <vector>
+
+using namespace osrm;
+using namespace osrm::contractor;
+using namespace osrm::unit_test;
+
+namespace
+{
+void checkSameGraph(const QueryGraph &graph, const CompressedQueryGraph &compressed)
+{
+    BOOST_REQUIRE_EQUAL(compressed.GetNumberOfNodes(), graph.GetNumberOfNodes());
+    BOOST_REQUIRE_EQUAL(compressed.GetNumberOfEdges(), graph.GetNumberOfEdges());
+    for (const auto node : util::irange(0u, graph.GetNumberOfNodes()))
+    {
+        BOOST_CHECK_EQUAL(compressed.BeginEdges(node), graph.BeginEdges(node));
+        BOOST_CHECK_EQUAL(compressed.EndEdges(node), graph.EndEdges(node));
+        for (const auto edge : graph.GetAdjacentEdgeRange(node))
+        {
+            const QueryEdge expected{node, graph.GetTarget(edge), graph.GetEdgeData(edge)};
+            const auto adjacent = compressed.GetAdjacentEdge(node, edge);
+            BOOST_CHECK_EQUAL(adjacent.edge, edge);
+            BOOST_CHECK(expected == (QueryEdge{node, adjacent.target, adjacent.data}));
+            BOOST_CHECK(
+                expected ==
+                (QueryEdge{node, compressed.GetTarget(edge), compressed.GetEdgeData(edge)}));
+        }
+    }
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(compressed_query_graph_test)
+
+BOOST_AUTO_TEST_CASE(compress_contracted_grid)
+{
+    tbb::global_control scheduler(tbb::global_control::max_allowed_parallelism, 1);
+
+    // 5x5 grid with varying weights
+    const unsigned width = 5;
+    const unsigned number_of_nodes = width * width;
+    std::vector<TestEdge> edges;
+    for (const auto node : util::irange(0u, number_of_nodes))
+    {
+        if (node % width + 1 < width)
+        {
+            edges.push_back(TestEdge{node, node + 1, static_cast<int>(1 + (node * 7) % 5)});
+        }
+        if (node + width < number_of_nodes)
+        {
+            edges.push_back(TestEdge{node, node + width, static_cast<int>(1 + (node * 3) % 4)});
+        }
+    }
+
+    auto contractor_graph = makeGraph(edges);
+    contractGraph(contractor_graph, std::vector<EdgeWeight>(number_of_nodes, EdgeWeight{1}));
+    QueryGraph graph{number_of_nodes, toEdges<QueryEdge>(std::move(contractor_graph))};
+
+    const auto compressed = compressQueryGraph(graph);
+    checkSameGraph(graph, compressed);
+}
+
+BOOST_AUTO_TEST_CASE(compress_values_that_do_not_fit)
+{
+    // a target further away than the packed difference allows and edge data that needs all bits
+    const NodeID far_node = 1u << 23;
+    const auto make_data = [](const NodeID turn_id,
+                              const std::int32_t weight,
+                              const std::int32_t duration,
+                              const float distance,
+                              const bool forward,
+                              const bool backward)
+    {
+        return QueryEdge::EdgeData{turn_id,
+                                   false,
+                                   EdgeWeight{weight},
+                                   EdgeDuration{duration},
+                                   EdgeDistance{distance},
+                                   forward,
+                                   backward};
+    };
+    std::vector<QueryEdge> edges = {
+        {0, 1, make_data(7, 10, 10, 1.5, true, false)},
+        {0, far_node, make_data((1u << 31) - 1, 1 << 20, (1 << 30) - 1, 1e30, true, true)},
+        {1, 0, make_data(3, 1, 1, 0, false, true)},
+        {far_node, 0, make_data(0, INVALID_EDGE_WEIGHT.__value, 5, 2.5, false, true)},
+        {far_node, far_node - 1, make_data(11, 20, 30, 40, true, false)}};
+    const QueryGraph graph{far_node + 1, edges};
+
+    const auto compressed = compressQueryGraph(graph);
+    checkSameGraph(graph, compressed);
+}
+
+BOOST_AUTO_TEST_CASE(iterate_filtered_edges)
+{
+    std::vector<QueryGraphView::NodeArrayEntry> nodes = {{0}, {3}, {3}, {4}, {4}};
+    std::vector<QueryGraphView::EdgeArrayEntry> edges = {
+        {1, QueryEdge::EdgeData{1, false, {1}, {1}, {1}, true, false}},
+        {2, QueryEdge::EdgeData{2, false, {2}, {2}, {2}, true, false}},
+        {3, QueryEdge::EdgeData{3, false, {3}, {3}, {3}, true, false}},
+        {0, QueryEdge::EdgeData{4, false, {4}, {4}, {4}, false, true}}};
+    const QueryGraphView graph{{nodes.data(), nodes.size()}, {edges.data(), edges.size()}};
+    // the second edge is excluded
+    std::uint64_t filter_bits = 0b1101;
+    const util::vector_view<bool> edge_filter{&filter_bits, edges.size()};
+
+    const auto make_range = [&](const NodeID node)
+    {
+        return AdjacentEdgeRange{
+            AdjacentEdgeIterator{&graph,
+                                 nullptr,
+                                 &edge_filter,
+                                 node,
+                                 graph.BeginEdges(node),
+                                 graph.EndEdges(node)},
+            AdjacentEdgeIterator{
+                &graph, nullptr, &edge_filter, node, graph.EndEdges(node), graph.EndEdges(node)}};
+    };
+
+    std::vector<NodeID> targets;
+    for (const auto &edge : make_range(0))
+    {
+        BOOST_CHECK_EQUAL(edge.data.turn_id, edge.target);
+        targets.push_back(edge.target);
+    }
+    const std::vector<NodeID> expected_targets = {1, 3};
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        targets.begin(), targets.end(), expected_targets.begin(), expected_targets.end());
+    BOOST_CHECK(make_range(1).empty());
+    BOOST_CHECK_EQUAL(std::ranges::distance(make_range(2)), 1);
+    BOOST_CHECK_EQUAL(make_range(2).begin()->target, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -5,6 +5,8 @@
 #include "../common/temporary_file.hpp"
 #include "helper.hpp"
 
+#include "util/integer_range.hpp"
+
 #include <boost/test/unit_test.hpp>
 
 BOOST_AUTO_TEST_SUITE(tar)
@@ -53,6 +55,60 @@ BOOST_AUTO_TEST_CASE(read_write_hsgr)
                             reference_metrics["duration"].edge_filter[2]);
     CHECK_EQUAL_COLLECTIONS(metrics["duration"].edge_filter[3],
                             reference_metrics["duration"].edge_filter[3]);
+    BOOST_CHECK(metrics["duration"].phast_sweeps.empty());
+}
+
+BOOST_AUTO_TEST_CASE(read_write_hsgr_phast)
+{
+    std::vector<TestEdge> edges = {TestEdge{0, 1, 3}, TestEdge{1, 2, 1}};
+    auto reference_graph = QueryGraph{3, toEdges<QueryEdge>(makeGraph(edges))};
+    std::vector<std::vector<bool>> reference_filters = {{true, true, true, true},
+                                                        {true, false, true, false}};
+
+    // one sweep per exclude class
+    PhastSweep reference_sweep;
+    reference_sweep.nodes = {2, 1, 0};
+    reference_sweep.positions = {2, 1, 0};
+    reference_sweep.first_arc = {0, 0, 1, 2};
+    reference_sweep.arcs = {{0, {1}, {2}, {1.0}}, {1, {3}, {6}, {1.5}}};
+    PhastSweep reference_excluded_sweep;
+    reference_excluded_sweep.nodes = {0, 2, 1};
+    reference_excluded_sweep.positions = {0, 2, 1};
+    reference_excluded_sweep.first_arc = {0, 0, 0, 1};
+    reference_excluded_sweep.arcs = {{1, {4}, {8}, {2.5}}};
+
+    std::unordered_map<std::string, ContractedMetric> reference_metrics = {
+        {"duration",
+         {std::move(reference_graph),
+          std::move(reference_filters),
+          {reference_sweep, reference_excluded_sweep}}}};
+
+    TemporaryFile tmp{TEST_DATA_DIR "/read_write_hsgr_phast_test.osrm.hsgr"};
+    contractor::files::writeGraph(tmp.path, reference_metrics, 0);
+
+    unsigned connectivity_checksum;
+    std::unordered_map<std::string, ContractedMetric> metrics = {{"duration", {}}};
+    contractor::files::readGraph(tmp.path, metrics, connectivity_checksum);
+
+    const auto &reference_sweeps = reference_metrics["duration"].phast_sweeps;
+    const auto &sweeps = metrics["duration"].phast_sweeps;
+    BOOST_REQUIRE_EQUAL(sweeps.size(), reference_sweeps.size());
+    for (const auto index : util::irange<std::size_t>(0, sweeps.size()))
+    {
+        const auto &sweep = sweeps[index];
+        const auto &reference = reference_sweeps[index];
+        CHECK_EQUAL_COLLECTIONS(sweep.nodes, reference.nodes);
+        CHECK_EQUAL_COLLECTIONS(sweep.positions, reference.positions);
+        CHECK_EQUAL_COLLECTIONS(sweep.first_arc, reference.first_arc);
+        BOOST_REQUIRE_EQUAL(sweep.arcs.size(), reference.arcs.size());
+        for (const auto arc : util::irange<std::size_t>(0, sweep.arcs.size()))
+        {
+            BOOST_CHECK_EQUAL(sweep.arcs[arc].tail, reference.arcs[arc].tail);
+            BOOST_CHECK_EQUAL(sweep.arcs[arc].weight, reference.arcs[arc].weight);
+            BOOST_CHECK_EQUAL(sweep.arcs[arc].duration, reference.arcs[arc].duration);
+            BOOST_CHECK_EQUAL(sweep.arcs[arc].distance, reference.arcs[arc].distance);
+        }
+    }
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,174 @@
+#include "contractor/phast_sweep.hpp"
+#include "contractor/graph_contractor.hpp"
+#include "contractor/graph_contractor_adaptors.hpp"
+
+#include "helper.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <tbb/global_control.h>
+
+#include <limits>
+
+using namespace osrm;
+using namespace osrm::contractor;
+using namespace osrm::unit_test;
+
+BOOST_AUTO_TEST_SUITE(phast_sweep)
+
+namespace
+{
+constexpr int INF = std::numeric_limits<int>::max();
+
+// Reference distances by Bellman-Ford on the uncontracted edges
+std::vector<int> referenceDistances(const std::vector<TestEdge> &edges,
+                                    const unsigned number_of_nodes,
+                                    const unsigned source)
+{
+    std::vector<int> distances(number_of_nodes, INF);
+    distances[source] = 0;
+    for (unsigned round = 0; round < number_of_nodes; ++round)
+    {
+        for (const auto &[start, target, weight] : edges)
+        {
+            if (distances[start] != INF)
+            {
+                distances[target] = std::min(distances[target], distances[start] + weight);
+            }
+        }
+    }
+    return distances;
+}
+
+// Upward search in reverse sweep order followed by the downward sweep
+std::vector<int> phastDistances(const QueryGraph &graph, const PhastSweep &sweep, unsigned source)
+{
+    const auto number_of_nodes = graph.GetNumberOfNodes();
+    std::vector<int> labels(number_of_nodes, INF);
+    labels[sweep.positions[source]] = 0;
+    for (auto position = number_of_nodes; position-- > 0;)
+    {
+        const auto node = sweep.nodes[position];
+        if (labels[position] == INF)
+        {
+            continue;
+        }
+        for (const auto edge : graph.GetAdjacentEdgeRange(node))
+        {
+            const auto &data = graph.GetEdgeData(edge);
+            if (data.forward)
+            {
+                auto &label = labels[sweep.positions[graph.GetTarget(edge)]];
+                label = std::min(label, labels[position] + from_alias<int>(data.weight));
+            }
+        }
+    }
+
+    for (const auto position : util::irange(0u, number_of_nodes))
+    {
+        for (auto arc = sweep.first_arc[position]; arc < sweep.first_arc[position + 1]; ++arc)
+        {
+            const auto tail = sweep.arcs[arc].tail;
+            const auto weight = from_alias<int>(sweep.arcs[arc].weight);
+            if (labels[tail] != INF)
+            {
+                labels[position] = std::min(labels[position], labels[tail] + weight);
+            }
+        }
+    }
+
+    std::vector<int> distances(number_of_nodes);
+    for (const auto node : util::irange(0u, number_of_nodes))
+    {
+        distances[node] = labels[sweep.positions[node]];
+    }
+    return distances;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(sweep_order)
+{
+    tbb::global_control scheduler(tbb::global_control::max_allowed_parallelism, 1);
+
+    std::vector<TestEdge> edges = {TestEdge{0, 1, 3},
+                                   TestEdge{0, 5, 1},
+                                   TestEdge{1, 3, 3},
+                                   TestEdge{1, 4, 1},
+                                   TestEdge{3, 1, 1},
+                                   TestEdge{4, 3, 1},
+                                   TestEdge{5, 1, 1}};
+    auto contractor_graph = makeGraph(edges);
+    contractGraph(contractor_graph, {{1}, {1}, {1}, {1}, {1}, {1}});
+    QueryGraph graph{6, toEdges<QueryEdge>(std::move(contractor_graph))};
+
+    const auto sweep = buildPhastSweep(graph, std::vector<bool>(graph.GetNumberOfEdges(), true));
+
+    BOOST_REQUIRE_EQUAL(sweep.nodes.size(), 6);
+    BOOST_REQUIRE_EQUAL(sweep.first_arc.size(), 7);
+    BOOST_CHECK_EQUAL(sweep.first_arc.back(), sweep.arcs.size());
+
+    std::size_t number_of_downward_edges = 0;
+    for (const auto position : util::irange<std::uint32_t>(0, 6))
+    {
+        const auto node = sweep.nodes[position];
+        BOOST_CHECK_EQUAL(sweep.positions[node], position);
+
+        for (const auto edge : graph.GetAdjacentEdgeRange(node))
+        {
+            // upward edges point to nodes that are swept earlier
+            BOOST_CHECK_LT(sweep.positions[graph.GetTarget(edge)], position);
+            number_of_downward_edges += graph.GetEdgeData(edge).backward;
+        }
+        for (auto arc = sweep.first_arc[position]; arc < sweep.first_arc[position + 1]; ++arc)
+        {
+            BOOST_CHECK_LT(sweep.arcs[arc].tail, position);
+        }
+    }
+    BOOST_CHECK_EQUAL(sweep.arcs.size(), number_of_downward_edges);
+}
+
+BOOST_AUTO_TEST_CASE(sweep_distances)
+{
+    tbb::global_control scheduler(tbb::global_control::max_allowed_parallelism, 1);
+
+    // 5x5 grid with varying weights in both directions
+    const unsigned width = 5;
+    const unsigned number_of_nodes = width * width;
+    std::vector<TestEdge> edges;
+    for (const auto y : util::irange(0u, width))
+    {
+        for (const auto x : util::irange(0u, width))
+        {
+            const auto node = y * width + x;
+            if (x + 1 < width)
+            {
+                edges.push_back(TestEdge{node, node + 1, static_cast<int>(1 + (node * 7) % 5)});
+            }
+            if (y + 1 < width)
+            {
+                edges.push_back(
+                    TestEdge{node, node + width, static_cast<int>(1 + (node * 3) % 4)});
+            }
+        }
+    }
+    std::vector<TestEdge> both_directions = edges;
+    for (const auto &[start, target, weight] : edges)
+    {
+        both_directions.push_back(TestEdge{target, start, weight});
+    }
+
+    auto contractor_graph = makeGraph(both_directions);
+    contractGraph(contractor_graph, std::vector<EdgeWeight>(number_of_nodes, EdgeWeight{1}));
+    QueryGraph graph{number_of_nodes, toEdges<QueryEdge>(std::move(contractor_graph))};
+
+    const auto sweep = buildPhastSweep(graph, std::vector<bool>(graph.GetNumberOfEdges(), true));
+
+    for (const auto source : util::irange(0u, number_of_nodes))
+    {
+        const auto reference = referenceDistances(both_directions, number_of_nodes, source);
+        const auto distances = phastDistances(graph, sweep, source);
+        BOOST_CHECK_EQUAL_COLLECTIONS(
+            distances.begin(), distances.end(), reference.begin(), reference.end());
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
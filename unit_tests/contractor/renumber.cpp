@@ -0,0 +1,87 @@
+#include "contractor/renumber.hpp"
+#include "contractor/graph_contractor.hpp"
+#include "contractor/graph_contractor_adaptors.hpp"
+
+#include "helper.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <tbb/global_control.h>
+
+#include <algorithm>
+
+using namespace osrm;
+using namespace osrm::contractor;
+using namespace osrm::unit_test;
+
+BOOST_AUTO_TEST_SUITE(renumber_test)
+
+BOOST_AUTO_TEST_CASE(renumber_by_level)
+{
+    tbb::global_control scheduler(tbb::global_control::max_allowed_parallelism, 1);
+
+    // 5x5 grid with varying weights
+    const unsigned width = 5;
+    const unsigned number_of_nodes = width * width;
+    std::vector<TestEdge> edges;
+    for (const auto node : util::irange(0u, number_of_nodes))
+    {
+        if (node % width + 1 < width)
+        {
+            edges.push_back(TestEdge{node, node + 1, static_cast<int>(1 + (node * 7) % 5)});
+            edges.push_back(TestEdge{node + 1, node, static_cast<int>(1 + (node * 7) % 5)});
+        }
+        if (node + width < number_of_nodes)
+        {
+            edges.push_back(TestEdge{node, node + width, static_cast<int>(1 + (node * 3) % 4)});
+            edges.push_back(TestEdge{node + width, node, static_cast<int>(1 + (node * 3) % 4)});
+        }
+    }
+
+    auto contractor_graph = makeGraph(edges);
+    contractGraph(contractor_graph, std::vector<EdgeWeight>(number_of_nodes, EdgeWeight{1}));
+    QueryGraph graph{number_of_nodes, toEdges<QueryEdge>(std::move(contractor_graph))};
+
+    // marks the edges with an odd weight, to follow them through the renumbering
+    std::vector<std::vector<bool>> edge_filters(1);
+    std::size_t number_of_shortcuts = 0;
+    for (const auto edge : util::irange(0u, graph.GetNumberOfEdges()))
+    {
+        edge_filters[0].push_back(from_alias<int>(graph.GetEdgeData(edge).weight) % 2 == 1);
+        number_of_shortcuts += graph.GetEdgeData(edge).shortcut;
+    }
+    BOOST_REQUIRE_GT(number_of_shortcuts, 0);
+
+    const auto permutation = makePermutation(graph);
+    BOOST_REQUIRE_EQUAL(permutation.size(), number_of_nodes);
+    auto sorted_permutation = permutation;
+    std::sort(sorted_permutation.begin(), sorted_permutation.end());
+    for (const auto node : util::irange(0u, number_of_nodes))
+    {
+        BOOST_CHECK_EQUAL(sorted_permutation[node], node);
+    }
+
+    const auto number_of_edges = graph.GetNumberOfEdges();
+    renumber(graph, edge_filters, permutation);
+    BOOST_CHECK_EQUAL(graph.GetNumberOfEdges(), number_of_edges);
+
+    for (const auto node : util::irange(0u, number_of_nodes))
+    {
+        for (const auto edge : graph.GetAdjacentEdgeRange(node))
+        {
+            const auto target = graph.GetTarget(edge);
+            const auto &data = graph.GetEdgeData(edge);
+            // higher levels come first
+            BOOST_CHECK_LT(target, node);
+            BOOST_CHECK_EQUAL(edge_filters[0][edge], from_alias<int>(data.weight) % 2 == 1);
+            if (data.shortcut)
+            {
+                // both halves of a shortcut are edges at the middle node
+                BOOST_CHECK(graph.FindEdgeInEitherDirection(node, data.turn_id) != SPECIAL_EDGEID);
+                BOOST_CHECK(graph.FindEdgeInEitherDirection(target, data.turn_id) !=
+                            SPECIAL_EDGEID);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,91 @@
+#include "customizer/compressed_multi_level_graph.hpp"
+#include "customizer/edge_based_graph.hpp"
+#include "partitioner/edge_based_graph.hpp"
+#include "partitioner/multi_level_graph.hpp"
+#include "partitioner/multi_level_partition.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+using namespace osrm;
+using namespace osrm::customizer;
+
+BOOST_AUTO_TEST_SUITE(compressed_multi_level_graph_tests)
+
+BOOST_AUTO_TEST_CASE(compress_two_level_graph)
+{
+    // 0 --- 1 --- 4
+    // |     |
+    // 2 --- 3 --- 5
+    // node:                0  1  2  3  4  5
+    std::vector<CellID> l1{{0, 0, 1, 1, 2, 2}};
+    std::vector<CellID> l2{{0, 0, 0, 0, 1, 1}};
+    partitioner::MultiLevelPartition mlp{{l1, l2}, {3, 2}};
+
+    using Edge =
+        util::static_graph_details::SortableEdgeWithData<partitioner::EdgeBasedGraphEdgeData>;
+    std::vector<Edge> edges;
+    NodeID turn_id = 0;
+    for (const auto &[from, to] : std::vector<std::pair<NodeID, NodeID>>{
+             {0, 1}, {0, 2}, {2, 3}, {3, 1}, {1, 4}, {3, 5}})
+    {
+        edges.push_back(Edge{
+            from, to, turn_id, EdgeWeight{1}, EdgeDistance{1}, EdgeDuration{1}, true, false});
+        edges.push_back(Edge{
+            to, from, turn_id++, EdgeWeight{1}, EdgeDistance{1}, EdgeDuration{1}, false, true});
+    }
+    // the largest turn id needs an exception
+    edges.back().data.turn_id = std::numeric_limits<std::int32_t>::max();
+    std::sort(edges.begin(), edges.end());
+
+    std::vector<EdgeWeight> node_weights = {{1}, {2}, {1 << 20}, {3}, INVALID_EDGE_WEIGHT, {4}};
+    std::vector<EdgeDuration> node_durations = {{1}, {2}, {3}, {1 << 25}, {4}, {5}};
+    std::vector<EdgeDistance> node_distances = {{1}, {2.5}, {3}, {4}, {1e20}, {0}};
+    const MultiLevelEdgeBasedGraph graph{
+        partitioner::MultiLevelGraph<partitioner::EdgeBasedGraphEdgeData,
+                                     storage::Ownership::Container>{mlp, 6, edges},
+        node_weights,
+        node_durations,
+        node_distances};
+
+    BOOST_REQUIRE_EQUAL(graph.GetNumberOfNodes(), 6);
+    BOOST_REQUIRE_EQUAL(graph.GetNumberOfEdges(), 12);
+
+    const auto compressed = compressMultiLevelGraph(graph);
+
+    BOOST_REQUIRE_EQUAL(compressed.GetNumberOfNodes(), graph.GetNumberOfNodes());
+    BOOST_REQUIRE_EQUAL(compressed.GetNumberOfEdges(), graph.GetNumberOfEdges());
+    BOOST_CHECK_EQUAL(compressed.GetNumberOfLevels(), graph.GetNumberOfLevels());
+    BOOST_CHECK_EQUAL(compressed.GetMaxBorderNodeID(), graph.GetMaxBorderNodeID());
+    for (const auto node : util::irange(0u, graph.GetNumberOfNodes()))
+    {
+        BOOST_CHECK_EQUAL(compressed.GetNodeWeight(node), graph.GetNodeWeight(node));
+        BOOST_CHECK_EQUAL(compressed.GetNodeDuration(node), graph.GetNodeDuration(node));
+        BOOST_CHECK_EQUAL(compressed.GetNodeDistance(node), graph.GetNodeDistance(node));
+        for (const auto level : util::irange<LevelID>(0, graph.GetNumberOfLevels()))
+        {
+            BOOST_CHECK_EQUAL(compressed.BeginBorderEdges(level, node),
+                              graph.BeginBorderEdges(level, node));
+        }
+        for (const auto edge : graph.GetAdjacentEdgeRange(node))
+        {
+            const auto adjacent = compressed.GetAdjacentEdge(node, edge);
+            BOOST_CHECK_EQUAL(adjacent.edge, edge);
+            BOOST_CHECK_EQUAL(adjacent.target, graph.GetTarget(edge));
+            BOOST_CHECK_EQUAL(adjacent.data.turn_id, graph.GetEdgeData(edge).turn_id);
+            BOOST_CHECK_EQUAL(adjacent.forward, graph.IsForwardEdge(edge));
+            BOOST_CHECK_EQUAL(adjacent.backward, graph.IsBackwardEdge(edge));
+            BOOST_CHECK_EQUAL(compressed.GetTarget(edge), graph.GetTarget(edge));
+            BOOST_CHECK_EQUAL(compressed.IsForwardEdge(edge), graph.IsForwardEdge(edge));
+            BOOST_CHECK_EQUAL(compressed.IsBackwardEdge(edge), graph.IsBackwardEdge(edge));
+            BOOST_CHECK_EQUAL(compressed.FindEdge(node, graph.GetTarget(edge)),
+                              graph.FindEdge(node, graph.GetTarget(edge)));
+        }
+    }
+    BOOST_CHECK_EQUAL(compressed.FindEdge(0, 5), SPECIAL_EDGEID);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,96 @@
+#include "engine/cancellation.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+BOOST_AUTO_TEST_SUITE(cancellation_test)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+namespace
+{
+// Number of CheckCancellation() calls until the first one that throws
+std::uint32_t countChecksUntilCancelled()
+{
+    for (std::uint32_t checks = 1; checks <= 4 * detail::CANCELLATION_CHECK_INTERVAL; ++checks)
+    {
+        try
+        {
+            CheckCancellation();
+        }
+        catch (const RequestCancelledException &)
+        {
+            return checks;
+        }
+    }
+    return 0;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(token_reasons)
+{
+    const CancellationToken unlimited(std::nullopt);
+    BOOST_CHECK(unlimited.Check() == CancellationReason::None);
+    BOOST_CHECK_NO_THROW(unlimited.ThrowIfCancelled());
+
+    const CancellationToken expired(CancellationToken::Clock::now());
+    BOOST_CHECK(expired.Check() == CancellationReason::Timeout);
+
+    std::atomic<bool> disconnected = false;
+    CancellationToken abandoned(std::nullopt, [&] { return disconnected.load(); });
+    BOOST_CHECK(abandoned.Check() == CancellationReason::None);
+    disconnected = true;
+    BOOST_CHECK(abandoned.Check() == CancellationReason::Cancelled);
+    // the reason sticks even if the probe changes its mind
+    disconnected = false;
+    BOOST_CHECK(abandoned.Check() == CancellationReason::Cancelled);
+
+    CancellationToken cancelled(CancellationToken::Clock::now() + std::chrono::hours(1));
+    cancelled.Cancel();
+    try
+    {
+        cancelled.ThrowIfCancelled();
+        BOOST_FAIL("expected RequestCancelledException");
+    }
+    catch (const RequestCancelledException &e)
+    {
+        BOOST_CHECK(e.Reason() == CancellationReason::Cancelled);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(scoped_checks)
+{
+    // without a token the checks never throw
+    BOOST_CHECK(CurrentCancellationToken() == nullptr);
+    BOOST_CHECK_EQUAL(countChecksUntilCancelled(), 0);
+
+    CancellationToken token(std::nullopt);
+    {
+        const ScopedCancellation scope(&token);
+        BOOST_CHECK(CurrentCancellationToken() == &token);
+        BOOST_CHECK_EQUAL(countChecksUntilCancelled(), 0);
+
+        token.Cancel();
+        {
+            // a nullptr keeps the token of the enclosing scope
+            const ScopedCancellation empty(nullptr);
+            BOOST_CHECK(CurrentCancellationToken() == &token);
+            // the token is only looked at every few hundred checks
+            BOOST_CHECK_EQUAL(countChecksUntilCancelled(), detail::CANCELLATION_CHECK_INTERVAL);
+        }
+
+        const CancellationToken inner(std::nullopt);
+        {
+            const ScopedCancellation nested(&inner);
+            BOOST_CHECK(CurrentCancellationToken() == &inner);
+            BOOST_CHECK_EQUAL(countChecksUntilCancelled(), 0);
+        }
+        BOOST_CHECK(CurrentCancellationToken() == &token);
+    }
+    BOOST_CHECK(CurrentCancellationToken() == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
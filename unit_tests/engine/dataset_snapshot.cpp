@@ -0,0 +1,50 @@
+#include "engine/dataset_snapshot.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+
+BOOST_AUTO_TEST_SUITE(dataset_snapshot_test)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+BOOST_AUTO_TEST_CASE(pin_first_data)
+{
+    int loads = 0;
+    const auto load = [&loads] { return std::make_shared<const int>(++loads); };
+    const int provider = 0;
+    const int other_provider = 0;
+
+    DatasetSnapshot snapshot;
+    const auto first = snapshot.Pin<int>(&provider, load);
+    const auto second = snapshot.Pin<int>(&provider, load);
+    BOOST_CHECK_EQUAL(*first, 1);
+    BOOST_CHECK(first == second);
+
+    // only the data of the first provider is pinned
+    BOOST_CHECK_EQUAL(*snapshot.Pin<int>(&other_provider, load), 2);
+    BOOST_CHECK_EQUAL(*snapshot.Pin<int>(&other_provider, load), 3);
+    BOOST_CHECK_EQUAL(*snapshot.Pin<int>(&provider, load), 1);
+}
+
+BOOST_AUTO_TEST_CASE(scoped_snapshot)
+{
+    BOOST_CHECK(CurrentDatasetSnapshot() == nullptr);
+
+    DatasetSnapshot snapshot;
+    {
+        const ScopedDatasetSnapshot scope(&snapshot);
+        BOOST_CHECK(CurrentDatasetSnapshot() == &snapshot);
+
+        DatasetSnapshot inner;
+        {
+            const ScopedDatasetSnapshot nested(&inner);
+            BOOST_CHECK(CurrentDatasetSnapshot() == &inner);
+        }
+        BOOST_CHECK(CurrentDatasetSnapshot() == &snapshot);
+    }
+    BOOST_CHECK(CurrentDatasetSnapshot() == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
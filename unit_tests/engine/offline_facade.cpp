@@ -129,6 +129,11 @@ class ContiguousInternalMemoryDataFacade<routing_algorithms::offline::Algorithm>
         return util::irange<EdgeID>(0, 0);
     }
 
+    auto GetBorderEdges(const LevelID /*level*/, const NodeID /*node*/) const
+    {
+        return customizer::AdjacentEdgeRange{};
+    }
+
     EdgeID FindEdge(const NodeID /*from*/, const NodeID /*to*/) const { return SPECIAL_EDGEID; }
 
     unsigned GetCheckSum() const override { return 0; }
@@ -244,6 +249,21 @@ class ContiguousInternalMemoryDataFacade<routing_algorithms::offline::Algorithm>
         return {};
     };
 
+    std::vector<std::vector<engine::PhantomNodeWithDistance>>
+    NearestPhantomNodes(const std::vector<engine::NearestQuery> &queries,
+                        const size_t /*max_results*/) const override
+    {
+        return std::vector<std::vector<engine::PhantomNodeWithDistance>>(queries.size());
+    };
+
+    std::vector<engine::PhantomCandidateAlternatives>
+    NearestCandidatesWithAlternativeFromBigComponent(
+        const std::vector<engine::NearestQuery> &queries,
+        const bool /*use_all_edges*/) const override
+    {
+        return std::vector<engine::PhantomCandidateAlternatives>(queries.size());
+    };
+
     util::guidance::LaneTupleIdPair GetLaneData(const EdgeID /*id*/) const override
     {
         return util::guidance::LaneTupleIdPair{};
@@ -0,0 +1,89 @@
+#include "engine/route_cache.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(route_cache_test)
+
+using namespace osrm;
+using namespace osrm::util;
+using namespace osrm::engine;
+
+namespace
+{
+api::RouteParameters makeParameters()
+{
+    api::RouteParameters parameters;
+    parameters.coordinates = {Coordinate{FloatLongitude{7.419}, FloatLatitude{43.731}},
+                              Coordinate{FloatLongitude{7.421}, FloatLatitude{43.736}}};
+    return parameters;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(key_covers_all_parameters)
+{
+    const auto key = RouteCache::MakeKey(makeParameters());
+    BOOST_CHECK_EQUAL(key, RouteCache::MakeKey(makeParameters()));
+
+    std::vector<api::RouteParameters> variants(9, makeParameters());
+    variants[0].coordinates.back() = Coordinate{FloatLongitude{7.421}, FloatLatitude{43.737}};
+    variants[1].radiuses = {10., std::nullopt};
+    variants[2].bearings = {std::nullopt, Bearing{90, 10}};
+    variants[3].approaches = {Approach::CURB, std::nullopt};
+    variants[4].exclude = {"toll"};
+    variants[5].steps = true;
+    variants[6].overview = api::RouteParameters::OverviewType::Full;
+    variants[7].continue_straight = false;
+    variants[8].waypoints = {0, 1};
+
+    for (const auto &variant : variants)
+    {
+        BOOST_CHECK(RouteCache::MakeKey(variant) != key);
+    }
+
+    // presence flags keep the values of different parameters apart
+    auto radius = makeParameters();
+    radius.radiuses = {std::nullopt};
+    auto bearing = makeParameters();
+    bearing.bearings = {std::nullopt};
+    BOOST_CHECK(RouteCache::MakeKey(radius) != RouteCache::MakeKey(bearing));
+}
+
+BOOST_AUTO_TEST_CASE(count_admissions_and_evictions)
+{
+    const auto facade = std::make_shared<const int>(0);
+    // room for one response per shard
+    RouteCache cache(1);
+
+    const auto hits = RouteCacheStatistics::hits.load();
+    const auto misses = RouteCacheStatistics::misses.load();
+    const auto admissions = RouteCacheStatistics::admissions.load();
+    const auto evictions = RouteCacheStatistics::evictions.load();
+
+    const std::vector<char> response{'{', '}'};
+    const auto key = RouteCache::MakeKey(makeParameters());
+    BOOST_CHECK(!cache.Find(facade, key));
+    cache.Insert(facade, key, response);
+    const auto found = cache.Find(facade, key);
+    BOOST_REQUIRE(found);
+    BOOST_CHECK(*found == response);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        cache.Insert(facade, key + std::to_string(i), response);
+    }
+    BOOST_CHECK(!cache.Find(facade, key));
+
+    BOOST_CHECK_EQUAL(RouteCacheStatistics::hits.load() - hits, 1);
+    BOOST_CHECK_EQUAL(RouteCacheStatistics::misses.load() - misses, 2);
+    BOOST_CHECK_EQUAL(RouteCacheStatistics::admissions.load() - admissions, 101);
+    // at most one response per shard is left
+    BOOST_CHECK_LE((RouteCacheStatistics::admissions.load() - admissions) -
+                       (RouteCacheStatistics::evictions.load() - evictions),
+                   16);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,61 @@
+#include "engine/search_engine_data.hpp"
+#include "util/integer_range.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <limits>
+
+BOOST_AUTO_TEST_SUITE(search_engine_data_test)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+BOOST_AUTO_TEST_CASE(trim_heaps_above_limit)
+{
+    using CH = routing_algorithms::ch::Algorithm;
+    SearchEngineData<CH> heaps;
+    // heaps left over by earlier tests on this thread are released
+    heaps.TrimThreadLocalStorage(0);
+    heaps.InitializeOrClearFirstThreadLocalStorage(100000);
+    heaps.InitializeOrClearSecondThreadLocalStorage(100000);
+
+    auto &largest = *SearchEngineData<CH>::forward_heap_1;
+    auto &large = *SearchEngineData<CH>::reverse_heap_1;
+    auto &small = *SearchEngineData<CH>::forward_heap_2;
+    for (const NodeID node : util::irange<NodeID>(0, 20000))
+    {
+        largest.Insert(node, EdgeWeight{1}, node);
+    }
+    for (const NodeID node : util::irange<NodeID>(0, 15000))
+    {
+        large.Insert(node, EdgeWeight{1}, node);
+    }
+    small.Insert(0, EdgeWeight{0}, 0);
+
+    const auto largest_usage = largest.MemoryUsage();
+    const auto large_usage = large.MemoryUsage();
+    const auto small_usage = small.MemoryUsage();
+    BOOST_REQUIRE_LT(large_usage, largest_usage);
+    const auto usage = heaps.TrimThreadLocalStorage(std::numeric_limits<std::size_t>::max());
+    BOOST_REQUIRE_GE(usage, largest_usage + large_usage + small_usage);
+    BOOST_CHECK_GE(HeapMemoryStatistics::high_water_mark.load(), usage);
+
+    // every heap is below the limit, but together they are above it
+    const auto limit = usage - largest_usage / 2;
+    BOOST_REQUIRE_LT(largest_usage, limit);
+    const auto trimmed_heaps = HeapMemoryStatistics::trimmed_heaps.load();
+
+    const auto trimmed_usage = heaps.TrimThreadLocalStorage(limit);
+
+    // only the largest heap is released, the others keep their nodes
+    BOOST_CHECK_LE(trimmed_usage, limit);
+    BOOST_CHECK(largest.Empty());
+    BOOST_CHECK_LT(largest.MemoryUsage(), largest_usage / 10);
+    BOOST_CHECK_EQUAL(large.Size(), 15000);
+    BOOST_CHECK_EQUAL(large.MemoryUsage(), large_usage);
+    BOOST_CHECK_EQUAL(small.Size(), 1);
+    BOOST_CHECK_EQUAL(small.MemoryUsage(), small_usage);
+    BOOST_CHECK_EQUAL(HeapMemoryStatistics::trimmed_heaps.load() - trimmed_heaps, 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,119 @@
+#include "engine/snapping_cache.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+
+BOOST_AUTO_TEST_SUITE(snapping_cache_test)
+
+using namespace osrm;
+using namespace osrm::util;
+using namespace osrm::engine;
+
+namespace
+{
+NearestQuery makeQuery(const double lon, const double lat)
+{
+    return NearestQuery{Coordinate{FloatLongitude{lon}, FloatLatitude{lat}},
+                        std::nullopt,
+                        std::nullopt,
+                        Approach::UNRESTRICTED};
+}
+
+PhantomCandidateAlternatives makeCandidates(const double lon, const double lat)
+{
+    PhantomNode phantom;
+    phantom.location = Coordinate{FloatLongitude{lon}, FloatLatitude{lat}};
+    return {{phantom}, {}};
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(find_snapping_parameters)
+{
+    const auto facade = std::make_shared<const int>(0);
+    SnappingCache cache(64);
+
+    const auto query = makeQuery(7.419, 43.731);
+    BOOST_CHECK(!cache.Find(facade, query, false));
+    cache.Insert(facade, query, false, makeCandidates(7.4191, 43.7311));
+
+    const auto found = cache.Find(facade, query, false);
+    BOOST_REQUIRE(found);
+    BOOST_CHECK_EQUAL(found->first.size(), 1);
+    BOOST_CHECK(found->first.front().location ==
+                Coordinate(FloatLongitude{7.4191}, FloatLatitude{43.7311}));
+
+    // every snapping parameter is part of the key
+    BOOST_CHECK(!cache.Find(facade, query, true));
+    auto with_radius = query;
+    with_radius.max_distance = 10.;
+    BOOST_CHECK(!cache.Find(facade, with_radius, false));
+    auto with_bearing = query;
+    with_bearing.bearing = Bearing{90, 10};
+    BOOST_CHECK(!cache.Find(facade, with_bearing, false));
+    auto with_approach = query;
+    with_approach.approach = Approach::CURB;
+    BOOST_CHECK(!cache.Find(facade, with_approach, false));
+    BOOST_CHECK(!cache.Find(facade, makeQuery(7.419001, 43.731), false));
+}
+
+BOOST_AUTO_TEST_CASE(evict_least_recently_used)
+{
+    const auto facade = std::make_shared<const int>(0);
+    // the smallest cache has room for one entry per shard
+    SnappingCache cache(1);
+
+    const auto first = makeQuery(7.419, 43.731);
+    cache.Insert(facade, first, false, makeCandidates(7.419, 43.731));
+    cache.Insert(facade, first, true, makeCandidates(7.419, 43.731));
+    BOOST_CHECK(cache.Find(facade, first, true));
+
+    // fill every shard with another entry, which evicts the first ones
+    for (int i = 0; i < 1000; ++i)
+    {
+        const auto query = makeQuery(7.4 + i * 0.0001, 43.7);
+        cache.Insert(facade, query, false, makeCandidates(7.4, 43.7));
+        BOOST_CHECK(cache.Find(facade, query, false));
+    }
+    BOOST_CHECK(!cache.Find(facade, first, false));
+    BOOST_CHECK(!cache.Find(facade, first, true));
+}
+
+BOOST_AUTO_TEST_CASE(invalidate_on_facade_swap)
+{
+    auto facade = std::make_shared<const int>(0);
+    const auto other_facade = std::make_shared<const int>(1);
+    SnappingCache cache(64);
+
+    const auto query = makeQuery(7.419, 43.731);
+    cache.Insert(facade, query, false, makeCandidates(7.419, 43.731));
+    BOOST_CHECK(cache.Find(facade, query, false));
+    // e.g. a facade with exclude flags
+    BOOST_CHECK(!cache.Find(other_facade, query, false));
+
+    // a new dataset can get the address of the old one
+    const auto *old_address = facade.get();
+    facade.reset();
+    const std::shared_ptr<const void> aliased_facade(other_facade, old_address);
+    BOOST_CHECK(!cache.Find(aliased_facade, query, false));
+}
+
+BOOST_AUTO_TEST_CASE(count_hits_and_misses)
+{
+    const auto facade = std::make_shared<const int>(0);
+    SnappingCache cache(64);
+
+    const auto hits = SnappingCacheStatistics::hits.load();
+    const auto misses = SnappingCacheStatistics::misses.load();
+
+    const auto query = makeQuery(7.419, 43.731);
+    BOOST_CHECK(!cache.Find(facade, query, false));
+    cache.Insert(facade, query, false, makeCandidates(7.419, 43.731));
+    BOOST_CHECK(cache.Find(facade, query, false));
+    BOOST_CHECK(cache.Find(facade, query, false));
+
+    BOOST_CHECK_EQUAL(SnappingCacheStatistics::hits.load() - hits, 2);
+    BOOST_CHECK_EQUAL(SnappingCacheStatistics::misses.load() - misses, 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
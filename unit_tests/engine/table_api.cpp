@@ -0,0 +1,101 @@
+#include "engine/api/table_api.hpp"
+#include "engine/api/flatbuffers/fbresult_generated.h"
+#include "util/json_renderer.hpp"
+
+#include "mocks/mock_datafacade.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(table_api)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+namespace
+{
+// 2x3 table with an unreachable cell in each matrix
+const std::pair<std::vector<EdgeDuration>, std::vector<EdgeDistance>> tables = {
+    {EdgeDuration{0},
+     EdgeDuration{15},
+     MAXIMAL_EDGE_DURATION,
+     EdgeDuration{7},
+     EdgeDuration{0},
+     EdgeDuration{123456}},
+    {EdgeDistance{0},
+     EdgeDistance{10.04},
+     INVALID_EDGE_DISTANCE,
+     EdgeDistance{3.25},
+     EdgeDistance{0},
+     EdgeDistance{98765.43}}};
+
+api::TableParameters makeParameters()
+{
+    api::TableParameters parameters;
+    parameters.coordinates = std::vector<util::Coordinate>(3);
+    parameters.sources = {0, 1};
+    parameters.skip_waypoints = true;
+    parameters.annotations = api::TableParameters::AnnotationsType::All;
+    return parameters;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(rendered_json_matches_json_tree)
+{
+    osrm::test::MockDataFacade<datafacade::CH> facade;
+    const auto parameters = makeParameters();
+    const std::vector<PhantomNodeCandidates> candidates(3);
+    api::TableAPI table_api{facade, parameters};
+
+    api::ResultT tree = util::json::Object();
+    table_api.MakeResponse(tables, candidates, {}, tree);
+    std::string expected;
+    util::json::render(expected, std::get<util::json::Object>(tree));
+
+    api::ResultT rendered = api::RenderedJSON();
+    table_api.MakeResponse(tables, candidates, {}, rendered);
+    const auto &content = std::get<api::RenderedJSON>(rendered).content;
+    const std::string actual(content.begin(), content.end());
+
+    // Members are the same, but their order depends on the hash map of the tree
+    BOOST_CHECK_EQUAL(actual.size(), expected.size());
+    BOOST_CHECK_EQUAL(actual.front(), '{');
+    BOOST_CHECK_EQUAL(actual.back(), '}');
+    for (const std::string member : {"\"code\":\"Ok\"",
+                                     "\"durations\":[[0,1.5,null],[0.7,0,12345.6]]",
+                                     "\"distances\":[[0,10,null],[3.3,0,98765.4]]"})
+    {
+        BOOST_CHECK_MESSAGE(expected.find(member) != std::string::npos, expected);
+        BOOST_CHECK_MESSAGE(actual.find(member) != std::string::npos, actual);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(flatbuffers_matrices)
+{
+    osrm::test::MockDataFacade<datafacade::CH> facade;
+    const auto parameters = makeParameters();
+    const std::vector<PhantomNodeCandidates> candidates(3);
+    api::TableAPI table_api{facade, parameters};
+
+    api::ResultT result = flatbuffers::FlatBufferBuilder();
+    table_api.MakeResponse(tables, candidates, {}, result);
+    const auto &builder = std::get<flatbuffers::FlatBufferBuilder>(result);
+    const auto table = api::fbresult::GetFBResult(builder.GetBufferPointer())->table();
+
+    BOOST_CHECK_EQUAL(table->rows(), 2);
+    BOOST_CHECK_EQUAL(table->cols(), 3);
+    const std::vector<float> durations = {0.f, 1.5f, 0.f, 0.7f, 0.f, 12345.6f};
+    const std::vector<float> distances = {0.f, 10.f, 0.f, 3.3f, 0.f, 98765.4f};
+    BOOST_CHECK_EQUAL_COLLECTIONS(table->durations()->begin(),
+                                  table->durations()->end(),
+                                  durations.begin(),
+                                  durations.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(table->distances()->begin(),
+                                  table->distances()->end(),
+                                  distances.begin(),
+                                  distances.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,155 @@
+#include <boost/test/unit_test.hpp>
+
+#include "coordinates.hpp"
+#include "fixture.hpp"
+
+#include "engine/datafacade_provider.hpp"
+#include "engine/routing_algorithms/isochrone.hpp"
+#include "engine/search_engine_data.hpp"
+
+#include "osrm/isochrone_parameters.hpp"
+#include "osrm/json_container.hpp"
+#include "osrm/osrm.hpp"
+#include "osrm/status.hpp"
+
+#include <functional>
+#include <queue>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(isochrone)
+
+using namespace osrm;
+using MLD = engine::routing_algorithms::mld::Algorithm;
+
+namespace
+{
+// Duration to every node within the budget, found by a Dijkstra search on the base graph that
+// settles the nodes by weight like the search on the overlay
+std::unordered_map<NodeID, EdgeDuration>
+plainIsochrone(const engine::DataFacade<MLD> &facade,
+               const engine::PhantomNodeCandidates &source_candidates,
+               const EdgeDuration max_duration)
+{
+    using Entry = std::tuple<EdgeWeight, NodeID, EdgeDuration>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    for (const auto &phantom_node : source_candidates)
+    {
+        if (phantom_node.IsValidForwardSource())
+        {
+            queue.emplace(EdgeWeight{0} - phantom_node.GetForwardWeightPlusOffset(),
+                          phantom_node.forward_segment_id.id,
+                          EdgeDuration{0} - phantom_node.GetForwardDuration());
+        }
+        if (phantom_node.IsValidReverseSource())
+        {
+            queue.emplace(EdgeWeight{0} - phantom_node.GetReverseWeightPlusOffset(),
+                          phantom_node.reverse_segment_id.id,
+                          EdgeDuration{0} - phantom_node.GetReverseDuration());
+        }
+    }
+
+    std::unordered_set<NodeID> settled;
+    std::unordered_map<NodeID, EdgeDuration> reached;
+    while (!queue.empty())
+    {
+        const auto [weight, node, duration] = queue.top();
+        queue.pop();
+        if (!settled.insert(node).second || duration > max_duration)
+        {
+            continue;
+        }
+        reached.emplace(node, duration);
+
+        for (const auto edge : facade.GetAdjacentEdgeRange(node))
+        {
+            const auto to = facade.GetTarget(edge);
+            if (!facade.IsForwardEdge(edge) || facade.ExcludeNode(to) || settled.count(to) > 0)
+            {
+                continue;
+            }
+            const auto turn_id = facade.GetEdgeData(edge).turn_id;
+            const auto to_weight =
+                weight + facade.GetNodeWeight(node) +
+                alias_cast<EdgeWeight>(facade.GetWeightPenaltyForEdgeID(turn_id));
+            const auto to_duration =
+                duration + facade.GetNodeDuration(node) +
+                alias_cast<EdgeDuration>(facade.GetDurationPenaltyForEdgeID(turn_id));
+            queue.emplace(to_weight, to, to_duration);
+        }
+    }
+    return reached;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_isochrone_matches_dijkstra)
+{
+    const engine::ImmutableProvider<MLD> provider(
+        storage::StorageConfig{OSRM_TEST_DATA_DIR "/mld/monaco.osrm"});
+    const auto facade = provider.Get(engine::api::BaseParameters{});
+    BOOST_REQUIRE(facade);
+
+    const auto source_candidates =
+        facade
+            ->NearestCandidatesWithAlternativeFromBigComponent(get_dummy_location(),
+                                                               std::nullopt,
+                                                               std::nullopt,
+                                                               engine::Approach::UNRESTRICTED,
+                                                               false)
+            .first;
+    BOOST_REQUIRE(!source_candidates.empty());
+
+    engine::SearchEngineData<MLD> heaps;
+    // budgets within one cell and across several levels of the overlay
+    for (const auto max_duration : {EdgeDuration{300}, EdgeDuration{1800}, EdgeDuration{6000}})
+    {
+        const auto expected = plainIsochrone(*facade, source_candidates, max_duration);
+        const auto reached = engine::routing_algorithms::isochroneSearch(
+            heaps, *facade, source_candidates, max_duration, true);
+
+        std::unordered_map<NodeID, EdgeDuration> durations;
+        for (const auto &reached_node : reached)
+        {
+            BOOST_CHECK(durations.emplace(reached_node.node, reached_node.duration).second);
+        }
+        BOOST_CHECK_EQUAL(durations.size(), expected.size());
+        for (const auto &[node, duration] : expected)
+        {
+            const auto found = durations.find(node);
+            BOOST_REQUIRE(found != durations.end());
+            BOOST_CHECK_EQUAL(found->second, duration);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_isochrone_polygon_is_closed_ring)
+{
+    const auto osrm = getOSRM(OSRM_TEST_DATA_DIR "/mld/monaco.osrm", EngineConfig::Algorithm::MLD);
+
+    // hardly anything is reached within a tenth of a second, the polygon is still a valid ring
+    for (const auto duration : {0.1, 60.})
+    {
+        IsochroneParameters params;
+        params.coordinates.push_back(get_dummy_location());
+        params.duration = duration;
+
+        json::Object json_result;
+        BOOST_REQUIRE(osrm.Isochrone(params, json_result) == Status::Ok);
+        const auto &polygon = std::get<json::Object>(json_result.values.at("polygon"));
+        const auto &rings = std::get<json::Array>(polygon.values.at("coordinates")).values;
+        BOOST_REQUIRE_EQUAL(rings.size(), 1);
+        const auto &ring = std::get<json::Array>(rings.front()).values;
+        BOOST_CHECK_GE(ring.size(), 4);
+
+        const auto &first = std::get<json::Array>(ring.front()).values;
+        const auto &last = std::get<json::Array>(ring.back()).values;
+        BOOST_CHECK_EQUAL(std::get<json::Number>(first[0]).value,
+                          std::get<json::Number>(last[0]).value);
+        BOOST_CHECK_EQUAL(std::get<json::Number>(first[1]).value,
+                          std::get<json::Number>(last[1]).value);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -11,6 +11,11 @@
 #include "osrm/osrm.hpp"
 #include "osrm/status.hpp"
 
+#include "util/json_renderer.hpp"
+
+#include <string>
+#include <vector>
+
 osrm::Status run_nearest_json(const osrm::OSRM &osrm,
                               const osrm::NearestParameters &params,
                               osrm::json::Object &json_result,
@@ -57,6 +62,28 @@ void test_nearest_response(bool use_json_only_api)
 BOOST_AUTO_TEST_CASE(test_nearest_response_old_api) { test_nearest_response(true); }
 BOOST_AUTO_TEST_CASE(test_nearest_response_new_api) { test_nearest_response(false); }
 
+BOOST_AUTO_TEST_CASE(test_nearest_rendered_response)
+{
+    auto osrm = getOSRM(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+
+    using namespace osrm;
+
+    NearestParameters params;
+    params.coordinates.push_back(get_dummy_location());
+
+    // services without a rendering API of their own render their JSON tree
+    engine::api::ResultT result = engine::api::RenderedJSON();
+    BOOST_REQUIRE(osrm.Nearest(params, result) == Status::Ok);
+    const auto &content = std::get<engine::api::RenderedJSON>(result).content;
+
+    json::Object json_result;
+    BOOST_REQUIRE(osrm.Nearest(params, json_result) == Status::Ok);
+    std::vector<char> expected;
+    util::json::render(expected, json_result);
+    BOOST_CHECK_EQUAL(std::string(content.begin(), content.end()),
+                      std::string(expected.begin(), expected.end()));
+}
+
 void test_nearest_response_skip_waypoints(bool use_json_only_api)
 {
     auto osrm = getOSRM(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
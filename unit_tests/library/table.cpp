@@ -387,4 +387,70 @@ BOOST_AUTO_TEST_CASE(test_table_serialiaze_fb_no_waypoints)
     BOOST_CHECK(fb->waypoints() == nullptr);
 }
 
+void test_table_parallel_matches_sequential(const std::string &base_path,
+                                            osrm::EngineConfig::Algorithm algorithm)
+{
+    using namespace osrm;
+
+    // 80x80 is above the size from which many-to-many searches are run in parallel
+    TableParameters params;
+    for (int lon = 0; lon < 10; ++lon)
+    {
+        for (int lat = 0; lat < 8; ++lat)
+        {
+            params.coordinates.push_back(
+                {Longitude{7.410 + lon * 0.003}, Latitude{43.730 + lat * 0.002}});
+        }
+    }
+    params.annotations = TableParameters::AnnotationsType::All;
+
+    const auto compute_table = [&](const int threads)
+    {
+        EngineConfig config;
+        config.storage_config = {base_path};
+        config.use_shared_memory = false;
+        config.algorithm = algorithm;
+        config.many_to_many_threads = threads;
+        OSRM osrm{config};
+
+        engine::api::ResultT result = flatbuffers::FlatBufferBuilder();
+        const auto rc = osrm.Table(params, result);
+        BOOST_CHECK(rc == Status::Ok);
+
+        auto &fb_result = std::get<flatbuffers::FlatBufferBuilder>(result);
+        auto fb = engine::api::fbresult::GetFBResult(fb_result.GetBufferPointer());
+        BOOST_REQUIRE(!fb->error());
+        return std::make_pair(
+            std::vector<float>(fb->table()->durations()->begin(), fb->table()->durations()->end()),
+            std::vector<float>(fb->table()->distances()->begin(),
+                               fb->table()->distances()->end()));
+    };
+
+    const auto sequential = compute_table(1);
+    const auto parallel = compute_table(4);
+
+    const auto number_of_coordinates = params.coordinates.size();
+    BOOST_CHECK_EQUAL(sequential.first.size(), number_of_coordinates * number_of_coordinates);
+    BOOST_CHECK_EQUAL_COLLECTIONS(sequential.first.begin(),
+                                  sequential.first.end(),
+                                  parallel.first.begin(),
+                                  parallel.first.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(sequential.second.begin(),
+                                  sequential.second.end(),
+                                  parallel.second.begin(),
+                                  parallel.second.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_table_parallel_matches_sequential_ch)
+{
+    test_table_parallel_matches_sequential(OSRM_TEST_DATA_DIR "/ch/monaco.osrm",
+                                           osrm::EngineConfig::Algorithm::CH);
+}
+
+BOOST_AUTO_TEST_CASE(test_table_parallel_matches_sequential_mld)
+{
+    test_table_parallel_matches_sequential(OSRM_TEST_DATA_DIR "/mld/monaco.osrm",
+                                           osrm::EngineConfig::Algorithm::MLD);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
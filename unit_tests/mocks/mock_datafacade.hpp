@@ -134,6 +134,21 @@ class MockBaseDataFacade : public engine::datafacade::BaseDataFacade
         return {};
     };
 
+    std::vector<std::vector<engine::PhantomNodeWithDistance>>
+    NearestPhantomNodes(const std::vector<engine::NearestQuery> &queries,
+                        const size_t /*max_results*/) const override
+    {
+        return std::vector<std::vector<engine::PhantomNodeWithDistance>>(queries.size());
+    };
+
+    std::vector<engine::PhantomCandidateAlternatives>
+    NearestCandidatesWithAlternativeFromBigComponent(
+        const std::vector<engine::NearestQuery> &queries,
+        const bool /*use_all_edges*/) const override
+    {
+        return std::vector<engine::PhantomCandidateAlternatives>(queries.size());
+    };
+
     std::uint32_t GetCheckSum() const override { return 0; }
 
     extractor::TravelMode GetTravelMode(const NodeID /* id */) const override
@@ -224,11 +239,15 @@ class MockAlgorithmDataFacade<engine::datafacade::CH>
     unsigned GetNumberOfEdges() const override { return 0; }
     unsigned GetOutDegree(const NodeID /* n */) const override { return 0; }
     NodeID GetTarget(const EdgeID /* e */) const override { return SPECIAL_NODEID; }
-    const EdgeData &GetEdgeData(const EdgeID /* e */) const override { return foo; }
+    EdgeData GetEdgeData(const EdgeID /* e */) const override { return foo; }
     EdgeRange GetAdjacentEdgeRange(const NodeID /* node */) const override
     {
         return EdgeRange(static_cast<EdgeID>(0), static_cast<EdgeID>(0), {});
     }
+    AdjacentEdgeRange GetAdjacentEdges(const NodeID /* node */) const override
+    {
+        return AdjacentEdgeRange{};
+    }
     EdgeID FindEdge(const NodeID /* from */, const NodeID /* to */) const override
     {
         return SPECIAL_EDGEID;
@@ -252,6 +271,8 @@ class MockAlgorithmDataFacade<engine::datafacade::CH>
     {
         return SPECIAL_EDGEID;
     }
+
+    const contractor::PhastSweepView *GetPhastSweep() const override { return nullptr; }
 };
 
 template <typename AlgorithmT>
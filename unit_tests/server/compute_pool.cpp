@@ -0,0 +1,171 @@
+#include "server/compute_pool.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(compute_pool)
+
+using namespace osrm;
+using namespace osrm::server;
+
+BOOST_AUTO_TEST_CASE(start_in_posted_order)
+{
+    const auto waited = ComputePoolStatistics::wait_durations[0].Count();
+
+    std::vector<int> order;
+    std::promise<void> release;
+    std::promise<void> done;
+    {
+        ComputePool pool(1);
+        BOOST_CHECK_EQUAL(pool.Size(), 1);
+        BOOST_CHECK_GE(ComputePoolStatistics::threads.load(), 1);
+
+        // keeps the only thread busy until all tasks are queued
+        pool.Post([future = release.get_future().share()] { future.wait(); });
+        for (int task = 0; task < 3; ++task)
+        {
+            pool.Post([&order, task] { order.push_back(task); });
+        }
+        pool.Post([&done] { done.set_value(); });
+        release.set_value();
+        done.get_future().wait();
+    }
+
+    BOOST_CHECK_EQUAL(order.size(), 3);
+    BOOST_CHECK(std::is_sorted(order.begin(), order.end()));
+    BOOST_CHECK_EQUAL(ComputePoolStatistics::wait_durations[0].Count() - waited, 5);
+    BOOST_CHECK_EQUAL(ComputePoolStatistics::queued[0].load(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(run_tasks_besides_a_slow_one)
+{
+    ComputePool pool(2);
+    std::promise<void> release;
+    std::promise<std::thread::id> fast;
+
+    pool.Post([future = release.get_future().share()] { future.wait(); });
+    pool.Post([&fast] { fast.set_value(std::this_thread::get_id()); });
+
+    // the second thread answers while the first one is still blocked
+    BOOST_CHECK(fast.get_future().get() != std::this_thread::get_id());
+    release.set_value();
+}
+
+BOOST_AUTO_TEST_CASE(start_higher_priorities_first)
+{
+    std::vector<RequestPriority> order;
+    std::promise<void> release;
+    std::promise<void> done;
+    {
+        ComputePool pool(1);
+        pool.Post([future = release.get_future().share()] { future.wait(); });
+        for (const auto priority : {RequestPriority::Batch,
+                                    RequestPriority::Interactive,
+                                    RequestPriority::Batch,
+                                    RequestPriority::Interactive})
+        {
+            pool.Post([&order, priority] { order.push_back(priority); }, priority);
+        }
+        pool.Post([&done] { done.set_value(); }, RequestPriority::Batch);
+        release.set_value();
+        done.get_future().wait();
+    }
+
+    const std::vector<RequestPriority> expected = {RequestPriority::Interactive,
+                                                   RequestPriority::Interactive,
+                                                   RequestPriority::Batch,
+                                                   RequestPriority::Batch};
+    BOOST_CHECK(order == expected);
+}
+
+BOOST_AUTO_TEST_CASE(limit_in_flight_and_queued_cost)
+{
+    ComputePool pool(2);
+    pool.SetLimits(RequestPriority::Batch, {1, 10});
+    const auto rejected = ComputePoolStatistics::rejected[1].load();
+
+    std::promise<void> release;
+    std::promise<void> started;
+    std::promise<std::thread::id> interactive;
+    auto blocker = release.get_future().share();
+
+    // the only batch slot is taken, so the second batch task waits
+    BOOST_CHECK(pool.Post(
+        [&started, blocker]
+        {
+            started.set_value();
+            blocker.wait();
+        },
+        RequestPriority::Batch));
+    started.get_future().wait();
+    BOOST_CHECK(pool.Post([] {}, RequestPriority::Batch, 8));
+
+    // the waiting tasks may cost 10 coordinates
+    BOOST_CHECK(!pool.Post([] {}, RequestPriority::Batch, 3));
+    BOOST_CHECK(pool.Post([] {}, RequestPriority::Batch, 2));
+    BOOST_CHECK_EQUAL(ComputePoolStatistics::rejected[1].load() - rejected, 1);
+
+    // the other thread is still free for interactive tasks
+    BOOST_CHECK(pool.Post([&interactive] { interactive.set_value(std::this_thread::get_id()); }));
+    BOOST_CHECK(interactive.get_future().get() != std::this_thread::get_id());
+    release.set_value();
+}
+
+BOOST_AUTO_TEST_CASE(parallel_for_in_tasks)
+{
+    ComputePool pool(2);
+    std::atomic<std::size_t> sum = 0;
+    std::promise<void> first_done;
+    std::promise<void> second_done;
+
+    // both tasks split their work while the pool has no thread left for the helpers
+    const auto split = [&pool, &sum](std::promise<void> &done)
+    {
+        pool.ParallelFor(100, [&sum](const std::size_t index) { sum += index; });
+        done.set_value();
+    };
+    pool.Post([&] { split(first_done); });
+    pool.Post([&] { split(second_done); }, RequestPriority::Batch);
+    first_done.get_future().wait();
+    second_done.get_future().wait();
+    BOOST_CHECK_EQUAL(sum.load(), 2 * 4950);
+
+    std::atomic<std::size_t> calls = 0;
+    BOOST_CHECK_THROW(pool.ParallelFor(10,
+                                       [&calls](const std::size_t index)
+                                       {
+                                           ++calls;
+                                           if (index == 3)
+                                           {
+                                               throw std::runtime_error("failed");
+                                           }
+                                       }),
+                      std::runtime_error);
+    // the other calls still ran
+    BOOST_CHECK_EQUAL(calls.load(), 10);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_for_helpers_not_accounted)
+{
+    const auto waited = ComputePoolStatistics::wait_durations[1].Count();
+    {
+        ComputePool pool(4);
+        std::atomic<std::size_t> calls = 0;
+        pool.ParallelFor(
+            100, [&calls](const std::size_t) { ++calls; }, RequestPriority::Batch);
+        BOOST_CHECK_EQUAL(calls.load(), 100);
+        // helpers that did not start yet are not waiting tasks
+        BOOST_CHECK_EQUAL(ComputePoolStatistics::queued[1].load(), 0);
+    }
+    BOOST_CHECK_EQUAL(ComputePoolStatistics::wait_durations[1].Count(), waited);
+    BOOST_CHECK_EQUAL(ComputePoolStatistics::queued[1].load(), 0);
+    BOOST_CHECK_EQUAL(ComputePoolStatistics::in_flight[1].load(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
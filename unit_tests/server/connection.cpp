@@ -0,0 +1,281 @@
+#include "server/connection.hpp"
+#include "server/api/parsed_url.hpp"
+#include "server/compute_pool.hpp"
+#include "server/request_handler.hpp"
+#include "server/service_handler.hpp"
+
+#include "engine/cancellation.hpp"
+#include "util/json_container.hpp"
+
+#include <boost/asio.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(connection)
+
+using namespace osrm;
+using namespace osrm::server;
+
+namespace
+{
+// Answers every query with the same random text, which compresses badly enough to span
+// several chunks. Waits for the client before it looks at the cancellation token like a search.
+class RandomTextServiceHandler final : public ServiceHandlerInterface
+{
+  public:
+    std::shared_future<void> client_ready;
+
+    engine::Status RunQuery(api::ParsedURL, engine::api::ResultT &result) override
+    {
+        if (client_ready.valid())
+        {
+            client_ready.wait();
+        }
+        if (const auto token = engine::CurrentCancellationToken())
+        {
+            token->ThrowIfCancelled();
+        }
+
+        std::mt19937 generator(42);
+        std::uniform_int_distribution<int> letter('a', 'z');
+        std::string text(512 * 1024, ' ');
+        for (auto &character : text)
+        {
+            character = static_cast<char>(letter(generator));
+        }
+
+        util::json::Object response;
+        response.values["text"] = std::move(text);
+        result = std::move(response);
+        return engine::Status::Ok;
+    }
+};
+
+// Looks at the cancellation token like a search until the request is cancelled, and tells the
+// test when it started and why it stopped
+class WaitForCancellationServiceHandler final : public ServiceHandlerInterface
+{
+  public:
+    std::promise<void> started;
+    std::promise<engine::CancellationReason> stopped;
+
+    engine::Status RunQuery(api::ParsedURL, engine::api::ResultT &result) override
+    {
+        started.set_value();
+
+        auto reason = engine::CancellationReason::None;
+        const auto token = engine::CurrentCancellationToken();
+        const auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (token && reason == engine::CancellationReason::None &&
+               std::chrono::steady_clock::now() < give_up)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            reason = token->Check();
+        }
+        stopped.set_value(reason);
+
+        result = util::json::Object();
+        return engine::Status::Ok;
+    }
+};
+
+struct Reply
+{
+    std::string headers;
+    std::string body;
+};
+
+// Sends a request to a connection of the handler and reads the reply until the connection is
+// closed. A client that half-closes shuts down its sending side after the request and then
+// fulfills the promise.
+Reply exchange(RequestHandler &handler,
+               const std::string &request,
+               std::promise<void> *half_closed = nullptr)
+{
+    boost::asio::io_context io_context;
+    auto work = boost::asio::make_work_guard(io_context);
+    ComputePool compute_pool(1);
+
+    boost::asio::ip::tcp::acceptor acceptor(
+        io_context,
+        boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+    const auto connection = std::make_shared<Connection>(io_context, handler, compute_pool, 5);
+    acceptor.async_accept(connection->socket(),
+                          [connection](const boost::system::error_code &error)
+                          {
+                              if (!error)
+                              {
+                                  connection->start();
+                              }
+                          });
+    std::thread io_thread([&io_context] { io_context.run(); });
+
+    boost::asio::io_context client_context;
+    boost::asio::ip::tcp::socket socket(client_context);
+    socket.connect(acceptor.local_endpoint());
+    boost::asio::write(socket, boost::asio::buffer(request));
+    if (half_closed)
+    {
+        socket.shutdown(boost::asio::ip::tcp::socket::shutdown_send);
+        half_closed->set_value();
+    }
+
+    std::string response;
+    boost::system::error_code error;
+    boost::asio::read(socket, boost::asio::dynamic_buffer(response), error);
+    BOOST_CHECK(error == boost::asio::error::eof);
+
+    work.reset();
+    io_context.stop();
+    io_thread.join();
+
+    const auto headers_end = response.find("\r\n\r\n");
+    BOOST_REQUIRE(headers_end != std::string::npos);
+    return {response.substr(0, headers_end), response.substr(headers_end + 4)};
+}
+
+// Joins the chunks of a chunked body, which ends with a chunk of size 0
+std::string decodeChunks(const std::string &body, std::size_t &number_of_chunks)
+{
+    std::string content;
+    number_of_chunks = 0;
+    std::size_t position = 0;
+    while (true)
+    {
+        const auto size_end = body.find("\r\n", position);
+        BOOST_REQUIRE(size_end != std::string::npos);
+        const auto size = std::stoul(body.substr(position, size_end - position), nullptr, 16);
+        position = size_end + 2;
+        if (size == 0)
+        {
+            BOOST_CHECK_EQUAL(body.substr(position), "\r\n");
+            return content;
+        }
+
+        BOOST_REQUIRE_LE(position + size + 2, body.size());
+        content += body.substr(position, size);
+        BOOST_REQUIRE_EQUAL(body.substr(position + size, 2), "\r\n");
+        position += size + 2;
+        ++number_of_chunks;
+    }
+}
+
+std::string gunzip(const std::string &compressed)
+{
+    std::string content;
+    boost::iostreams::filtering_ostream decompressor;
+    decompressor.push(boost::iostreams::gzip_decompressor());
+    decompressor.push(boost::iostreams::back_inserter(content));
+    decompressor.write(compressed.data(), compressed.size());
+    boost::iostreams::close(decompressor);
+    return content;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(chunked_gzip_reply)
+{
+    RequestHandler handler;
+    handler.RegisterServiceHandler(std::make_unique<RandomTextServiceHandler>());
+
+    const auto plain = exchange(handler,
+                                "GET /route/v1/driving/1,2;3,4 HTTP/1.1\r\n"
+                                "Host: localhost\r\n"
+                                "Connection: close\r\n\r\n");
+    BOOST_CHECK(plain.headers.find("Content-Length: " + std::to_string(plain.body.size())) !=
+                std::string::npos);
+    BOOST_REQUIRE_GT(plain.body.size(), 512 * 1024);
+
+    const auto compressed = exchange(handler,
+                                     "GET /route/v1/driving/1,2;3,4 HTTP/1.1\r\n"
+                                     "Host: localhost\r\n"
+                                     "Accept-Encoding: gzip\r\n"
+                                     "Connection: close\r\n\r\n");
+    BOOST_CHECK(compressed.headers.find("Transfer-Encoding: chunked") != std::string::npos);
+    BOOST_CHECK(compressed.headers.find("Content-Encoding: gzip") != std::string::npos);
+    BOOST_CHECK(compressed.headers.find("Content-Length") == std::string::npos);
+
+    std::size_t number_of_chunks = 0;
+    const auto content = gunzip(decodeChunks(compressed.body, number_of_chunks));
+    BOOST_CHECK_GT(number_of_chunks, 1);
+    BOOST_CHECK(content == plain.body);
+}
+
+BOOST_AUTO_TEST_CASE(half_closed_client_gets_reply)
+{
+    RequestHandler handler;
+    handler.EnableCancellation(std::nullopt, false);
+    auto service_handler = std::make_unique<RandomTextServiceHandler>();
+    std::promise<void> half_closed;
+    service_handler->client_ready = half_closed.get_future().share();
+    handler.RegisterServiceHandler(std::move(service_handler));
+
+    // without --cancel-on-disconnect the end of the request stream is not looked at
+    const auto reply = exchange(handler,
+                                "GET /route/v1/driving/1,2;3,4 HTTP/1.1\r\n"
+                                "Host: localhost\r\n"
+                                "Connection: close\r\n\r\n",
+                                &half_closed);
+    BOOST_CHECK(reply.headers.find("200 OK") != std::string::npos);
+    BOOST_CHECK(reply.headers.find("Content-Length: " + std::to_string(reply.body.size())) !=
+                std::string::npos);
+    BOOST_CHECK_GT(reply.body.size(), 512 * 1024);
+}
+
+BOOST_AUTO_TEST_CASE(closed_client_cancels_search)
+{
+    RequestHandler handler;
+    handler.EnableCancellation(std::nullopt, true);
+    auto service_handler = std::make_unique<WaitForCancellationServiceHandler>();
+    auto started = service_handler->started.get_future();
+    auto stopped = service_handler->stopped.get_future();
+    handler.RegisterServiceHandler(std::move(service_handler));
+
+    boost::asio::io_context io_context;
+    auto work = boost::asio::make_work_guard(io_context);
+    ComputePool compute_pool(1);
+
+    boost::asio::ip::tcp::acceptor acceptor(
+        io_context,
+        boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+    const auto connection = std::make_shared<Connection>(io_context, handler, compute_pool, 5);
+    acceptor.async_accept(connection->socket(),
+                          [connection](const boost::system::error_code &error)
+                          {
+                              if (!error)
+                              {
+                                  connection->start();
+                              }
+                          });
+    std::thread io_thread([&io_context] { io_context.run(); });
+
+    boost::asio::io_context client_context;
+    boost::asio::ip::tcp::socket socket(client_context);
+    socket.connect(acceptor.local_endpoint());
+    boost::asio::write(socket,
+                       boost::asio::buffer(std::string("GET /route/v1/driving/1,2;3,4 HTTP/1.1\r\n"
+                                                       "Host: localhost\r\n\r\n")));
+
+    // the client goes away while the search runs
+    BOOST_REQUIRE(started.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+    socket.close();
+
+    BOOST_REQUIRE(stopped.wait_for(std::chrono::seconds(20)) == std::future_status::ready);
+    BOOST_CHECK(stopped.get() == engine::CancellationReason::Cancelled);
+
+    work.reset();
+    io_context.stop();
+    io_thread.join();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -3,6 +3,7 @@
 #include "parameters_io.hpp"
 
 #include "engine/api/base_parameters.hpp"
+#include "engine/api/isochrone_parameters.hpp"
 #include "engine/api/match_parameters.hpp"
 #include "engine/api/nearest_parameters.hpp"
 #include "engine/api/route_parameters.hpp"
@@ -752,6 +753,55 @@ BOOST_AUTO_TEST_CASE(valid_nearest_urls)
     CHECK_EQUAL_RANGE(reference_2.coordinates, result_2->coordinates);
 }
 
+BOOST_AUTO_TEST_CASE(coordinates_from_body)
+{
+    // the body of the request holds the coordinates, the URL only the options
+    auto route = parseParameters<RouteParameters>("body?steps=true");
+    BOOST_CHECK(route);
+    BOOST_CHECK(route->coordinates.empty());
+    BOOST_CHECK_EQUAL(route->steps, true);
+
+    auto table = parseParameters<TableParameters>("body.json?sources=0");
+    BOOST_CHECK(table);
+    BOOST_CHECK(table->coordinates.empty());
+    BOOST_CHECK_EQUAL(table->sources.size(), 1);
+
+    BOOST_CHECK_EQUAL(testInvalidOptions<RouteParameters>("bodyx"), 4);
+}
+
+BOOST_AUTO_TEST_CASE(valid_isochrone_urls)
+{
+    std::vector<util::Coordinate> coords_1 = {{util::FloatLongitude{1}, util::FloatLatitude{2}}};
+
+    auto result_1 = parseParameters<IsochroneParameters>("1,2?duration=600");
+    BOOST_CHECK(result_1);
+    BOOST_CHECK(result_1->IsValid());
+    BOOST_CHECK_EQUAL(result_1->duration, 600.);
+    BOOST_CHECK(result_1->output == IsochroneParameters::OutputType::Polygon);
+    CHECK_EQUAL_RANGE(coords_1, result_1->coordinates);
+
+    auto result_2 =
+        parseParameters<IsochroneParameters>("1,2?duration=90.5&output=edges&radiuses=10");
+    BOOST_CHECK(result_2);
+    BOOST_CHECK(result_2->IsValid());
+    BOOST_CHECK_EQUAL(result_2->duration, 90.5);
+    BOOST_CHECK(result_2->output == IsochroneParameters::OutputType::Edges);
+    BOOST_CHECK_EQUAL(result_2->radiuses.size(), 1);
+
+    // Parses, but a duration is required
+    auto result_3 = parseParameters<IsochroneParameters>("1,2");
+    BOOST_CHECK(result_3);
+    BOOST_CHECK(!result_3->IsValid());
+}
+
+BOOST_AUTO_TEST_CASE(invalid_isochrone_urls)
+{
+    BOOST_CHECK_EQUAL(testInvalidOptions<IsochroneParameters>("1,2?duration=foo"), 13UL);
+    BOOST_CHECK_EQUAL(testInvalidOptions<IsochroneParameters>("1,2?duration=60&output=area"),
+                      23UL);
+    BOOST_CHECK_EQUAL(testInvalidOptions<IsochroneParameters>("1,2?number=3"), 4UL);
+}
+
 BOOST_AUTO_TEST_CASE(invalid_tile_urls)
 {
     TileParameters reference_1{1, 2, 3};
@@ -0,0 +1,90 @@
+#include "server/api/request_body_parser.hpp"
+
+#include "engine/api/flatbuffers/fbrequest_generated.h"
+#include "engine/api/match_parameters.hpp"
+#include "engine/api/route_parameters.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <limits>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(request_body_parser)
+
+using namespace osrm;
+using namespace osrm::server;
+using namespace osrm::engine::api;
+
+namespace
+{
+std::string makeBody(const std::vector<fbrequest::Coordinate> &coordinates,
+                     const std::vector<double> &radiuses,
+                     const std::vector<fbrequest::Bearing> &bearings,
+                     const std::vector<unsigned> &timestamps)
+{
+    flatbuffers::FlatBufferBuilder builder;
+    builder.Finish(fbrequest::CreateFBRequestDirect(
+        builder, &coordinates, &radiuses, &bearings, &timestamps));
+    return std::string(reinterpret_cast<const char *>(builder.GetBufferPointer()),
+                       builder.GetSize());
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(coordinates_and_values_per_coordinate)
+{
+    const auto body = makeBody({{7416351, 43731205}, {7420363, 43736189}},
+                               {-1, std::numeric_limits<double>::infinity()},
+                               {{90, 10}, {-1, 0}},
+                               {});
+    RouteParameters parameters;
+    parameters.radiuses = {5., 5., 5.};
+    std::string help;
+    BOOST_REQUIRE(api::parseBody(body, parameters, help));
+
+    BOOST_REQUIRE_EQUAL(parameters.coordinates.size(), 2);
+    BOOST_CHECK(parameters.coordinates[0] ==
+                util::Coordinate(util::FixedLongitude{7416351}, util::FixedLatitude{43731205}));
+    BOOST_CHECK(parameters.coordinates[1] ==
+                util::Coordinate(util::FixedLongitude{7420363}, util::FixedLatitude{43736189}));
+
+    // the radiuses of the body replace those of the URL
+    BOOST_REQUIRE_EQUAL(parameters.radiuses.size(), 2);
+    BOOST_CHECK(!parameters.radiuses[0]);
+    BOOST_CHECK(parameters.radiuses[1] &&
+                *parameters.radiuses[1] == std::numeric_limits<double>::infinity());
+
+    BOOST_REQUIRE_EQUAL(parameters.bearings.size(), 2);
+    BOOST_CHECK(parameters.bearings[0] && parameters.bearings[0]->bearing == 90 &&
+                parameters.bearings[0]->range == 10);
+    BOOST_CHECK(!parameters.bearings[1]);
+    BOOST_CHECK(parameters.IsValid());
+}
+
+BOOST_AUTO_TEST_CASE(timestamps_only_for_match)
+{
+    const auto body = makeBody({{1000000, 2000000}, {3000000, 4000000}}, {}, {}, {10, 20});
+
+    MatchParameters match_parameters;
+    std::string help;
+    BOOST_REQUIRE(api::parseBody(body, match_parameters, help));
+    BOOST_CHECK_EQUAL(match_parameters.coordinates.size(), 2);
+    BOOST_CHECK_EQUAL(match_parameters.timestamps.size(), 2);
+    BOOST_CHECK_EQUAL(match_parameters.timestamps[1], 20);
+
+    RouteParameters route_parameters;
+    BOOST_CHECK(!api::parseBody(body, route_parameters, help));
+    BOOST_CHECK_EQUAL(help, "Only the match service supports timestamps");
+}
+
+BOOST_AUTO_TEST_CASE(invalid_body)
+{
+    const std::string body = "{\"coordinates\": [[1, 2], [3, 4]]}";
+    RouteParameters parameters;
+    std::string help;
+    BOOST_CHECK(!api::parseBody(body, parameters, help));
+    BOOST_CHECK_EQUAL(help, "Request body is no valid FBRequest");
+    BOOST_CHECK(parameters.coordinates.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
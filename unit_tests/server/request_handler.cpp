@@ -0,0 +1,203 @@
+#include "server/request_handler.hpp"
+#include "server/api/parsed_url.hpp"
+#include "server/compute_pool.hpp"
+#include "server/http/reply.hpp"
+#include "server/http/request.hpp"
+
+#include "engine/api/flatbuffers/fbrequest_generated.h"
+#include "util/json_container.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(request_handler)
+
+using namespace osrm;
+using namespace osrm::server;
+
+namespace
+{
+RequestClass classify(const RequestHandler &handler, const std::string &uri)
+{
+    http::request request;
+    request.uri = uri;
+    return handler.Classify(request);
+}
+
+// Answers every query with its service and query string
+class EchoServiceHandler final : public ServiceHandlerInterface
+{
+  public:
+    engine::Status RunQuery(api::ParsedURL parsed_url, engine::api::ResultT &result) override
+    {
+        util::json::Object response;
+        response.values["echo"] = parsed_url.service + "/" + parsed_url.query;
+        result = std::move(response);
+        return engine::Status::Ok;
+    }
+};
+
+// Fails every query of a route request with an exception and answers the others
+class ThrowingServiceHandler final : public ServiceHandlerInterface
+{
+  public:
+    engine::Status RunQuery(api::ParsedURL parsed_url, engine::api::ResultT &result) override
+    {
+        if (parsed_url.service == "route")
+        {
+            throw std::runtime_error("search failed");
+        }
+        result = util::json::Object();
+        return engine::Status::Ok;
+    }
+};
+
+http::reply handle(RequestHandler &handler, const std::string &uri, const std::string &body)
+{
+    http::request request;
+    request.method = "POST";
+    request.uri = uri;
+    request.body = body;
+    http::reply reply;
+    handler.HandleRequest(request, reply);
+    return reply;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(classify_by_service_and_coordinates)
+{
+    RequestHandler handler;
+    handler.SetBatchServices({"table", "match"});
+
+    const auto route = classify(handler, "/route/v1/driving/7.41,43.73;7.42,43.74?steps=true");
+    BOOST_CHECK(route.priority == RequestPriority::Interactive);
+    BOOST_CHECK_EQUAL(route.cost, 2);
+
+    const auto table = classify(handler, "/table/v1/driving/1,2;3,4;5,6;7,8.json?sources=0");
+    BOOST_CHECK(table.priority == RequestPriority::Batch);
+    BOOST_CHECK_EQUAL(table.cost, 4);
+
+    // _p~iF~ps|U_ulLnnqC_mqNvxq`@ are three coordinates
+    const auto polyline =
+        classify(handler, "/match/v1/driving/polyline(_p~iF~ps|U_ulLnnqC_mqNvxq`@)");
+    BOOST_CHECK(polyline.priority == RequestPriority::Batch);
+    BOOST_CHECK_EQUAL(polyline.cost, 3);
+
+    // percent encoded characters are decoded, the options are not counted
+    const auto encoded = classify(
+        handler, "/match/v1/driving/polyline(%5Fp~iF~ps%7CU_ulLnnqC_mqNvxq%60%40)?radiuses=1;2;3");
+    BOOST_CHECK_EQUAL(encoded.cost, 3);
+    const auto separators = classify(handler, "/table/v1/driving/1,2%3B3,4%3b5,6?radiuses=1;2;3");
+    BOOST_CHECK_EQUAL(separators.cost, 3);
+
+    const auto invalid = classify(handler, "/table");
+    BOOST_CHECK(invalid.priority == RequestPriority::Interactive);
+    BOOST_CHECK_EQUAL(invalid.cost, 1);
+}
+
+BOOST_AUTO_TEST_CASE(classify_body_by_coordinates)
+{
+    RequestHandler handler;
+    handler.SetBatchServices({"table"});
+
+    flatbuffers::FlatBufferBuilder builder;
+    const std::vector<engine::api::fbrequest::Coordinate> coordinates(5, {1000000, 2000000});
+    builder.Finish(engine::api::fbrequest::CreateFBRequestDirect(builder, &coordinates));
+
+    http::request request;
+    request.uri = "/table/v1/driving/body?sources=0";
+    request.body.assign(reinterpret_cast<const char *>(builder.GetBufferPointer()),
+                        builder.GetSize());
+    const auto table = handler.Classify(request);
+    BOOST_CHECK(table.priority == RequestPriority::Batch);
+    // estimated from the size of the body, which is not parsed on the I/O thread
+    BOOST_CHECK_GE(table.cost, 5);
+    BOOST_CHECK_LE(table.cost, 5 + 4);
+}
+
+BOOST_AUTO_TEST_CASE(classify_batch_by_queries)
+{
+    RequestHandler handler;
+    handler.SetBatchServices({"batch"});
+
+    http::request request;
+    request.uri = "/batch/v1/driving/route";
+    request.body = R"({"queries": ["7.41,43.73;7.42,43.74", "1,2;3,4;5,6?steps=true"]})";
+    const auto batch = handler.Classify(request);
+    BOOST_CHECK(batch.priority == RequestPriority::Batch);
+    BOOST_CHECK_EQUAL(batch.cost, 1 + 2 + 3);
+}
+
+BOOST_AUTO_TEST_CASE(batch_responses_in_query_order)
+{
+    ComputePool pool(2);
+    RequestHandler handler;
+    handler.RegisterServiceHandler(std::make_unique<EchoServiceHandler>());
+
+    const std::string body = R"({"queries": ["1,2;3,4", "5,6;7,8%3Fsteps=true", "9,10;11,12"]})";
+    const std::string expected = R"({"code":"Ok","results":[{"echo":"route/1,2;3,4"},)"
+                                 R"({"echo":"route/5,6;7,8?steps=true"},)"
+                                 R"({"echo":"route/9,10;11,12"}]})";
+
+    // one after another without a pool, in parallel with one
+    for (auto *compute_pool : {static_cast<ComputePool *>(nullptr), &pool})
+    {
+        handler.SetComputePool(compute_pool);
+        const auto reply = handle(handler, "/batch/v1/driving/route", body);
+        BOOST_CHECK_EQUAL(reply.status, http::reply::ok);
+        BOOST_CHECK_EQUAL(std::string(reply.content.begin(), reply.content.end()), expected);
+    }
+
+    const auto empty = handle(handler, "/batch/v1/driving/route", R"({"queries": []})");
+    BOOST_CHECK_EQUAL(std::string(empty.content.begin(), empty.content.end()),
+                      R"({"code":"Ok","results":[]})");
+
+    const auto invalid_body = handle(handler, "/batch/v1/driving/route", R"(["1,2;3,4"])");
+    BOOST_CHECK_EQUAL(invalid_body.status, http::reply::bad_request);
+    const std::string invalid_content(invalid_body.content.begin(), invalid_body.content.end());
+    BOOST_CHECK(invalid_content.find("InvalidBody") != std::string::npos);
+
+    const auto nested = handle(handler, "/batch/v1/driving/batch", R"({"queries": []})");
+    BOOST_CHECK_EQUAL(nested.status, http::reply::bad_request);
+
+    handler.SetMaxBatchSize(2);
+    const auto too_big = handle(handler, "/batch/v1/driving/route", body);
+    BOOST_CHECK_EQUAL(too_big.status, http::reply::bad_request);
+    const std::string too_big_content(too_big.content.begin(), too_big.content.end());
+    BOOST_CHECK(too_big_content.find("TooBig") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(metrics_of_failed_requests)
+{
+    RequestHandler handler;
+    handler.EnableMetrics(true, true);
+    handler.RegisterServiceHandler(std::make_unique<ThrowingServiceHandler>());
+
+    const auto failed = handle(handler, "/route/v1/driving/1,2;3,4", "");
+    BOOST_CHECK_EQUAL(failed.status, http::reply::internal_server_error);
+    BOOST_CHECK(std::any_of(failed.headers.begin(),
+                            failed.headers.end(),
+                            [](const auto &header) { return header.name == "Server-Timing"; }));
+    const auto invalid = handle(handler, "/nearest", "");
+    BOOST_CHECK_EQUAL(invalid.status, http::reply::bad_request);
+    const auto answered = handle(handler, "/nearest/v1/driving/1,2", "");
+    BOOST_CHECK_EQUAL(answered.status, http::reply::ok);
+
+    const auto metrics = handle(handler, "/metrics", "");
+    const std::string text(metrics.content.begin(), metrics.content.end());
+    BOOST_CHECK(text.find("osrm_request_duration_seconds_count{service=\"route\",status=\"500\"} "
+                          "1\n") != std::string::npos);
+    BOOST_CHECK(text.find("osrm_request_duration_seconds_count{service=\"route\",status=\"200\"} "
+                          "0\n") != std::string::npos);
+    BOOST_CHECK(text.find("osrm_request_duration_seconds_count{service=\"invalid\",status="
+                          "\"400\"} 1\n") != std::string::npos);
+    BOOST_CHECK(text.find("osrm_request_duration_seconds_count{service=\"nearest\",status="
+                          "\"200\"} 1\n") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,122 @@
+#include "server/request_parser.hpp"
+#include "server/http/reply.hpp"
+#include "server/http/request.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <string>
+
+BOOST_AUTO_TEST_SUITE(request_parser)
+
+using namespace osrm;
+using namespace osrm::server;
+
+namespace
+{
+std::tuple<RequestParser::RequestStatus, http::compression_type> parse(std::string input,
+                                                                       http::request &request)
+{
+    RequestParser parser;
+    return parser.parse(request, input.data(), input.data() + input.size());
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(http_version)
+{
+    http::request request;
+    const auto [status, compression] =
+        parse("GET /route/v1/driving/1,2;3,4 HTTP/1.1\r\nAccept-Encoding: gzip, deflate\r\n\r\n",
+              request);
+    BOOST_CHECK(status == RequestParser::RequestStatus::valid);
+    BOOST_CHECK_EQUAL(compression, http::gzip_rfc1952);
+    BOOST_CHECK_EQUAL(request.uri, "/route/v1/driving/1,2;3,4");
+    BOOST_CHECK_EQUAL(request.http_version_major, 1);
+    BOOST_CHECK_EQUAL(request.http_version_minor, 1);
+
+    http::request old_request;
+    parse("GET /route/v1/driving/1,2;3,4 HTTP/1.0\r\n\r\n", old_request);
+    BOOST_CHECK_EQUAL(old_request.http_version_major, 1);
+    BOOST_CHECK_EQUAL(old_request.http_version_minor, 0);
+
+    http::request multi_digit_request;
+    parse("GET / HTTP/12.34\r\n\r\n", multi_digit_request);
+    BOOST_CHECK_EQUAL(multi_digit_request.http_version_major, 12);
+    BOOST_CHECK_EQUAL(multi_digit_request.http_version_minor, 34);
+}
+
+BOOST_AUTO_TEST_CASE(post_body)
+{
+    std::string input = "POST /batch/v1/driving/route HTTP/1.1\r\n"
+                        "Content-Type: application/json\r\n"
+                        "Content-Length: 24\r\n"
+                        "Expect: 100-continue\r\n\r\n"
+                        "{\"queries\": [\"1,2;3,4\"]}";
+    const auto header_size = input.find("\r\n\r\n") + 4;
+
+    // the body arrives in two parts after the client was told to continue
+    http::request request;
+    RequestParser parser;
+    auto [status, compression] =
+        parser.parse(request, input.data(), input.data() + header_size + 10);
+    BOOST_CHECK(status == RequestParser::RequestStatus::indeterminate);
+    BOOST_CHECK(parser.expects_continue());
+    BOOST_CHECK(!parser.expects_continue());
+    std::tie(status, compression) =
+        parser.parse(request, input.data() + header_size + 10, input.data() + input.size());
+    BOOST_CHECK(status == RequestParser::RequestStatus::valid);
+    BOOST_CHECK_EQUAL(request.method, "POST");
+    BOOST_CHECK_EQUAL(request.uri, "/batch/v1/driving/route");
+    BOOST_CHECK_EQUAL(request.content_type, "application/json");
+    BOOST_CHECK_EQUAL(request.body, "{\"queries\": [\"1,2;3,4\"]}");
+
+    http::request get_request;
+    BOOST_CHECK(std::get<0>(parse("GET / HTTP/1.1\r\n\r\n", get_request)) ==
+                RequestParser::RequestStatus::valid);
+    BOOST_CHECK_EQUAL(get_request.method, "GET");
+    BOOST_CHECK(get_request.body.empty());
+
+    const auto status_of = [](const std::string &header)
+    {
+        http::request request;
+        return std::get<0>(parse("POST / HTTP/1.1\r\n" + header + "\r\n\r\n", request));
+    };
+    BOOST_CHECK(status_of("Content-Length: abc") == RequestParser::RequestStatus::invalid);
+    BOOST_CHECK(status_of("Content-Length: " + std::to_string(RequestParser::MAX_BODY_SIZE + 1)) ==
+                RequestParser::RequestStatus::invalid);
+    BOOST_CHECK(status_of("Transfer-Encoding: chunked") == RequestParser::RequestStatus::invalid);
+    BOOST_CHECK(status_of("Content-Length: 0") == RequestParser::RequestStatus::valid);
+
+    // the body grows as it arrives instead of reserving the announced size at once
+    const std::string large_header = "POST / HTTP/1.1\r\nContent-Length: " +
+                                     std::to_string(RequestParser::MAX_BODY_SIZE) + "\r\n\r\n";
+    http::request large_request;
+    BOOST_CHECK(std::get<0>(parse(large_header, large_request)) ==
+                RequestParser::RequestStatus::indeterminate);
+    BOOST_CHECK_LT(large_request.body.capacity(), RequestParser::MAX_BODY_SIZE);
+}
+
+BOOST_AUTO_TEST_CASE(chunked_reply)
+{
+    http::reply reply;
+    reply.headers.emplace_back("Content-Type", "application/json; charset=UTF-8");
+    reply.headers.emplace_back("Content-Length", "1000000");
+    reply.set_chunked();
+
+    const auto has_header = [&](const std::string &name, const std::string &value)
+    {
+        return std::any_of(reply.headers.begin(),
+                           reply.headers.end(),
+                           [&](const auto &h) { return h.name == name && h.value == value; });
+    };
+    BOOST_CHECK(has_header("Transfer-Encoding", "chunked"));
+    BOOST_CHECK(has_header("Content-Type", "application/json; charset=UTF-8"));
+    BOOST_CHECK(!has_header("Content-Length", "1000000"));
+
+    const auto buffers = reply.headers_to_buffers();
+    const std::string status_line(static_cast<const char *>(buffers.front().data()),
+                                  buffers.front().size());
+    BOOST_CHECK_EQUAL(status_line, "HTTP/1.1 200 OK\r\n");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,72 @@
+#include "util/json_container.hpp"
+#include "util/json_renderer.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+
+BOOST_AUTO_TEST_SUITE(json_container)
+
+using namespace osrm::util::json;
+
+BOOST_AUTO_TEST_CASE(object_keeps_insertion_order)
+{
+    Object object;
+    object.values["code"] = "Ok";
+    object.values["routes"] = Array{};
+    object.values["waypoints"] = Number{1};
+    // like std::unordered_map, emplace keeps the existing value
+    BOOST_CHECK(!object.values.emplace("code", "Error").second);
+    object.values["waypoints"] = Number{2};
+
+    BOOST_CHECK_EQUAL(object.values.size(), 3);
+    BOOST_CHECK_EQUAL(object.values.count("routes"), 1);
+    BOOST_CHECK(object.values.find("message") == object.values.end());
+    BOOST_CHECK_THROW(object.values.at("message"), std::out_of_range);
+
+    std::string out;
+    render(out, object);
+    BOOST_CHECK_EQUAL(out, R"({"code":"Ok","routes":[],"waypoints":2})");
+
+    object.values.erase(object.values.find("routes"));
+    out.clear();
+    render(out, object);
+    BOOST_CHECK_EQUAL(out, R"({"code":"Ok","waypoints":2})");
+}
+
+BOOST_AUTO_TEST_CASE(scoped_memory_resource)
+{
+    // fails every allocation that does not fit into the buffer
+    std::array<std::byte, 4096> buffer;
+    std::pmr::monotonic_buffer_resource arena{
+        buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+
+    const std::string EXPECTED =
+        R"({"name":"longer than the small string buffer","location":[7.4,43.7]})";
+
+    Object copy;
+    {
+        const ScopedMemoryResource scoped_arena{&arena};
+        Object object;
+        object.values["name"] = String("longer than the small string buffer");
+        object.values["location"] = Array{{Number{7.4}, Number{43.7}}};
+        BOOST_CHECK_THROW(String(std::string(8192, 'x')), std::bad_alloc);
+
+        std::string out;
+        render(out, object);
+        BOOST_CHECK_EQUAL(out, EXPECTED);
+
+        // the copy keeps allocating from the heap it was created with
+        copy = object;
+    }
+
+    std::string out;
+    render(out, copy);
+    BOOST_CHECK_EQUAL(out, EXPECTED);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
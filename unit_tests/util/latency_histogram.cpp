@@ -0,0 +1,94 @@
+#include "util/latency_histogram.hpp"
+#include "util/request_phases.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(latency_histogram_test)
+
+using namespace osrm;
+using namespace osrm::util;
+using namespace std::chrono_literals;
+
+BOOST_AUTO_TEST_CASE(prometheus_buckets)
+{
+    LatencyHistogram histogram;
+    histogram.Record(50us);
+    histogram.Record(100us);
+    histogram.Record(2ms);
+    histogram.Record(10s);
+    BOOST_CHECK_EQUAL(histogram.Count(), 4);
+
+    std::string out;
+    histogram.RenderPrometheus(out, "osrm_test_seconds", "service=\"route\"");
+
+    // bucket bounds are inclusive and counts are cumulative
+    BOOST_CHECK(out.find("osrm_test_seconds_bucket{service=\"route\",le=\"0.0001\"} 2\n") !=
+                std::string::npos);
+    BOOST_CHECK(out.find("osrm_test_seconds_bucket{service=\"route\",le=\"0.001\"} 2\n") !=
+                std::string::npos);
+    BOOST_CHECK(out.find("osrm_test_seconds_bucket{service=\"route\",le=\"0.0025\"} 3\n") !=
+                std::string::npos);
+    BOOST_CHECK(out.find("osrm_test_seconds_bucket{service=\"route\",le=\"5\"} 3\n") !=
+                std::string::npos);
+    BOOST_CHECK(out.find("osrm_test_seconds_bucket{service=\"route\",le=\"+Inf\"} 4\n") !=
+                std::string::npos);
+    BOOST_CHECK(out.find("osrm_test_seconds_sum{service=\"route\"} 10.00215\n") !=
+                std::string::npos);
+    BOOST_CHECK(out.find("osrm_test_seconds_count{service=\"route\"} 4\n") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_records)
+{
+    LatencyHistogram histogram;
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < 4; ++thread)
+    {
+        threads.emplace_back(
+            [&histogram]
+            {
+                for (int i = 0; i < 10000; ++i)
+                {
+                    histogram.Record(1ms);
+                }
+            });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    BOOST_CHECK_EQUAL(histogram.Count(), 40000);
+}
+
+BOOST_AUTO_TEST_CASE(nested_request_phases)
+{
+    // not accounted outside of a request
+    {
+        const ScopedRequestPhase phase(RequestPhase::Search);
+        std::this_thread::sleep_for(1ms);
+    }
+
+    StartRequestPhases();
+    {
+        const ScopedRequestPhase search(RequestPhase::Search);
+        std::this_thread::sleep_for(5ms);
+        {
+            const ScopedRequestPhase unpacking(RequestPhase::Unpacking);
+            std::this_thread::sleep_for(20ms);
+        }
+    }
+    const auto durations = StopRequestPhases();
+
+    const auto search = durations[static_cast<std::size_t>(RequestPhase::Search)];
+    const auto unpacking = durations[static_cast<std::size_t>(RequestPhase::Unpacking)];
+    BOOST_CHECK(search >= 5ms);
+    // the nested phase paused the search
+    BOOST_CHECK(search < 20ms);
+    BOOST_CHECK(unpacking >= 20ms);
+    BOOST_CHECK_EQUAL(durations[static_cast<std::size_t>(RequestPhase::Snapping)].count(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,50 @@
+#include "util/integer_range.hpp"
+#include "util/patched_packed_vector.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(patched_packed_vector_test)
+
+using namespace osrm;
+using namespace osrm::util;
+
+BOOST_AUTO_TEST_CASE(zigzag_round_trip)
+{
+    BOOST_CHECK_EQUAL(zigzagEncode(0), 0);
+    BOOST_CHECK_EQUAL(zigzagEncode(-1), 1);
+    BOOST_CHECK_EQUAL(zigzagEncode(1), 2);
+    BOOST_CHECK_EQUAL(zigzagEncode(-2), 3);
+
+    for (const std::int64_t value : {std::int64_t{0},
+                                     std::int64_t{-123456},
+                                     std::int64_t{123456},
+                                     std::numeric_limits<std::int64_t>::min(),
+                                     std::numeric_limits<std::int64_t>::max()})
+    {
+        BOOST_CHECK_EQUAL(zigzagDecode(zigzagEncode(value)), value);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(values_that_do_not_fit_are_exceptions)
+{
+    PatchedPackedVector<4> vector;
+    // 15 is the escape code and has to be stored as an exception too
+    const std::vector<std::uint64_t> values = {
+        0, 14, 15, 16, 3, std::numeric_limits<std::uint64_t>::max(), 7, 1ULL << 40};
+    for (const auto value : values)
+    {
+        vector.push_back(value);
+    }
+
+    BOOST_CHECK_EQUAL(vector.GetNumberOfExceptions(), 4);
+    for (const auto index : util::irange<std::size_t>(0, values.size()))
+    {
+        BOOST_CHECK_EQUAL(vector[index], values[index]);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
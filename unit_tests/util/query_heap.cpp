@@ -176,4 +176,107 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(decrease_key_test, T, storage_types, RandomData
     }
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(release_memory_test,
+                                 T,
+                                 storage_types,
+                                 RandomDataFixture<NUM_NODES>)
+{
+    QueryHeap<TestNodeID, TestKey, TestWeight, TestData, T> heap(NUM_NODES);
+    const auto initial_usage = heap.MemoryUsage();
+
+    for (unsigned idx : order)
+    {
+        heap.Insert(ids[idx], weights[idx], data[idx]);
+    }
+    BOOST_CHECK_GT(heap.MemoryUsage(), initial_usage);
+
+    // Clear keeps the capacity for the next search
+    heap.Clear();
+    BOOST_CHECK_GT(heap.MemoryUsage(), initial_usage);
+
+    heap.ReleaseMemory();
+    BOOST_CHECK(heap.Empty());
+    BOOST_CHECK_LE(heap.MemoryUsage(), initial_usage);
+
+    heap.Insert(ids[0], weights[0], data[0]);
+    BOOST_CHECK(heap.WasInserted(ids[0]));
+    BOOST_CHECK_EQUAL(heap.Min(), ids[0]);
+}
+
+BOOST_FIXTURE_TEST_CASE(radix_heap_test, RandomDataFixture<NUM_NODES>)
+{
+    QueryHeap<TestNodeID,
+              TestKey,
+              TestWeight,
+              TestData,
+              ArrayStorage<TestNodeID, TestKey>,
+              IntegerRadixHeap>
+        heap(2 * NUM_NODES);
+
+    for (unsigned idx : order)
+    {
+        heap.Insert(ids[idx], weights[idx], data[idx]);
+    }
+
+    // move every other node in front of its predecessor
+    for (TestNodeID id = 1; id < NUM_NODES; id += 2)
+    {
+        weights[id] = weights[id - 1] - 1;
+        heap.DecreaseKey(id, weights[id]);
+    }
+
+    for (TestNodeID id = 0; id < NUM_NODES; ++id)
+    {
+        const auto expected = id % 2 == 0 ? id + 1 : id - 1;
+        BOOST_CHECK_EQUAL(heap.MinKey(), weights[expected]);
+        BOOST_CHECK_EQUAL(heap.DeleteMin(), expected);
+        BOOST_CHECK(heap.WasRemoved(expected));
+
+        // nodes inserted during the search are settled in order as well
+        if (id % 10 == 0)
+        {
+            heap.Insert(NUM_NODES + id, weights[expected], TestData{id});
+            BOOST_CHECK_EQUAL(heap.DeleteMin(), NUM_NODES + id);
+        }
+    }
+    BOOST_CHECK(heap.Empty());
+}
+
+BOOST_AUTO_TEST_CASE(array_or_map_storage_clear_test)
+{
+    for (const bool use_array : {false, true})
+    {
+        QueryHeap<TestNodeID,
+                  TestKey,
+                  TestWeight,
+                  TestData,
+                  ArrayOrMapStorage<TestNodeID, TestKey>>
+            heap(NUM_NODES, use_array);
+
+        for (TestNodeID id = 0; id < NUM_NODES; id += 2)
+        {
+            heap.Insert(id, id, TestData{id});
+        }
+
+        heap.Clear();
+        BOOST_CHECK(heap.Empty());
+        for (TestNodeID id = 0; id < NUM_NODES; ++id)
+        {
+            BOOST_CHECK(!heap.WasInserted(id));
+        }
+
+        // positions left over from the previous query must not leak into the new one
+        heap.Insert(1, 1, TestData{1});
+        BOOST_CHECK(heap.WasInserted(1));
+        BOOST_CHECK(!heap.WasInserted(0));
+        BOOST_CHECK(heap.GetHeapNodeIfWasInserted(0) == nullptr);
+        BOOST_CHECK_EQUAL(heap.GetData(1).value, 1);
+
+        const auto &storage = heap.GetIndexStorage();
+        BOOST_CHECK(storage.IsCompatible(NUM_NODES, use_array));
+        BOOST_CHECK(!storage.IsCompatible(NUM_NODES, !use_array));
+        BOOST_CHECK_EQUAL(storage.IsCompatible(NUM_NODES + 1, use_array), !use_array);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,164 @@
+#include "util/radix_heap.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace osrm;
+using namespace osrm::util;
+
+BOOST_AUTO_TEST_SUITE(radix_heap_test)
+
+namespace
+{
+struct HeapData
+{
+    int weight;
+    int data;
+};
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_emplace_and_pop)
+{
+    RadixHeap<HeapData> heap;
+    BOOST_CHECK(heap.empty());
+    heap.emplace({10, 0}, [](const HeapData &, size_t) {});
+    heap.emplace({5, 1}, [](const HeapData &, size_t) {});
+    heap.emplace({8, 2}, [](const HeapData &, size_t) {});
+    BOOST_CHECK_EQUAL(heap.size(), 3);
+
+    for (const auto weight : {5, 8, 10})
+    {
+        BOOST_CHECK_EQUAL(heap.top().weight, weight);
+        heap.pop([](const HeapData &, size_t) {});
+    }
+    BOOST_CHECK(heap.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_decrease)
+{
+    RadixHeap<HeapData> heap;
+    std::vector<size_t> handles(3, RadixHeap<HeapData>::INVALID_HANDLE);
+    auto reorder_handler = [&](const HeapData &value, size_t new_handle)
+    { handles[value.data] = new_handle; };
+
+    heap.emplace({10, 0}, reorder_handler);
+    heap.emplace({5, 1}, reorder_handler);
+    heap.emplace({8, 2}, reorder_handler);
+    BOOST_CHECK_EQUAL(heap[handles[2]].weight, 8);
+
+    heap.decrease(handles[0], {3, 0}, reorder_handler);
+    BOOST_CHECK_EQUAL(heap.size(), 3);
+    BOOST_CHECK_EQUAL(heap.top().data, 0);
+    heap.pop(reorder_handler);
+    BOOST_CHECK_EQUAL(heap.top().data, 1);
+
+    // decreasing to the last removed weight keeps the heap monotone
+    heap.decrease(handles[2], {3, 2}, reorder_handler);
+    BOOST_CHECK_EQUAL(heap.top().data, 2);
+    BOOST_CHECK_EQUAL(heap[handles[1]].weight, 5);
+}
+
+BOOST_AUTO_TEST_CASE(test_weights_below_removed_minimum)
+{
+    RadixHeap<HeapData, RadixWeightKey> heap;
+    heap.emplace({10, 0}, [](const HeapData &, size_t) {});
+    heap.emplace({20, 1}, [](const HeapData &, size_t) {});
+    heap.pop([](const HeapData &, size_t) {});
+
+    // the first nodes of a search can have negative weights
+    heap.emplace({-5, 2}, [](const HeapData &, size_t) {});
+    heap.emplace({-7, 3}, [](const HeapData &, size_t) {});
+    for (const auto weight : {-7, -5, 20})
+    {
+        BOOST_CHECK_EQUAL(heap.top().weight, weight);
+        heap.pop([](const HeapData &, size_t) {});
+    }
+    BOOST_CHECK(heap.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_alias_weights)
+{
+    struct AliasHeapData
+    {
+        EdgeWeight weight;
+    };
+    RadixHeap<AliasHeapData> heap;
+    heap.emplace({EdgeWeight{3}}, [](const AliasHeapData &, size_t) {});
+    heap.emplace({INVALID_EDGE_WEIGHT}, [](const AliasHeapData &, size_t) {});
+    heap.emplace({EdgeWeight{-3}}, [](const AliasHeapData &, size_t) {});
+    BOOST_CHECK_EQUAL(heap.top().weight, EdgeWeight{-3});
+    heap.pop([](const AliasHeapData &, size_t) {});
+    BOOST_CHECK_EQUAL(heap.top().weight, EdgeWeight{3});
+    heap.pop([](const AliasHeapData &, size_t) {});
+    BOOST_CHECK_EQUAL(heap.top().weight, INVALID_EDGE_WEIGHT);
+}
+
+BOOST_AUTO_TEST_CASE(test_monotone_search)
+{
+    // Dijkstra-like sequence of operations, checked against an ordered map
+    std::mt19937 generator(13);
+    std::uniform_int_distribution<int> offset(0, 1000);
+
+    RadixHeap<HeapData> heap;
+    std::vector<size_t> handles;
+    std::vector<int> weights;
+    std::multimap<int, int> expected;
+    auto reorder_handler = [&](const HeapData &value, size_t new_handle)
+    { handles[value.data] = new_handle; };
+    auto erase = [&](const int weight, const int id)
+    {
+        auto range = expected.equal_range(weight);
+        while (range.first->second != id)
+        {
+            ++range.first;
+        }
+        expected.erase(range.first);
+    };
+
+    int last_weight = 0;
+    for (int round = 0; round < 10000; ++round)
+    {
+        const auto operation = generator() % 3;
+        if (operation == 0 && !heap.empty())
+        {
+            BOOST_REQUIRE_EQUAL(heap.top().weight, expected.begin()->first);
+            last_weight = heap.top().weight;
+            erase(last_weight, heap.top().data);
+            handles[heap.top().data] = RadixHeap<HeapData>::INVALID_HANDLE;
+            heap.pop(reorder_handler);
+        }
+        else if (operation == 1 && !heap.empty())
+        {
+            const auto id = static_cast<int>(generator() % weights.size());
+            if (handles[id] == RadixHeap<HeapData>::INVALID_HANDLE || weights[id] == last_weight)
+            {
+                continue;
+            }
+            const auto weight = weights[id] - 1;
+            erase(weights[id], id);
+            expected.emplace(weight, id);
+            weights[id] = weight;
+            heap.decrease(handles[id], {weight, id}, reorder_handler);
+        }
+        else
+        {
+            const auto id = static_cast<int>(weights.size());
+            const auto weight = last_weight + offset(generator);
+            handles.push_back(RadixHeap<HeapData>::INVALID_HANDLE);
+            weights.push_back(weight);
+            expected.emplace(weight, id);
+            heap.emplace({weight, id}, reorder_handler);
+        }
+        BOOST_REQUIRE_EQUAL(heap.size(), expected.size());
+        for (const auto &[weight, id] : expected)
+        {
+            BOOST_REQUIRE_EQUAL(heap[handles[id]].data, id);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
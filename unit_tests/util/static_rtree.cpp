@@ -272,6 +272,47 @@ BOOST_FIXTURE_TEST_CASE(construct_multiple_levels_test, TestRandomGraphFixture_M
     construction_test("test_5", *this);
 }
 
+BOOST_FIXTURE_TEST_CASE(batch_nearest_test, TestRandomGraphFixture_MultipleLevels)
+{
+    TemporaryFile tmp;
+    auto rtree = make_rtree<TestStaticRTree>(tmp.path, *this);
+
+    std::mt19937 g(RANDOM_SEED);
+    std::uniform_int_distribution<> lat_udist(WORLD_MIN_LAT, WORLD_MAX_LAT);
+    std::uniform_int_distribution<> lon_udist(WORLD_MIN_LON, WORLD_MAX_LON);
+    // more than one block of queries, so the batch runs in parallel
+    std::vector<Coordinate> queries;
+    for (unsigned i = 0; i < 3 * TestStaticRTree::BATCH_BLOCK_SIZE; i++)
+    {
+        queries.emplace_back(FixedLongitude{lon_udist(g)}, FixedLatitude{lat_udist(g)});
+    }
+
+    const auto accept_all = [](const auto &) { return std::make_pair(true, true); };
+    const auto three_results = [](const std::size_t num_results, const auto &)
+    { return num_results >= 3; };
+
+    std::vector<std::vector<TestStaticRTree::CandidateSegment>> batch_results(queries.size());
+    rtree.BatchNearest(queries,
+                       [&](const std::size_t index, TestStaticRTree::LeafCache &leaf_cache)
+                       {
+                           batch_results[index] = rtree.Nearest(
+                               queries[index], accept_all, three_results, &leaf_cache);
+                       });
+
+    for (const auto index : irange<std::size_t>(0, queries.size()))
+    {
+        const auto results = rtree.Nearest(queries[index], accept_all, three_results);
+        BOOST_REQUIRE_EQUAL(results.size(), batch_results[index].size());
+        for (const auto result : irange<std::size_t>(0, results.size()))
+        {
+            BOOST_CHECK_EQUAL(results[result].data.u, batch_results[index][result].data.u);
+            BOOST_CHECK_EQUAL(results[result].data.v, batch_results[index][result].data.v);
+            BOOST_CHECK(results[result].fixed_projected_coordinate ==
+                        batch_results[index][result].fixed_projected_coordinate);
+        }
+    }
+}
+
 // Bug: If you querry a point that lies between two BBs that have a gap,
 // one BB will be pruned, even if it could contain a nearer match.
 BOOST_AUTO_TEST_CASE(regression_test)